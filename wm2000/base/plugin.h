@@ -143,6 +143,11 @@ PLUGINS_EXPORTDLL const char* ts3plugin_keyDeviceName(const char* keyIdentifier)
 PLUGINS_EXPORTDLL const char* ts3plugin_displayKeyText(const char* keyIdentifier);
 PLUGINS_EXPORTDLL const char* ts3plugin_keyPrefix();
 
+/* Not called by TS3, used by the headless tools in bench/ */
+void wm2000_set_synchronous_events(int bSynchronous);   /* 1 => callbacks process their event before they return */
+void wm2000_flush_events();                             /* process all queued events in the calling thread */
+void wm2000_reload_config();                            /* read config.xml again, like the apply button of the settings */
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,5 +1,7 @@
 #include "plugin_base.h"
+#ifdef _WIN32
 #include <Shlwapi.h>
+#endif
 //#include <synchapi.h>
 
 #if USE_CALL_STACK
@@ -16,11 +18,15 @@ plugin_base::plugin_base()
     CALL_STACK
     try
     {
-        this->m_vServerList.reserve(20);
         this->m_pPluginID           = nullptr;
         this->m_nServerConnected    = 0;
         this->m_bServerConnected    = false;
         this->m_pMainUi             = nullptr;
+        this->m_bSynchronous        = false;
+        this->m_pcRxFilter          = std::make_shared<rx_filter_map>();
+
+        // hotkey actions are resolved from config on first use
+        this->m_cHotkeyTable.init(&this->m_cConfigData);
     }
     catch (std::exception &e)
     {
@@ -42,6 +48,7 @@ plugin_base::plugin_base()
 plugin_base::~plugin_base()
 {
     CALL_STACK
+    this->m_cWorkPool.stop();
 }
 
 /* ----------------------------------------------------------------------------
@@ -59,12 +66,17 @@ void plugin_base::Init(struct TS3Functions stTs3TempFunc, std::string sPluginPat
 
         //create UI and read config from file
         std::string sConfigPath = this->m_sPluginPath + std::string("WhisperMaster2000/");
+        language_pkg::set_language_path(sConfigPath);
         if(this->m_pMainUi == nullptr) this->m_pMainUi = new wm2000_main_ui_actions(&m_cConfigData, nullptr, sConfigPath);
+        this->m_pMainUi->set_work_pool(&this->m_cWorkPool);
         check_param();
 
         // set language
         this->m_cTranslate.set_language(this->m_cConfigData.s_get_Language());
         //this->m_cSpeechEngine.set_language(this->m_cConfigData.s_get_Language().c_str());
+
+        // callbacks only queue their events from now on
+        if (!this->m_bSynchronous) this->m_cWorkPool.start();
     }
     catch (std::exception &e)
     {
@@ -130,6 +142,10 @@ void plugin_base::Close()
     {
         //this->m_cConfigData.s_write_param();
 
+        // finish all queued events before the UI is gone
+        this->m_cWorkPool.stop();
+        flush_events();
+
         //close UI
         if (this->m_pMainUi != nullptr)
         {
@@ -137,6 +153,13 @@ void plugin_base::Close()
             delete this->m_pMainUi;
             this->m_pMainUi = nullptr;
         }
+
+        // release remaining servers while the TS3 functions are still valid
+        {
+            boost::lock_guard<boost::mutex> lock(this->m_cRxFilterMutex);
+            std::atomic_store(&this->m_pcRxFilter, std::shared_ptr<const rx_filter_map>(std::make_shared<rx_filter_map>()));
+        }
+        this->m_cServerRegistry.clear();
     }
     catch (std::exception &e)
     {
@@ -161,36 +184,57 @@ void plugin_base::onConnect(uint64 nServerConnectionHandlerID, int newStatus)
     CALL_STACK
     try
     {
+        // server list and UI are changed here, all queued events of the server are processed first
+        server_list *pcServer = find_server(nServerConnectionHandlerID);
+        if (pcServer != nullptr)
+            flush_server(pcServer);
+
         if (newStatus == STATUS_CONNECTED)
         {
             //create server_list entry
-            if (find_server_idx(nServerConnectionHandlerID) < 0)
+            if (pcServer == nullptr)
             {
-                server_list cServerList;
-                cServerList.m_nServerID = nServerConnectionHandlerID;
-                if (this->m_stTs3Functions.getClientID(nServerConnectionHandlerID, &cServerList.m_nMyClientID) == ERROR_ok)
+                std::unique_ptr<server_list> pcNewServer(new server_list());
+                pcNewServer->m_nServerID    = nServerConnectionHandlerID;
+                pcNewServer->m_bScheduled   = false;
+                pcNewServer->m_bClosing     = false;
+                if (this->m_stTs3Functions.getClientID(nServerConnectionHandlerID, &pcNewServer->m_nMyClientID) == ERROR_ok)
                 {
-                    cServerList.m_pHandler = new plugin_handler(nServerConnectionHandlerID, cServerList.m_nMyClientID, &this->m_stTs3Functions, &this->m_cConfigData, this->m_pPluginID, &this->m_cTranslate);
-                    this->m_vServerList.push_back(cServerList);
+                    pcNewServer->m_pHandler.reset(new plugin_handler(nServerConnectionHandlerID, pcNewServer->m_nMyClientID, &this->m_stTs3Functions, &this->m_cConfigData, this->m_pPluginID, &this->m_cTranslate));
+                    {
+                        boost::lock_guard<boost::mutex> lock(this->m_cRxFilterMutex);
+                        std::shared_ptr<rx_filter_map> pcNewFilter = std::make_shared<rx_filter_map>(*std::atomic_load(&this->m_pcRxFilter));
+                        (*pcNewFilter)[nServerConnectionHandlerID] = pcNewServer->m_pHandler->get_rx_filter();
+                        std::atomic_store(&this->m_pcRxFilter, std::shared_ptr<const rx_filter_map>(std::move(pcNewFilter)));
+                    }
+                    this->m_cServerRegistry.insert(nServerConnectionHandlerID, std::move(pcNewServer));
                 }
             }
             else
             {
                 //error
             }
-            if (DEBUG_LOG) printf("PLUGIN: New server (%d/%zd) connection established\n", this->m_nServerConnected, this->m_vServerList.size());
+            if (DEBUG_LOG) printf("PLUGIN: New server (%d/%zd) connection established\n", this->m_nServerConnected, this->m_cServerRegistry.size());
         }
         else if (newStatus == STATUS_CONNECTION_ESTABLISHED)
         {
             // if client connection is fully established
-            if (find_server_idx(nServerConnectionHandlerID) >= 0)
+            if (pcServer != nullptr)
             {
-                //update meta data if server is fully connected
-                find_server_handler(nServerConnectionHandlerID)->update_meta_data();
-                //check server depending parameter
-                find_server_handler(nServerConnectionHandlerID)->check_param();
+                //channels of the ignore list may exist on any connected server
+                if (this->m_cConfigData.s_get_SaveIgnoreList())
+                {
+                    flush_events();
+                    validate_ignore_list();
+                }
+
+                //update meta data and check server depending parameter in work pool
+                plugin_event cEvent = plugin_event();
+                cEvent.eType        = EVENT_ESTABLISHED;
+                cEvent.nServerID    = nServerConnectionHandlerID;
+                post_event(pcServer, cEvent);
                 //setup link to client filter
-                if (this->m_pMainUi != nullptr) this->m_pMainUi->add_pointer(find_server_handler(nServerConnectionHandlerID)->get_client_filter(), find_server_handler(nServerConnectionHandlerID)->get_channel_filter());
+                if (this->m_pMainUi != nullptr) this->m_pMainUi->add_pointer(pcServer->m_pHandler->get_client_filter(), pcServer->m_pHandler->get_channel_filter(), pcServer->m_pHandler->get_talk_tracker());
             }
             else
                 if (DEBUG_LOG) printf("Server not found \"plugin_base::onConnect\"\n");
@@ -210,21 +254,26 @@ void plugin_base::onConnect(uint64 nServerConnectionHandlerID, int newStatus)
                     this->m_stTs3Functions.logMessage(TRANSLATE("conn_WrongConn"), LogLevel_WARNING, "Whispermaster2000", nServerConnectionHandlerID);
                 return;
             }
-            if (DEBUG_LOG) printf("PLUGIN: Server (%d/%zd) name: %s\n", this->m_nServerConnected, this->m_vServerList.size(), s);
+            if (DEBUG_LOG) printf("PLUGIN: Server (%d/%zd) name: %s\n", this->m_nServerConnected, this->m_cServerRegistry.size(), s);
             this->m_stTs3Functions.freeMemory(s);
         }
         else if (newStatus == STATUS_DISCONNECTED)
         {
             //destroy server_list entry
-            int nServerIdx = find_server_idx(nServerConnectionHandlerID);
-            if (nServerIdx >= 0)
+            if (pcServer != nullptr)
             {
                 //clean up link to client filter
-                if (this->m_pMainUi != nullptr) this->m_pMainUi->delete_pointer(find_server_handler(nServerConnectionHandlerID)->get_client_filter(), find_server_handler(nServerConnectionHandlerID)->get_channel_filter());
+                if (this->m_pMainUi != nullptr) this->m_pMainUi->delete_pointer(pcServer->m_pHandler->get_client_filter(), pcServer->m_pHandler->get_channel_filter(), pcServer->m_pHandler->get_talk_tracker());
+                {
+                    boost::lock_guard<boost::mutex> lock(this->m_cRxFilterMutex);
+                    std::shared_ptr<rx_filter_map> pcNewFilter = std::make_shared<rx_filter_map>(*std::atomic_load(&this->m_pcRxFilter));
+                    pcNewFilter->erase(nServerConnectionHandlerID);
+                    std::atomic_store(&this->m_pcRxFilter, std::shared_ptr<const rx_filter_map>(std::move(pcNewFilter)));
+                }
 
-                // delete handler in list
-                delete this->m_vServerList[nServerIdx].m_pHandler;
-                this->m_vServerList.erase(this->m_vServerList.begin() + nServerIdx);
+                // remove from registry, the entry is destroyed after its queued or running task has finished
+                std::unique_ptr<server_list> pcOldServer = this->m_cServerRegistry.erase(nServerConnectionHandlerID);
+                close_server(pcOldServer.get());
             }
             //mark as disconnected
             this->m_nServerConnected--;
@@ -251,34 +300,36 @@ void plugin_base::onConnect(uint64 nServerConnectionHandlerID, int newStatus)
 
 
 /* ----------------------------------------------------------------------------
-* find serverID in server list and return index
+* check which channels of the ignore list exist on the connected servers
+*   lookup runs in parallel for all servers, the list is changed afterwards
+*   (no events are processed meanwhile, flush_events has to be called before)
 */
-int plugin_base::find_server_idx(uint64 nServerConnectionHandlerID)
+void plugin_base::validate_ignore_list()
 {
     CALL_STACK
-    for (int ii = 0; ii < this->m_vServerList.size(); ii++)
-        if (this->m_vServerList[ii].m_nServerID == nServerConnectionHandlerID)
-            return ii;
-
-    return -1;
-}
+    std::vector<channel_info> *plIgnoreList = this->m_cConfigData.s_get_IgnoreList();
+    std::vector<std::vector<char>> vvFound(this->m_cServerRegistry.size());
 
+    std::vector<work_pool::task> vTask;
+    for (size_t ii = 0; ii < this->m_cServerRegistry.size(); ii++)
+    {
+        channel_filter *pcFilter = this->m_cServerRegistry.at(ii)->m_pHandler->get_channel_filter();
+        std::vector<char> *pvFound = &vvFound[ii];
+        vTask.push_back([pcFilter, plIgnoreList, pvFound]() { pcFilter->find_channels_in_list(plIgnoreList, *pvFound); });
+    }
+    this->m_cWorkPool.run_all(vTask);
 
+    // entry is valid, if it was found on any server
+    std::vector<char> vbFound(plIgnoreList->size(), 0);
+    for (size_t ii = 0; ii < vvFound.size(); ii++)
+        for (size_t jj = 0; (jj < vvFound[ii].size()) && (jj < vbFound.size()); jj++)
+            vbFound[jj] |= vvFound[ii][jj];
 
-/* ----------------------------------------------------------------------------
-* find serverID in server list and return ptr to handler
-*/
-plugin_handler* plugin_base::find_server_handler(uint64 nServerConnectionHandlerID)
-{
-    CALL_STACK
-    for (int ii = 0; ii < this->m_vServerList.size(); ii++)
-        if (this->m_vServerList[ii].m_nServerID == nServerConnectionHandlerID)
-            return this->m_vServerList[ii].m_pHandler;
-
-    return nullptr;
+    channel_filter::update_invalid_count(plIgnoreList, vbFound);
 }
 
 
+
 /* ----------------------------------------------------------------------------
 * check all parameter of this->configData on init
 */
@@ -420,7 +471,7 @@ void plugin_base::initHotkeys(struct PluginHotkey*** hotkeys)
         BEGIN_CREATE_HOTKEYS(nItems);  /* Create hotkeys. Size must be correct for allocating memory. */
         for (int ii = 0; ii < this->m_cConfigData.s_get_MaxNumProfiles(); ii++)
         {
-            sprintf_s(cBuffer_key, nBuffSize, "profile_%d", ii + 1);
+            sprintf_s(cBuffer_key, nBuffSize, HOTKEY_KEYWORD_PROFILE, ii + 1);
             if (this->m_cConfigData.s_get_ProfileType(ii) == PROFILE_FAVORITE)
             {
                 if(this->m_cConfigData.s_get_AutoActivate(ii))
@@ -446,7 +497,7 @@ void plugin_base::initHotkeys(struct PluginHotkey*** hotkeys)
                 CREATE_HOTKEY(cBuffer_key, cBuffer_txt);
             }
         }
-        CREATE_HOTKEY("reset", TRANSLATE("hotkey_Reset"));
+        CREATE_HOTKEY(HOTKEY_KEYWORD_RESET, TRANSLATE("hotkey_Reset"));
         END_CREATE_HOTKEYS;
     }
     catch (std::exception &e)
@@ -507,6 +558,7 @@ void plugin_base::InitMenu(struct PluginMenuItem*** menuItems)
                 nItems++;                               //MENU_ID_GLOBAL_FREQ_MUTE_P1 - MENU_ID_GLOBAL_FREQ_MUTE_P_Max
         }
         nItems++;                                       //MENU_ID_GLOBAL_HELP
+        nItems++;                                       //MENU_ID_GLOBAL_ABOUT
 
         // Create menu
         BEGIN_CREATE_MENUS(nItems);  /* IMPORTANT: Number of menu items must be correct! */
@@ -574,6 +626,45 @@ void plugin_base::InitMenu(struct PluginMenuItem*** menuItems)
 
 
 
+/* ----------------------------------------------------------------------------
+* handle console command "/WhisperMaster <command>", returns 0 if command was handled
+*/
+int plugin_base::processCommand(uint64 nServerConnectionHandlerID, const char* command)
+{
+    CALL_STACK
+    try
+    {
+        const size_t nBuffSize = 512;
+        char cBuffer[nBuffSize];
+
+        if (strcmp(command, "langpack") == 0)
+        {
+            // write language packs of the built-in strings, used as template for translations
+            std::string sConfigPath = this->m_sPluginPath + std::string("WhisperMaster2000/");
+            if (language_pkg::export_language_files(sConfigPath))
+                sprintf_s(cBuffer, nBuffSize, TRANSLATE("cmd_LangpackDone"), sConfigPath.c_str());
+            else
+                sprintf_s(cBuffer, nBuffSize, TRANSLATE("cmd_LangpackErr"), sConfigPath.c_str());
+
+            this->m_stTs3Functions.printMessageToCurrentTab(cBuffer);
+            return 0;
+        }
+    }
+    catch (std::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (boost::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (...)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__);
+    }
+    return 1;
+}
+
 /* ----------------------------------------------------------------------------
 * interface function
 */
@@ -585,10 +676,19 @@ void plugin_base::onHotkeyEvent(const char* keyword)
         // serverID is not delivered with this event, get the actual selected ServerTab
         uint64 nServerConnectionHandlerID = this->m_stTs3Functions.getCurrentServerConnectionHandlerID();
 
-        if (find_server_idx(nServerConnectionHandlerID) >= 0)
-            find_server_handler(nServerConnectionHandlerID)->onHotkeyEvent(keyword);
-        else
-            if (DEBUG_LOG) printf("Server not found \"plugin_base::onHotkeyEvent\"\n");
+        // only the table index is queued, the action is resolved in the work pool
+        int iIndex = this->m_cHotkeyTable.find_index(keyword);
+        if (iIndex < 0)
+        {
+            if (DEBUG_LOG) printf("Hotkey %s unknown\n", keyword);
+            return;
+        }
+
+        plugin_event cEvent = plugin_event();
+        cEvent.eType        = EVENT_HOTKEY;
+        cEvent.nServerID    = nServerConnectionHandlerID;
+        cEvent.iValue       = iIndex;
+        post_event(cEvent);
     }
     catch (std::exception &e)
     {
@@ -611,14 +711,40 @@ void plugin_base::onUpdateClientEvent(uint64 nServerConnectionHandlerID, anyID n
     CALL_STACK
     try
     {
-        if (find_server_idx(nServerConnectionHandlerID) >= 0)
-        {
-            find_server_handler(nServerConnectionHandlerID)->onUpdateClientEvent(nClientID, nActChannel);
+        plugin_event cEvent = plugin_event();
+        cEvent.eType        = EVENT_UPDATE_CLIENT;
+        cEvent.nServerID    = nServerConnectionHandlerID;
+        cEvent.nChannelID   = nActChannel;
+        cEvent.nClientID    = nClientID;
+        post_event(cEvent);
+    }
+    catch (std::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (boost::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (...)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__);
+    }
+}
 
-            if (this->m_pMainUi != nullptr) this->m_pMainUi->update_ui();
-        }
-        else
-            if (DEBUG_LOG) printf("Server not found \"plugin_base::onUpdateClientEvent\"\n");
+
+/* ----------------------------------------------------------------------------
+* interface function (channel created, deleted, moved or edited)
+*/
+void plugin_base::onChannelEvent(uint64 nServerConnectionHandlerID)
+{
+    CALL_STACK
+    try
+    {
+        plugin_event cEvent = plugin_event();
+        cEvent.eType        = EVENT_CHANNEL;
+        cEvent.nServerID    = nServerConnectionHandlerID;
+        post_event(cEvent);
     }
     catch (std::exception &e)
     {
@@ -643,10 +769,70 @@ void plugin_base::onTalkStatusChangeEvent(uint64 nServerConnectionHandlerID, int
     CALL_STACK
     try
     {
-        if (find_server_idx(nServerConnectionHandlerID) >= 0)
-            find_server_handler(nServerConnectionHandlerID)->onTalkStatusChangeEvent(iStatus, iIsReceivedWhisper, nClientID);
-        else
-            if (DEBUG_LOG) printf("Server not found \"%s\"\n", __FUNCSIG__);
+        // the voice data follows immediately, the receive filter is told here and not in the work pool
+        std::shared_ptr<rx_filter> pcRxFilter = find_rx_filter(nServerConnectionHandlerID);
+        if (pcRxFilter)
+            pcRxFilter->set_talk_status(nClientID, iStatus == STATUS_TALKING, iIsReceivedWhisper != 0);
+
+        plugin_event cEvent = plugin_event();
+        cEvent.eType                = EVENT_TALK_STATUS;
+        cEvent.nServerID            = nServerConnectionHandlerID;
+        cEvent.nClientID            = nClientID;
+        cEvent.iValue               = iStatus;
+        cEvent.bIsReceivedWhisper   = (iIsReceivedWhisper != 0);
+        post_event(cEvent);
+    }
+    catch (std::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (boost::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (...)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__);
+    }
+}
+
+
+/* ----------------------------------------------------------------------------
+* interface function (audio thread), no call stack trace on this path
+*/
+void plugin_base::onEditPlaybackVoiceDataEvent(uint64 nServerConnectionHandlerID, anyID nClientID, short* psSamples, int iSampleCount, int iChannels)
+{
+    try
+    {
+        std::shared_ptr<rx_filter> pcRxFilter = find_rx_filter(nServerConnectionHandlerID);
+        if (pcRxFilter)
+            pcRxFilter->process(nClientID, psSamples, iSampleCount, iChannels);
+    }
+    catch (std::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (boost::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (...)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__);
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* interface function (audio thread), full volume for placed clients, the
+* rolloff of TS3 further away, no lookup of the server or client
+* (see spatial_layout::get_rolloff)
+*/
+void plugin_base::onCustom3dRolloffCalculationClientEvent(uint64 nServerConnectionHandlerID, anyID nClientID, float fDistance, float* pfVolume)
+{
+    try
+    {
+        if (pfVolume != nullptr)
+            *pfVolume = spatial_layout::get_rolloff(fDistance, *pfVolume);
     }
     catch (std::exception &e)
     {
@@ -662,6 +848,16 @@ void plugin_base::onTalkStatusChangeEvent(uint64 nServerConnectionHandlerID, int
     }
 }
 
+/* ----------------------------------------------------------------------------
+* receive filter of a server, nullptr if unknown (any thread), the audio
+* thread reads the current snapshot and never waits for a connect or disconnect
+*/
+std::shared_ptr<rx_filter> plugin_base::find_rx_filter(uint64 nServerConnectionHandlerID)
+{
+    std::shared_ptr<const rx_filter_map> pcFilter = std::atomic_load(&this->m_pcRxFilter);
+    rx_filter_map::const_iterator it = pcFilter->find(nServerConnectionHandlerID);
+    return (it != pcFilter->end()) ? it->second : std::shared_ptr<rx_filter>();
+}
 
 /* ----------------------------------------------------------------------------
 * interface function
@@ -671,8 +867,13 @@ void plugin_base::infoData(uint64 nServerConnectionHandlerID, uint64 id, enum Pl
     CALL_STACK
     try
     {
-        if (find_server_idx(nServerConnectionHandlerID) >= 0)
-            find_server_handler(nServerConnectionHandlerID)->infoData(id, type, data);
+        server_list *pcServer = find_server(nServerConnectionHandlerID);
+        if (pcServer != nullptr)
+        {
+            // handler may be used by the work pool, wait for the actual event
+            boost::lock_guard<boost::recursive_mutex> lock(pcServer->m_cWorkMutex);
+            pcServer->m_pHandler->infoData(id, type, data);
+        }
         else
             if (DEBUG_LOG) printf("Server not found \"%s\"\n", __FUNCSIG__);
     }
@@ -701,6 +902,10 @@ void plugin_base::onMenuItemEvent(uint64 nServerConnectionHandlerID, enum Plugin
     {
         const size_t nBuffSize = 512;
         char cBuffer[nBuffSize];
+
+        // menu items print or change the lists shared by all servers, all queued events are processed first
+        flush_events();
+        server_list *pcServer = find_server(nServerConnectionHandlerID);
     
         switch (type) {
         case PLUGIN_MENU_TYPE_GLOBAL:
@@ -715,8 +920,8 @@ void plugin_base::onMenuItemEvent(uint64 nServerConnectionHandlerID, enum Plugin
                 break;
 
             case MENU_ID_GLOBAL_SHOW_ALL:
-                if (find_server_idx(nServerConnectionHandlerID) >= 0)
-                    find_server_handler(nServerConnectionHandlerID)->print_all_lists();
+                if (pcServer != nullptr)
+                    pcServer->m_pHandler->print_all_lists();
                 break;
 
             case MENU_ID_GLOBAL_CLEAN_IGNORE:
@@ -732,7 +937,11 @@ void plugin_base::onMenuItemEvent(uint64 nServerConnectionHandlerID, enum Plugin
 
                 if (this->m_cConfigData.file_exists(temp))
                 {
+#ifdef _WIN32
                     ShellExecute(NULL, L"open", temp_w.c_str(), NULL, NULL, SW_SHOW);
+#else
+                    if (DEBUG_LOG) printf("PLUGIN: open help file %s\n", temp.c_str());
+#endif
                 }
                 else
                 {
@@ -757,8 +966,16 @@ void plugin_base::onMenuItemEvent(uint64 nServerConnectionHandlerID, enum Plugin
                 {
                     // Menu "mute frequency" was triggered
                     this->m_cConfigData.s_set_MuteFreq(menuItemID - MENU_ID_GLOBAL_FREQ_MUTE_P1, !this->m_cConfigData.s_get_MuteFreq(menuItemID - MENU_ID_GLOBAL_FREQ_MUTE_P1));
-                    for (size_t ii = 0; ii < this->m_vServerList.size(); ii++)
-                        this->m_vServerList[ii].m_pHandler->update_meta_data();
+                    std::vector<work_pool::task> vTask;
+                    for (size_t ii = 0; ii < this->m_cServerRegistry.size(); ii++)
+                    {
+                        server_list *pcEntry = this->m_cServerRegistry.at(ii);
+                        vTask.push_back([pcEntry]() {
+                            boost::lock_guard<boost::recursive_mutex> lock(pcEntry->m_cWorkMutex);
+                            pcEntry->m_pHandler->update_meta_data();
+                        });
+                    }
+                    this->m_cWorkPool.run_all(vTask);
 
                     //update change in ui
                     if (this->m_pMainUi != nullptr) this->m_pMainUi->update_config();
@@ -775,8 +992,8 @@ void plugin_base::onMenuItemEvent(uint64 nServerConnectionHandlerID, enum Plugin
                 // add or clear selected channel from ignore list
                 //-------------------------------------------------------------------------------------
                 if (DEBUG_LOG) printf("PLUGIN: Toggle ignore list\n");
-                if (find_server_idx(nServerConnectionHandlerID) >= 0)
-                    find_server_handler(nServerConnectionHandlerID)->toggle_ignore(selectedItemID);
+                if (pcServer != nullptr)
+                    pcServer->m_pHandler->toggle_ignore(selectedItemID);
 
                 break;
             }
@@ -787,16 +1004,16 @@ void plugin_base::onMenuItemEvent(uint64 nServerConnectionHandlerID, enum Plugin
                     // add or clear selected channel from channel list (favorite + audio)
                     //-------------------------------------------------------------------------------------
                     if (DEBUG_LOG) printf("Toggle P%d\n", menuItemID - MENU_ID_CHANNEL_TOGGLE_P1 + 1);
-                    if (find_server_idx(nServerConnectionHandlerID) >= 0)
-                        find_server_handler(nServerConnectionHandlerID)->toggle_favorite(menuItemID - MENU_ID_CHANNEL_TOGGLE_P1, selectedItemID);
+                    if (pcServer != nullptr)
+                        pcServer->m_pHandler->toggle_favorite(menuItemID - MENU_ID_CHANNEL_TOGGLE_P1, selectedItemID);
                 }
                 else if ((menuItemID >= MENU_ID_CHANNEL_LEVEL_P1) && (menuItemID <= MENU_ID_CHANNEL_LEVEL_P_Max))
                 {
                     // set new start level, but keep actual end level in mind
                     //-------------------------------------------------------------------------------------
                     if (DEBUG_LOG) printf("Set Level P%d\n", menuItemID - MENU_ID_CHANNEL_LEVEL_P1 + 1);
-                    if (find_server_idx(nServerConnectionHandlerID) >= 0)
-                        find_server_handler(nServerConnectionHandlerID)->set_profile_level(menuItemID - MENU_ID_CHANNEL_LEVEL_P1, selectedItemID, true);
+                    if (pcServer != nullptr)
+                        pcServer->m_pHandler->set_profile_level(menuItemID - MENU_ID_CHANNEL_LEVEL_P1, selectedItemID, true);
 
                 }
                 else if ((menuItemID >= MENU_ID_CHANNEL_LEVEL_END_P1) && (menuItemID <= MENU_ID_CHANNEL_LEVEL_END_P_Max))
@@ -804,8 +1021,8 @@ void plugin_base::onMenuItemEvent(uint64 nServerConnectionHandlerID, enum Plugin
                     // set new end level, but keep actual start level in mind
                     //-------------------------------------------------------------------------------------
                     if (DEBUG_LOG) printf("Set Level end P%d\n", menuItemID - MENU_ID_CHANNEL_LEVEL_END_P1 + 1);
-                    if (find_server_idx(nServerConnectionHandlerID) >= 0)
-                        find_server_handler(nServerConnectionHandlerID)->set_profile_level(menuItemID - MENU_ID_CHANNEL_LEVEL_END_P1, selectedItemID, false);
+                    if (pcServer != nullptr)
+                        pcServer->m_pHandler->set_profile_level(menuItemID - MENU_ID_CHANNEL_LEVEL_END_P1, selectedItemID, false);
                 }
                 break;
             }
@@ -850,6 +1067,276 @@ void plugin_base::onMenuItemEvent(uint64 nServerConnectionHandlerID, enum Plugin
 }
 
 
+/* ----------------------------------------------------------------------------
+* queue event of a TS3 callback for the work pool
+*
+* if the queue of the server is full (or in synchronous mode) the callback
+* processes all queued events and its own one, so no event is lost or reordered.
+*/
+void plugin_base::post_event(const plugin_event& cEvent)
+{
+    post_event(find_server(cEvent.nServerID), cEvent);
+}
+
+void plugin_base::post_event(server_list *pcServer, const plugin_event& cEvent)
+{
+    CALL_STACK
+    if (pcServer == nullptr)
+    {
+        if (DEBUG_LOG && (cEvent.eType != EVENT_CHANNEL)) printf("Server not found \"%s\"\n", __FUNCSIG__);
+        return;
+    }
+
+    if (!this->m_bSynchronous && pcServer->m_cEventQueue.push(cEvent))
+    {
+        schedule_server(pcServer);
+        return;
+    }
+
+    if (DEBUG_LOG && !this->m_bSynchronous) printf("PLUGIN: event queue full, processed in callback\n");
+    boost::lock_guard<boost::recursive_mutex> lock(pcServer->m_cWorkMutex);
+    process_events(pcServer, SIZE_MAX);
+    process_event(pcServer, cEvent);
+}
+
+/* ----------------------------------------------------------------------------
+* process queued events, m_cWorkMutex of the server has to be locked by the caller
+*
+* client updates in a row (mass move, server restart) are folded per client and
+* applied together before the next other event, the order to other events stays.
+*/
+size_t plugin_base::process_events(server_list *pcServer, size_t nMaxEvents)
+{
+    CALL_STACK
+    plugin_event cEvent;
+    size_t nEvents = 0;
+    while ((nEvents < nMaxEvents) && pcServer->m_cEventQueue.pop(cEvent))
+    {
+        nEvents++;
+        if (cEvent.eType == EVENT_UPDATE_CLIENT)
+        {
+            pcServer->m_cClientUpdate.add(cEvent.nClientID, cEvent.nChannelID);
+            continue;
+        }
+
+        apply_client_updates(pcServer);
+        process_event(pcServer, cEvent);
+    }
+    apply_client_updates(pcServer);
+    return nEvents;
+}
+
+/* ----------------------------------------------------------------------------
+* apply folded client updates: one pass over the client list, one UI refresh
+*/
+void plugin_base::apply_client_updates(server_list *pcServer)
+{
+    if (pcServer->m_cClientUpdate.empty())
+        return;
+
+    try
+    {
+        if (DEBUG_LOG) printf("PLUGIN: %zd client events folded to %zd updates\n", pcServer->m_cClientUpdate.get_num_events(), pcServer->m_cClientUpdate.get_updates().size());
+        pcServer->m_pHandler->onUpdateClientEvent(pcServer->m_cClientUpdate.get_updates());
+
+        // only mark as changed, refresh is done by GUI thread
+        if (this->m_pMainUi != nullptr) this->m_pMainUi->request_update_ui();
+    }
+    catch (std::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (boost::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (...)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__);
+    }
+    pcServer->m_cClientUpdate.clear();
+}
+
+/* ----------------------------------------------------------------------------
+* process one event, m_cWorkMutex of the server has to be locked by the caller
+*/
+void plugin_base::process_event(server_list *pcServer, const plugin_event& cEvent)
+{
+    CALL_STACK
+    try
+    {
+        plugin_handler *pcHandler = pcServer->m_pHandler.get();
+
+        switch (cEvent.eType)
+        {
+        case EVENT_UPDATE_CLIENT:
+            pcHandler->onUpdateClientEvent(cEvent.nClientID, cEvent.nChannelID);
+
+            // only mark as changed, refresh is done by GUI thread
+            if (this->m_pMainUi != nullptr) this->m_pMainUi->request_update_ui();
+            break;
+
+        case EVENT_CHANNEL:
+            pcHandler->onChannelEvent();
+            break;
+
+        case EVENT_TALK_STATUS:
+            pcHandler->onTalkStatusChangeEvent(cEvent.iValue, cEvent.bIsReceivedWhisper, cEvent.nClientID);
+
+            // talkers are shown in the frequency list, refreshes are merged by the GUI thread
+            if (this->m_pMainUi != nullptr) this->m_pMainUi->request_update_ui();
+            break;
+
+        case EVENT_HOTKEY:
+            {
+                hotkey_action cHotkey = this->m_cHotkeyTable.get(cEvent.iValue);
+                if (cHotkey.eAction != HOTKEY_UNKNOWN)
+                    pcHandler->onHotkeyEvent(cHotkey);
+            }
+            break;
+
+        case EVENT_ESTABLISHED:
+            //update meta data if server is fully connected
+            pcHandler->update_meta_data();
+            //check server depending parameter
+            pcHandler->check_param();
+            if (this->m_pMainUi != nullptr) this->m_pMainUi->request_update_ui();
+            break;
+
+        default:
+            break;
+        }
+    }
+    catch (std::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (boost::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (...)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__);
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* queue a task for the server, if there is none yet
+*/
+void plugin_base::schedule_server(server_list *pcServer)
+{
+    if (pcServer->m_bClosing || pcServer->m_bScheduled.exchange(true))
+        return;
+    this->m_cWorkPool.submit([this, pcServer]() { run_server(pcServer); });
+}
+
+/* ----------------------------------------------------------------------------
+* task of the work pool: one batch of events, then other servers get their turn
+*/
+void plugin_base::run_server(server_list *pcServer)
+{
+    CALL_STACK
+    boost::lock_guard<boost::recursive_mutex> lock(pcServer->m_cWorkMutex);
+    if (pcServer->m_bClosing)
+    {
+        // close_server waits for this (locked, so it wakes after the mutex is released)
+        pcServer->m_bScheduled = false;
+        pcServer->m_cIdleCond.notify_all();
+        return;
+    }
+    process_events(pcServer, EVENT_BATCH_SIZE);
+
+    // exchange pairs with schedule_server: either the producer saw the flag or we see its event
+    pcServer->m_bScheduled.exchange(false);
+    if (!pcServer->m_cEventQueue.empty())
+        schedule_server(pcServer);
+}
+
+/* ----------------------------------------------------------------------------
+* process all queued events of a server in the calling thread
+*/
+void plugin_base::flush_server(server_list *pcServer)
+{
+    CALL_STACK
+    boost::lock_guard<boost::recursive_mutex> lock(pcServer->m_cWorkMutex);
+    process_events(pcServer, SIZE_MAX);
+}
+
+/* ----------------------------------------------------------------------------
+* server was removed from the registry: drop its queued events and wait until
+* its task has finished, then the entry can be destroyed
+*/
+void plugin_base::close_server(server_list *pcServer)
+{
+    CALL_STACK
+    boost::unique_lock<boost::recursive_mutex> lock(pcServer->m_cWorkMutex);
+    pcServer->m_bClosing = true;
+
+    plugin_event cEvent;
+    while (pcServer->m_cEventQueue.pop(cEvent))
+        ;
+    pcServer->m_cClientUpdate.clear();
+
+    // a queued task only resets the flag, a running one holds the mutex until it is done
+    while (pcServer->m_bScheduled)
+        pcServer->m_cIdleCond.wait(lock);
+}
+
+/* ----------------------------------------------------------------------------
+* synchronous mode: every callback processes its event before it returns
+*/
+void plugin_base::set_synchronous(bool bSynchronous)
+{
+    CALL_STACK
+    if (bSynchronous)
+    {
+        this->m_cWorkPool.stop();
+        this->m_bSynchronous = true;
+        flush_events();
+    }
+    else
+    {
+        this->m_bSynchronous = false;
+        if (this->m_pMainUi != nullptr) this->m_cWorkPool.start();
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* process all queued events in the calling thread
+*/
+void plugin_base::flush_events()
+{
+    CALL_STACK
+    for (size_t ii = 0; ii < this->m_cServerRegistry.size(); ii++)
+        flush_server(this->m_cServerRegistry.at(ii));
+}
+
+/* ----------------------------------------------------------------------------
+* read config.xml again like the apply button of the settings UI, all servers
+* take over the changes
+*/
+void plugin_base::reload_config()
+{
+    CALL_STACK
+    flush_events();
+    config_container cNewConfig;
+    cNewConfig.s_read_param(this->m_sPluginPath + std::string("WhisperMaster2000/config.xml"));
+    this->m_cConfigData = cNewConfig;
+
+    std::vector<work_pool::task> vTask;
+    for (size_t ii = 0; ii < this->m_cServerRegistry.size(); ii++)
+    {
+        server_list *pcEntry = this->m_cServerRegistry.at(ii);
+        vTask.push_back([pcEntry]() {
+            boost::lock_guard<boost::recursive_mutex> lock(pcEntry->m_cWorkMutex);
+            pcEntry->m_pHandler->update_meta_data();
+        });
+    }
+    this->m_cWorkPool.run_all(vTask);
+}
+
+
 /* ----------------------------------------------------------------------------
 * Helper function to create a menu item
 */
@@ -7,7 +7,19 @@
 //#include "speech_engine.h"
 #include "misc/channel_filter.h"
 #include "misc/client_filter.h"
+#include "misc/hotkey_table.h"
+#include "misc/event_queue.h"
+#include "misc/work_pool.h"
+#include "misc/server_registry.h"
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <boost/thread.hpp>
+#ifdef WM2000_HEADLESS
+#include "bench/headless_ui.h"
+#else
 #include "ui\wm2000_main_ui_actions.h"
+#endif
 #include "teamspeak/public_errors.h"
 #include "teamspeak/public_errors_rare.h"
 #include "teamspeak/public_definitions.h"
@@ -19,11 +31,14 @@
 
 #define PATH_BUFSIZE 512
 #define COMMAND_BUFSIZE 128
-#define INFODATA_BUFSIZE 128
+#define INFODATA_BUFSIZE 512
 #define SERVERINFO_BUFSIZE 256
 #define CHANNELINFO_BUFSIZE 512
 #define RETURNCODE_BUFSIZE 128
 
+#define EVENT_QUEUE_SIZE 4096   // events per server waiting for the work pool (power of 2)
+#define EVENT_BATCH_SIZE 64     // events processed per task, then other servers get their turn
+
 
 /* Some makros to make the code to create menu items a bit more readable */
 #define BEGIN_CREATE_MENUS(x) const size_t sz = x + 1; size_t n = 0; *menuItems = (struct PluginMenuItem**)malloc(sizeof(struct PluginMenuItem*) * sz);
@@ -36,13 +51,50 @@
 #define END_CREATE_HOTKEYS (*hotkeys)[n++] = NULL; assert(n == sz);
 
 // some helper to use with language_pkg
-#define TRANSLATE(a) this->m_cTranslate.translate(a).c_str()
+#define TRANSLATE(a) this->m_cTranslate.translate(a)
+
+enum ePluginEvent
+{
+    EVENT_UPDATE_CLIENT = 1,    // client moved, connected, disconnected or changed
+    EVENT_CHANNEL,              // channel created, deleted, moved or edited
+    EVENT_TALK_STATUS,
+    EVENT_HOTKEY,
+    EVENT_ESTABLISHED           // connection established, read meta data and check server parameter
+};
+
+/* ----------------------------------------------------------------------------
+* compact copy of a TS3 callback, processed by the work pool
+*/
+struct plugin_event
+{
+    uint64          nServerID;
+    uint64          nChannelID;         // EVENT_UPDATE_CLIENT: actual channel
+    anyID           nClientID;          // EVENT_UPDATE_CLIENT, EVENT_TALK_STATUS
+    uint8_t         eType;              // ePluginEvent
+    uint8_t         bIsReceivedWhisper; // EVENT_TALK_STATUS
+    int32_t         iValue;             // EVENT_TALK_STATUS: status, EVENT_HOTKEY: index in hotkey_table
+};
 
+/* ----------------------------------------------------------------------------
+* one server tab (shard): the handler with its client_filter/channel_filter is
+* only used while m_cWorkMutex is locked, events of a server are processed in
+* order by one task at a time, different servers in parallel.
+* Owned by plugin_base::m_cServerRegistry from STATUS_CONNECTED until
+* STATUS_DISCONNECTED (UI links to the filters are removed before), then
+* destroyed after the queued task of the server has finished.
+*/
 struct server_list
 {
     anyID		    m_nMyClientID;
     uint64          m_nServerID;
-    plugin_handler *m_pHandler;
+    std::unique_ptr<plugin_handler> m_pHandler;
+
+    event_queue<plugin_event, EVENT_QUEUE_SIZE> m_cEventQueue;
+    boost::recursive_mutex  m_cWorkMutex;   // task of the work pool, callbacks with UI access, full queue
+    std::atomic<bool>       m_bScheduled;   // a task for this server is queued or running
+    std::atomic<bool>       m_bClosing;     // disconnected, no new task is queued
+    boost::condition_variable_any m_cIdleCond;  // signaled with m_cWorkMutex when m_bScheduled is reset while closing
+    client_update_batch     m_cClientUpdate;// EVENT_UPDATE_CLIENT of the actual batch, folded per client
 };
 
 class plugin_base
@@ -69,20 +121,39 @@ public:
     
     void initHotkeys(struct PluginHotkey*** hotkeys);
     void onHotkeyEvent(const char* keyword);
+    int  processCommand(uint64 serverConnectionHandlerID, const char* command);
     void onUpdateClientEvent(uint64 nServerConnectionHandlerID, anyID nClientID, uint64 nActChannel);
+    void onChannelEvent(uint64 nServerConnectionHandlerID);
     void onTalkStatusChangeEvent(uint64 nServerConnectionHandlerID, int iStatus, int iIsReceivedWhisper, anyID nClientID);
+    void onEditPlaybackVoiceDataEvent(uint64 nServerConnectionHandlerID, anyID nClientID, short* psSamples, int iSampleCount, int iChannels);
+    void onCustom3dRolloffCalculationClientEvent(uint64 nServerConnectionHandlerID, anyID nClientID, float fDistance, float* pfVolume);
     void infoData(uint64 serverConnectionHandlerID, uint64 id, enum PluginItemType type, char** data);
 
     void Close();
 
+    void set_synchronous(bool bSynchronous);    // process events in the callback, no work pool
+    void flush_events();                        // process all queued events in the calling thread
+    void reload_config();                       // read config.xml again (headless tools)
+
 private:
     void                    check_param();
+    void                    validate_ignore_list();
+
+    void                    post_event(const plugin_event& cEvent);
+    void                    post_event(server_list *pcServer, const plugin_event& cEvent);
+    void                    process_event(server_list *pcServer, const plugin_event& cEvent);
+    size_t                  process_events(server_list *pcServer, size_t nMaxEvents);
+    void                    apply_client_updates(server_list *pcServer);
+    void                    schedule_server(server_list *pcServer);
+    void                    run_server(server_list *pcServer);
+    void                    flush_server(server_list *pcServer);
+    void                    close_server(server_list *pcServer);
 
     struct PluginMenuItem*  createMenuItem(enum PluginMenuType type, int id, const char* text, const char* icon);
     struct PluginHotkey*    createHotkey(const char* keyword, const char* description);
 
-    int                     find_server_idx(uint64 nServerConnectionHandlerID);
-    plugin_handler*         find_server_handler(uint64 nServerConnectionHandlerID);
+    server_list*            find_server(uint64 nServerConnectionHandlerID) { return this->m_cServerRegistry.find(nServerConnectionHandlerID); };
+    std::shared_ptr<rx_filter> find_rx_filter(uint64 nServerConnectionHandlerID);
 
 /* ----------------------------------------------------------------------------
 * member variable
@@ -93,8 +164,9 @@ public:
 
 private:
     error_handler               m_cErrHandler;      // link to error handler
-    std::vector<server_list>    m_vServerList;      // Server list entry TODO
+    server_registry<server_list> m_cServerRegistry; // Server list entries by ID, changed by TS3 callbacks only
     config_container            m_cConfigData;      // configuration container
+    hotkey_table                m_cHotkeyTable;     // keyword => pre-resolved hotkey action
     struct TS3Functions         m_stTs3Functions;   // TS3 interface functions
     std::string                 m_sPluginPath;      // path to plugin folder
     char*                       m_pPluginID;        // used for plugin commands
@@ -103,4 +175,11 @@ private:
     bool                        m_bServerConnected; // save state of server connection
 
     wm2000_main_ui_actions     *m_pMainUi;          // pointer to main UI
+
+    work_pool                   m_cWorkPool;        // events of all servers and cross-server jobs (UI)
+    std::atomic<bool>           m_bSynchronous;     // no work pool, events are processed in the callback
+
+    typedef std::unordered_map<uint64, std::shared_ptr<rx_filter>> rx_filter_map;   // server ID => receive filter of the handler
+    boost::mutex                m_cRxFilterMutex;   // serializes connect and disconnect, the audio thread does not lock
+    std::shared_ptr<const rx_filter_map> m_pcRxFilter;  // snapshot, replaced by a changed copy (std::atomic_store)
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "plugin_handler.h"
+#ifdef _WIN32
 #include <Shlwapi.h>
+#endif
 #include "teamspeak/public_errors.h"
 #include "teamspeak/public_errors_rare.h"
 #include "teamspeak/public_definitions.h"
@@ -21,7 +23,13 @@ plugin_handler::plugin_handler()
     this->m_pcTranslate     = nullptr;
 
     this->m_nActualActiveProfile = 0;
-    this->m_bPttState            = false;
+    this->m_bActiveAutoActivate  = false;
+
+    this->m_nInfoGeneration      = 0;
+    this->m_nInfoCacheGeneration = 0;
+    this->m_nInfoCacheConfigGen  = 0;
+    this->m_nChannelGeneration   = 0;
+    this->m_pcRxFilter           = std::make_shared<rx_filter>();
 }
 
 /* ----------------------------------------------------------------------------
@@ -39,7 +47,13 @@ plugin_handler::plugin_handler(uint64 nServerID, anyID nMyClientID, TS3Functions
     this->m_pcTranslate     = pcTranslate;
 
     this->m_nActualActiveProfile = 0;
-    this->m_bPttState            = false;
+    this->m_bActiveAutoActivate  = false;
+
+    this->m_nInfoGeneration      = 0;
+    this->m_nInfoCacheGeneration = 0;
+    this->m_nInfoCacheConfigGen  = this->m_pcConfigData->s_get_Generation();
+    this->m_nChannelGeneration   = 0;
+    this->m_pcRxFilter           = std::make_shared<rx_filter>();
 
     // set interface to channel filter
     this->m_cChannelFilter.init(this->m_pstTs3Functions, this->m_pcConfigData, this->m_nServerID, this->m_nMyClientID);
@@ -47,12 +61,23 @@ plugin_handler::plugin_handler(uint64 nServerID, anyID nMyClientID, TS3Functions
     // set interface to client filter
     this->m_cClientFilter.init(this->m_pstTs3Functions, this->m_pcConfigData, &this->m_cChannelFilter, this->m_nServerID, INVALID_CHANNEL_ID, this->m_nMyClientID);
 
-    // set own 3D audio settings
-    const TS3_VECTOR position   = { 0.0, 0.0, 0.0 };    //I'm at the center, ...
-    const TS3_VECTOR forward    = { 1.0, 0.0, 0.0 };    // ...I look in X direction...
-    const TS3_VECTOR up         = { 0.0, 0.0, 1.0 };    // ...and Z is upwards
-    if( this->m_pstTs3Functions->systemset3DListenerAttributes(this->m_nServerID, &position, &forward, &up) != ERROR_ok )
-        if (DEBUG_LOG) printf("PLUGIN: error while init 3D audio\n");
+    // set interface to whisper list/PTT handling
+    this->m_cWhisper.init(this->m_pstTs3Functions, this->m_pcTranslate, this->m_nServerID, this->m_nMyClientID);
+
+    // set interface to profile membership
+    this->m_cMembership.init(&this->m_cChannelFilter, this->m_pcConfigData);
+
+    // set interface to level profile targets
+    this->m_cLevelTargets.init(&this->m_cChannelFilter, this->m_pcConfigData);
+
+    // set interface to receive filter
+    this->m_pcRxFilter->init(&this->m_cClientFilter, &this->m_cChannelFilter, this->m_pcConfigData);
+
+    // set own 3D audio settings and interface to the layout of received frequencies
+    this->m_cSpatial.init(this->m_pstTs3Functions, &this->m_cClientFilter, this->m_pcConfigData, this->m_nServerID);
+
+    // set interface to talk statistics
+    this->m_cTalkTracker.init(&this->m_cClientFilter, this->m_pcConfigData);
 
     if (DEBUG_LOG) printf("PLUGIN: plugin_handler was created (nServerID %llu, nMyClientID %d)\n", nServerID, nMyClientID);
 }
@@ -63,15 +88,23 @@ plugin_handler::plugin_handler(uint64 nServerID, anyID nMyClientID, TS3Functions
 */
 plugin_handler::~plugin_handler()
 {
+    // the audio thread may still hold the receive filter, it must not use the filters of this handler anymore
+    this->m_pcRxFilter->init(nullptr, nullptr, nullptr);
+
     if (this->m_pstTs3Functions == nullptr)
         return;
 
+    // placed clients would keep their position after the plugin is unloaded
+    this->m_cSpatial.reset();
+
     // if actual profile is selected profile, deselect whisperlist and deactivate PTT (on demand)
     if (this->m_nActualActiveProfile != 0)
     {
         if (DEBUG_LOG) printf("PLUGIN: deactivate profile %d on disconnect\n", this->m_nActualActiveProfile);
-        reset_WhisperlList();
-        if (this->m_pcConfigData->s_get_AutoActivate(this->m_nActualActiveProfile - 1)) activate_PTT(INPUT_DEACTIVATED);
+        this->m_cWhisper.begin();
+        this->m_cWhisper.reset_whisper_list();
+        if (this->m_bActiveAutoActivate) this->m_cWhisper.set_ptt(false);
+        this->m_cWhisper.commit();
         this->m_nActualActiveProfile = 0;
         return;
     }
@@ -111,9 +144,7 @@ void plugin_handler::check_param()
             this->m_pstTs3Functions->freeMemory(s);
         }
 
-        // check if channel of ignore list exists
-        if (this->m_pcConfigData->s_get_SaveIgnoreList())
-            this->m_cChannelFilter.validate_channel_list(this->m_pcConfigData->s_get_IgnoreList());
+        // channels of the ignore list are checked for all servers in plugin_base::validate_ignore_list
 
         //check profile specific parameter
         for (int ii = 0; ii < this->m_pcConfigData->s_get_MaxNumProfiles(); ii++)
@@ -164,95 +195,101 @@ void plugin_handler::check_param()
 }
 
 
-/*----------------------------------------------------------------------------
-* reset whisperlist
+/* ----------------------------------------------------------------------------
+* client connected, moved, changed or disconnected
 */
-void plugin_handler::reset_WhisperlList()
+void plugin_handler::onUpdateClientEvent(anyID nClientID, uint64 nActChannel)
 {
-    if (this->m_pstTs3Functions->requestClientSetWhisperList(this->m_nServerID, this->m_nMyClientID, NULL, NULL, NULL) != ERROR_ok)
-        this->m_pstTs3Functions->logMessage(TRANSLATE_PTR("hotkey_ErrReset"), LogLevel_ERROR, "WhisperMaster2000", this->m_nServerID);
+    uint64 nLastChannelID = this->m_cClientFilter.get_my_channel_id();
+    this->m_cClientFilter.update_client_list(nClientID, nActChannel);
+    this->m_nInfoGeneration++;
+    check_own_move(nLastChannelID);
+
+    client_update_batch cBatch;
+    cBatch.add(nClientID, nActChannel);
+    this->m_pcRxFilter->update(&cBatch.get_updates(), this->m_nChannelGeneration);
+    this->m_cSpatial.update(&cBatch.get_updates());
+    this->m_cTalkTracker.update(&cBatch.get_updates());
 }
 
+void plugin_handler::onUpdateClientEvent(const std::vector<client_update>& vUpdate)
+{
+    uint64 nLastChannelID = this->m_cClientFilter.get_my_channel_id();
+    this->m_cClientFilter.update_client_list(vUpdate);
+    this->m_nInfoGeneration++;
+    check_own_move(nLastChannelID);
+    this->m_pcRxFilter->update(&vUpdate, this->m_nChannelGeneration);
+    this->m_cSpatial.update(&vUpdate);
+    this->m_cTalkTracker.update(&vUpdate);
+}
 
-/*----------------------------------------------------------------------------
-* (de-)activate PTT on demand, but only if it is not already active
+/* ----------------------------------------------------------------------------
+* channel was created, deleted, moved or edited
 */
-void plugin_handler::activate_PTT(int iState)
+void plugin_handler::onChannelEvent()
 {
-    uint32_t nError = ERROR_ok;
-    const size_t nBuffSize = 512;
-    char    cBuffer[nBuffSize];
-
-    bool bNewPttState = (iState == INPUT_ACTIVE);
+    this->m_nInfoGeneration++;
+    this->m_nChannelGeneration++;
+    this->m_pcRxFilter->update(nullptr, this->m_nChannelGeneration);
+}
 
-    if (this->m_bPttState != bNewPttState)
-    {
-        if (nError = this->m_pstTs3Functions->setClientSelfVariableAsInt(this->m_nServerID, CLIENT_INPUT_DEACTIVATED, iState) != ERROR_ok)
-        {
-            sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("hotkey_ErrActivate1"), nError);
-            this->m_pstTs3Functions->logMessage(cBuffer, LogLevel_ERROR, "WhisperMaster2000", this->m_nServerID);
-        }
-        else
-        {
-            this->m_bPttState = bNewPttState;
-            nError = this->m_pstTs3Functions->flushClientSelfUpdates(this->m_nServerID, NULL);
-            if ((nError != ERROR_ok) && (nError != ERROR_undefined) && (nError != ERROR_ok_no_update))
-            {
-                sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("hotkey_ErrActivate2"), nError);
-                this->m_pstTs3Functions->logMessage(cBuffer, LogLevel_WARNING, "WhisperMaster2000", this->m_nServerID);
-                if (iState == INPUT_ACTIVE) activate_PTT(INPUT_DEACTIVATED);
-            }
+/* ----------------------------------------------------------------------------
+* level profiles are relative to my channel, after a move their targets are
+* built here (event processing) instead of at the next hotkey
+*/
+void plugin_handler::check_own_move(uint64 nLastChannelID)
+{
+    uint64 nMyChannelID = this->m_cClientFilter.get_my_channel_id();
+    if ((nMyChannelID == nLastChannelID) || (nMyChannelID == INVALID_CHANNEL_ID) || (nMyChannelID == 0))
+        return;
 
-        }
-    }
+    if (DEBUG_LOG) printf("own channel changed (%llu => %llu), rebuild level targets\n", (long long unsigned int)nLastChannelID, (long long unsigned int)nMyChannelID);
+    this->m_cLevelTargets.rebuild(nMyChannelID, this->m_nChannelGeneration);
 }
 
+
 /* ----------------------------------------------------------------------------
 * handle Hotkey events
+*   all whisper list and PTT changes of one event are sent together
 */
-void plugin_handler::onHotkeyEvent(const char* keyword)
+void plugin_handler::onHotkeyEvent(const hotkey_action& cHotkey)
+{
+    this->m_cWhisper.begin();
+    handle_hotkey(cHotkey);
+    this->m_cWhisper.commit();
+}
+
+void plugin_handler::handle_hotkey(const hotkey_action& cHotkey)
 {
     int nError;
+    const size_t nBuffSize = 512;
+    char cBuffer[nBuffSize];
 
-    if (DEBUG_LOG) printf("Hotkey %s incomming\n", keyword);
+    if (DEBUG_LOG) printf("Hotkey %d (action %d) incomming\n", cHotkey.iProfile, cHotkey.eAction);
 
-    if (strcmp(keyword, "reset") == 0)
+    if (cHotkey.eAction == HOTKEY_RESET)
     {
         // on reset event, just restore whisperlist to default and deactivate PTT on demand
         //-------------------------------------------------------------------------------------
         if (DEBUG_LOG) printf("Hotkey reset erkannt\n");
 
-        reset_WhisperlList();
-        if (this->m_pcConfigData->s_get_AutoActivate(this->m_nActualActiveProfile - 1)) activate_PTT(INPUT_DEACTIVATED);
-        this->m_pcConfigData->s_set_ActualState(this->m_nActualActiveProfile, false);
+        this->m_cWhisper.reset_whisper_list();
+        if (this->m_nActualActiveProfile != 0)
+        {
+            if (this->m_bActiveAutoActivate) this->m_cWhisper.set_ptt(false);
+            this->m_pcConfigData->s_set_ActualState(this->m_nActualActiveProfile - 1, false);
+        }
         this->m_nActualActiveProfile = 0;
     }
-    else
+    else if (cHotkey.eAction == HOTKEY_OUT_OF_RANGE)
     {
-        int     nConverted;
-        int     iHotkeyIndex;
-        const size_t nBuffSize = 512;
-        char    cBuffer[nBuffSize];
-
-        //filter profile index and check keyword
-        nConverted = sscanf_s(keyword, "%[a-zA-Z]_%d", cBuffer, (unsigned int)nBuffSize, &iHotkeyIndex);
-        if (nConverted != 2)
-        {
-            if (DEBUG_LOG) printf("Hotkey falscher count %d erkannt\n", nConverted);
-            return;
-        }
-        if (strcmp(cBuffer, "profile") != 0)
-        {
-            if (DEBUG_LOG) printf("Hotkey falscher string %s erkannt\n", cBuffer);
-            return;
-        }
-        if (iHotkeyIndex > this->m_pcConfigData->s_get_MaxNumProfiles())
-        {
-            sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("hotkey_MaxNum"), iHotkeyIndex, this->m_pcConfigData->s_get_MaxNumProfiles());
-            this->m_pstTs3Functions->logMessage(cBuffer, LogLevel_WARNING, "WhisperMaster2000", this->m_nServerID);
-            return;
-        }
-        printf("Hotkey %d erkannt\n", iHotkeyIndex);
+        sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("hotkey_MaxNum"), cHotkey.iProfile, this->m_pcConfigData->s_get_MaxNumProfiles());
+        this->m_pstTs3Functions->logMessage(cBuffer, LogLevel_WARNING, "WhisperMaster2000", this->m_nServerID);
+    }
+    else if (cHotkey.eAction == HOTKEY_PROFILE)
+    {
+        int iHotkeyIndex = cHotkey.iProfile;
+        if (DEBUG_LOG) printf("Hotkey %d erkannt\n", iHotkeyIndex);
 
 
         if (this->m_nActualActiveProfile == iHotkeyIndex)
@@ -260,8 +297,8 @@ void plugin_handler::onHotkeyEvent(const char* keyword)
             // if actual profile is selected profile, deselect whisperlist and deactivate PTT (on demand)
             //-------------------------------------------------------------------------------------
             if (DEBUG_LOG) printf("deactivate profile %d\n", iHotkeyIndex);
-            reset_WhisperlList();
-            if (this->m_pcConfigData->s_get_AutoActivate(iHotkeyIndex - 1)) activate_PTT(INPUT_DEACTIVATED);
+            this->m_cWhisper.reset_whisper_list();
+            if (this->m_bActiveAutoActivate) this->m_cWhisper.set_ptt(false);
             this->m_nActualActiveProfile = 0;
             this->m_pcConfigData->s_set_ActualState(iHotkeyIndex - 1, false);
             return;
@@ -269,7 +306,7 @@ void plugin_handler::onHotkeyEvent(const char* keyword)
         else if (this->m_nActualActiveProfile != 0)
         {
             // key was pressed (but not released) until another hotkey was pressed...
-            if (this->m_pcConfigData->s_get_ActualState(iHotkeyIndex - 1) && this->m_pcConfigData->s_get_AutoActivate(iHotkeyIndex - 1))
+            if (cHotkey.bAutoActivate && this->m_pcConfigData->s_get_ActualState(iHotkeyIndex - 1))
             {
                 //... if AutoActive, just restore first key, but hold actual setting (key release event).
                 this->m_pcConfigData->s_set_ActualState(iHotkeyIndex - 1, false);
@@ -277,9 +314,9 @@ void plugin_handler::onHotkeyEvent(const char* keyword)
             }
 
             //... non AutoActive, prepare for new setup.
-            reset_WhisperlList();
-            if (this->m_pcConfigData->s_get_AutoActivate(this->m_nActualActiveProfile - 1))
-                activate_PTT(INPUT_DEACTIVATED);
+            this->m_cWhisper.reset_whisper_list();
+            if (this->m_bActiveAutoActivate)
+                this->m_cWhisper.set_ptt(false);
         }
 
         // get default parameter
@@ -288,22 +325,24 @@ void plugin_handler::onHotkeyEvent(const char* keyword)
 
         anyID  *pnFilteredClientList = nullptr;
         uint64 *pnFilteredChannelList = nullptr;
-        if ((this->m_pcConfigData->s_get_ProfileType(iHotkeyIndex - 1) == PROFILE_OFF) || (this->m_pcConfigData->s_get_ProfileType(iHotkeyIndex - 1) == PROFILE_AUDIO))
+        const uint64 *pnChannelList = nullptr;     // list to activate, owned by pnFilteredChannelList or the level targets
+        if ((cHotkey.eType == PROFILE_OFF) || (cHotkey.eType == PROFILE_AUDIO))
         {
             // these types don't need any action
             //-------------------------------------------------------------------------------------
-            sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("hotkey_Off"), iHotkeyIndex, this->m_pcConfigData->profile_string_from_enum(this->m_pcConfigData->s_get_ProfileType(iHotkeyIndex - 1)).c_str());
+            sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("hotkey_Off"), iHotkeyIndex, this->m_pcConfigData->profile_string_from_enum(cHotkey.eType).c_str());
             this->m_pstTs3Functions->logMessage(cBuffer, LogLevel_WARNING, "WhisperMaster2000", this->m_nServerID);
             return;
         }
-        else if (this->m_pcConfigData->s_get_ProfileType(iHotkeyIndex - 1) == PROFILE_FAVORITE)
+        else if (cHotkey.eType == PROFILE_FAVORITE)
         {
             // if profile is in favorite mode, activate all channels in list
             //-------------------------------------------------------------------------------------
             if (DEBUG_LOG) printf("Hotkey %d => favorite erkannt\n", iHotkeyIndex);
 
             // filter channel list
-            pnFilteredChannelList = this->m_cChannelFilter.filter_channel_from_list(this->m_pcConfigData->s_get_FavoriteList(iHotkeyIndex - 1), this->m_pcConfigData->s_get_UseSubChOfFav(iHotkeyIndex - 1), this->m_pcConfigData->s_get_UseIgnoreListTx(iHotkeyIndex - 1));
+            pnFilteredChannelList = this->m_cChannelFilter.filter_channel_from_list(this->m_pcConfigData->s_get_FavoriteList(iHotkeyIndex - 1), cHotkey.bUseSubChOfFav, cHotkey.bUseIgnoreListTx);
+            pnChannelList = pnFilteredChannelList;
 
             if (pnFilteredChannelList == nullptr)
             {
@@ -311,67 +350,64 @@ void plugin_handler::onHotkeyEvent(const char* keyword)
                 this->m_pstTs3Functions->logMessage(cBuffer, LogLevel_WARNING, "WhisperMaster2000", this->m_nServerID);
             }
         }
-        else if (this->m_pcConfigData->s_get_ProfileType(iHotkeyIndex - 1) == PROFILE_LEVEL)
+        else if (cHotkey.eType == PROFILE_LEVEL)
         {
             // if profile is in level mode, activate all channels in the selected channel range
             //-------------------------------------------------------------------------------------
             if (DEBUG_LOG) printf("Hotkey %d => level erkannt\n", iHotkeyIndex);
 
-            // filter channel list
-            pnFilteredChannelList = this->m_cChannelFilter.filter_channel_from_level(this->m_pcConfigData->s_get_MinChLevel(iHotkeyIndex - 1), this->m_pcConfigData->s_get_MaxChLevel(iHotkeyIndex - 1), this->m_pcConfigData->s_get_UseIgnoreListTx(iHotkeyIndex - 1));
+            // channel list, usually built in the background after my last move
+            pnChannelList = this->m_cLevelTargets.get(iHotkeyIndex - 1, nChannelID, cHotkey.nMinChLevel, cHotkey.nMaxChLevel, cHotkey.bUseIgnoreListTx, this->m_nChannelGeneration);
 
-            if (pnFilteredChannelList == nullptr)
+            if (pnChannelList == nullptr)
             {
-                sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("hotkey_LevelOutRange"), this->m_pcConfigData->s_get_MinChLevel(iHotkeyIndex - 1), this->m_pcConfigData->s_get_MaxChLevel(iHotkeyIndex - 1), this->m_pcConfigData->s_get_ProfileName(iHotkeyIndex - 1).c_str(), this->m_cChannelFilter.get_channel_level(nChannelID));
+                sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("hotkey_LevelOutRange"), cHotkey.nMinChLevel, cHotkey.nMaxChLevel, this->m_pcConfigData->s_get_ProfileName(iHotkeyIndex - 1).c_str(), this->m_cChannelFilter.get_channel_level(nChannelID));
                 this->m_pstTs3Functions->logMessage(cBuffer, LogLevel_WARNING, "WhisperMaster2000", this->m_nServerID);
             }
         }
-        else if (this->m_pcConfigData->s_get_ProfileType(iHotkeyIndex - 1) == PROFILE_FREQUENCY)
+        else if (cHotkey.eType == PROFILE_FREQUENCY)
         {
             // if profile is in frequency mode, activate clients instead of channels
             //-------------------------------------------------------------------------------------
             if (DEBUG_LOG) printf("Hotkey %d => frequency erkannt\n", iHotkeyIndex);
 
-            pnFilteredClientList = this->m_cClientFilter.get_client_list(this->m_pcConfigData->s_get_ActiveFreq(iHotkeyIndex - 1), this->m_pcConfigData->s_get_UseIgnoreListTx(iHotkeyIndex - 1), !this->m_pcConfigData->s_get_PrioFreq(iHotkeyIndex - 1));
+            pnFilteredClientList = this->m_cClientFilter.get_client_list(cHotkey.iActiveFreq, cHotkey.bUseIgnoreListTx, !cHotkey.bPrioFreq);
 
             if (pnFilteredClientList == nullptr)
             {
-                sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("hotkey_NoActiveClients"), this->m_pcConfigData->s_get_ActiveFreq(iHotkeyIndex - 1), this->m_pcConfigData->s_get_ProfileName(iHotkeyIndex - 1).c_str());
+                sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("hotkey_NoActiveClients"), cHotkey.iActiveFreq, this->m_pcConfigData->s_get_ProfileName(iHotkeyIndex - 1).c_str());
                 this->m_pstTs3Functions->logMessage(cBuffer, LogLevel_WARNING, "WhisperMaster2000", this->m_nServerID);
             }
         }
 
         //mark active profile
         this->m_nActualActiveProfile = iHotkeyIndex;
+        this->m_bActiveAutoActivate  = cHotkey.bAutoActivate;
         this->m_pcConfigData->s_set_ActualState(iHotkeyIndex - 1, true);
 
         //activate whisperlist
-        if ((pnFilteredChannelList != nullptr) || (pnFilteredClientList != nullptr))
+        if ((pnChannelList != nullptr) || (pnFilteredClientList != nullptr))
         {
             // set filter list
-            if (nError = this->m_pstTs3Functions->requestClientSetWhisperList(this->m_nServerID, this->m_nMyClientID, pnFilteredChannelList, pnFilteredClientList, NULL) != ERROR_ok)
-            {
-                sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("error_ErrCreateWhisper"), "plugin_base::onHotkeyEvent", nError);
-                this->m_pstTs3Functions->logMessage(cBuffer, LogLevel_ERROR, "WhisperMaster2000", this->m_nServerID);
-            }
+            this->m_cWhisper.set_whisper_list(pnChannelList, pnFilteredClientList);
 
             // Activate PTT on demand. Or deactivate it, if it was active before.
-            if (this->m_pcConfigData->s_get_AutoActivate(iHotkeyIndex - 1)) activate_PTT(INPUT_ACTIVE);
+            if (cHotkey.bAutoActivate) this->m_cWhisper.set_ptt(true);
 
             // print all filtered channel names (DEBUG)
-            if (DEBUG_LOG && (pnFilteredChannelList != nullptr))
+            if (DEBUG_LOG && (pnChannelList != nullptr))
             {
                 char* s;
                 printf("PLUGIN: filtered channels:\n");
-                for (int i = 0; pnFilteredChannelList[i]; i++)
+                for (int i = 0; pnChannelList[i]; i++)
                 {
                     // Query channel name
-                    if (nError = this->m_pstTs3Functions->getChannelVariableAsString(this->m_nServerID, pnFilteredChannelList[i], CHANNEL_NAME, &s) != ERROR_ok)
+                    if (nError = this->m_pstTs3Functions->getChannelVariableAsString(this->m_nServerID, pnChannelList[i], CHANNEL_NAME, &s) != ERROR_ok)
                     {
                         sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("error_ErrQueryChName"), "plugin_base::onHotkeyEvent", nError);
                         this->m_pstTs3Functions->logMessage(cBuffer, LogLevel_ERROR, "WhisperMaster2000", this->m_nServerID);
                     }
-                    printf("PLUGIN: Channel ID = %llu, name = %s\n", (long long unsigned int)pnFilteredChannelList[i], s);
+                    printf("PLUGIN: Channel ID = %llu, name = %s\n", (long long unsigned int)pnChannelList[i], s);
                     this->m_pstTs3Functions->freeMemory(s);
                 }
             }
@@ -400,7 +436,7 @@ void plugin_handler::onHotkeyEvent(const char* keyword)
 //        else
 //        {
 //            //communicate to user if no one is active
-//            if (this->m_pcConfigData->s_get_ProfileType(iHotkeyIndex - 1) == PROFILE_FREQUENCY)
+//            if (cHotkey.eType == PROFILE_FREQUENCY)
 //                this->m_cSpeechEngine.say("NoClientFreq");
 //            else
 //                this->m_cSpeechEngine.say("NoClientPofile");
@@ -413,14 +449,105 @@ void plugin_handler::onHotkeyEvent(const char* keyword)
 
 /* ----------------------------------------------------------------------------
 * handle request for info data to display in the right subwindow
+*   texts are cached until a client, channel or config change happens
 */
 void plugin_handler::infoData(uint64 id, PluginItemType type, char ** data)
+{
+    if ((type != PLUGIN_SERVER) && (type != PLUGIN_CHANNEL) && (type != PLUGIN_CLIENT))
+    {
+        printf("Invalid item type: %d\n", type);
+        data = NULL;  /* Ignore */
+        return;
+    }
+
+    boost::lock_guard<boost::mutex> lock(this->m_cInfoCacheMutex);
+
+    // drop all texts, if anything changed since the cache was filled
+    uint32_t nInfoGeneration   = this->m_nInfoGeneration;
+    uint32_t nConfigGeneration = this->m_pcConfigData->s_get_Generation();
+    if ((nInfoGeneration != this->m_nInfoCacheGeneration) || (nConfigGeneration != this->m_nInfoCacheConfigGen))
+    {
+        for (int ii = 0; ii <= PLUGIN_CLIENT; ii++)
+            this->m_amInfoCache[ii].clear();
+        this->m_nInfoCacheGeneration = nInfoGeneration;
+        this->m_nInfoCacheConfigGen  = nConfigGeneration;
+    }
+
+    std::unordered_map<uint64, std::string>::iterator it = this->m_amInfoCache[type].find(id);
+    if (it == this->m_amInfoCache[type].end())
+        it = this->m_amInfoCache[type].emplace(id, create_info_text(id, type)).first;
+
+    // talk activity changes without any event, it is not cached
+    std::string sActivity = create_activity_text(id, type);
+
+    // allocate memory for the buffer
+    *data = (char*)malloc(INFODATA_BUFSIZE * sizeof(char));
+    // copy string to buffer
+    sprintf_s(*data, INFODATA_BUFSIZE, "%s%s%s", it->second.c_str(), sActivity.empty() ? "" : "\n", sActivity.c_str());  // bbCode is supported. HTML is not supported
+    return;
+}
+
+
+/* ----------------------------------------------------------------------------
+* live part of the info text: talk state of a client, activity of my
+* frequency profiles for the server
+*/
+std::string plugin_handler::create_activity_text(uint64 id, PluginItemType type)
+{
+    const size_t nBuffSize = 128;
+    char cBuffer[nBuffSize];
+    std::string sText = "";
+
+    switch (type) {
+    case PLUGIN_CLIENT:
+    {
+        uint64_t nDuration_ms = 0;
+        uint8_t nState = this->m_cTalkTracker.get_client((anyID)id, nDuration_ms);
+        if (nState & TRACKER_TALKING)
+        {
+            sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR((nState & TRACKER_WHISPER) ? "info_ActWhisper" : "info_ActTalk"), (unsigned)(nDuration_ms / 1000));
+            sText.append(cBuffer);
+        }
+        break;
+    }
+    case PLUGIN_SERVER:
+    {
+        for (int ii = 0; ii < this->m_pcConfigData->s_get_MaxNumProfiles(); ii++)
+        {
+            talk_activity cActivity;
+            if (!this->m_cTalkTracker.get_activity(ii, cActivity) || (cActivity.iIdle_ms < 0))
+                continue;
+
+            unsigned nSeconds = (unsigned)(cActivity.nTalkTime_ms / 1000);
+            sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("info_ActFreq"), cActivity.iFreq, cActivity.nTalkers, cActivity.nWhispers,
+                nSeconds / 60, nSeconds % 60, (unsigned)(cActivity.iIdle_ms / 1000));
+
+            // profiles that do not fit are left out
+            if (sText.size() + strlen(cBuffer) + 1 > INFODATA_ACTIVITY_LEN)
+                break;
+            if (sText.size() != 0) sText.append("\n");
+            sText.append(cBuffer);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+    return sText;
+}
+
+
+/* ----------------------------------------------------------------------------
+* create info text of server, channel or client
+*/
+std::string plugin_handler::create_info_text(uint64 id, PluginItemType type)
 {
     int nIndex = 0;
-    bool bUseSubChOfFav = false;
     std::string sText = "";
     uint64 nChannelID = id;
-    uint64 *pnFilteredList;
+
+    // membership of all profiles is evaluated once after each channel or config change
+    this->m_cMembership.update(this->m_nChannelGeneration, this->m_cClientFilter.get_my_channel_id(), this->m_pcConfigData->s_get_Generation());
 
     /* For demonstration purpose, display the name of the currently selected server, channel or client. */
     switch (type) {
@@ -468,90 +595,66 @@ void plugin_handler::infoData(uint64 id, PluginItemType type, char ** data)
         }
     }
     case PLUGIN_CHANNEL:
+    {
+        channel_membership cChannel = this->m_cMembership.get_channel(nChannelID);
+        profile_mask nIgnoreTx = this->m_cMembership.get_ignore_tx_profiles();
+        profile_mask nLevel    = this->m_cMembership.get_type_profiles(PROFILE_LEVEL);
+
+        // frequency profiles the client is part of
+        profile_mask nFreq = 0;
+        bool bClientIgnored = false;
+        if ((type == PLUGIN_CLIENT) && (nIndex >= 0))
+        {
+            for (int jj = 0; ((jj < NUM_FREQUENCIES) && (this->m_cClientFilter.m_cClientList[nIndex].acFreqList[jj].nBit.nFreq > 0)); jj++)
+                nFreq |= this->m_cMembership.get_freq_profiles(this->m_cClientFilter.m_cClientList[nIndex].acFreqList[jj].nBit.nFreq);
+            bClientIgnored = this->m_cMembership.get_channel(this->m_cClientFilter.m_cClientList[nIndex].nActualChannelID).bIgnored;
+        }
+
         for (int ii = 0; ii < this->m_pcConfigData->s_get_MaxNumProfiles(); ii++)
         {
-            // generate channel list based on same filter like hotkey
-            if ((this->m_pcConfigData->s_get_ProfileType(ii) == PROFILE_FAVORITE) || (this->m_pcConfigData->s_get_ProfileType(ii) == PROFILE_AUDIO))
-            {
-                pnFilteredList = this->m_cChannelFilter.filter_channel_from_list(this->m_pcConfigData->s_get_FavoriteList(ii), this->m_pcConfigData->s_get_UseSubChOfFav(ii), false);
-                if (this->m_pcConfigData->s_get_UseSubChOfFav(ii)) bUseSubChOfFav = true;
-            }
-            else if (this->m_pcConfigData->s_get_ProfileType(ii) == PROFILE_LEVEL)
-            {
-                pnFilteredList = this->m_cChannelFilter.filter_channel_from_level(this->m_pcConfigData->s_get_MinChLevel(ii), this->m_pcConfigData->s_get_MaxChLevel(ii), false);
-            }
-            else if ((this->m_pcConfigData->s_get_ProfileType(ii) == PROFILE_FREQUENCY) && (type == PLUGIN_CLIENT) && (nIndex >= 0))
+            if (nFreq & PROFILE_BIT(ii))
             {
                 //print profile info if frequency of profile can be found in client FreqList
-                bool bFreqFound = false;
                 bool bMuted = false;
-                bool bIgnored = false;
                 for (int jj = 0; ((jj < NUM_FREQUENCIES) && (this->m_cClientFilter.m_cClientList[nIndex].acFreqList[jj].nBit.nFreq > 0)); jj++)
                 {
                     if (this->m_cClientFilter.m_cClientList[nIndex].acFreqList[jj].nBit.nFreq == this->m_pcConfigData->s_get_ActiveFreq(ii))
                     {
-                        bFreqFound = true;
                         bMuted = this->m_cClientFilter.m_cClientList[nIndex].acFreqList[jj].nBit.nMute;
                         break;
                     }
                 }
-                if ((this->m_cChannelFilter.find_channel_in_list(this->m_pcConfigData->s_get_IgnoreList(), this->m_cClientFilter.m_cClientList[nIndex].nActualChannelID) >= 0) && this->m_pcConfigData->s_get_UseIgnoreListTx(ii))
-                    bIgnored = true;
 
-                if (bFreqFound)
-                {
-                    if (sText.size() != 0) sText.append("\n");
-                    sText.append("[I]\"");
-                    sText.append(this->m_pcConfigData->s_get_ProfileName(ii));
-                    sText.append("\"[/I] (Freq. ");
-                    sText.append(std::to_string(this->m_pcConfigData->s_get_ActiveFreq(ii)));
-                    if (bMuted) sText.append(" [muted]");
-                    if (bIgnored) sText.append(" [ignored]");
-                    sText.append(")");
-                }
-                continue;
+                if (sText.size() != 0) sText.append("\n");
+                sText.append("[I]\"");
+                sText.append(this->m_pcConfigData->s_get_ProfileName(ii));
+                sText.append("\"[/I] (Freq. ");
+                sText.append(std::to_string(this->m_pcConfigData->s_get_ActiveFreq(ii)));
+                if (bMuted) sText.append(" [muted]");
+                if (bClientIgnored && (nIgnoreTx & PROFILE_BIT(ii))) sText.append(" [ignored]");
+                sText.append(")");
             }
-            else
-                pnFilteredList = nullptr;
-
-
-            //check if selected filter is part of channel list
-            if (pnFilteredList != nullptr)
+            else if (cChannel.nProfiles & PROFILE_BIT(ii))
             {
-                for (int jj = 0; pnFilteredList[jj] != 0; jj++)
-                {
-                    if (pnFilteredList[jj] == nChannelID)
-                    {
-                        bool bIgnored = false;
-                        if (sText.size() != 0) sText.append("\n");
-                        sText.append("[I]\"");
-                        sText.append(this->m_pcConfigData->s_get_ProfileName(ii));
-                        sText.append("\"[/I]");
-
-                        //if subchannel are used, try to find it in the master list
-                        if (bUseSubChOfFav)
-                            if (this->m_pcConfigData->s_find_entry(this->m_pcConfigData->s_get_FavoriteList(ii), this->m_cChannelFilter.get_channel_info(nChannelID)) < 0)
-                                sText.append(" (sub channel)");
-
-                        if ((this->m_cChannelFilter.find_channel_in_list(this->m_pcConfigData->s_get_IgnoreList(), nChannelID) >= 0) && this->m_pcConfigData->s_get_UseIgnoreListTx(ii))
-                            bIgnored = true;
+                //channel is part of level/favorite list of profile
+                if (sText.size() != 0) sText.append("\n");
+                sText.append("[I]\"");
+                sText.append(this->m_pcConfigData->s_get_ProfileName(ii));
+                sText.append("\"[/I]");
 
-                        //if it is a level based profile, add actual level
-                        if (this->m_pcConfigData->s_get_ProfileType(ii) == PROFILE_LEVEL)
-                            sText.append(std::string(" (level ") + std::to_string(this->m_cChannelFilter.get_channel_level(nChannelID)) + std::string(")"));
+                if (cChannel.nSubChannel & PROFILE_BIT(ii))
+                    sText.append(" (sub channel)");
 
-                        if (bIgnored) sText.append(" [ignored]");
-                        break;
-                    }
-                }
+                //if it is a level based profile, add actual level
+                if (nLevel & PROFILE_BIT(ii))
+                    sText.append(std::string(" (level ") + std::to_string(this->m_cChannelFilter.get_channel_level(nChannelID)) + std::string(")"));
 
-                // free filtered list after function is done
-                this->m_pstTs3Functions->freeMemory(pnFilteredList);
+                if (cChannel.bIgnored && (nIgnoreTx & PROFILE_BIT(ii))) sText.append(" [ignored]");
             }
         }
 
         // check ignore list
-        if (this->m_pcConfigData->s_find_entry(this->m_pcConfigData->s_get_IgnoreList(), this->m_cChannelFilter.get_channel_info(nChannelID)) > 0)
+        if (cChannel.bIgnored)
         {
             if (sText.size() != 0) sText.append("\n");
             sText.append(TRANSLATE_PTR("info_Ignore"));
@@ -562,10 +665,9 @@ void plugin_handler::infoData(uint64 id, PluginItemType type, char ** data)
             sText.append(TRANSLATE_PTR("info_Default"));
 
         break;
+    }
     default:
-        printf("Invalid item type: %d\n", type);
-        data = NULL;  /* Ignore */
-        return;
+        break;
     }
 
     // limit length of string
@@ -575,12 +677,7 @@ void plugin_handler::infoData(uint64 id, PluginItemType type, char ** data)
         sText = sText.substr(0, 120);
         sText.append("\n...");
     }
-
-    // allocate memory for the buffer
-    *data = (char*)malloc(INFODATA_BUFSIZE * sizeof(char));
-    // copy string to buffer
-    sprintf_s(*data, INFODATA_BUFSIZE, "%s", sText.c_str());  // bbCode is supported. HTML is not supported
-    return;
+    return sText;
 }
 
 
@@ -589,19 +686,15 @@ void plugin_handler::infoData(uint64 id, PluginItemType type, char ** data)
 */
 void plugin_handler::onTalkStatusChangeEvent(int iStatus, int iIsReceivedWhisper, anyID nClientID)
 {
-    // Demonstrate usage of getClientDisplayName
-    int iClientIdx = this->m_cClientFilter.find_client(nClientID);
-    if (iClientIdx >= 0)
-    {
-        if (iStatus == STATUS_TALKING)
-        {
-            printf("--> %s starts %s\n", this->m_cClientFilter.m_cClientList[iClientIdx].sClientName.c_str(), iIsReceivedWhisper == 0 ? "talking" : "whispering");
-        }
-        else
-        {
-            printf("--> %s stops %s\n", this->m_cClientFilter.m_cClientList[iClientIdx].sClientName.c_str(), iIsReceivedWhisper == 0 ? "talking" : "whispering");
-        }
-    }
+    // config changes of the settings dialog are not sent as event, check them before the voice data arrives
+    this->m_pcRxFilter->update(nullptr, this->m_nChannelGeneration);
+    this->m_cSpatial.set_talk_status(nClientID, iStatus == STATUS_TALKING, iIsReceivedWhisper != 0);
+
+    // statistics per frequency profile, shown by the info text and the UI
+    this->m_cTalkTracker.update(nullptr);
+    this->m_cTalkTracker.set_talk_status(nClientID, iStatus == STATUS_TALKING, iIsReceivedWhisper != 0);
+
+    if (DEBUG_LOG) printf("--> client %d %s %s\n", nClientID, (iStatus == STATUS_TALKING) ? "starts" : "stops", (iIsReceivedWhisper == 0) ? "talking" : "whispering");
 }
 
 
@@ -612,27 +705,31 @@ void plugin_handler::print_all_lists()
 {
     const size_t nBuffSize = 512;
     char cBuffer[nBuffSize];
-    char *pcChName;
+    std::string sReport;    // whole report, printed in a few chunks at the end
+
+    // sub channel and ignore state of all channels
+    this->m_cMembership.update(this->m_nChannelGeneration, this->m_cClientFilter.get_my_channel_id(), this->m_pcConfigData->s_get_Generation());
+    profile_mask nIgnoreTx = this->m_cMembership.get_ignore_tx_profiles();
 
     // add some new lines
     sprintf_s(cBuffer, nBuffSize, "\n\n");
-    this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
+    sReport.append(cBuffer);
 
     //print ignore list
     sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("menuEv_IgnoreInfo"), m_pcConfigData->s_get_IgnoreList()->size() - 1);
-    this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
+    sReport.append(cBuffer);
     if (m_pcConfigData->s_get_IgnoreList()->size() > 1)
     {
         for (int ii = 1; ii < m_pcConfigData->s_get_IgnoreList()->size(); ii++)
         {
             sprintf_s(cBuffer, nBuffSize, "+____%3d: %s\n", ii, (*m_pcConfigData->s_get_IgnoreList())[ii].sChannelName.c_str());
-            this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
+            sReport.append(cBuffer);
         }
     }
     else
     {
         sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("menuEv_NoChInList"));
-        this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
+        sReport.append(cBuffer);
     }
 
     //print profiles
@@ -642,40 +739,30 @@ void plugin_handler::print_all_lists()
         if ((this->m_pcConfigData->s_get_ProfileType(ii) == PROFILE_FAVORITE) || (this->m_pcConfigData->s_get_ProfileType(ii) == PROFILE_AUDIO))
         {
             sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("menuEv_FavoriteInfo"), this->m_pcConfigData->s_get_ProfileName(ii).c_str(), this->m_pcConfigData->s_get_FavoriteList(ii)->size() - 1);
-            this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
+            sReport.append(cBuffer);
 
             // print channel list based on same filter like hotkey
-            uint64 *pnFilteredList = this->m_cChannelFilter.filter_channel_from_list(this->m_pcConfigData->s_get_FavoriteList(ii), this->m_pcConfigData->s_get_UseSubChOfFav(ii), false);
-            if (pnFilteredList != nullptr)
+            std::vector<uint64> vChannel = this->m_cMembership.get_profile_channels(ii);
+            if (!vChannel.empty())
             {
-                for (int jj = 0; pnFilteredList[jj] != 0; jj++)
+                for (int jj = 0; jj < vChannel.size(); jj++)
                 {
-                    bool bIsSubChannel = false;
-                    bool bIgnored = false;
-
-                    //if subchannel are used, try to find it in the master list
-                    if (this->m_pcConfigData->s_get_UseSubChOfFav(ii))
-                        if (this->m_pcConfigData->s_find_entry(this->m_pcConfigData->s_get_FavoriteList(ii), this->m_cChannelFilter.get_channel_info(pnFilteredList[jj])) < 0)
-                            bIsSubChannel = true;;
+                    channel_membership cChannel = this->m_cMembership.get_channel(vChannel[jj]);
+                    bool bIsSubChannel = (cChannel.nSubChannel & PROFILE_BIT(ii)) != 0;
+                    bool bIgnored = cChannel.bIgnored && (nIgnoreTx & PROFILE_BIT(ii));
 
-                    if ((this->m_cChannelFilter.find_channel_in_list(this->m_pcConfigData->s_get_IgnoreList(), pnFilteredList[jj]) >= 0) && this->m_pcConfigData->s_get_UseIgnoreListTx(ii))
-                        bIgnored = true;
-
-                    this->m_pstTs3Functions->getChannelVariableAsString(this->m_nServerID, pnFilteredList[jj], CHANNEL_NAME, &pcChName);
-                    if (pcChName != nullptr)
+                    std::string sChName = this->m_cMembership.get_channel_name(vChannel[jj]);
+                    if (!sChName.empty())
                     {
-                        sprintf_s(cBuffer, nBuffSize, "+____%3d: %s%s%s\n", jj + 1, pcChName, bIsSubChannel ? "[I](sub channel)[/I]" : "", bIgnored ? " [ignored]" : "");
-                        this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
-                        this->m_pstTs3Functions->freeMemory(pcChName);
+                        sprintf_s(cBuffer, nBuffSize, "+____%3d: %s%s%s\n", jj + 1, sChName.c_str(), bIsSubChannel ? "[I](sub channel)[/I]" : "", bIgnored ? " [ignored]" : "");
+                        sReport.append(cBuffer);
                     }
                 }
-                // free filtered list after function is done
-                this->m_pstTs3Functions->freeMemory(pnFilteredList);
             }
             else
             {
                 sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("menuEv_NoChInList"));
-                this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
+                sReport.append(cBuffer);
             }
         }
         else if (this->m_pcConfigData->s_get_ProfileType(ii) == PROFILE_LEVEL)
@@ -685,41 +772,35 @@ void plugin_handler::print_all_lists()
                 sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("menuEv_LevelInfo1"), this->m_pcConfigData->s_get_ProfileName(ii).c_str(), this->m_pcConfigData->s_get_MinChLevel(ii), this->m_pcConfigData->s_get_MaxChLevel(ii));
             else
                 sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("menuEv_LevelInfo2"), this->m_pcConfigData->s_get_ProfileName(ii).c_str(), this->m_pcConfigData->s_get_MinChLevel(ii));
-            this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
+            sReport.append(cBuffer);
 
             // print channel list based on same filter like hotkey
-            uint64 *pnFilteredList = this->m_cChannelFilter.filter_channel_from_level(this->m_pcConfigData->s_get_MinChLevel(ii), this->m_pcConfigData->s_get_MaxChLevel(ii), false);
-            if (pnFilteredList != nullptr)
+            std::vector<uint64> vChannel = this->m_cMembership.get_profile_channels(ii);
+            if (!vChannel.empty())
             {
-                for (int jj = 0; pnFilteredList[jj] != 0; jj++)
+                for (int jj = 0; jj < vChannel.size(); jj++)
                 {
-                    bool bIgnored = false;
-
-                    if ((this->m_cChannelFilter.find_channel_in_list(this->m_pcConfigData->s_get_IgnoreList(), pnFilteredList[jj]) >= 0) && this->m_pcConfigData->s_get_UseIgnoreListTx(ii))
-                        bIgnored = true;
+                    bool bIgnored = this->m_cMembership.get_channel(vChannel[jj]).bIgnored && (nIgnoreTx & PROFILE_BIT(ii));
 
-                    this->m_pstTs3Functions->getChannelVariableAsString(this->m_nServerID, pnFilteredList[jj], CHANNEL_NAME, &pcChName);
-                    if (pcChName != nullptr)
+                    std::string sChName = this->m_cMembership.get_channel_name(vChannel[jj]);
+                    if (!sChName.empty())
                     {
-                        sprintf_s(cBuffer, nBuffSize, "+____%3d: %s [I](level %zd)[/I]%s\n", jj + 1, pcChName, this->m_cChannelFilter.get_channel_level(pnFilteredList[jj]), bIgnored ? " [ignored]" : "");
-                        this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
-                        this->m_pstTs3Functions->freeMemory(pcChName);
+                        sprintf_s(cBuffer, nBuffSize, "+____%3d: %s [I](level %zd)[/I]%s\n", jj + 1, sChName.c_str(), this->m_cMembership.get_channel_level(vChannel[jj]), bIgnored ? " [ignored]" : "");
+                        sReport.append(cBuffer);
                     }
                 }
-                // free filtered list after function is done
-                this->m_pstTs3Functions->freeMemory(pnFilteredList);
             }
             else
             {
                 sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("menuEv_NoChInRange"));
-                this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
+                sReport.append(cBuffer);
             }
         }
         else if (this->m_pcConfigData->s_get_ProfileType(ii) == PROFILE_FREQUENCY)
         {
             // Type "Frequency" depending on selected frequency
             sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("menuEv_FreqInfo"), this->m_pcConfigData->s_get_ActiveFreq(ii), this->m_pcConfigData->s_get_ProfileName(ii).c_str(), this->m_cClientFilter.m_cClientList.size(), this->m_pcConfigData->s_get_MuteFreq(ii) ? " => muted" : "");
-            this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
+            sReport.append(cBuffer);
 
             if (this->m_pcConfigData->s_get_ActiveFreq(ii) != 0)
             {
@@ -732,7 +813,7 @@ void plugin_handler::print_all_lists()
                     {
                         //check if client is muted/ignored or not
                         bool bMuted = false;
-                        bool bIgnored = false;
+                        bool bIgnored = this->m_cMembership.get_channel(this->m_cClientFilter.m_cClientList[vActiveClient[jj]].nActualChannelID).bIgnored && (nIgnoreTx & PROFILE_BIT(ii));
                         for (int kk = 0; ((kk < NUM_FREQUENCIES) && (this->m_cClientFilter.m_cClientList[vActiveClient[jj]].acFreqList[kk].nBit.nFreq > 0)); kk++)
                         {
                             if (this->m_cClientFilter.m_cClientList[vActiveClient[jj]].acFreqList[kk].nBit.nFreq == this->m_pcConfigData->s_get_ActiveFreq(ii))
@@ -741,27 +822,58 @@ void plugin_handler::print_all_lists()
                                 break;
                             }
                         }
-                        if((this->m_cChannelFilter.find_channel_in_list(this->m_pcConfigData->s_get_IgnoreList(), this->m_cClientFilter.m_cClientList[vActiveClient[jj]].nActualChannelID) >= 0) && this->m_pcConfigData->s_get_UseIgnoreListTx(ii))
-                            bIgnored = true;
-
                         //print name and state of client
                         sprintf_s(cBuffer, nBuffSize, "+____%3d: %s%s%s\n", jj + 1, this->m_cClientFilter.m_cClientList[vActiveClient[jj]].sClientName.c_str(), bMuted ? " [muted]" : "", bIgnored ? " [ignored]" : "");
-                        this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
+                        sReport.append(cBuffer);
                     }
                 }
                 else
                 {
                     sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("menuEv_NoClientInList"));
-                    this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
+                    sReport.append(cBuffer);
                 }
             }
             else
             {
                 sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("menuEv_FreqDisabled"));
-                this->m_pstTs3Functions->printMessageToCurrentTab(cBuffer);
+                sReport.append(cBuffer);
             }
         }
     }
+
+    print_report(sReport);
+}
+
+
+/*
+* print text to current tab, split at line ends into messages the client accepts
+*/
+void plugin_handler::print_report(const std::string& sReport)
+{
+    const size_t nMaxChunk = TS3_MAX_SIZE_TEXTMESSAGE - 1;
+    size_t nStart = 0;
+
+    while (nStart < sReport.size())
+    {
+        size_t nEnd = nStart + nMaxChunk;
+        if (nEnd >= sReport.size())
+        {
+            nEnd = sReport.size();
+        }
+        else
+        {
+            // cut behind last complete line, a single long line is cut before an UTF-8 sequence
+            size_t nLineEnd = sReport.rfind('\n', nEnd - 1);
+            if ((nLineEnd != std::string::npos) && (nLineEnd >= nStart))
+                nEnd = nLineEnd + 1;
+            else
+                while ((nEnd > nStart + 1) && ((sReport[nEnd] & 0xC0) == 0x80))
+                    nEnd--;
+        }
+
+        this->m_pstTs3Functions->printMessageToCurrentTab(sReport.substr(nStart, nEnd - nStart).c_str());
+        nStart = nEnd;
+    }
 }
 
 
@@ -771,6 +883,10 @@ void plugin_handler::print_all_lists()
 void plugin_handler::update_meta_data()
 {
     this->m_cClientFilter.set_meta_data();
+    this->m_nInfoGeneration++;
+    this->m_pcRxFilter->update(nullptr, this->m_nChannelGeneration);
+    this->m_cSpatial.update(nullptr);
+    this->m_cTalkTracker.update(nullptr);
 }
 
 
@@ -797,6 +913,9 @@ void plugin_handler::toggle_ignore(uint64 nChannel)
         this->m_pcConfigData->s_delete_entry(this->m_pcConfigData->s_get_IgnoreList(), nEntry);
 
     if (DEBUG_LOG) printf("Id %llu, IsPermanent %d, Parent %llu, Name %s, Invalid %d (Entry %d)\n", stChInfo.nChannelID, stChInfo.bIsPermanent, stChInfo.nChannelParent, stChInfo.sChannelName.c_str(), stChInfo.iInvalidCount, nEntry);
+
+    // whispers from the channel are dropped / passed from now on
+    this->m_pcRxFilter->update(nullptr, this->m_nChannelGeneration);
 }
 
 /*
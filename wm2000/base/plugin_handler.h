@@ -5,12 +5,23 @@
 //#include "speech_engine.h"
 #include "misc/channel_filter.h"
 #include "misc/client_filter.h"
+#include "misc/profile_membership.h"
+#include "misc/level_targets.h"
+#include "misc/rx_filter.h"
+#include "misc/spatial_layout.h"
+#include "misc/talk_tracker.h"
+#include "misc/hotkey_table.h"
+#include "misc/whisper_transaction.h"
 #include "ts3_functions.h"
+#include <unordered_map>
+#include <atomic>
+#include <memory>
 
-#define INFODATA_BUFSIZE 128
+#define INFODATA_BUFSIZE 512
+#define INFODATA_ACTIVITY_LEN 240      // live part of the info text, after the cached part (max. 124)
 
 // some helper to use with language_pkg
-#define TRANSLATE_PTR(a) this->m_pcTranslate->translate(a).c_str()
+#define TRANSLATE_PTR(a) this->m_pcTranslate->translate(a)
 
 
 class plugin_handler
@@ -24,8 +35,10 @@ public:
     void                 check_param();
 
     //event functions
-    void onUpdateClientEvent(anyID nClientID, uint64 nActChannel) { this->m_cClientFilter.update_client_list(nClientID, nActChannel); };
-    void onHotkeyEvent(const char* keyword);
+    void onUpdateClientEvent(anyID nClientID, uint64 nActChannel);
+    void onUpdateClientEvent(const std::vector<client_update>& vUpdate);    // folded batch, one invalidation
+    void onChannelEvent();                                                  // channel was created, deleted, moved or edited
+    void onHotkeyEvent(const hotkey_action& cHotkey);
     void infoData(uint64 id, enum PluginItemType type, char** data);
     void onTalkStatusChangeEvent(int iStatus, int iIsReceivedWhisper, anyID nClientID);
 
@@ -41,11 +54,16 @@ public:
     // interface
     client_filter*      get_client_filter()  { return &this->m_cClientFilter; };
     channel_filter*     get_channel_filter() { return &this->m_cChannelFilter; };
+    std::shared_ptr<rx_filter> get_rx_filter() { return this->m_pcRxFilter; };     // used by the audio thread, may outlive the handler
+    talk_tracker*       get_talk_tracker()   { return &this->m_cTalkTracker; };    // read by the UI
 
 protected:
-    void                reset_WhisperlList();
-    void                activate_PTT(int iState);
+    void                handle_hotkey(const hotkey_action& cHotkey);
     void                internal_write_err(const char* pFuncName);
+    std::string         create_info_text(uint64 id, enum PluginItemType type);
+    std::string         create_activity_text(uint64 id, enum PluginItemType type);
+    void                print_report(const std::string& sReport);
+    void                check_own_move(uint64 nLastChannelID);
 
 private:
 //    speech_engine        m_cSpeechEngine;       // interface to speech engine
@@ -60,10 +78,24 @@ private:
     char*                m_pPluginID;           // used for plugin commands
 
     int                  m_nActualActiveProfile;// number of the actual used profile (0 => off)
-    bool                 m_bPttState;           // state of PTT activation
+    bool                 m_bActiveAutoActivate; // AutoActivate setting the actual profile was activated with
 
     client_filter        m_cClientFilter;       // helper class to filter clients
     channel_filter       m_cChannelFilter;      // helper class to filter channel lists
+    whisper_transaction  m_cWhisper;            // whisper list and PTT state, changes are sent per hotkey event
+    profile_membership   m_cMembership;         // profiles per channel/frequency, rebuilt after changes
+    level_targets        m_cLevelTargets;       // whisper targets of level profiles, rebuilt after own moves
+    std::atomic<uint32_t> m_nChannelGeneration; // incremented on channel changes (level targets, rx filter, membership)
+    std::shared_ptr<rx_filter> m_pcRxFilter;    // receive side of Mute/Squelch/UseIgnoreListRx
+    spatial_layout       m_cSpatial;            // 3D positions of clients whispering over a frequency
+    talk_tracker         m_cTalkTracker;        // active talkers and talk time per frequency profile
+
+    // cache of info texts (index = PluginItemType, key = item ID), dropped on any change
+    boost::mutex                                    m_cInfoCacheMutex;
+    std::unordered_map<uint64, std::string>         m_amInfoCache[PLUGIN_CLIENT + 1];
+    std::atomic<uint32_t>                           m_nInfoGeneration;      // incremented on client and channel changes
+    uint32_t                                        m_nInfoCacheGeneration; // m_nInfoGeneration the cache was filled with
+    uint32_t                                        m_nInfoCacheConfigGen;  // config generation the cache was filled with
 };
 
 
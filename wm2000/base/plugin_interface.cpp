@@ -9,6 +9,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <time.h>
 #include "base/plugin_base.h"
 #include "teamspeak/public_errors.h"
 #include "teamspeak/public_errors_rare.h"
@@ -18,6 +19,7 @@
 #include "ts3_functions.h"
 #include "base/plugin.h"
 #include "misc/error_handler.h"
+#include "misc/event_recorder.h"
 
 char pPluginPath[PATH_BUFSIZE];
 
@@ -26,6 +28,7 @@ static char* pluginID = NULL;
 
 static plugin_base          cPluginBase;
 error_handler               cErrHandler;      // link to error handler
+static event_recorder       cRecorder;        // opt-in log of all callbacks, see record_command
 
 #define DEBUG_TSIF 1
 
@@ -115,6 +118,12 @@ int ts3plugin_init()
     // read config from file
     cPluginBase.Init(ts3Functions, std::string(pPluginPath), pluginID);
 
+    // record from the start (e.g. connect of a server), if WM2000_RECORD is set to a file name
+    cRecorder.init(&ts3Functions);
+    const char *pRecordFile = getenv("WM2000_RECORD");
+    if ((pRecordFile != NULL) && (pRecordFile[0] != 0))
+        cRecorder.start(std::string(pRecordFile), std::string(pPluginPath) + "WhisperMaster2000/config.xml", 0);
+
     return 0;  /* 0 = success, 1 = failure, -2 = failure but client will not show a "failed to load" warning */
 	/* -2 is a very special case and should only be used if a plugin displays a dialog (e.g. overlay) asking the user to disable
 	 * the plugin again, avoiding the show another dialog by the client telling the user the plugin failed to load.
@@ -129,6 +138,8 @@ void ts3plugin_shutdown()
     {
         if (DEBUG_TSIF) printf("PLUGIN: start shutdown\n");
 
+        cRecorder.stop();
+
 	    //save last config to file
         cPluginBase.Close();
         if (DEBUG_TSIF) printf("PLUGIN: shutdown...\n");
@@ -204,10 +215,52 @@ const char* ts3plugin_commandKeyword()
 }
 
 
+/*
+ * "record start": write all following callbacks to <plugin path>/WhisperMaster2000/record_<date>_<time>.wm2rec,
+ * starts with a snapshot of the server. "record stop": close the file. Replay with bench/wm2000_replay.
+ */
+static int record_command(uint64 serverConnectionHandlerID, const char* command)
+{
+    char cBuffer[PATH_BUFSIZE + 128];
+    if (strcmp(command, "record start") == 0)
+    {
+        char cTime[32];
+        time_t nNow = time(NULL);
+        struct tm stNow;
+        localtime_s(&stNow, &nNow);
+        strftime(cTime, sizeof(cTime), "%Y%m%d_%H%M%S", &stNow);
+
+        std::string sConfigPath = std::string(pPluginPath) + "WhisperMaster2000/";
+        std::string sFileName = sConfigPath + "record_" + cTime + ".wm2rec";
+        if (cRecorder.start(sFileName, sConfigPath + "config.xml", serverConnectionHandlerID))
+            snprintf(cBuffer, sizeof(cBuffer), cPluginBase.m_cTranslate.translate("cmd_RecordStart"), sFileName.c_str());
+        else
+            snprintf(cBuffer, sizeof(cBuffer), cPluginBase.m_cTranslate.translate("cmd_RecordErr"), sFileName.c_str());
+    }
+    else if (strcmp(command, "record stop") == 0)
+    {
+        std::string sFileName = cRecorder.get_file_name();
+        size_t nEvents = cRecorder.get_num_events();
+        if (!cRecorder.is_active())
+            return 1;
+        cRecorder.stop();
+        snprintf(cBuffer, sizeof(cBuffer), cPluginBase.m_cTranslate.translate("cmd_RecordStop"), (unsigned int)nEvents, sFileName.c_str());
+    }
+    else
+        return 1;
+
+    ts3Functions.printMessageToCurrentTab(cBuffer);
+    return 0;
+}
+
 /* Plugin processes console command. Return 0 if plugin handled the command, 1 if not handled. */
 int ts3plugin_processCommand(uint64 serverConnectionHandlerID, const char* command)
 {
-	return 0;  /* Plugin handled command */
+    if (strncmp(command, "record ", 7) == 0)
+        return record_command(serverConnectionHandlerID, command);
+
+    cRecorder.onCommand(serverConnectionHandlerID, command);
+    return cPluginBase.processCommand(serverConnectionHandlerID, command);
 }
 
 /* Client changed current server connection handler */
@@ -236,6 +289,7 @@ const char* ts3plugin_infoTitle()
  */
 void ts3plugin_infoData(uint64 serverConnectionHandlerID, uint64 id, enum PluginItemType type, char** data)
 {
+    cRecorder.onInfoData(serverConnectionHandlerID, id, type);
     cPluginBase.infoData(serverConnectionHandlerID, id, type, data);
     return;
 }
@@ -360,6 +414,7 @@ void ts3plugin_initHotkeys(struct PluginHotkey*** hotkeys)
 void ts3plugin_onConnectStatusChangeEvent(uint64 serverConnectionHandlerID, int newStatus, unsigned int errorNumber)
 {
     /* Some example code following to show how to use the information query functions. */
+    cRecorder.onConnectStatusChange(serverConnectionHandlerID, newStatus, errorNumber);
     cPluginBase.onConnect(serverConnectionHandlerID, newStatus);
     return;
 }
@@ -367,6 +422,7 @@ void ts3plugin_onConnectStatusChangeEvent(uint64 serverConnectionHandlerID, int
 void ts3plugin_onNewChannelEvent(uint64 serverConnectionHandlerID, uint64 channelID, uint64 channelParentID)
 {
 	//initialisation of channel by channel => use ts3plugin_onConnectStatusChangeEvent(...) instead
+    cRecorder.onChannel(REC_NEW_CHANNEL, serverConnectionHandlerID, channelID, channelParentID, 0);
     //if (DEBUG_TSIF) printf("ts3plugin_onNewChannelEvent \n");
 }
 
@@ -374,18 +430,24 @@ void ts3plugin_onNewChannelCreatedEvent(uint64 serverConnectionHandlerID, uint64
 {
 	//on creation of new sub-/channel
     if (DEBUG_TSIF) printf("ts3plugin_onNewChannelCreatedEvent: channelID %llu, channelParentID %llu, invokerID %d, invokerName %s\n", channelID, channelParentID, invokerID, invokerName);
+    cRecorder.onChannel(REC_NEW_CHANNEL_CREATED, serverConnectionHandlerID, channelID, channelParentID, invokerID);
+    cPluginBase.onChannelEvent(serverConnectionHandlerID);
 }
 
 void ts3plugin_onDelChannelEvent(uint64 serverConnectionHandlerID, uint64 channelID, anyID invokerID, const char* invokerName, const char* invokerUniqueIdentifier)
 {
 	//on (auto-)delete of a channel
     if (DEBUG_TSIF) printf("ts3plugin_onDelChannelEvent: channelID %llu, invokerID %d, invokerName %s\n", channelID, invokerID, invokerName);
+    cRecorder.onChannel(REC_DEL_CHANNEL, serverConnectionHandlerID, channelID, 0, invokerID);
+    cPluginBase.onChannelEvent(serverConnectionHandlerID);
 }
 
 void ts3plugin_onChannelMoveEvent(uint64 serverConnectionHandlerID, uint64 channelID, uint64 newChannelParentID, anyID invokerID, const char* invokerName, const char* invokerUniqueIdentifier)
 {
 	//if channel is moved
     if (DEBUG_TSIF) printf("ts3plugin_onChannelMoveEvent: channelID %llu, newChannelParentID %llu, invokerID %d, invokerName %s\n", channelID, newChannelParentID, invokerID, invokerName);
+    cRecorder.onChannel(REC_CHANNEL_MOVE, serverConnectionHandlerID, channelID, newChannelParentID, invokerID);
+    cPluginBase.onChannelEvent(serverConnectionHandlerID);
 }
 
 void ts3plugin_onUpdateChannelEvent(uint64 serverConnectionHandlerID, uint64 channelID)
@@ -397,6 +459,8 @@ void ts3plugin_onUpdateChannelEvent(uint64 serverConnectionHandlerID, uint64 cha
 void ts3plugin_onUpdateChannelEditedEvent(uint64 serverConnectionHandlerID, uint64 channelID, anyID invokerID, const char* invokerName, const char* invokerUniqueIdentifier)
 {
     if (DEBUG_TSIF) printf("ts3plugin_onUpdateChannelEditedEvent \n");
+    cRecorder.onChannel(REC_CHANNEL_EDITED, serverConnectionHandlerID, channelID, 0, invokerID);
+    cPluginBase.onChannelEvent(serverConnectionHandlerID);
 }
 
 void ts3plugin_onUpdateClientEvent(uint64 serverConnectionHandlerID, anyID clientID, anyID invokerID, const char* invokerName, const char* invokerUniqueIdentifier)
@@ -405,6 +469,7 @@ void ts3plugin_onUpdateClientEvent(uint64 serverConnectionHandlerID, anyID clien
     if (DEBUG_TSIF) printf("onUpdateClientEvent(clientID %d) => ", clientID);
 
     //connection state is always == connected
+    cRecorder.onUpdateClient(serverConnectionHandlerID, clientID, invokerID);
     cPluginBase.onUpdateClientEvent(serverConnectionHandlerID, clientID, INVALID_CHANNEL_ID);
 }
 
@@ -414,6 +479,7 @@ void ts3plugin_onClientMoveEvent(uint64 serverConnectionHandlerID, anyID clientI
     //if user selects other channel	(visibility 1)
     //on disconnect of other client	(newChannelID 0, visibility 2)
     if (DEBUG_TSIF) printf("onClientMoveEvent (clientID %d, newChannelID %llu) => ", clientID, newChannelID);
+    cRecorder.onClientMove(REC_CLIENT_MOVE, serverConnectionHandlerID, clientID, oldChannelID, newChannelID, visibility, 0);
 
     //if newChannelID == 0 => disconnect
     cPluginBase.onUpdateClientEvent(serverConnectionHandlerID, clientID, newChannelID);
@@ -423,6 +489,7 @@ void ts3plugin_onClientMoveSubscriptionEvent(uint64 serverConnectionHandlerID, a
 {
     //called on connect of own client
     if (DEBUG_TSIF) printf("onSubscriptionEvent(clientID %d, newChannelID %llu) => ", clientID, newChannelID);
+    cRecorder.onClientMove(REC_CLIENT_SUBSCRIPTION, serverConnectionHandlerID, clientID, oldChannelID, newChannelID, visibility, 0);
 
     //channel id is unknown here, set to -1 to prevent update function to overwrite the value
     cPluginBase.onUpdateClientEvent(serverConnectionHandlerID, clientID, newChannelID);
@@ -432,6 +499,7 @@ void ts3plugin_onClientMoveTimeoutEvent(uint64 serverConnectionHandlerID, anyID
 {
     //if other client times out
     if (DEBUG_TSIF) printf("onClientMoveTimeoutEvent (clientID %d, newChannelID %llu) => ", clientID, newChannelID);
+    cRecorder.onClientMove(REC_CLIENT_TIMEOUT, serverConnectionHandlerID, clientID, oldChannelID, newChannelID, visibility, 0);
 
     //if newChannelID == 0 => disconnect
     cPluginBase.onUpdateClientEvent(serverConnectionHandlerID, clientID, newChannelID);
@@ -442,6 +510,7 @@ void ts3plugin_onClientMoveMovedEvent(uint64 serverConnectionHandlerID, anyID cl
 	// if user is automoved after (sub-)channel creation
     // if user is manually moved by other user
     if (DEBUG_TSIF) printf("onClientMoveMovedEvent (clientID %d, newChannelID %llu) => ", clientID, newChannelID);
+    cRecorder.onClientMove(REC_CLIENT_MOVED, serverConnectionHandlerID, clientID, oldChannelID, newChannelID, visibility, moverID);
     cPluginBase.onUpdateClientEvent(serverConnectionHandlerID, clientID, newChannelID);
 }
 
@@ -499,9 +568,22 @@ int ts3plugin_onTextMessageEvent(uint64 serverConnectionHandlerID, anyID targetM
 
 void ts3plugin_onTalkStatusChangeEvent(uint64 serverConnectionHandlerID, int status, int isReceivedWhisper, anyID clientID)
 {
+    cRecorder.onTalkStatusChange(serverConnectionHandlerID, status, isReceivedWhisper, clientID);
     cPluginBase.onTalkStatusChangeEvent(serverConnectionHandlerID, status, isReceivedWhisper, clientID);
 }
 
+/* Audio thread, not recorded (one call per client and 20 ms frame) */
+void ts3plugin_onEditPlaybackVoiceDataEvent(uint64 serverConnectionHandlerID, anyID clientID, short* samples, int sampleCount, int channels)
+{
+    cPluginBase.onEditPlaybackVoiceDataEvent(serverConnectionHandlerID, clientID, samples, sampleCount, channels);
+}
+
+/* Audio thread, not recorded (one call per client and 20 ms frame) */
+void ts3plugin_onCustom3dRolloffCalculationClientEvent(uint64 serverConnectionHandlerID, anyID clientID, float distance, float* volume)
+{
+    cPluginBase.onCustom3dRolloffCalculationClientEvent(serverConnectionHandlerID, clientID, distance, volume);
+}
+
 /* Client UI callbacks */
 
 /*
@@ -524,6 +606,7 @@ void ts3plugin_onAvatarUpdated(uint64 serverConnectionHandlerID, anyID clientID,
  */
 void ts3plugin_onMenuItemEvent(uint64 serverConnectionHandlerID, enum PluginMenuType type, int menuItemID, uint64 selectedItemID)
 {
+    cRecorder.onMenuItem(serverConnectionHandlerID, type, menuItemID, selectedItemID);
     cPluginBase.onMenuItemEvent(serverConnectionHandlerID, type, menuItemID, selectedItemID);
     return;
 }
@@ -531,6 +614,7 @@ void ts3plugin_onMenuItemEvent(uint64 serverConnectionHandlerID, enum PluginMenu
 /* This function is called if a plugin hotkey was pressed. Omit if hotkeys are unused. */
 void ts3plugin_onHotkeyEvent(const char* keyword)
 {
+    cRecorder.onHotkey(keyword);
     cPluginBase.onHotkeyEvent(keyword);
     return;
 }
@@ -566,3 +650,21 @@ void ts3plugin_onClientDisplayNameChanged(uint64 serverConnectionHandlerID, anyI
 {
     return;
 }
+
+/* ----------------------------------------------------------------------------
+* used by the headless tools in bench/ only
+*/
+void wm2000_set_synchronous_events(int bSynchronous)
+{
+    cPluginBase.set_synchronous(bSynchronous != 0);
+}
+
+void wm2000_flush_events()
+{
+    cPluginBase.flush_events();
+}
+
+void wm2000_reload_config()
+{
+    cPluginBase.reload_config();
+}
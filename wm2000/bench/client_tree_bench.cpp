@@ -0,0 +1,231 @@
+/* ----------------------------------------------------------------------------
+* clientTreeModel refresh benchmark
+*
+* builds the rows of a level profile (like clientTreeWidget does) from a
+* simulated server and applies them to the model. The view is emulated by
+* expanding the new server rows once (one fetchMore), the number of created
+* items is counted through rowCount. Prints the time and the heap allocations
+* per refresh for the first fill, one changed row and all texts changed.
+* Limits given on the command line are checked, the exit code is 1 if one of
+* them is exceeded.
+*
+*   wm2000_tree_bench [--channels=N] [--depth=N] [--seed=N] [--iterations=N]
+*                     [--limit-us=US] [--limit-items=N]
+*
+*   example: wm2000_tree_bench --channels=5000 --limit-items=200
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <new>
+#include <QtGui/QGuiApplication>
+#include "bench/ts3_server_sim.h"
+#include "ui/clientTreeModel.h"
+
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+/* ----------------------------------------------------------------------------
+* heap allocations of the whole process
+*/
+static std::atomic<size_t> s_nAllocs(0);
+
+void* operator new(size_t nSize)
+{
+    s_nAllocs.fetch_add(1, std::memory_order_relaxed);
+    void* pMemory = malloc(nSize ? nSize : 1);
+    if (pMemory == nullptr)
+        throw std::bad_alloc();
+    return pMemory;
+}
+
+void* operator new[](size_t nSize)
+{
+    return operator new(nSize);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+    free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+    free(pMemory);
+}
+
+void operator delete(void* pMemory, size_t nSize) noexcept
+{
+    free(pMemory);
+}
+
+void operator delete[](void* pMemory, size_t nSize) noexcept
+{
+    free(pMemory);
+}
+
+/* ----------------------------------------------------------------------------
+* helper
+*/
+static bool get_option(const char* pcArg, const char* pcName, std::string& sValue)
+{
+    size_t nLen = strlen(pcName);
+    if ((strncmp(pcArg, pcName, nLen) != 0) || (pcArg[nLen] != '='))
+        return false;
+    sValue = pcArg + nLen + 1;
+    return true;
+}
+
+// rows of a level profile over all channels, sState = <pcLevel><channel level>
+static std::vector<client_tree_row> create_rows(ts3_server_sim& cServer, const char* pcLevel)
+{
+    std::vector<client_tree_row> vcRows;
+    vcRows.push_back({ clientTreeModel::ITEM_SERVER, cServer.get_server_id(), QString::fromStdString("Simulated server"), QString::fromStdString("None"), -1, {} });
+    client_tree_row& ServerParent = vcRows.back();
+    for (const sim_channel& cChannel : cServer.get_channels())
+    {
+        if (cChannel.bDeleted)
+            continue;
+        ServerParent.vcChildren.push_back({ clientTreeModel::ITEM_CHANNEL, cChannel.nChannelID, QString::fromStdString(cChannel.sName),
+            QString::fromStdString(pcLevel + std::to_string(cChannel.iLevel)), cChannel.iLevel, {} });
+    }
+    return vcRows;
+}
+
+// the view expands new server rows, every expand fetches one block
+static void expand_servers(clientTreeModel& cModel)
+{
+    for (int ii = 0; ii < cModel.rowCount(); ii++)
+    {
+        QModelIndex cIndex = cModel.index(ii, 0);
+        if (cModel.canFetchMore(cIndex))
+            cModel.fetchMore(cIndex);
+    }
+}
+
+static int count_items(clientTreeModel& cModel, const QModelIndex& cParent)
+{
+    int iItems = 0;
+    for (int ii = 0; ii < cModel.rowCount(cParent); ii++)
+        iItems += 1 + count_items(cModel, cModel.index(ii, 0, cParent));
+    return iItems;
+}
+
+struct bench_result
+{
+    double      dUsPerRefresh;
+    double      dAllocsPerRefresh;
+    int         iItems;             // items of the model after the last refresh
+};
+
+// vcRows are built before the measurement, apply() and the view are measured
+static void measure(clientTreeModel& cModel, std::vector<client_tree_row> vcRows, bool bExpand, bench_result& cResult)
+{
+    size_t nAllocs = s_nAllocs.load();
+    auto cStart = std::chrono::steady_clock::now();
+    cModel.apply(std::move(vcRows));
+    if (bExpand)
+        expand_servers(cModel);
+    auto cEnd = std::chrono::steady_clock::now();
+
+    cResult.dUsPerRefresh     += std::chrono::duration<double, std::micro>(cEnd - cStart).count();
+    cResult.dAllocsPerRefresh += (double)(s_nAllocs.load() - nAllocs);
+}
+
+/* ----------------------------------------------------------------------------
+* main
+*/
+int main(int argc, char* argv[])
+{
+    sim_server_param cParam;
+    cParam.iNumChannel      = 5000;
+    cParam.iMaxDepth        = 4;
+    cParam.iNumClient       = 0;
+    cParam.iWmClientRatio   = 0;
+    cParam.iNumFreq         = 0;
+    cParam.iFreqPerClient   = 0;
+    cParam.nSeed            = 1;
+
+    int iIterations     = 50;
+    double dLimitUs     = -1.0;
+    int iLimitItems     = -1;
+    for (int ii = 1; ii < argc; ii++)
+    {
+        std::string sValue;
+        if      (get_option(argv[ii], "--channels", sValue))        cParam.iNumChannel  = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--depth", sValue))           cParam.iMaxDepth    = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--seed", sValue))            cParam.nSeed        = (unsigned)atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--iterations", sValue))      iIterations         = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--limit-us", sValue))        dLimitUs            = atof(sValue.c_str());
+        else if (get_option(argv[ii], "--limit-items", sValue))     iLimitItems         = atoi(sValue.c_str());
+        else
+        {
+            fprintf(stderr, "usage: wm2000_tree_bench [--channels=N] [--depth=N] [--seed=N] [--iterations=N] [--limit-us=US] [--limit-items=N]\n");
+            return 2;
+        }
+    }
+    if (iIterations <= 0)
+        iIterations = 1;
+
+    // QFont needs a gui application, no window is shown
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty())
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QGuiApplication cApp(argc, argv);
+
+    // the model prints debug output to stdout, keep it out of the measurement
+    fflush(stdout);
+    if (freopen(NULL_DEVICE, "w", stdout) == nullptr)
+        fprintf(stderr, "stdout could not be redirected, debug output is part of the measurement\n");
+
+    ts3_server_sim cServer;
+    cServer.create(cParam);
+    std::vector<client_tree_row> vcRows = create_rows(cServer, "Level ");
+    int iNumRows = (int)vcRows[0].vcChildren.size();
+
+    clientTreeModel cModel;
+    bench_result acResult[3] = {};
+
+    // first fill
+    measure(cModel, vcRows, true, acResult[0]);
+    acResult[0].iItems = count_items(cModel, QModelIndex());
+
+    // one changed row per refresh, the rest is the same
+    for (int ii = 0; ii < iIterations; ii++)
+    {
+        std::vector<client_tree_row> vcChanged = vcRows;
+        vcChanged[0].vcChildren[(ii * 97) % iNumRows].sState = QString::fromStdString("Ignore");
+        measure(cModel, std::move(vcChanged), false, acResult[1]);
+    }
+    acResult[1].iItems = count_items(cModel, QModelIndex());
+
+    // all texts changed (language switch)
+    for (int ii = 0; ii < iIterations; ii++)
+        measure(cModel, create_rows(cServer, (ii & 1) ? "Level " : "Ebene "), false, acResult[2]);
+    acResult[2].iItems = count_items(cModel, QModelIndex());
+
+    for (int ii = 1; ii < 3; ii++)
+    {
+        acResult[ii].dUsPerRefresh     /= iIterations;
+        acResult[ii].dAllocsPerRefresh /= iIterations;
+    }
+
+    // report
+    fprintf(stderr, "server: %d channels, depth %d, %d rows, %d iterations\n\n", cParam.iNumChannel, cParam.iMaxDepth, iNumRows + 1, iIterations);
+    fprintf(stderr, "%-12s %12s %12s %8s\n", "refresh", "us/refresh", "allocs", "items");
+    const char* apcName[3] = { "first fill", "1 change", "all changed" };
+    bool bFailed = false;
+    for (int ii = 0; ii < 3; ii++)
+    {
+        bool bExceeded = ((dLimitUs >= 0.0) && (acResult[ii].dUsPerRefresh > dLimitUs)) || ((iLimitItems >= 0) && (acResult[ii].iItems > iLimitItems));
+        fprintf(stderr, "%-12s %12.1f %12.1f %8d%s\n", apcName[ii], acResult[ii].dUsPerRefresh, acResult[ii].dAllocsPerRefresh, acResult[ii].iItems, bExceeded ? "  LIMIT EXCEEDED" : "");
+        bFailed |= bExceeded;
+    }
+    return bFailed ? 1 : 0;
+}
@@ -0,0 +1,360 @@
+#include "bench/event_replay.h"
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <sys/stat.h>
+#include "teamspeak/public_errors.h"
+#include "teamspeak/public_definitions.h"
+#include "teamspeak/clientlib_publicdefinitions.h"
+#include "plugin_definitions.h"
+#include "base/plugin.h"
+
+/* ----------------------------------------------------------------------------
+* helper
+*/
+static double thread_cpu_us()
+{
+    struct timespec stTime;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &stTime);
+    return (double)stTime.tv_sec * 1e6 + (double)stTime.tv_nsec / 1e3;
+}
+
+static double percentile(const std::vector<float>& vSorted, double dPercent)
+{
+    if (vSorted.empty())
+        return 0.0;
+    size_t nIdx = (size_t)(dPercent / 100.0 * (double)(vSorted.size() - 1) + 0.5);
+    return vSorted[nIdx];
+}
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+event_replay::event_replay()
+{
+    this->m_sPluginPath         = "./";
+    this->m_nRecServerID        = 0;
+    this->m_nRecMyClientID      = 0;
+    this->m_bLoaded             = false;
+    this->m_bConnected          = false;
+    this->m_bAsync              = false;
+    this->m_nNumSlowest         = 10;
+    this->m_nNumRecords         = 0;
+    this->m_nNumSkipped         = 0;
+    this->m_nRecDuration_us     = 0;
+    this->m_dReplayDuration_s   = 0.0;
+    for (int ii = 0; ii < REC_TYPE_END; ii++)
+        this->m_anApiCalls[ii] = 0;
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+event_replay::~event_replay()
+{
+    this->m_cClient.unload();
+}
+
+/* ----------------------------------------------------------------------------
+* replay the whole log, as fast as possible or with the recorded timing
+*/
+bool event_replay::run(const std::string& sFileName, bool bRealtime)
+{
+    event_reader cReader;
+    if (!cReader.open(sFileName))
+    {
+        fprintf(stderr, "%s: no WhisperMaster2000 recording\n", sFileName.c_str());
+        return false;
+    }
+    this->m_sFileName = sFileName;
+
+    // empty server, filled by the state records
+    sim_server_param cParam = { 0, 1, 0, 0, 0, 0, 1 };
+    this->m_cClient.create_server(cParam);
+    this->m_cClient.set_plugin_path(this->m_sPluginPath);
+
+    std::chrono::steady_clock::time_point cStart = std::chrono::steady_clock::now();
+    rec_event cEvent;
+    while (cReader.read(cEvent))
+    {
+        this->m_nNumRecords++;
+        this->m_nRecDuration_us = cEvent.nTime_us;
+
+        if (cEvent.eType == REC_CONFIG)
+        {
+            if (!this->m_bLoaded && !load_plugin(cEvent.asText[0]))
+                return false;
+            continue;
+        }
+        if (!this->m_bLoaded && !load_plugin(std::string()))
+            return false;
+
+        // first server in the log, if not selected
+        if ((this->m_nRecServerID == 0) && (cEvent.nServerID != 0))
+            this->m_nRecServerID = cEvent.nServerID;
+        if ((cEvent.nServerID != 0) && (cEvent.nServerID != this->m_nRecServerID))
+        {
+            this->m_nNumSkipped++;
+            continue;
+        }
+
+        if (bRealtime)
+            std::this_thread::sleep_until(cStart + std::chrono::microseconds(cEvent.nTime_us));
+
+        apply_state(cEvent);
+        if (cEvent.eType >= REC_CONNECT_STATUS)
+            dispatch(cEvent);
+        else if ((cEvent.eType == REC_SNAPSHOT_END) && !this->m_bConnected)
+        {
+            // recording was started while connected, plugin has to know the server
+            this->m_cClient.connect();
+            this->m_bConnected = true;
+        }
+    }
+    this->m_dReplayDuration_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - cStart).count();
+
+    if (cReader.has_error())
+        fprintf(stderr, "%s: recording is truncated after %zu records\n", sFileName.c_str(), this->m_nNumRecords);
+    this->m_cClient.unload();
+    return true;
+}
+
+/* ----------------------------------------------------------------------------
+* load plugin with the config of the recording
+*/
+bool event_replay::load_plugin(const std::string& sConfig)
+{
+    std::string sPluginPath = this->m_sPluginPath;
+    if (!sPluginPath.empty() && (sPluginPath.back() != '/'))
+        sPluginPath += "/";
+    std::string sConfigPath = sPluginPath + "WhisperMaster2000/";
+    mkdir(sPluginPath.c_str(), 0755);
+    mkdir(sConfigPath.c_str(), 0755);
+
+    if (!sConfig.empty())
+    {
+        FILE *pFile = fopen((sConfigPath + "config.xml").c_str(), "wb");
+        if (pFile == nullptr)
+        {
+            fprintf(stderr, "%sconfig.xml: can't write config\n", sConfigPath.c_str());
+            return false;
+        }
+        fwrite(sConfig.data(), 1, sConfig.size(), pFile);
+        fclose(pFile);
+    }
+
+    wm2000_set_synchronous_events(this->m_bAsync ? 0 : 1);
+    this->m_bLoaded = this->m_cClient.load();
+    if (!this->m_bLoaded)
+        fprintf(stderr, "plugin init failed\n");
+    return this->m_bLoaded;
+}
+
+/* ----------------------------------------------------------------------------
+* ID mapping, unknown IDs are 0
+*/
+uint64 event_replay::map_channel(uint64 nRecChannelID)
+{
+    std::map<uint64, uint64>::iterator it = this->m_mChannel.find(nRecChannelID);
+    return (it == this->m_mChannel.end()) ? 0 : it->second;
+}
+
+anyID event_replay::map_client(uint64 nRecClientID)
+{
+    std::map<uint64, anyID>::iterator it = this->m_mClient.find(nRecClientID);
+    return (it == this->m_mClient.end()) ? 0 : it->second;
+}
+
+anyID event_replay::add_client(uint64 nRecClientID, uint64 nRecChannelID, const std::string& sName, const std::string& sMetaData)
+{
+    ts3_server_sim *pcServer = this->m_cClient.get_server();
+    anyID nClientID = pcServer->add_client(map_channel(nRecChannelID), sName, sMetaData);
+    if (nClientID != 0)
+        this->m_mClient[nRecClientID] = nClientID;
+    return nClientID;
+}
+
+/* ----------------------------------------------------------------------------
+* change the simulated server like the real one before the callback
+*/
+void event_replay::apply_state(const rec_event& cEvent)
+{
+    ts3_server_sim *pcServer = this->m_cClient.get_server();
+    const uint64_t *anValue = cEvent.aValue;
+
+    switch (cEvent.eType)
+    {
+    case REC_CHANNEL:
+        if (map_channel(anValue[0]) == 0)
+        {
+            uint64 nChannelID = pcServer->add_channel(map_channel(anValue[1]), cEvent.asText[0]);
+            if (nChannelID != 0)
+                this->m_mChannel[anValue[0]] = nChannelID;
+        }
+        break;
+
+    case REC_CLIENT:
+        if (anValue[0] == this->m_nRecMyClientID)
+            break;
+        if (pcServer->find_client(map_client(anValue[0])) == nullptr)
+        {
+            add_client(anValue[0], anValue[1], cEvent.asText[0], cEvent.asText[1]);
+        }
+        else
+        {
+            pcServer->set_meta_data(map_client(anValue[0]), cEvent.asText[1]);
+            pcServer->move_client(map_client(anValue[0]), map_channel(anValue[1]));
+        }
+        break;
+
+    case REC_MY_CLIENT:
+        this->m_nRecMyClientID = anValue[0];
+        this->m_mClient[anValue[0]] = pcServer->get_my_client_id();
+        if (map_channel(anValue[1]) != 0)
+            pcServer->set_my_channel_id(map_channel(anValue[1]));
+        break;
+
+    case REC_DEL_CHANNEL:
+        pcServer->remove_channel(map_channel(anValue[0]));
+        break;
+
+    case REC_CHANNEL_MOVE:
+        pcServer->move_channel(map_channel(anValue[0]), map_channel(anValue[1]));
+        break;
+
+    case REC_NEW_CHANNEL:
+    case REC_NEW_CHANNEL_CREATED:
+        if (map_channel(anValue[0]) == 0)
+        {
+            uint64 nChannelID = pcServer->add_channel(map_channel(anValue[1]), std::string());
+            if (nChannelID != 0)
+                this->m_mChannel[anValue[0]] = nChannelID;
+        }
+        break;
+
+    case REC_CLIENT_MOVE:
+    case REC_CLIENT_SUBSCRIPTION:
+    case REC_CLIENT_TIMEOUT:
+    case REC_CLIENT_MOVED:
+        if (anValue[0] == this->m_nRecMyClientID)
+        {
+            if (map_channel(anValue[2]) != 0)
+                pcServer->move_client(pcServer->get_my_client_id(), map_channel(anValue[2]));
+        }
+        else if (anValue[2] == 0)
+            pcServer->remove_client(map_client(anValue[0]));
+        else if (pcServer->find_client(map_client(anValue[0])) != nullptr)
+            pcServer->move_client(map_client(anValue[0]), map_channel(anValue[2]));
+        else
+            add_client(anValue[0], anValue[2], std::string(), std::string());
+        break;
+
+    default:
+        break;
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* send callback to the plugin and measure its CPU time
+*/
+void event_replay::dispatch(const rec_event& cEvent)
+{
+    ts3_server_sim *pcServer = this->m_cClient.get_server();
+    uint64 nServerID = pcServer->get_server_id();
+    const uint64_t *anValue = cEvent.aValue;
+
+    size_t nApiCalls = pcServer->m_nApiCalls;
+    double dStart = thread_cpu_us();
+    switch (cEvent.eType)
+    {
+    case REC_CONNECT_STATUS:      ts3plugin_onConnectStatusChangeEvent(nServerID, (int)anValue[0], (unsigned int)anValue[1]); break;
+    case REC_NEW_CHANNEL:         ts3plugin_onNewChannelEvent(nServerID, map_channel(anValue[0]), map_channel(anValue[1])); break;
+    case REC_NEW_CHANNEL_CREATED: ts3plugin_onNewChannelCreatedEvent(nServerID, map_channel(anValue[0]), map_channel(anValue[1]), map_client(anValue[2]), "", ""); break;
+    case REC_DEL_CHANNEL:         ts3plugin_onDelChannelEvent(nServerID, map_channel(anValue[0]), map_client(anValue[1]), "", ""); break;
+    case REC_CHANNEL_MOVE:        ts3plugin_onChannelMoveEvent(nServerID, map_channel(anValue[0]), map_channel(anValue[1]), map_client(anValue[2]), "", ""); break;
+    case REC_CHANNEL_EDITED:      ts3plugin_onUpdateChannelEditedEvent(nServerID, map_channel(anValue[0]), map_client(anValue[1]), "", ""); break;
+    case REC_UPDATE_CLIENT:       ts3plugin_onUpdateClientEvent(nServerID, map_client(anValue[0]), map_client(anValue[1]), "", ""); break;
+    case REC_CLIENT_MOVE:         ts3plugin_onClientMoveEvent(nServerID, map_client(anValue[0]), map_channel(anValue[1]), map_channel(anValue[2]), (int)anValue[3], ""); break;
+    case REC_CLIENT_SUBSCRIPTION: ts3plugin_onClientMoveSubscriptionEvent(nServerID, map_client(anValue[0]), map_channel(anValue[1]), map_channel(anValue[2]), (int)anValue[3]); break;
+    case REC_CLIENT_TIMEOUT:      ts3plugin_onClientMoveTimeoutEvent(nServerID, map_client(anValue[0]), map_channel(anValue[1]), map_channel(anValue[2]), (int)anValue[3], ""); break;
+    case REC_CLIENT_MOVED:        ts3plugin_onClientMoveMovedEvent(nServerID, map_client(anValue[0]), map_channel(anValue[1]), map_channel(anValue[2]), (int)anValue[3], map_client(anValue[4]), "", "", ""); break;
+    case REC_TALK_STATUS:         ts3plugin_onTalkStatusChangeEvent(nServerID, (int)anValue[0], (int)anValue[1], map_client(anValue[2])); break;
+    case REC_MENU_ITEM:
+        {
+            // selected item is a channel or a client
+            uint64 nSelectedID = (anValue[0] == PLUGIN_MENU_TYPE_CHANNEL) ? map_channel(anValue[2]) : (anValue[0] == PLUGIN_MENU_TYPE_CLIENT) ? map_client(anValue[2]) : anValue[2];
+            ts3plugin_onMenuItemEvent(nServerID, (enum PluginMenuType)anValue[0], (int)anValue[1], nSelectedID);
+        }
+        break;
+    case REC_HOTKEY:              ts3plugin_onHotkeyEvent(cEvent.asText[0].c_str()); break;
+    case REC_COMMAND:             ts3plugin_processCommand(nServerID, cEvent.asText[0].c_str()); break;
+    case REC_INFO_DATA:
+        {
+            char *pcData = nullptr;
+            uint64 nID = (anValue[1] == PLUGIN_CHANNEL) ? map_channel(anValue[0]) : (anValue[1] == PLUGIN_CLIENT) ? map_client(anValue[0]) : nServerID;
+            ts3plugin_infoData(nServerID, nID, (enum PluginItemType)anValue[1], &pcData);
+            if (pcData != nullptr)
+                ts3plugin_freeMemory(pcData);
+        }
+        break;
+    default:
+        return;
+    }
+    double dCpu_us = thread_cpu_us() - dStart;
+
+    this->m_avCpu_us[cEvent.eType].push_back((float)dCpu_us);
+    this->m_anApiCalls[cEvent.eType] += pcServer->m_nApiCalls - nApiCalls;
+
+    if ((this->m_vSlowest.size() < this->m_nNumSlowest) || (!this->m_vSlowest.empty() && (dCpu_us > this->m_vSlowest.back().dCpu_us)))
+    {
+        slow_event cSlow = { dCpu_us, cEvent };
+        std::vector<slow_event>::iterator it = std::upper_bound(this->m_vSlowest.begin(), this->m_vSlowest.end(), cSlow,
+            [](const slow_event& a, const slow_event& b) { return a.dCpu_us > b.dCpu_us; });
+        this->m_vSlowest.insert(it, cSlow);
+        if (this->m_vSlowest.size() > this->m_nNumSlowest)
+            this->m_vSlowest.pop_back();
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* CPU time per callback type and the slowest callbacks
+*/
+void event_replay::report(FILE *pFile)
+{
+    fprintf(pFile, "%s: %zu records, %zu of other servers skipped, recorded %.1f s, replayed in %.3f s%s\n\n",
+        this->m_sFileName.c_str(), this->m_nNumRecords, this->m_nNumSkipped, (double)this->m_nRecDuration_us / 1e6, this->m_dReplayDuration_s,
+        this->m_bAsync ? " (async, enqueue only)" : "");
+    fprintf(pFile, "%-24s %9s %11s %9s %9s %9s %9s %9s %10s\n", "callback (cpu time)", "count", "total ms", "mean us", "p50 us", "p90 us", "p99 us", "max us", "TS3 calls");
+
+    for (int ii = REC_CONNECT_STATUS; ii < REC_TYPE_END; ii++)
+    {
+        std::vector<float>& vCpu_us = this->m_avCpu_us[ii];
+        if (vCpu_us.empty())
+            continue;
+        std::vector<float> vSorted = vCpu_us;
+        std::sort(vSorted.begin(), vSorted.end());
+        double dTotal = 0.0;
+        for (float fCpu_us : vSorted)
+            dTotal += fCpu_us;
+
+        fprintf(pFile, "%-24s %9zu %11.2f %9.1f %9.1f %9.1f %9.1f %9.1f %10.1f\n", rec_type_name((eRecType)ii), vSorted.size(), dTotal / 1e3,
+            dTotal / (double)vSorted.size(), percentile(vSorted, 50), percentile(vSorted, 90), percentile(vSorted, 99), (double)vSorted.back(),
+            (double)this->m_anApiCalls[ii] / (double)vSorted.size());
+    }
+
+    if (this->m_vSlowest.empty())
+        return;
+    fprintf(pFile, "\nslowest callbacks (recorded IDs):\n");
+    for (const slow_event& cSlow : this->m_vSlowest)
+    {
+        const rec_event& cEvent = cSlow.cEvent;
+        fprintf(pFile, "  %10.3f s  %9.1f us  %-24s", (double)cEvent.nTime_us / 1e6, cSlow.dCpu_us, rec_type_name(cEvent.eType));
+        for (size_t jj = 0; jj < rec_num_values(cEvent.eType); jj++)
+            fprintf(pFile, " %llu", (unsigned long long)cEvent.aValue[jj]);
+        for (size_t jj = 0; jj < rec_num_texts(cEvent.eType); jj++)
+            fprintf(pFile, " \"%s\"", cEvent.asText[jj].c_str());
+        fprintf(pFile, "\n");
+    }
+}
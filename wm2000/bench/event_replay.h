@@ -0,0 +1,72 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include "bench/ts3_client_sim.h"
+#include "misc/event_recorder.h"
+
+/* ----------------------------------------------------------------------------
+* replays a log of event_recorder on the simulated client (headless build)
+*
+* the server is rebuilt from the state records of the log, recorded IDs are
+* mapped to the IDs of the simulated server. Every callback is sent to the
+* plugin like in the recording and its CPU time (thread time) is measured.
+* Only one server of the log is replayed (first one, or see set_server).
+* By default the plugin processes every event in the callback, with set_async
+* the events are queued for its work pool and only the enqueue is measured.
+*/
+class event_replay
+{
+public:
+    event_replay();
+    ~event_replay();
+
+    void                set_plugin_path(const std::string& sPluginPath) { this->m_sPluginPath = sPluginPath; };
+    void                set_server(uint64 nServerID) { this->m_nRecServerID = nServerID; };
+    void                set_num_slowest(size_t nNumSlowest) { this->m_nNumSlowest = nNumSlowest; };
+    void                set_async(bool bAsync) { this->m_bAsync = bAsync; };
+
+    bool                run(const std::string& sFileName, bool bRealtime);
+    void                report(FILE *pFile);
+
+protected:
+    bool                load_plugin(const std::string& sConfig);
+    void                apply_state(const rec_event& cEvent);
+    void                dispatch(const rec_event& cEvent);
+
+    uint64              map_channel(uint64 nRecChannelID);
+    anyID               map_client(uint64 nRecClientID);
+    anyID               add_client(uint64 nRecClientID, uint64 nRecChannelID, const std::string& sName, const std::string& sMetaData);
+
+private:
+    struct slow_event
+    {
+        double          dCpu_us;
+        rec_event       cEvent;
+    };
+
+    ts3_client_sim      m_cClient;
+    std::string         m_sPluginPath;
+    std::string         m_sFileName;
+    uint64              m_nRecServerID;         // server of the log to replay, 0 => first one
+    uint64              m_nRecMyClientID;
+    bool                m_bLoaded;
+    bool                m_bConnected;           // connect sent by replay after a snapshot
+    bool                m_bAsync;               // plugin uses its work pool
+
+    std::map<uint64, uint64>    m_mChannel;     // recorded => simulated channel ID
+    std::map<uint64, anyID>     m_mClient;      // recorded => simulated client ID
+
+    // statistics
+    std::vector<float>          m_avCpu_us[REC_TYPE_END];      // per callback type
+    size_t                      m_anApiCalls[REC_TYPE_END];
+    std::vector<slow_event>     m_vSlowest;     // sorted, slowest first
+    size_t                      m_nNumSlowest;
+    size_t                      m_nNumRecords;
+    size_t                      m_nNumSkipped;  // other servers
+    uint64_t                    m_nRecDuration_us;
+    double                      m_dReplayDuration_s;
+};
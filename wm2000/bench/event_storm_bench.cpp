@@ -0,0 +1,282 @@
+/* ----------------------------------------------------------------------------
+* callback return latency under an event storm
+*
+* loads the plugin in the simulated client and sends bursts of client moves,
+* meta data changes, talk status changes and hotkeys through the ts3plugin_*
+* interface, once with the events processed in the callbacks (synchronous) and
+* once queued for the work pool of the plugin. The wall time until each
+* callback returns is the time the TS3 client is blocked.
+*
+*   wm2000_storm [--channels=N] [--depth=N] [--clients=N] [--wm-ratio=PCT]
+*                [--freqs=N] [--freq-per-client=N] [--events=N] [--burst=N]
+*                [--gap-us=N] [--seed=N] [--path=DIR] [--limit=STAT:US]
+*
+*   STAT = p50 | p90 | p99 | max, checked for the queued (async) mode
+*   example: wm2000_storm --clients=1000 --burst=500 --limit=p99:20
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+#include <random>
+#include "bench/ts3_client_sim.h"
+#include "teamspeak/public_definitions.h"
+#include "base/plugin.h"
+
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+enum eStormEvent
+{
+    STORM_MOVE = 0,
+    STORM_META,
+    STORM_TALK,
+    STORM_HOTKEY,
+    STORM_MAX
+};
+
+static const char* s_apcEventName[STORM_MAX] = { "move", "meta", "talk", "hotkey" };
+
+struct storm_result
+{
+    double      dMean;
+    double      dP50;
+    double      dP90;
+    double      dP99;
+    double      dMax;
+    size_t      nCount;
+};
+
+struct storm_run
+{
+    storm_result    acEvent[STORM_MAX];
+    storm_result    cAll;
+    double          dStorm_ms;      // first to last callback
+    double          dDrain_ms;      // last callback until all events are processed
+};
+
+/* ----------------------------------------------------------------------------
+* helper
+*/
+static bool get_option(const char* pcArg, const char* pcName, std::string& sValue)
+{
+    size_t nLen = strlen(pcName);
+    if ((strncmp(pcArg, pcName, nLen) != 0) || (pcArg[nLen] != '='))
+        return false;
+    sValue = pcArg + nLen + 1;
+    return true;
+}
+
+static storm_result evaluate(std::vector<double>& vLatency)
+{
+    storm_result cResult = {};
+    if (vLatency.empty())
+        return cResult;
+
+    std::sort(vLatency.begin(), vLatency.end());
+    for (double dValue : vLatency)
+        cResult.dMean += dValue;
+    cResult.dMean   /= vLatency.size();
+    cResult.dP50    = vLatency[(vLatency.size() - 1) * 50 / 100];
+    cResult.dP90    = vLatency[(vLatency.size() - 1) * 90 / 100];
+    cResult.dP99    = vLatency[(vLatency.size() - 1) * 99 / 100];
+    cResult.dMax    = vLatency.back();
+    cResult.nCount  = vLatency.size();
+    return cResult;
+}
+
+static double get_stat(const storm_result& cResult, const std::string& sStat)
+{
+    if (sStat == "p50") return cResult.dP50;
+    if (sStat == "p90") return cResult.dP90;
+    if (sStat == "p99") return cResult.dP99;
+    if (sStat == "max") return cResult.dMax;
+    return -1.0;
+}
+
+/* ----------------------------------------------------------------------------
+* one storm, same seed => same events in both modes
+*/
+static storm_run run_storm(const sim_server_param& cParam, const std::string& sPath, bool bAsync, int iNumEvents, int iBurst, int iGap_us)
+{
+    ts3_client_sim cClient;
+    cClient.create_server(cParam);
+    cClient.set_plugin_path(sPath);
+    cClient.set_config("general.MaxNumProfiles", "2");
+    cClient.set_config("profile.profile1.ProfileType", "level");
+    cClient.set_config("profile.profile1.MinChLevel", "1");
+    cClient.set_config("profile.profile1.MaxChLevel", "2");
+    cClient.set_config("profile.profile1.AutoActivate", "true");
+    cClient.set_config("profile.profile2.ProfileType", "frequency");
+    cClient.set_config("profile.profile2.ActiveFreq", "1");
+    cClient.set_config("profile.profile2.AutoActivate", "true");
+
+    wm2000_set_synchronous_events(bAsync ? 0 : 1);
+    cClient.load();
+    cClient.connect();
+    wm2000_flush_events();
+
+    ts3_server_sim *pcServer = cClient.get_server();
+    uint64 nServerID = pcServer->get_server_id();
+    const std::vector<sim_channel>& vChannel = pcServer->get_channels();
+    const std::vector<sim_client>& vClient = pcServer->get_clients();
+
+    std::mt19937 cRandom(cParam.nSeed);
+    std::vector<double> avLatency[STORM_MAX];
+    std::vector<double> vAll;
+    std::chrono::steady_clock::time_point tStorm = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point tLast = tStorm;
+    for (int ii = 0; (ii < iNumEvents) && !vClient.empty() && !vChannel.empty(); ii++)
+    {
+        if ((iBurst > 0) && (ii > 0) && ((ii % iBurst) == 0))
+            std::this_thread::sleep_for(std::chrono::microseconds(iGap_us));
+
+        // mostly moves like a mass move, some meta data / talk changes and hotkeys
+        unsigned nKind = cRandom() % 100;
+        int iEvent = (nKind < 70) ? STORM_MOVE : (nKind < 85) ? STORM_META : (nKind < 98) ? STORM_TALK : STORM_HOTKEY;
+        anyID nClientID = vClient[cRandom() % vClient.size()].nClientID;
+        uint64 nChannelID = vChannel[cRandom() % vChannel.size()].nChannelID;
+        std::string sMetaData = "#WhisperMaster2000[" + std::to_string(1 + cRandom() % (cParam.iNumFreq > 0 ? cParam.iNumFreq : 1)) + ",];";
+        int iTalk = (int)(cRandom() % 2);
+        const char* pcKeyword = (cRandom() % 2) ? "profile_1" : "profile_2";
+
+        // server changes before the callback, not part of the latency
+        uint64 nOldChannelID = 0;
+        if (iEvent == STORM_MOVE)
+        {
+            nOldChannelID = pcServer->find_client(nClientID)->nChannelID;
+            pcServer->move_client(nClientID, nChannelID);
+        }
+        else if (iEvent == STORM_META)
+            pcServer->set_meta_data(nClientID, sMetaData);
+
+        std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+        switch (iEvent)
+        {
+        case STORM_MOVE:    ts3plugin_onClientMoveEvent(nServerID, nClientID, nOldChannelID, nChannelID, RETAIN_VISIBILITY, ""); break;
+        case STORM_META:    ts3plugin_onUpdateClientEvent(nServerID, nClientID, nClientID, "", ""); break;
+        case STORM_TALK:    ts3plugin_onTalkStatusChangeEvent(nServerID, iTalk ? STATUS_TALKING : STATUS_NOT_TALKING, 0, nClientID); break;
+        case STORM_HOTKEY:  ts3plugin_onHotkeyEvent(pcKeyword); break;
+        default:            break;
+        }
+        tLast = std::chrono::steady_clock::now();
+
+        double dLatency = std::chrono::duration<double, std::micro>(tLast - tStart).count();
+        avLatency[iEvent].push_back(dLatency);
+        vAll.push_back(dLatency);
+    }
+    wm2000_flush_events();
+    std::chrono::steady_clock::time_point tDrained = std::chrono::steady_clock::now();
+
+    storm_run cRun;
+    for (int ii = 0; ii < STORM_MAX; ii++)
+        cRun.acEvent[ii] = evaluate(avLatency[ii]);
+    cRun.cAll       = evaluate(vAll);
+    cRun.dStorm_ms  = std::chrono::duration<double, std::milli>(tLast - tStorm).count();
+    cRun.dDrain_ms  = std::chrono::duration<double, std::milli>(tDrained - tLast).count();
+
+    cClient.disconnect();
+    cClient.unload();
+    return cRun;
+}
+
+static void print_run(const char* pcMode, const storm_run& cRun)
+{
+    for (int ii = 0; ii < STORM_MAX; ii++)
+    {
+        const storm_result& cResult = cRun.acEvent[ii];
+        fprintf(stderr, "%-6s %-8s %8zu %10.1f %10.1f %10.1f %10.1f %10.1f\n", pcMode, s_apcEventName[ii],
+            cResult.nCount, cResult.dMean, cResult.dP50, cResult.dP90, cResult.dP99, cResult.dMax);
+    }
+    fprintf(stderr, "%-6s %-8s %8zu %10.1f %10.1f %10.1f %10.1f %10.1f   storm %.1f ms, drain %.1f ms\n", pcMode, "all",
+        cRun.cAll.nCount, cRun.cAll.dMean, cRun.cAll.dP50, cRun.cAll.dP90, cRun.cAll.dP99, cRun.cAll.dMax, cRun.dStorm_ms, cRun.dDrain_ms);
+}
+
+/* ----------------------------------------------------------------------------
+* main
+*/
+int main(int argc, char* argv[])
+{
+    sim_server_param cParam;
+    cParam.iNumChannel      = 500;
+    cParam.iMaxDepth        = 4;
+    cParam.iNumClient       = 200;
+    cParam.iWmClientRatio   = 50;
+    cParam.iNumFreq         = 20;
+    cParam.iFreqPerClient   = 3;
+    cParam.nSeed            = 1;
+
+    int iNumEvents  = 20000;
+    int iBurst      = 500;
+    int iGap_us     = 20000;
+    std::string sPath = "wm2000_storm_plugin/";
+    std::vector<std::pair<std::string, double>> vLimit;
+
+    // read command line
+    for (int ii = 1; ii < argc; ii++)
+    {
+        std::string sValue;
+        if      (get_option(argv[ii], "--channels", sValue))        cParam.iNumChannel      = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--depth", sValue))           cParam.iMaxDepth        = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--clients", sValue))         cParam.iNumClient       = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--wm-ratio", sValue))        cParam.iWmClientRatio   = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--freqs", sValue))           cParam.iNumFreq         = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--freq-per-client", sValue)) cParam.iFreqPerClient   = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--seed", sValue))            cParam.nSeed            = (unsigned)atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--events", sValue))          iNumEvents              = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--burst", sValue))           iBurst                  = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--gap-us", sValue))          iGap_us                 = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--path", sValue))            sPath                   = sValue;
+        else if (get_option(argv[ii], "--limit", sValue))
+        {
+            // STAT:US
+            size_t nPos = sValue.find(':');
+            std::string sStat = sValue.substr(0, nPos);
+            if ((nPos == std::string::npos) || (get_stat(storm_result(), sStat) < 0))
+            {
+                fprintf(stderr, "invalid limit \"%s\", use STAT:US\n", sValue.c_str());
+                return 2;
+            }
+            vLimit.push_back(std::make_pair(sStat, atof(sValue.c_str() + nPos + 1)));
+        }
+        else
+        {
+            fprintf(stderr, "unknown option \"%s\"\n", argv[ii]);
+            return 2;
+        }
+    }
+
+    // the plugin prints debug output to stdout, keep it out of the measurement
+    fflush(stdout);
+    if (freopen(NULL_DEVICE, "w", stdout) == nullptr)
+        fprintf(stderr, "stdout could not be redirected, debug output is part of the measurement\n");
+
+    storm_run cSync  = run_storm(cParam, sPath, false, iNumEvents, iBurst, iGap_us);
+    storm_run cAsync = run_storm(cParam, sPath, true, iNumEvents, iBurst, iGap_us);
+
+    // report
+    fprintf(stderr, "server: %d channels, depth %d, %d clients (%d%% WhisperMaster), %d events in bursts of %d, %d us gap\n",
+        cParam.iNumChannel, cParam.iMaxDepth, cParam.iNumClient, cParam.iWmClientRatio, iNumEvents, iBurst, iGap_us);
+    fprintf(stderr, "%-6s %-8s %8s %10s %10s %10s %10s %10s\n", "mode", "event", "count", "mean[us]", "p50[us]", "p90[us]", "p99[us]", "max[us]");
+    print_run("sync", cSync);
+    print_run("async", cAsync);
+
+    // check limits (queued mode, all callbacks)
+    int iResult = 0;
+    for (const std::pair<std::string, double>& cLimit : vLimit)
+    {
+        double dValue = get_stat(cAsync.cAll, cLimit.first);
+        bool bFailed = dValue > cLimit.second;
+        fprintf(stderr, "%s async:%s = %.1f us (limit %.1f us)\n", bFailed ? "FAIL" : "ok  ", cLimit.first.c_str(), dValue, cLimit.second);
+        if (bFailed)
+            iResult = 1;
+    }
+    return iResult;
+}
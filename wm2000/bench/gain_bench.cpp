@@ -0,0 +1,206 @@
+/* ----------------------------------------------------------------------------
+* playback voice processing benchmark
+*
+* checks every gain kernel the CPU supports against the scalar reference and
+* prints the time per 20 ms frame of 48 kHz PCM (the TS3 playback format) for
+* a constant gain and for a ramp, and for the radio effect on full scale
+* noise and on silence (mono and stereo). The exit code is 1 if a kernel
+* differs from the reference or the radio effect exceeds its budget per frame.
+* --check only compares the kernels (no timing, used by ctest).
+*
+*   wm2000_gain_bench [--check] [--iterations=N] [--seed=N] [--radio-budget=US]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "misc/gain_kernel.h"
+#include "misc/radio_effect.h"
+
+#define FRAME_SAMPLES   (960 * 2)   // 20 ms, 48 kHz, stereo
+#define RADIO_BUDGET_US 25.0        // radio effect per talker and frame (0.125 % of a core)
+
+/* ----------------------------------------------------------------------------
+* helper
+*/
+static bool get_option(const char* pcArg, const char* pcName, std::string& sValue)
+{
+    size_t nLen = strlen(pcName);
+    if ((strncmp(pcArg, pcName, nLen) != 0) || (pcArg[nLen] != '='))
+        return false;
+    sValue = pcArg + nLen + 1;
+    return true;
+}
+
+static bool verify(eGainKernel eKernel, std::mt19937& cRandom)
+{
+    std::uniform_int_distribution<int> cSample(-32768, 32767);
+    std::uniform_int_distribution<int> cGain(0, 32767);
+    std::uniform_int_distribution<int> cLength(0, FRAME_SAMPLES + 63);
+
+    std::vector<short> vInput(FRAME_SAMPLES + 64);
+    std::vector<short> vReference;
+    std::vector<short> vResult;
+    for (int ii = 0; ii < 2000; ii++)
+    {
+        size_t nSamples = (size_t)cLength(cRandom);
+        for (size_t jj = 0; jj < nSamples; jj++)
+            vInput[jj] = (short)cSample(cRandom);
+
+        // every 4th run constant, gains above GAIN_UNITY saturate
+        int iStartGain = cGain(cRandom);
+        int iEndGain = ((ii % 4) == 0) ? iStartGain : cGain(cRandom);
+
+        vReference.assign(vInput.begin(), vInput.begin() + nSamples);
+        vResult.assign(vInput.begin(), vInput.begin() + nSamples);
+        gain_kernel::apply(GAIN_KERNEL_SCALAR, vReference.data(), nSamples, iStartGain, iEndGain);
+        gain_kernel::apply(eKernel, vResult.data(), nSamples, iStartGain, iEndGain);
+        if (vReference != vResult)
+        {
+            fprintf(stderr, "%s differs from scalar: %u samples, gain %d -> %d\n",
+                gain_kernel::get_name(eKernel), (unsigned)nSamples, iStartGain, iEndGain);
+            return false;
+        }
+    }
+    return true;
+}
+
+static double measure(eGainKernel eKernel, const std::vector<short>& vInput, int iIterations, int iStartGain, int iEndGain)
+{
+    std::vector<short> vFrame(vInput);
+    auto tStart = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < iIterations; ii++)
+    {
+        // restore input every 64 frames so the samples do not decay to 0
+        if ((ii & 63) == 0)
+            memcpy(vFrame.data(), vInput.data(), vInput.size() * sizeof(short));
+        gain_kernel::apply(eKernel, vFrame.data(), vFrame.size(), iStartGain, iEndGain);
+    }
+    auto tEnd = std::chrono::steady_clock::now();
+
+    // keep the result alive
+    volatile short sSink = vFrame[vFrame.size() / 2];
+    (void)sSink;
+    return std::chrono::duration<double, std::nano>(tEnd - tStart).count() / iIterations;
+}
+
+static double measure_radio(const std::vector<short>& vInput, int iChannels, int iIterations)
+{
+    radio_effect cRadio;
+    radio_state cState;
+    radio_effect::reset(cState, 1);
+
+    // the effect is not idempotent, every frame starts from the input
+    std::vector<short> vFrame(vInput.size());
+    int iSampleCount = (int)vInput.size() / iChannels;
+    auto tStart = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < iIterations; ii++)
+    {
+        memcpy(vFrame.data(), vInput.data(), vInput.size() * sizeof(short));
+        cRadio.process(cState, vFrame.data(), iSampleCount, iChannels);
+    }
+    auto tEnd = std::chrono::steady_clock::now();
+
+    volatile short sSink = vFrame[vFrame.size() / 2];
+    (void)sSink;
+    return std::chrono::duration<double, std::nano>(tEnd - tStart).count() / iIterations;
+}
+
+/* ----------------------------------------------------------------------------
+* main
+*/
+int main(int argc, char* argv[])
+{
+    int         iIterations = 200000;
+    unsigned    nSeed       = 1;
+    double      dRadioBudget= RADIO_BUDGET_US;
+    bool        bCheckOnly  = false;
+
+    // read command line
+    for (int ii = 1; ii < argc; ii++)
+    {
+        std::string sValue;
+        if      (strcmp(argv[ii], "--check") == 0)              bCheckOnly  = true;
+        else if (get_option(argv[ii], "--iterations", sValue))  iIterations = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--seed", sValue))        nSeed       = (unsigned)atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--radio-budget", sValue)) dRadioBudget = atof(sValue.c_str());
+        else
+        {
+            fprintf(stderr, "unknown option \"%s\"\n", argv[ii]);
+            return 2;
+        }
+    }
+    if (iIterations < 1)
+        iIterations = 1;
+
+    std::mt19937 cRandom(nSeed);
+    std::uniform_int_distribution<int> cSample(-32768, 32767);
+    std::vector<short> vInput(FRAME_SAMPLES);
+    for (short& sSample : vInput)
+        sSample = (short)cSample(cRandom);
+
+    printf("selected kernel: %s\n", gain_kernel::get_name(gain_kernel::get_kernel()));
+    if (bCheckOnly)
+    {
+        int iFailed = 0;
+        for (int ii = 0; ii < GAIN_KERNEL_MAX; ii++)
+        {
+            eGainKernel eKernel = (eGainKernel)ii;
+            bool bSupported = gain_kernel::is_supported(eKernel);
+            bool bOk = !bSupported || verify(eKernel, cRandom);
+            printf("%s  %-8s %s\n", bOk ? "ok    " : "FAILED", gain_kernel::get_name(eKernel), bSupported ? "same as scalar" : "not supported");
+            iFailed += bOk ? 0 : 1;
+        }
+        fprintf(stderr, "%s: %d failed\n", iFailed ? "FAILED" : "passed", iFailed);
+        return iFailed ? 1 : 0;
+    }
+
+    printf("%-8s %-8s %12s %12s %12s\n", "kernel", "gain", "ns/frame", "Msamples/s", "x realtime");
+
+    int iExitCode = 0;
+    for (int ii = 0; ii < GAIN_KERNEL_MAX; ii++)
+    {
+        eGainKernel eKernel = (eGainKernel)ii;
+        if (!gain_kernel::is_supported(eKernel))
+        {
+            printf("%-8s not supported\n", gain_kernel::get_name(eKernel));
+            continue;
+        }
+        if (!verify(eKernel, cRandom))
+            iExitCode = 1;
+
+        const char* apcName[2] = { "constant", "ramp" };
+        const int aiEndGain[2] = { GAIN_UNITY / 4, GAIN_UNITY };
+        for (int jj = 0; jj < 2; jj++)
+        {
+            double dNs = measure(eKernel, vInput, iIterations, GAIN_UNITY / 4, aiEndGain[jj]);
+            printf("%-8s %-8s %12.1f %12.1f %12.0f\n", gain_kernel::get_name(eKernel), apcName[jj],
+                dNs, FRAME_SAMPLES / dNs * 1000.0, 20.0e6 / dNs);
+        }
+    }
+
+    // radio effect, the iterations copy the frame first
+    int iRadioIterations = std::max(1, iIterations / 10);
+    std::vector<short> vSilence(FRAME_SAMPLES, 0);
+    printf("\n%-8s %-8s %12s %12s %12s   budget %.1f us\n", "radio", "input", "ns/frame", "Msamples/s", "x realtime", dRadioBudget);
+    for (int iChannels = 1; iChannels <= 2; iChannels++)
+    {
+        const char* apcName[2] = { "noise", "silence" };
+        const std::vector<short>* apvInput[2] = { &vInput, &vSilence };
+        for (int jj = 0; jj < 2; jj++)
+        {
+            std::vector<short> vFrame(apvInput[jj]->begin(), apvInput[jj]->begin() + 960 * iChannels);
+            double dNs = measure_radio(vFrame, iChannels, iRadioIterations);
+            bool bOver = dNs > dRadioBudget * 1000.0;
+            printf("%-8s %-8s %12.1f %12.1f %12.0f%s\n", (iChannels == 1) ? "mono" : "stereo", apcName[jj],
+                dNs, vFrame.size() / dNs * 1000.0, 20.0e6 / dNs, bOver ? "   over budget" : "");
+            if (bOver)
+                iExitCode = 1;
+        }
+    }
+    return iExitCode;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <string>
+#include "misc/config_container.h"
+#include "misc/channel_filter.h"
+#include "misc/client_filter.h"
+#include "misc/work_pool.h"
+#include "misc/talk_tracker.h"
+
+/* ----------------------------------------------------------------------------
+* replaces wm2000_main_ui_actions in the headless build (WM2000_HEADLESS)
+*
+* same interface as used by plugin_base, no window. Like the real UI it loads
+* config.xml from the config path (default settings, if the file is missing).
+*/
+class wm2000_main_ui_actions
+{
+public:
+    wm2000_main_ui_actions(config_container *pcConfigData, void(*fUpdate_server)(), std::string sConfigPath, void *parent = nullptr)
+    {
+        this->m_bVisible = false;
+        pcConfigData->set_file_path(sConfigPath + std::string("config.xml"));
+        pcConfigData->s_read_param();
+    };
+    ~wm2000_main_ui_actions() { };
+
+    void update_config() { };
+    void request_update_ui() { };
+    void add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker) { };
+    void delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker) { };
+    void set_work_pool(work_pool *pcWorkPool) { };
+    void update_box_size() { };
+    void open_about_ui() { };
+    void open_freq_ui() { };
+
+    bool isVisible() { return this->m_bVisible; };
+    void show() { this->m_bVisible = true; };
+    bool close() { this->m_bVisible = false; return true; };
+    void raise() { };
+    void activateWindow() { };
+
+private:
+    bool m_bVisible;
+};
@@ -0,0 +1,346 @@
+/* ----------------------------------------------------------------------------
+* hotkey => whisper list latency benchmark
+*
+* drives plugin_handler::onHotkeyEvent against a simulated server and prints
+* the latency distribution per profile type. print_all_lists ("show all lists")
+* is timed with favorite profiles that list all channels, after a channel
+* change, after an update of another client and unchanged. Limits given on the command line are checked, the exit
+* code is 1 if one of them is exceeded.
+*
+*   wm2000_bench [--channels=N] [--depth=N] [--clients=N] [--wm-ratio=PCT]
+*                [--freqs=N] [--freq-per-client=N] [--favorites=N] [--ignored=N]
+*                [--iterations=N] [--seed=N] [--list-profiles=N]
+*                [--list-iterations=N] [--limit=TYPE:STAT:US ...]
+*
+*   TYPE = level | favorite | frequency | lists, STAT = p50 | p90 | p99 | max
+*   (the limit of lists is checked after a channel change)
+*   example: wm2000_bench --channels=2000 --limit=favorite:p99:500
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <random>
+#include "bench/ts3_server_sim.h"
+#include "base/plugin_handler.h"
+#include "misc/hotkey_table.h"
+
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+#define BENCH_CONFIG_FILE "wm2000_bench_config.xml"
+
+enum eBenchProfile
+{
+    BENCH_LEVEL = 0,
+    BENCH_FAVORITE,
+    BENCH_FREQUENCY,
+    BENCH_MAX,
+    BENCH_LISTS = BENCH_MAX         // print_all_lists, limits only
+};
+
+static const char* s_apcProfileName[BENCH_LISTS + 1] = { "level", "favorite", "frequency", "lists" };
+
+struct bench_limit
+{
+    int         iProfile;
+    std::string sStat;
+    double      dMaxUs;
+};
+
+struct bench_result
+{
+    double      dMean;
+    double      dP50;
+    double      dP90;
+    double      dP99;
+    double      dMax;
+    double      dApiCalls;          // TS3 calls per event
+};
+
+/* ----------------------------------------------------------------------------
+* helper
+*/
+static bool get_option(const char* pcArg, const char* pcName, std::string& sValue)
+{
+    size_t nLen = strlen(pcName);
+    if ((strncmp(pcArg, pcName, nLen) != 0) || (pcArg[nLen] != '='))
+        return false;
+    sValue = pcArg + nLen + 1;
+    return true;
+}
+
+static bench_result evaluate(std::vector<double>& vLatency, size_t nApiCalls)
+{
+    bench_result cResult = {};
+    if (vLatency.empty())
+        return cResult;
+
+    std::sort(vLatency.begin(), vLatency.end());
+    for (double dValue : vLatency)
+        cResult.dMean += dValue;
+    cResult.dMean       /= vLatency.size();
+    cResult.dP50        = vLatency[(vLatency.size() - 1) * 50 / 100];
+    cResult.dP90        = vLatency[(vLatency.size() - 1) * 90 / 100];
+    cResult.dP99        = vLatency[(vLatency.size() - 1) * 99 / 100];
+    cResult.dMax        = vLatency.back();
+    cResult.dApiCalls   = (double)nApiCalls / vLatency.size();
+    return cResult;
+}
+
+static double get_stat(const bench_result& cResult, const std::string& sStat)
+{
+    if (sStat == "p50") return cResult.dP50;
+    if (sStat == "p90") return cResult.dP90;
+    if (sStat == "p99") return cResult.dP99;
+    if (sStat == "max") return cResult.dMax;
+    return -1.0;
+}
+
+/* ----------------------------------------------------------------------------
+* main
+*/
+int main(int argc, char* argv[])
+{
+    sim_server_param cParam;
+    cParam.iNumChannel      = 500;
+    cParam.iMaxDepth        = 4;
+    cParam.iNumClient       = 200;
+    cParam.iWmClientRatio   = 50;
+    cParam.iNumFreq         = 20;
+    cParam.iFreqPerClient   = 3;
+    cParam.nSeed            = 1;
+
+    int iNumFavorites   = 20;
+    int iNumIgnored     = 10;
+    int iIterations     = 1000;
+    int iListProfiles   = REAL_MAXNUMPROFILES;
+    int iListIterations = 20;
+    std::vector<bench_limit> vLimit;
+
+    // read command line
+    for (int ii = 1; ii < argc; ii++)
+    {
+        std::string sValue;
+        if      (get_option(argv[ii], "--channels", sValue))        cParam.iNumChannel      = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--depth", sValue))           cParam.iMaxDepth        = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--clients", sValue))         cParam.iNumClient       = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--wm-ratio", sValue))        cParam.iWmClientRatio   = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--freqs", sValue))           cParam.iNumFreq         = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--freq-per-client", sValue)) cParam.iFreqPerClient   = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--seed", sValue))            cParam.nSeed            = (unsigned)atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--favorites", sValue))       iNumFavorites           = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--ignored", sValue))         iNumIgnored             = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--iterations", sValue))      iIterations             = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--list-profiles", sValue))   iListProfiles           = std::min(atoi(sValue.c_str()), REAL_MAXNUMPROFILES);
+        else if (get_option(argv[ii], "--list-iterations", sValue)) iListIterations         = atoi(sValue.c_str());
+        else if (get_option(argv[ii], "--limit", sValue))
+        {
+            // TYPE:STAT:US
+            size_t nFirst = sValue.find(':');
+            size_t nSecond = (nFirst == std::string::npos) ? std::string::npos : sValue.find(':', nFirst + 1);
+            bench_limit cLimit;
+            cLimit.iProfile = -1;
+            if (nSecond != std::string::npos)
+            {
+                for (int jj = 0; jj <= BENCH_LISTS; jj++)
+                    if (sValue.compare(0, nFirst, s_apcProfileName[jj]) == 0)
+                        cLimit.iProfile = jj;
+                cLimit.sStat = sValue.substr(nFirst + 1, nSecond - nFirst - 1);
+                cLimit.dMaxUs = atof(sValue.c_str() + nSecond + 1);
+            }
+            if ((cLimit.iProfile < 0) || (get_stat(bench_result(), cLimit.sStat) < 0))
+            {
+                fprintf(stderr, "invalid limit \"%s\", use TYPE:STAT:US\n", sValue.c_str());
+                return 2;
+            }
+            vLimit.push_back(cLimit);
+        }
+        else
+        {
+            fprintf(stderr, "unknown option \"%s\"\n", argv[ii]);
+            return 2;
+        }
+    }
+
+    // create server
+    ts3_server_sim cServer;
+    cServer.create(cParam);
+    cServer.activate();
+    struct TS3Functions stFunctions = cServer.get_functions();
+
+    // the plugin prints debug output to stdout, keep it out of the measurement
+    fflush(stdout);
+    if (freopen(NULL_DEVICE, "w", stdout) == nullptr)
+        fprintf(stderr, "stdout could not be redirected, debug output is part of the measurement\n");
+
+    // default config (written once), profiles are set up here
+    config_container cConfig;
+    cConfig.s_read_param(BENCH_CONFIG_FILE);
+    cConfig.s_set_MaxNumProfiles(BENCH_MAX);
+    for (int ii = 0; ii < BENCH_MAX; ii++)
+    {
+        cConfig.s_set_AutoActivate(ii, true);
+        cConfig.s_set_UseIgnoreListTx(ii, false);
+    }
+    cConfig.s_set_ProfileType(BENCH_LEVEL, PROFILE_LEVEL);
+    cConfig.s_set_MinChLevel(BENCH_LEVEL, 1);
+    cConfig.s_set_MaxChLevel(BENCH_LEVEL, cParam.iMaxDepth);
+
+    cConfig.s_set_ProfileType(BENCH_FAVORITE, PROFILE_FAVORITE);
+    cConfig.s_set_UseSubChOfFav(BENCH_FAVORITE, true);
+
+    cConfig.s_set_ProfileType(BENCH_FREQUENCY, PROFILE_FREQUENCY);
+    cConfig.s_set_ActiveFreq(BENCH_FREQUENCY, 1);
+    cConfig.s_set_PrioFreq(BENCH_FREQUENCY, false);
+    cConfig.s_set_UseIgnoreListTx(BENCH_FREQUENCY, true);
+
+    language_pkg cTranslate;
+    char acPluginID[] = "wm2000_bench";
+    plugin_handler *pcHandler = new plugin_handler(cServer.get_server_id(), cServer.get_my_client_id(), &stFunctions, &cConfig, acPluginID, &cTranslate);
+
+    // favorites + ignore list are random channels, stored like the menu does
+    std::mt19937 cRandom(cParam.nSeed);
+    const std::vector<sim_channel>& vChannel = cServer.get_channels();
+    for (int ii = 0; (ii < iNumFavorites) && !vChannel.empty(); ii++)
+        cConfig.s_add_entry(cConfig.s_get_FavoriteList(BENCH_FAVORITE), pcHandler->get_channel_filter()->get_channel_info(vChannel[cRandom() % vChannel.size()].nChannelID));
+    for (int ii = 0; (ii < iNumIgnored) && !vChannel.empty(); ii++)
+        cConfig.s_add_entry(cConfig.s_get_IgnoreList(), pcHandler->get_channel_filter()->get_channel_info(vChannel[cRandom() % vChannel.size()].nChannelID));
+
+    // connect all clients like TS3 does after connecting
+    pcHandler->onUpdateClientEvent(cServer.get_my_client_id(), cServer.get_my_channel_id());
+    for (const sim_client& cClient : cServer.get_clients())
+        pcHandler->onUpdateClientEvent(cClient.nClientID, cClient.nChannelID);
+
+    // measure: press (activate profile) and press again (release profile)
+    hotkey_table cHotkeys;
+    cHotkeys.init(&cConfig);
+
+    bench_result acPress[BENCH_MAX];
+    bench_result acRelease[BENCH_MAX];
+    for (int ii = 0; ii < BENCH_MAX; ii++)
+    {
+        const size_t nBuffSize = 32;
+        char cKeyword[nBuffSize];
+        sprintf_s(cKeyword, nBuffSize, HOTKEY_KEYWORD_PROFILE, ii + 1);
+
+        std::vector<double> vPress, vRelease;
+        size_t nPressCalls = 0, nReleaseCalls = 0;
+        for (int jj = 0; jj < iIterations; jj++)
+        {
+            size_t nCalls = cServer.m_nApiCalls;
+            std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+            pcHandler->onHotkeyEvent(cHotkeys.find(cKeyword));
+            std::chrono::steady_clock::time_point tPressed = std::chrono::steady_clock::now();
+            nPressCalls += cServer.m_nApiCalls - nCalls;
+
+            nCalls = cServer.m_nApiCalls;
+            pcHandler->onHotkeyEvent(cHotkeys.find(cKeyword));
+            std::chrono::steady_clock::time_point tReleased = std::chrono::steady_clock::now();
+            nReleaseCalls += cServer.m_nApiCalls - nCalls;
+
+            vPress.push_back(std::chrono::duration<double, std::micro>(tPressed - tStart).count());
+            vRelease.push_back(std::chrono::duration<double, std::micro>(tReleased - tPressed).count());
+        }
+        acPress[ii]   = evaluate(vPress, nPressCalls);
+        acRelease[ii] = evaluate(vRelease, nReleaseCalls);
+    }
+    delete pcHandler;
+
+    // measure: print_all_lists, every profile lists all top level channels and their sub channels
+    enum { LISTS_CHANGED = 0, LISTS_CLIENT, LISTS_SAME, LISTS_MAX };
+    static const char* apcListsEvent[LISTS_MAX] = { "changed", "client", "same" };
+    bench_result acLists[LISTS_MAX] = {};
+    size_t nListMessages = 0, nListBytes = 0;
+    if ((iListProfiles > 0) && (iListIterations > 0))
+    {
+        config_container cListConfig;
+        cListConfig.s_read_param(BENCH_CONFIG_FILE);
+        cListConfig.s_set_MaxNumProfiles(iListProfiles);
+        for (int ii = 0; ii < iListProfiles; ii++)
+        {
+            cListConfig.s_set_ProfileType(ii, PROFILE_FAVORITE);
+            cListConfig.s_set_UseSubChOfFav(ii, true);
+        }
+        plugin_handler *pcListHandler = new plugin_handler(cServer.get_server_id(), cServer.get_my_client_id(), &stFunctions, &cListConfig, acPluginID, &cTranslate);
+        for (const sim_channel& cChannel : vChannel)
+        {
+            if (cChannel.bDeleted || (cChannel.nParentID != 0))
+                continue;
+            for (int ii = 0; ii < iListProfiles; ii++)
+                cListConfig.s_add_entry(cListConfig.s_get_FavoriteList(ii), pcListHandler->get_channel_filter()->get_channel_info(cChannel.nChannelID));
+        }
+        pcListHandler->onUpdateClientEvent(cServer.get_my_client_id(), cServer.get_my_channel_id());
+        for (const sim_client& cClient : cServer.get_clients())
+            pcListHandler->onUpdateClientEvent(cClient.nClientID, cClient.nChannelID);
+
+        std::vector<double> avLatency[LISTS_MAX];
+        size_t anCalls[LISTS_MAX] = {};
+        for (int jj = 0; jj < iListIterations; jj++)
+        {
+            for (int kk = 0; kk < LISTS_MAX; kk++)
+            {
+                // a channel change rebuilds the lists, updates of other clients and the next print use them unchanged
+                if (kk == LISTS_CHANGED)
+                    pcListHandler->onChannelEvent();
+                else if ((kk == LISTS_CLIENT) && !cServer.get_clients().empty())
+                    pcListHandler->onUpdateClientEvent(cServer.get_clients()[jj % cServer.get_clients().size()].nClientID, cServer.get_clients()[jj % cServer.get_clients().size()].nChannelID);
+
+                size_t nCalls = cServer.m_nApiCalls;
+                size_t nChat = cServer.get_chat().size();
+                std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+                pcListHandler->print_all_lists();
+                std::chrono::steady_clock::time_point tPrinted = std::chrono::steady_clock::now();
+                anCalls[kk] += cServer.m_nApiCalls - nCalls;
+                avLatency[kk].push_back(std::chrono::duration<double, std::micro>(tPrinted - tStart).count());
+
+                nListMessages = cServer.get_chat().size() - nChat;
+                nListBytes = 0;
+                for (size_t nMsg = nChat; nMsg < cServer.get_chat().size(); nMsg++)
+                    nListBytes += cServer.get_chat()[nMsg].size();
+            }
+        }
+        for (int kk = 0; kk < LISTS_MAX; kk++)
+            acLists[kk] = evaluate(avLatency[kk], anCalls[kk]);
+        delete pcListHandler;
+    }
+    remove(BENCH_CONFIG_FILE);
+
+    // report
+    fprintf(stderr, "server: %d channels, depth %d, %d clients (%d%% WhisperMaster, %d freqs, %d per client), %d favorites, %d ignored, %d iterations\n",
+        cParam.iNumChannel, cParam.iMaxDepth, cParam.iNumClient, cParam.iWmClientRatio, cParam.iNumFreq, cParam.iFreqPerClient, iNumFavorites, iNumIgnored, iIterations);
+    fprintf(stderr, "%-10s %-8s %10s %10s %10s %10s %10s %10s\n", "profile", "event", "mean[us]", "p50[us]", "p90[us]", "p99[us]", "max[us]", "TS3 calls");
+    for (int ii = 0; ii < BENCH_MAX; ii++)
+    {
+        fprintf(stderr, "%-10s %-8s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", s_apcProfileName[ii], "press",
+            acPress[ii].dMean, acPress[ii].dP50, acPress[ii].dP90, acPress[ii].dP99, acPress[ii].dMax, acPress[ii].dApiCalls);
+        fprintf(stderr, "%-10s %-8s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", s_apcProfileName[ii], "release",
+            acRelease[ii].dMean, acRelease[ii].dP50, acRelease[ii].dP90, acRelease[ii].dP99, acRelease[ii].dMax, acRelease[ii].dApiCalls);
+    }
+    if ((iListProfiles > 0) && (iListIterations > 0))
+    {
+        for (int kk = 0; kk < LISTS_MAX; kk++)
+            fprintf(stderr, "%-10s %-8s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", s_apcProfileName[BENCH_LISTS], apcListsEvent[kk],
+                acLists[kk].dMean, acLists[kk].dP50, acLists[kk].dP90, acLists[kk].dP99, acLists[kk].dMax, acLists[kk].dApiCalls);
+        fprintf(stderr, "lists: %d profiles, %d iterations, %llu chat messages, %llu bytes per print\n",
+            iListProfiles, iListIterations, (unsigned long long)nListMessages, (unsigned long long)nListBytes);
+    }
+
+    // check limits (press latency)
+    int iResult = 0;
+    for (const bench_limit& cLimit : vLimit)
+    {
+        double dValue = get_stat((cLimit.iProfile == BENCH_LISTS) ? acLists[LISTS_CHANGED] : acPress[cLimit.iProfile], cLimit.sStat);
+        bool bFailed = dValue > cLimit.dMaxUs;
+        fprintf(stderr, "%s %s:%s = %.1f us (limit %.1f us)\n", bFailed ? "FAIL" : "ok  ", s_apcProfileName[cLimit.iProfile], cLimit.sStat.c_str(), dValue, cLimit.dMaxUs);
+        if (bFailed)
+            iResult = 1;
+    }
+    return iResult;
+}
@@ -0,0 +1,87 @@
+/* ----------------------------------------------------------------------------
+* format check of external language packs
+*
+* writes an english pack with texts that expect the same or other arguments
+* than the built-in texts into <dir> and checks which ones language_pkg uses.
+* Unknown ids have to return the id itself. The exit code is 1 if a text with
+* other arguments is used, a matching one is replaced or an unknown id isn't
+* returned.
+*
+*   wm2000_language_test [<dir>]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/stat.h>
+#include "misc/language_pkg.h"
+#include "misc/language_file.h"
+
+#define PACK_ENTRY(key, en, bUsed) { { lang_hash(key), key, { en, nullptr } }, bUsed }
+
+struct pack_case
+{
+    lang_entry  cEntry;
+    bool        bUsed;              // text of the pack is expected, otherwise the built-in one
+};
+
+static const pack_case s_acCase[] =
+{
+    PACK_ENTRY("ctUi_treeItemStateWhisper",  u8"Whisper (100%%)",                   true),
+    PACK_ENTRY("hotkey_ErrActivate2",        u8"PTT flush failed [%x]",             true),
+    PACK_ENTRY("info_ActFreq",               u8"%d: %u / %u, %u:%02u min, %u s",    true),
+    PACK_ENTRY("test1",                      u8"Test %s",                           false),
+    PACK_ENTRY("ErrUnknown",                 u8"Error in %s (%s)",                  false),
+    PACK_ENTRY("ErrExtMessageBox",           u8"Errors in the last session%n",      false),
+    PACK_ENTRY("ErrStdUnknown",              u8"std::exception in %*s (%s)",        false),
+    PACK_ENTRY("ctUi_treeItemStateTalkTime", u8"%1 talking, %3:%4 min",             false),
+};
+
+int main(int argc, char* argv[])
+{
+    std::string sPath = (argc > 1) ? std::string(argv[1]) : std::string("language_test");
+    sPath += "/";
+    mkdir(sPath.c_str(), 0755);
+
+    const size_t nNumCase = sizeof(s_acCase) / sizeof(s_acCase[0]);
+    lang_entry acTable[nNumCase];
+    for (size_t ii = 0; ii < nNumCase; ii++)
+        acTable[ii] = s_acCase[ii].cEntry;
+    if (!language_file::write(sPath + "lang_en.wmlp", "en", acTable, nNumCase, LANGUAGE_EN))
+    {
+        fprintf(stderr, "%slang_en.wmlp: can't write language pack\n", sPath.c_str());
+        return 1;
+    }
+
+    language_pkg::set_language_path(sPath);
+    language_pkg cTranslate;
+    cTranslate.set_language("english");
+
+    int iFailed = 0;
+    for (size_t ii = 0; ii < nNumCase; ii++)
+    {
+        const lang_entry& cEntry = s_acCase[ii].cEntry;
+        const char* sText = cTranslate.translate(cEntry.sKey);
+        bool bUsed = (strcmp(sText, cEntry.asText[LANGUAGE_EN]) == 0);
+        if (bUsed != s_acCase[ii].bUsed)
+        {
+            printf("FAILED  %-28s %s \"%s\"\n", cEntry.sKey, bUsed ? "used" : "replaced", cEntry.asText[LANGUAGE_EN]);
+            iFailed++;
+        }
+        else
+            printf("ok      %-28s %s\n", cEntry.sKey, bUsed ? "used" : "replaced");
+    }
+
+    // unknown ids return the id itself, narrow and wide
+    const wchar_t* const apwcUnknown[] = { L"no_such_key", L"no_such_key_\u00e4" };
+    const char* const apcUnknown[] = { "no_such_key", u8"no_such_key_\u00e4" };
+    for (size_t ii = 0; ii < 2; ii++)
+    {
+        bool bOk = (strcmp(cTranslate.translate(apcUnknown[ii]), apcUnknown[ii]) == 0) && (strcmp(cTranslate.translate(apwcUnknown[ii]), apcUnknown[ii]) == 0);
+        printf("%s  %-28s %s\n", bOk ? "ok    " : "FAILED", apcUnknown[ii], "unknown id");
+        iFailed += bOk ? 0 : 1;
+    }
+
+    fprintf(stderr, "%s: %d failed\n", iFailed ? "FAILED" : "passed", iFailed);
+    return iFailed ? 1 : 0;
+}
@@ -0,0 +1,70 @@
+/* ----------------------------------------------------------------------------
+* replay a recording of the plugin callbacks (headless build)
+*
+*   wm2000_replay [--realtime] [--async] [--server=ID] [--slowest=N] [--path=DIR] [--quiet] <file.wm2rec>
+*
+* recordings are written by the plugin after "/WhisperMaster record start" or
+* with the environment variable WM2000_RECORD=<file>. Without --realtime the
+* callbacks are sent as fast as possible, the CPU time per callback is the same.
+* With --async the plugin queues the events for its work pool like in TS3,
+* the CPU time is the time the callback blocks the client.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "bench/event_replay.h"
+
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+int main(int argc, char* argv[])
+{
+    event_replay cReplay;
+    std::string sFileName;
+    bool bRealtime = false;
+    bool bQuiet = false;
+    bool bUsage = false;
+
+    cReplay.set_plugin_path("wm2000_replay_plugin/");
+    for (int ii = 1; ii < argc; ii++)
+    {
+        if (strcmp(argv[ii], "--realtime") == 0)
+            bRealtime = true;
+        else if (strcmp(argv[ii], "--async") == 0)
+            cReplay.set_async(true);
+        else if (strcmp(argv[ii], "--quiet") == 0)
+            bQuiet = true;
+        else if (strncmp(argv[ii], "--server=", 9) == 0)
+            cReplay.set_server(strtoull(argv[ii] + 9, nullptr, 10));
+        else if (strncmp(argv[ii], "--slowest=", 10) == 0)
+            cReplay.set_num_slowest((size_t)atoi(argv[ii] + 10));
+        else if (strncmp(argv[ii], "--path=", 7) == 0)
+            cReplay.set_plugin_path(argv[ii] + 7);
+        else if ((argv[ii][0] != '-') && sFileName.empty())
+            sFileName = argv[ii];
+        else
+            bUsage = true;
+    }
+    if (bUsage || sFileName.empty())
+    {
+        fprintf(stderr, "usage: wm2000_replay [--realtime] [--async] [--server=ID] [--slowest=N] [--path=DIR] [--quiet] <file.wm2rec>\n");
+        return 2;
+    }
+
+    // debug output of the plugin goes to stdout, report to stderr
+    if (bQuiet)
+    {
+        fflush(stdout);
+        if (freopen(NULL_DEVICE, "w", stdout) == nullptr)
+            fprintf(stderr, "stdout could not be redirected\n");
+    }
+
+    bool bResult = cReplay.run(sFileName, bRealtime);
+    if (bResult)
+        cReplay.report(stderr);
+    return bResult ? 0 : 1;
+}
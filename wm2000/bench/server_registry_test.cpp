@@ -0,0 +1,153 @@
+/* ----------------------------------------------------------------------------
+* server_registry against std::map
+*
+* random inserts, erases and finds on both containers, the registry has to
+* give the same answers. IDs come from a small range, so probe chains wrap
+* around the table and backward shift deletion is exercised. After every
+* change the size and the number of live entries are compared, the iteration
+* order is checked every few operations. The exit code is 1 on the first
+* difference.
+*
+*   wm2000_registry_test [--operations=N] [--ids=N] [--seed=N]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <map>
+#include <set>
+#include <random>
+#include "misc/server_registry.h"
+
+/* ----------------------------------------------------------------------------
+* entry that knows its ID and counts the live instances
+*/
+static long s_nLive = 0;
+
+struct test_entry
+{
+    test_entry(uint64_t nID) : nID(nID) { s_nLive++; };
+    ~test_entry() { s_nLive--; };
+
+    uint64_t    nID;
+};
+
+/* ----------------------------------------------------------------------------
+* helper
+*/
+static bool get_option(const char* pcArg, const char* pcName, std::string& sValue)
+{
+    size_t nLen = strlen(pcName);
+    if ((strncmp(pcArg, pcName, nLen) != 0) || (pcArg[nLen] != '='))
+        return false;
+    sValue = pcArg + nLen + 1;
+    return true;
+}
+
+static bool check_all(server_registry<test_entry>& cRegistry, std::map<uint64_t, int>& mReference, size_t nOperation)
+{
+    // every entry once, each one findable under its ID
+    std::set<uint64_t> sSeen;
+    for (size_t ii = 0; ii < cRegistry.size(); ii++)
+    {
+        test_entry* pcEntry = cRegistry.at(ii);
+        if ((pcEntry == nullptr) || !sSeen.insert(pcEntry->nID).second || (cRegistry.find(pcEntry->nID) != pcEntry) || (mReference.count(pcEntry->nID) == 0))
+        {
+            printf("FAILED  operation %llu: iteration at %llu\n", (unsigned long long)nOperation, (unsigned long long)ii);
+            return false;
+        }
+    }
+    if (sSeen.size() != mReference.size())
+    {
+        printf("FAILED  operation %llu: %llu entries iterated, %llu expected\n", (unsigned long long)nOperation, (unsigned long long)sSeen.size(), (unsigned long long)mReference.size());
+        return false;
+    }
+    return true;
+}
+
+/* ----------------------------------------------------------------------------
+* main
+*/
+int main(int argc, char* argv[])
+{
+    size_t nOperations = 2000000;
+    uint64_t nIDs = 300;
+    unsigned nSeed = 1;
+    for (int ii = 1; ii < argc; ii++)
+    {
+        std::string sValue;
+        if      (get_option(argv[ii], "--operations", sValue))  nOperations = strtoull(sValue.c_str(), nullptr, 10);
+        else if (get_option(argv[ii], "--ids", sValue))         nIDs        = strtoull(sValue.c_str(), nullptr, 10);
+        else if (get_option(argv[ii], "--seed", sValue))        nSeed       = (unsigned)atoi(sValue.c_str());
+        else
+        {
+            fprintf(stderr, "usage: wm2000_registry_test [--operations=N] [--ids=N] [--seed=N]\n");
+            return 2;
+        }
+    }
+    if (nIDs == 0)
+        nIDs = 1;
+
+    std::mt19937_64 cRandom(nSeed);
+    server_registry<test_entry> cRegistry;
+    std::map<uint64_t, int> mReference;
+    size_t anCount[3] = {};
+
+    for (size_t nOp = 0; nOp < nOperations; nOp++)
+    {
+        // mostly small consecutive IDs like TS3 uses, some large ones
+        uint64_t nID = (cRandom() % nIDs) + 1;
+        if (cRandom() % 16 == 0)
+            nID += (1ull << 40);
+        // phases that grow and shrink the registry, so the table is rehashed
+        bool bGrow = ((nOp / 50000) % 2) == 0;
+        int iAction = (int)(cRandom() % 10);
+        bool bOk = true;
+
+        if (iAction < (bGrow ? 5 : 2))
+        {
+            anCount[0]++;
+            bool bKnown = mReference.count(nID) != 0;
+            test_entry* pcEntry = cRegistry.insert(nID, std::unique_ptr<test_entry>(new test_entry(nID)));
+            bOk = bKnown ? (pcEntry == nullptr) : ((pcEntry != nullptr) && (pcEntry->nID == nID));
+            mReference[nID] = 0;
+        }
+        else if (iAction < 7)
+        {
+            anCount[1]++;
+            bool bKnown = mReference.erase(nID) != 0;
+            std::unique_ptr<test_entry> pcEntry = cRegistry.erase(nID);
+            bOk = bKnown ? (pcEntry && (pcEntry->nID == nID)) : !pcEntry;
+        }
+        else
+        {
+            anCount[2]++;
+            bool bKnown = mReference.count(nID) != 0;
+            test_entry* pcEntry = cRegistry.find(nID);
+            bOk = bKnown ? ((pcEntry != nullptr) && (pcEntry->nID == nID)) : (pcEntry == nullptr);
+        }
+
+        if (!bOk || (cRegistry.size() != mReference.size()) || (s_nLive != (long)mReference.size()))
+        {
+            printf("FAILED  operation %llu (action %d, ID %llu): size %llu, live %ld, expected %llu\n", (unsigned long long)nOp, iAction, (unsigned long long)nID,
+                (unsigned long long)cRegistry.size(), s_nLive, (unsigned long long)mReference.size());
+            return 1;
+        }
+        if (((nOp % 997) == 0) && !check_all(cRegistry, mReference, nOp))
+            return 1;
+    }
+    if (!check_all(cRegistry, mReference, nOperations))
+        return 1;
+
+    cRegistry.clear();
+    if (s_nLive != 0)
+    {
+        printf("FAILED  clear: %ld entries alive\n", s_nLive);
+        return 1;
+    }
+
+    printf("ok      %llu operations (%llu insert, %llu erase, %llu find), IDs 1..%llu\n", (unsigned long long)nOperations,
+        (unsigned long long)anCount[0], (unsigned long long)anCount[1], (unsigned long long)anCount[2], (unsigned long long)nIDs);
+    fprintf(stderr, "passed: 0 failed\n");
+    return 0;
+}
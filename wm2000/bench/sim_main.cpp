@@ -0,0 +1,66 @@
+/* ----------------------------------------------------------------------------
+* run the plugin in a simulated TS3 client (headless build)
+*
+*   wm2000_sim [--quiet] <script> [<script> ...]
+*
+* the scripts are executed in order on the same client (see ts3_client_sim.h),
+* "-" reads from stdin. Exit code 1, if a command or expectation failed.
+* --quiet drops the debug output of the plugin (stdout).
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <iostream>
+#include "bench/ts3_client_sim.h"
+
+#ifdef _WIN32
+#define NULL_DEVICE "NUL"
+#else
+#define NULL_DEVICE "/dev/null"
+#endif
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> vScript;
+    for (int ii = 1; ii < argc; ii++)
+    {
+        if (strcmp(argv[ii], "--quiet") == 0)
+        {
+            fflush(stdout);
+            if (freopen(NULL_DEVICE, "w", stdout) == nullptr)
+                fprintf(stderr, "stdout could not be redirected\n");
+        }
+        else
+            vScript.push_back(argv[ii]);
+    }
+    if (vScript.empty())
+    {
+        fprintf(stderr, "usage: wm2000_sim [--quiet] <script> [<script> ...]\n");
+        return 2;
+    }
+
+    int iFailed = 0;
+    ts3_client_sim cClient;
+    for (const std::string& sScript : vScript)
+    {
+        if (sScript == "-")
+        {
+            iFailed += cClient.run_script(std::cin, "stdin");
+            continue;
+        }
+
+        std::ifstream cFile(sScript);
+        if (!cFile.good())
+        {
+            fprintf(stderr, "%s: can't open script\n", sScript.c_str());
+            iFailed++;
+            continue;
+        }
+        iFailed += cClient.run_script(cFile, sScript);
+    }
+    cClient.unload();
+
+    fprintf(stderr, "%s: %d failed\n", iFailed ? "FAILED" : "passed", iFailed);
+    return iFailed ? 1 : 0;
+}
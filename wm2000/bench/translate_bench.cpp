@@ -0,0 +1,156 @@
+/* ----------------------------------------------------------------------------
+* language_pkg::translate benchmark
+*
+* translates a fixed set of string ids (narrow and wide, both languages) and
+* prints the time and the heap allocations per call. Limits given on the
+* command line are checked, the exit code is 1 if one of them is exceeded.
+*
+*   wm2000_translate_bench [--iterations=N] [--limit-ns=NS] [--limit-allocs=N]
+*
+*   example: wm2000_translate_bench --iterations=1000000 --limit-allocs=0
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <chrono>
+#include <atomic>
+#include <new>
+#include "misc/language_pkg.h"
+
+/* ----------------------------------------------------------------------------
+* heap allocations of the whole process
+*/
+static std::atomic<size_t> s_nAllocs(0);
+
+void* operator new(size_t nSize)
+{
+    s_nAllocs.fetch_add(1, std::memory_order_relaxed);
+    void* pMemory = malloc(nSize ? nSize : 1);
+    if (pMemory == nullptr)
+        throw std::bad_alloc();
+    return pMemory;
+}
+
+void* operator new[](size_t nSize)
+{
+    return operator new(nSize);
+}
+
+void operator delete(void* pMemory) noexcept
+{
+    free(pMemory);
+}
+
+void operator delete[](void* pMemory) noexcept
+{
+    free(pMemory);
+}
+
+void operator delete(void* pMemory, size_t nSize) noexcept
+{
+    free(pMemory);
+}
+
+void operator delete[](void* pMemory, size_t nSize) noexcept
+{
+    free(pMemory);
+}
+
+/* ----------------------------------------------------------------------------
+* string ids used on hot paths (hotkeys, info texts, UI refresh), one unknown
+*/
+static const char* const s_apcKey[] =
+{
+    "base_name",
+    "info_Title",
+    "info_ActFreq",
+    "info_ActWhisper",
+    "hotkey_ErrActivate2",
+    "ctUi_treeItemStateWhisper",
+    "ctUi_treeItemStateTalkTime",
+    "no_such_key"
+};
+static const wchar_t* const s_apwcKey[] = { L"base_name", L"info_ActFreq", L"ctUi_treeItemStateWhisper", L"no_such_key" };
+
+#define NUM_KEYS    (sizeof(s_apcKey) / sizeof(s_apcKey[0]))
+#define NUM_WKEYS   (sizeof(s_apwcKey) / sizeof(s_apwcKey[0]))
+
+/* ----------------------------------------------------------------------------
+* helper
+*/
+static bool get_option(const char* pcArg, const char* pcName, std::string& sValue)
+{
+    size_t nLen = strlen(pcName);
+    if ((strncmp(pcArg, pcName, nLen) != 0) || (pcArg[nLen] != '='))
+        return false;
+    sValue = pcArg + nLen + 1;
+    return true;
+}
+
+struct bench_result
+{
+    double      dNsPerCall;
+    double      dAllocsPerCall;
+    size_t      nChecksum;          // keeps the calls from being optimized away
+};
+
+static bench_result run(language_pkg& cTranslate, bool bWide, size_t nIterations)
+{
+    bench_result cResult = {};
+    size_t nAllocs = s_nAllocs.load();
+    auto cStart = std::chrono::steady_clock::now();
+    for (size_t ii = 0; ii < nIterations; ii++)
+    {
+        const char* pcText = bWide ? cTranslate.translate(s_apwcKey[ii % NUM_WKEYS]) : cTranslate.translate(s_apcKey[ii % NUM_KEYS]);
+        cResult.nChecksum += (size_t)(uint8_t)pcText[0];
+    }
+    auto cEnd = std::chrono::steady_clock::now();
+
+    double dTotalNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(cEnd - cStart).count();
+    cResult.dNsPerCall      = dTotalNs / (double)nIterations;
+    cResult.dAllocsPerCall  = (double)(s_nAllocs.load() - nAllocs) / (double)nIterations;
+    return cResult;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t nIterations = 1000000;
+    double dLimitNs = -1.0;
+    double dLimitAllocs = -1.0;
+    for (int ii = 1; ii < argc; ii++)
+    {
+        std::string sValue;
+        if (get_option(argv[ii], "--iterations", sValue))           nIterations = strtoull(sValue.c_str(), nullptr, 10);
+        else if (get_option(argv[ii], "--limit-ns", sValue))        dLimitNs = atof(sValue.c_str());
+        else if (get_option(argv[ii], "--limit-allocs", sValue))    dLimitAllocs = atof(sValue.c_str());
+        else
+        {
+            fprintf(stderr, "usage: wm2000_translate_bench [--iterations=N] [--limit-ns=NS] [--limit-allocs=N]\n");
+            return 2;
+        }
+    }
+    if (nIterations == 0)
+        nIterations = 1;
+
+    language_pkg cTranslate;
+    printf("%llu translate() calls per run, %d narrow / %d wide string ids\n\n", (unsigned long long)nIterations, (int)NUM_KEYS, (int)NUM_WKEYS);
+    printf("language  ids      ns/call  allocs/call\n");
+
+    bool bFailed = false;
+    const char* apcLanguage[] = { "de", "en" };
+    for (int iLang = 0; iLang < 2; iLang++)
+    {
+        cTranslate.set_language(apcLanguage[iLang]);
+        for (int iWide = 0; iWide < 2; iWide++)
+        {
+            run(cTranslate, iWide != 0, nIterations / 10 + 1);     // warm up
+            bench_result cResult = run(cTranslate, iWide != 0, nIterations);
+            bool bExceeded = ((dLimitNs >= 0.0) && (cResult.dNsPerCall > dLimitNs)) || ((dLimitAllocs >= 0.0) && (cResult.dAllocsPerCall > dLimitAllocs));
+            printf("%-8s  %-6s %9.1f  %11.3f%s   (checksum %llu)\n", apcLanguage[iLang], iWide ? "wide" : "narrow",
+                cResult.dNsPerCall, cResult.dAllocsPerCall, bExceeded ? "  LIMIT EXCEEDED" : "", (unsigned long long)cResult.nChecksum);
+            bFailed |= bExceeded;
+        }
+    }
+    return bFailed ? 1 : 0;
+}
@@ -0,0 +1,578 @@
+#include "bench/ts3_client_sim.h"
+#include <string.h>
+#include <math.h>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <sys/stat.h>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+#include "teamspeak/public_errors.h"
+#include "teamspeak/public_definitions.h"
+#include "teamspeak/public_rare_definitions.h"
+#include "teamspeak/clientlib_publicdefinitions.h"
+#include "plugin_definitions.h"
+#include "base/plugin.h"
+#include "misc/rx_filter.h"
+
+#define SIM_PLUGIN_ID "wm2000_sim"
+#define SIM_TS3_ROLLOFF 0.25f   // volume of the TS3 rolloff passed to the plugin
+
+/* ----------------------------------------------------------------------------
+* helper
+*/
+static std::vector<std::string> split(const std::string& sText, char cSeparator)
+{
+    std::vector<std::string> vResult;
+    std::stringstream cStream(sText);
+    std::string sPart;
+    while (std::getline(cStream, sPart, cSeparator))
+        if (!sPart.empty())
+            vResult.push_back(sPart);
+    return vResult;
+}
+
+template <class T>
+static std::string join(const std::vector<T>& vList)
+{
+    std::string sResult;
+    for (size_t ii = 0; ii < vList.size(); ii++)
+        sResult += (ii ? "," : "") + std::to_string(vList[ii]);
+    return sResult.empty() ? std::string("-") : sResult;
+}
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+ts3_client_sim::ts3_client_sim()
+{
+    this->m_bLoaded     = false;
+    this->m_bConnected  = false;
+    this->m_sPluginPath = "./";
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+ts3_client_sim::~ts3_client_sim()
+{
+    unload();
+}
+
+/* ----------------------------------------------------------------------------
+* plugin life cycle
+*/
+void ts3_client_sim::create_server(const sim_server_param& cParam)
+{
+    this->m_cServer.create(cParam);
+    this->m_cServer.activate();
+}
+
+void ts3_client_sim::set_plugin_path(const std::string& sPluginPath)
+{
+    this->m_sPluginPath = sPluginPath;
+    if (!this->m_sPluginPath.empty() && (this->m_sPluginPath.back() != '/'))
+        this->m_sPluginPath += "/";
+    this->m_cServer.set_plugin_path(this->m_sPluginPath);
+}
+
+bool ts3_client_sim::set_config(const std::string& sKey, const std::string& sValue)
+{
+    std::string sConfigPath = this->m_sPluginPath + "WhisperMaster2000/";
+    std::string sFileName = sConfigPath + "config.xml";
+    boost::property_tree::ptree tree;
+    try
+    {
+        mkdir(this->m_sPluginPath.c_str(), 0755);
+        mkdir(sConfigPath.c_str(), 0755);
+        std::ifstream cFile(sFileName);
+        if (cFile.good())
+            boost::property_tree::read_xml(cFile, tree, boost::property_tree::xml_parser::trim_whitespace);
+        cFile.close();
+
+        tree.put(sKey, sValue);
+        boost::property_tree::write_xml(sFileName, tree, std::locale(), boost::property_tree::xml_writer_make_settings<std::string>(' ', 4));
+    }
+    catch (boost::property_tree::ptree_error &e)
+    {
+        fprintf(stderr, "%s: config %s: %s\n", this->m_sContext.c_str(), sFileName.c_str(), e.what());
+        return false;
+    }
+    return true;
+}
+
+bool ts3_client_sim::load()
+{
+    if (this->m_bLoaded)
+        return true;
+
+    std::string sConfigPath = this->m_sPluginPath + "WhisperMaster2000/";
+    mkdir(this->m_sPluginPath.c_str(), 0755);
+    mkdir(sConfigPath.c_str(), 0755);
+
+    this->m_cServer.activate();
+    this->m_cServer.set_plugin_path(this->m_sPluginPath);
+    ts3plugin_setFunctionPointers(this->m_cServer.get_functions());
+    ts3plugin_registerPluginID(SIM_PLUGIN_ID);
+    if (ts3plugin_init() != 0)
+        return false;
+    this->m_bLoaded = true;
+
+    // the client asks for menus and hotkeys right after init
+    struct PluginMenuItem **ppcMenuItems = nullptr;
+    char *pcMenuIcon = nullptr;
+    ts3plugin_initMenus(&ppcMenuItems, &pcMenuIcon);
+    for (int ii = 0; (ppcMenuItems != nullptr) && (ppcMenuItems[ii] != nullptr); ii++)
+        ts3plugin_freeMemory(ppcMenuItems[ii]);
+    ts3plugin_freeMemory(ppcMenuItems);
+    ts3plugin_freeMemory(pcMenuIcon);
+
+    struct PluginHotkey **ppcHotkeys = nullptr;
+    ts3plugin_initHotkeys(&ppcHotkeys);
+    for (int ii = 0; (ppcHotkeys != nullptr) && (ppcHotkeys[ii] != nullptr); ii++)
+        ts3plugin_freeMemory(ppcHotkeys[ii]);
+    ts3plugin_freeMemory(ppcHotkeys);
+    return true;
+}
+
+bool ts3_client_sim::reload()
+{
+    if (!this->m_bLoaded)
+        return false;
+    wm2000_reload_config();
+    return true;
+}
+
+void ts3_client_sim::connect()
+{
+    if (!this->m_bLoaded || this->m_bConnected)
+        return;
+
+    uint64 nServerID = this->m_cServer.get_server_id();
+    ts3plugin_onConnectStatusChangeEvent(nServerID, STATUS_CONNECTING, ERROR_ok);
+    ts3plugin_onConnectStatusChangeEvent(nServerID, STATUS_CONNECTED, ERROR_ok);
+    for (const sim_channel& cChannel : this->m_cServer.get_channels())
+        if (!cChannel.bDeleted)
+            ts3plugin_onNewChannelEvent(nServerID, cChannel.nChannelID, cChannel.nParentID);
+    ts3plugin_onConnectStatusChangeEvent(nServerID, STATUS_CONNECTION_ESTABLISHING, ERROR_ok);
+
+    // own client first, then all clients of the subscribed channels
+    ts3plugin_onClientMoveSubscriptionEvent(nServerID, this->m_cServer.get_my_client_id(), 0, this->m_cServer.get_my_channel_id(), ENTER_VISIBILITY);
+    for (const sim_client& cClient : this->m_cServer.get_clients())
+        if (cClient.bConnected)
+            ts3plugin_onClientMoveSubscriptionEvent(nServerID, cClient.nClientID, 0, cClient.nChannelID, ENTER_VISIBILITY);
+    ts3plugin_onConnectStatusChangeEvent(nServerID, STATUS_CONNECTION_ESTABLISHED, ERROR_ok);
+    this->m_bConnected = true;
+}
+
+void ts3_client_sim::disconnect()
+{
+    if (!this->m_bConnected)
+        return;
+    ts3plugin_onConnectStatusChangeEvent(this->m_cServer.get_server_id(), STATUS_DISCONNECTED, ERROR_ok);
+    this->m_bConnected = false;
+}
+
+void ts3_client_sim::unload()
+{
+    if (!this->m_bLoaded)
+        return;
+    disconnect();
+    ts3plugin_shutdown();
+    this->m_bLoaded = false;
+}
+
+/* ----------------------------------------------------------------------------
+* events: change server first, then inform the plugin
+*/
+bool ts3_client_sim::move_client(anyID nClientID, uint64 nChannelID)
+{
+    uint64 nOldChannelID = 0;
+    if (nClientID == this->m_cServer.get_my_client_id())
+        nOldChannelID = this->m_cServer.get_my_channel_id();
+    else if (this->m_cServer.find_client(nClientID) != nullptr)
+        nOldChannelID = this->m_cServer.find_client(nClientID)->nChannelID;
+
+    if (!this->m_cServer.move_client(nClientID, nChannelID))
+        return false;
+    if (this->m_bConnected)
+        ts3plugin_onClientMoveEvent(this->m_cServer.get_server_id(), nClientID, nOldChannelID, nChannelID, RETAIN_VISIBILITY, "");
+    return true;
+}
+
+anyID ts3_client_sim::join_client(uint64 nChannelID, const std::string& sName, const std::string& sMetaData)
+{
+    anyID nClientID = this->m_cServer.add_client(nChannelID, sName, sMetaData);
+    if ((nClientID != 0) && this->m_bConnected)
+        ts3plugin_onClientMoveEvent(this->m_cServer.get_server_id(), nClientID, 0, nChannelID, ENTER_VISIBILITY, "");
+    return nClientID;
+}
+
+bool ts3_client_sim::leave_client(anyID nClientID)
+{
+    const sim_client *pcClient = this->m_cServer.find_client(nClientID);
+    if (pcClient == nullptr)
+        return false;
+    uint64 nOldChannelID = pcClient->nChannelID;
+
+    this->m_cServer.remove_client(nClientID);
+    if (this->m_bConnected)
+        ts3plugin_onClientMoveEvent(this->m_cServer.get_server_id(), nClientID, nOldChannelID, 0, LEAVE_VISIBILITY, "");
+    return true;
+}
+
+bool ts3_client_sim::set_meta_data(anyID nClientID, const std::string& sMetaData)
+{
+    if (!this->m_cServer.set_meta_data(nClientID, sMetaData))
+        return false;
+    if (this->m_bConnected)
+        ts3plugin_onUpdateClientEvent(this->m_cServer.get_server_id(), nClientID, nClientID, "", "");
+    return true;
+}
+
+uint64 ts3_client_sim::create_channel(uint64 nParentID, const std::string& sName)
+{
+    uint64 nChannelID = this->m_cServer.add_channel(nParentID, sName);
+    if ((nChannelID != 0) && this->m_bConnected)
+        ts3plugin_onNewChannelCreatedEvent(this->m_cServer.get_server_id(), nChannelID, nParentID, 0, "", "");
+    return nChannelID;
+}
+
+bool ts3_client_sim::delete_channel(uint64 nChannelID)
+{
+    if (!this->m_cServer.remove_channel(nChannelID))
+        return false;
+    if (this->m_bConnected)
+        ts3plugin_onDelChannelEvent(this->m_cServer.get_server_id(), nChannelID, 0, "", "");
+    return true;
+}
+
+void ts3_client_sim::hotkey(const std::string& sKeyword)
+{
+    if (this->m_bLoaded)
+        ts3plugin_onHotkeyEvent(sKeyword.c_str());
+}
+
+void ts3_client_sim::talk(anyID nClientID, bool bTalking, bool bWhisper)
+{
+    if (this->m_bConnected)
+        ts3plugin_onTalkStatusChangeEvent(this->m_cServer.get_server_id(), bTalking ? STATUS_TALKING : STATUS_NOT_TALKING, bWhisper ? 1 : 0, nClientID);
+}
+
+/* ----------------------------------------------------------------------------
+* two 20 ms stereo frames (48 kHz) of a client through the playback callback,
+* the result is derived from the second frame (the first may contain a gain ramp)
+*/
+std::string ts3_client_sim::rolloff(float fDistance)
+{
+    // TS3 passes the volume of its own rolloff
+    float fVolume = SIM_TS3_ROLLOFF;
+    ts3plugin_onCustom3dRolloffCalculationClientEvent(this->m_cServer.get_server_id(), 0, fDistance, &fVolume);
+    if (fVolume == 1.0f)
+        return "full";
+    if (fVolume == SIM_TS3_ROLLOFF)
+        return "ts3";
+    return std::to_string(fVolume);
+}
+
+std::string ts3_client_sim::play_voice(anyID nClientID)
+{
+    const int iSampleCount = 960;
+    const int iChannels    = 2;
+    std::vector<short> vInput(iSampleCount * iChannels);
+    for (size_t ii = 0; ii < vInput.size(); ii++)
+        vInput[ii] = (short)(((ii * 997) % 32768) - 16384);
+
+    std::vector<short> vSample;
+    for (int iFrame = 0; iFrame < 2; iFrame++)
+    {
+        vSample = vInput;
+        if (this->m_bConnected)
+            ts3plugin_onEditPlaybackVoiceDataEvent(this->m_cServer.get_server_id(), nClientID, vSample.data(), iSampleCount, iChannels);
+    }
+
+    if (vSample == vInput)
+        return "pass";
+
+    // attenuate: plain ducking gain, anything else is the radio effect
+    bool bZero = true;
+    bool bDucked = true;
+    for (size_t ii = 0; ii < vSample.size(); ii++)
+    {
+        bZero &= (vSample[ii] == 0);
+        bDucked &= (abs(vSample[ii] * GAIN_UNITY - vInput[ii] * RX_DUCK_GAIN) <= GAIN_UNITY);   // within 1 LSB
+    }
+    if (bZero)
+        return "zero";
+    return bDucked ? "attenuate" : "radio";
+}
+
+void ts3_client_sim::menu(int iType, int iMenuID, uint64 nSelectedID)
+{
+    if (this->m_bLoaded)
+        ts3plugin_onMenuItemEvent(this->m_cServer.get_server_id(), (enum PluginMenuType)iType, iMenuID, nSelectedID);
+}
+
+int ts3_client_sim::command(const std::string& sCommand)
+{
+    if (!this->m_bLoaded)
+        return 1;
+    return ts3plugin_processCommand(this->m_cServer.get_server_id(), sCommand.c_str());
+}
+
+std::string ts3_client_sim::get_info(int iType, uint64 nID)
+{
+    if (!this->m_bLoaded)
+        return std::string();
+
+    char *pcData = nullptr;
+    ts3plugin_infoData(this->m_cServer.get_server_id(), nID, (enum PluginItemType)iType, &pcData);
+    std::string sText = (pcData != nullptr) ? pcData : "";
+    if (pcData != nullptr)
+        ts3plugin_freeMemory(pcData);
+    return sText;
+}
+
+/* ----------------------------------------------------------------------------
+* scripts
+*/
+int ts3_client_sim::run_script(std::istream& cScript, const std::string& sName)
+{
+    int iFailed = 0;
+    int iLine = 0;
+    std::string sLine;
+    while (std::getline(cScript, sLine))
+    {
+        iLine++;
+        this->m_sContext = sName + ":" + std::to_string(iLine);
+        if (!run_command(sLine))
+            iFailed++;
+    }
+    this->m_sContext.clear();
+    return iFailed;
+}
+
+anyID ts3_client_sim::to_client_id(const std::string& sText)
+{
+    if (sText == "me")
+        return this->m_cServer.get_my_client_id();
+    return (anyID)strtoul(sText.c_str(), nullptr, 10);
+}
+
+bool ts3_client_sim::run_command(const std::string& sLine)
+{
+    std::string sCommand = sLine;
+    if (!sCommand.empty() && (sCommand.back() == '\r'))
+        sCommand.pop_back();
+    std::vector<std::string> vArg = split(sCommand, ' ');
+    if (vArg.empty() || (vArg[0][0] == '#'))
+        return true;
+
+    const std::string& sName = vArg[0];
+    bool bResult = true;
+    if (sName == "server")
+    {
+        sim_server_param cParam = { 100, 3, 50, 50, 20, 3, 1 };
+        for (size_t ii = 1; ii < vArg.size(); ii++)
+        {
+            size_t nPos = vArg[ii].find('=');
+            std::string sKey = vArg[ii].substr(0, nPos);
+            int iValue = (nPos == std::string::npos) ? 0 : atoi(vArg[ii].c_str() + nPos + 1);
+            if      (sKey == "channels")        cParam.iNumChannel      = iValue;
+            else if (sKey == "depth")           cParam.iMaxDepth        = iValue;
+            else if (sKey == "clients")         cParam.iNumClient       = iValue;
+            else if (sKey == "wm-ratio")        cParam.iWmClientRatio   = iValue;
+            else if (sKey == "freqs")           cParam.iNumFreq         = iValue;
+            else if (sKey == "freq-per-client") cParam.iFreqPerClient   = iValue;
+            else if (sKey == "seed")            cParam.nSeed            = (unsigned)iValue;
+            else bResult = false;
+        }
+        create_server(cParam);
+    }
+    else if ((sName == "path") && (vArg.size() == 2))   set_plugin_path(vArg[1]);
+    else if (sName == "config")
+    {
+        for (size_t ii = 1; ii < vArg.size(); ii++)
+        {
+            size_t nPos = vArg[ii].find('=');
+            bResult &= (nPos != std::string::npos) && set_config(vArg[ii].substr(0, nPos), vArg[ii].substr(nPos + 1));
+        }
+    }
+    else if (sName == "reload")                         bResult = reload();
+    else if (sName == "load")                           bResult = load();
+    else if (sName == "connect")                        connect();
+    else if (sName == "disconnect")                     disconnect();
+    else if (sName == "unload")                         unload();
+    else if ((sName == "move") && (vArg.size() == 3))   bResult = move_client(to_client_id(vArg[1]), strtoull(vArg[2].c_str(), nullptr, 10));
+    else if ((sName == "join") && (vArg.size() >= 3))   bResult = join_client(strtoull(vArg[1].c_str(), nullptr, 10), vArg[2], (vArg.size() > 3) ? vArg[3] : std::string()) != 0;
+    else if ((sName == "leave") && (vArg.size() == 2))  bResult = leave_client(to_client_id(vArg[1]));
+    else if ((sName == "meta") && (vArg.size() >= 2))   bResult = set_meta_data(to_client_id(vArg[1]), (vArg.size() > 2) ? vArg[2] : std::string());
+    else if ((sName == "create") && (vArg.size() == 3)) bResult = create_channel(strtoull(vArg[1].c_str(), nullptr, 10), vArg[2]) != 0;
+    else if ((sName == "delete") && (vArg.size() == 2)) bResult = delete_channel(strtoull(vArg[1].c_str(), nullptr, 10));
+    else if ((sName == "hotkey") && (vArg.size() == 2)) hotkey(vArg[1]);
+    else if ((sName == "bind") && (vArg.size() == 3))   this->m_cServer.bind_hotkey(vArg[1], vArg[2]);
+    else if ((sName == "talk") && (vArg.size() >= 3))   talk(to_client_id(vArg[1]), vArg[2] == "1", (vArg.size() > 3) && (vArg[3] == "whisper"));
+    else if ((sName == "menu") && (vArg.size() >= 3))
+    {
+        int iType = (vArg[1] == "channel") ? PLUGIN_MENU_TYPE_CHANNEL : (vArg[1] == "client") ? PLUGIN_MENU_TYPE_CLIENT : PLUGIN_MENU_TYPE_GLOBAL;
+        menu(iType, atoi(vArg[2].c_str()), (vArg.size() > 3) ? strtoull(vArg[3].c_str(), nullptr, 10) : 0);
+    }
+    else if ((sName == "command") && (vArg.size() >= 2))
+    {
+        command(sCommand.substr(sCommand.find("command") + 8));
+    }
+    else if ((sName == "wait") && (vArg.size() == 2))   std::this_thread::sleep_for(std::chrono::milliseconds(atoi(vArg[1].c_str())));
+    else if ((sName == "expect") && (vArg.size() >= 2))  bResult = expect(vArg);
+    else if ((sName == "print") && (vArg.size() == 2))   print(vArg[1]);
+    else
+    {
+        fprintf(stderr, "%s: unknown command \"%s\"\n", this->m_sContext.c_str(), sCommand.c_str());
+        return false;
+    }
+
+    // the plugin processes events in its work pool, every command is finished before the next one
+    if (this->m_bLoaded)
+        wm2000_flush_events();
+
+    if (!bResult && (sName != "expect"))
+        fprintf(stderr, "%s: \"%s\" failed\n", this->m_sContext.c_str(), sCommand.c_str());
+    return bResult;
+}
+
+/* ----------------------------------------------------------------------------
+* compare state of the server with the expected state
+*/
+bool ts3_client_sim::expect(std::vector<std::string>& vArg)
+{
+    std::string sActual, sExpected;
+    if ((vArg[1] == "whisper") && (vArg.size() >= 3))
+    {
+        std::vector<uint64> vChannel = this->m_cServer.get_whisper_channels();
+        std::vector<anyID>  vClient  = this->m_cServer.get_whisper_clients();
+        std::sort(vChannel.begin(), vChannel.end());
+        std::sort(vClient.begin(), vClient.end());
+
+        std::vector<uint64> vExpChannel;
+        std::vector<anyID>  vExpClient;
+        for (const std::string& sID : split(vArg[2], ','))
+            if (sID != "-") vExpChannel.push_back(strtoull(sID.c_str(), nullptr, 10));
+        if (vArg.size() > 3)
+            for (const std::string& sID : split(vArg[3], ','))
+                if (sID != "-") vExpClient.push_back(to_client_id(sID));
+        std::sort(vExpChannel.begin(), vExpChannel.end());
+        std::sort(vExpClient.begin(), vExpClient.end());
+
+        sActual   = join(vChannel) + " " + join(vClient);
+        sExpected = join(vExpChannel) + " " + join(vExpClient);
+    }
+    else if ((vArg[1] == "ptt") && (vArg.size() == 3))
+    {
+        sActual   = this->m_cServer.get_input_active() ? "1" : "0";
+        sExpected = vArg[2];
+    }
+    else if ((vArg[1] == "muted") && (vArg.size() == 4))
+    {
+        sActual   = this->m_cServer.is_muted(to_client_id(vArg[2])) ? "1" : "0";
+        sExpected = vArg[3];
+    }
+    else if ((vArg[1] == "position") && (vArg.size() == 4))
+    {
+        // azimuth in degrees, positive to the right (Y points to the left)
+        TS3_VECTOR stPosition = this->m_cServer.get_position(to_client_id(vArg[2]));
+        if ((stPosition.x == 0.0f) && (stPosition.y == 0.0f) && (stPosition.z == 0.0f))
+            sActual = "center";
+        else
+            sActual = std::to_string((int)lround(atan2(-stPosition.y, stPosition.x) * 180.0 / 3.14159265358979323846));
+        sExpected = vArg[3];
+    }
+    else if ((vArg[1] == "positions") && (vArg.size() == 3))
+    {
+        sActual   = std::to_string(this->m_cServer.m_nPositionCalls);
+        sExpected = vArg[2];
+    }
+    else if ((vArg[1] == "rolloff") && (vArg.size() == 4))
+    {
+        // distance of the client position or distance=<value>
+        float fDistance;
+        if (vArg[2].compare(0, 9, "distance=") == 0)
+            fDistance = strtof(vArg[2].c_str() + 9, nullptr);
+        else
+        {
+            TS3_VECTOR stPosition = this->m_cServer.get_position(to_client_id(vArg[2]));
+            fDistance = sqrtf(stPosition.x * stPosition.x + stPosition.y * stPosition.y + stPosition.z * stPosition.z);
+        }
+        sActual   = rolloff(fDistance);
+        sExpected = vArg[3];
+    }
+    else if ((vArg[1] == "voice") && (vArg.size() == 4))
+    {
+        sActual   = play_voice(to_client_id(vArg[2]));
+        sExpected = vArg[3];
+    }
+    else if ((vArg[1] == "info") && (vArg.size() >= 5))
+    {
+        int iType = (vArg[2] == "channel") ? PLUGIN_CHANNEL : (vArg[2] == "client") ? PLUGIN_CLIENT : PLUGIN_SERVER;
+        uint64 nID = (iType == PLUGIN_SERVER) ? this->m_cServer.get_server_id() : (iType == PLUGIN_CLIENT) ? to_client_id(vArg[3]) : strtoull(vArg[3].c_str(), nullptr, 10);
+        std::string sText;
+        for (size_t ii = 4; ii < vArg.size(); ii++)
+            sText += (ii > 4 ? " " : "") + vArg[ii];
+        sExpected = sText;
+        sActual   = get_info(iType, nID);
+        if (sActual.find(sText) != std::string::npos)
+            sActual = sText;
+    }
+    else if ((vArg[1] == "log") && (vArg.size() >= 3))
+    {
+        std::string sText;
+        for (size_t ii = 2; ii < vArg.size(); ii++)
+            sText += (ii > 2 ? " " : "") + vArg[ii];
+        sExpected = sText;
+        for (const std::string& sEntry : this->m_cServer.get_log())
+            if (sEntry.find(sText) != std::string::npos)
+                sActual = sText;
+        if (sActual.empty())
+            sActual = "<not found>";
+    }
+    else
+    {
+        fprintf(stderr, "%s: invalid expect\n", this->m_sContext.c_str());
+        return false;
+    }
+
+    if (sActual != sExpected)
+    {
+        fprintf(stderr, "%s: expect %s: \"%s\", got \"%s\"\n", this->m_sContext.c_str(), vArg[1].c_str(), sExpected.c_str(), sActual.c_str());
+        return false;
+    }
+    return true;
+}
+
+/* ----------------------------------------------------------------------------
+* print state of the server
+*/
+void ts3_client_sim::print(const std::string& sWhat)
+{
+    if (sWhat == "whisper")
+    {
+        fprintf(stderr, "whisper channels %s, clients %s, ptt %d\n", join(this->m_cServer.get_whisper_channels()).c_str(), join(this->m_cServer.get_whisper_clients()).c_str(), this->m_cServer.get_input_active() ? 1 : 0);
+    }
+    else if ((sWhat == "log") || (sWhat == "chat"))
+    {
+        for (const std::string& sEntry : (sWhat == "log") ? this->m_cServer.get_log() : this->m_cServer.get_chat())
+            fprintf(stderr, "%s\n", sEntry.c_str());
+    }
+    else if (sWhat == "tree")
+    {
+        for (const sim_channel& cChannel : this->m_cServer.get_channels())
+        {
+            if (cChannel.bDeleted)
+                continue;
+            fprintf(stderr, "%*s%llu %s%s\n", 2 * (cChannel.iLevel - 1), "", (unsigned long long)cChannel.nChannelID, cChannel.sName.c_str(), (cChannel.nChannelID == this->m_cServer.get_my_channel_id()) ? " <= me" : "");
+            for (const sim_client& cClient : this->m_cServer.get_clients())
+                if (cClient.bConnected && (cClient.nChannelID == cChannel.nChannelID))
+                    fprintf(stderr, "%*s  - %u %s %s\n", 2 * (cChannel.iLevel - 1), "", (unsigned)cClient.nClientID, cClient.sName.c_str(), cClient.sMetaData.c_str());
+        }
+    }
+}
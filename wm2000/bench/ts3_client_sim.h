@@ -0,0 +1,85 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <istream>
+#include "bench/ts3_server_sim.h"
+
+/* ----------------------------------------------------------------------------
+* TS3 client around the plugin (headless build)
+*
+* loads the plugin through its ts3plugin_* exports like the TS3 client does,
+* changes the simulated server and sends the matching plugin events. Scripts
+* are text files with one command per line:
+*
+*   server    channels=N depth=N clients=N wm-ratio=PCT freqs=N freq-per-client=N seed=N
+*   path      <plugin path>           config <key>=<value> ... (config.xml, before load or reload)
+*   load                              connect / disconnect / unload / reload (config.xml)
+*   move      <client> <channel>      join <channel> <name> [meta data]
+*   leave     <client>                meta <client> <meta data>
+*   create    <parent> <name>         delete <channel>
+*   hotkey    <keyword>               bind <keyword> <key>
+*   talk      <client> <0|1> [whisper]
+*   wait      <ms>                    (real time passes, e.g. for talk times)
+*   menu      <global|channel|client> <menu ID> [<selected ID>]
+*   command   <text>
+*   expect    whisper <channel,..|-> [<client,..|->] / ptt <0|1> / muted <client> <0|1> / log <text>
+*             voice <client> <pass|attenuate|zero|radio>  (synthetic voice frames of the client, see play_voice)
+*             position <client> <degrees|center> / positions <number of channelset3DAttributes calls>
+*             rolloff <client|distance=N> <full|ts3>  (volume of the plugin rolloff at the client position)
+*             info <server|channel|client> <ID> <text>  (info text contains text, ID of the server is not used)
+*   print     whisper / log / chat / tree
+*
+* lines starting with '#' are comments, "me" can be used as own client ID.
+* All queued plugin events are processed after each command of a script.
+*/
+class ts3_client_sim
+{
+public:
+    ts3_client_sim();
+    ~ts3_client_sim();
+
+    ts3_server_sim*     get_server() { return &this->m_cServer; };
+
+    // plugin life cycle
+    void                create_server(const sim_server_param& cParam);
+    void                set_plugin_path(const std::string& sPluginPath);
+    bool                set_config(const std::string& sKey, const std::string& sValue);
+    bool                load();
+    bool                reload();
+    void                connect();
+    void                disconnect();
+    void                unload();
+
+    // events
+    bool                move_client(anyID nClientID, uint64 nChannelID);
+    anyID               join_client(uint64 nChannelID, const std::string& sName, const std::string& sMetaData);
+    bool                leave_client(anyID nClientID);
+    bool                set_meta_data(anyID nClientID, const std::string& sMetaData);
+    uint64              create_channel(uint64 nParentID, const std::string& sName);
+    bool                delete_channel(uint64 nChannelID);
+    void                hotkey(const std::string& sKeyword);
+    void                talk(anyID nClientID, bool bTalking, bool bWhisper);
+    std::string         play_voice(anyID nClientID);        // "pass", "attenuate", "zero" or "radio"
+    std::string         rolloff(float fDistance);           // "full", "ts3" (volume of TS3 kept) or the volume
+    void                menu(int iType, int iMenuID, uint64 nSelectedID);
+    int                 command(const std::string& sCommand);
+    std::string         get_info(int iType, uint64 nID);    // info text of the side window, empty if there is none
+
+    // scripts, returns number of failed commands / expectations
+    int                 run_script(std::istream& cScript, const std::string& sName);
+    bool                run_command(const std::string& sLine);
+
+protected:
+    bool                expect(std::vector<std::string>& vArg);
+    void                print(const std::string& sWhat);
+    anyID               to_client_id(const std::string& sText);
+
+private:
+    ts3_server_sim      m_cServer;
+    bool                m_bLoaded;
+    bool                m_bConnected;
+    std::string         m_sPluginPath;
+    std::string         m_sContext;         // script name and line for messages
+};
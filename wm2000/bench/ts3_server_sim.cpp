@@ -0,0 +1,621 @@
+#include "bench/ts3_server_sim.h"
+#include <string.h>
+#include <random>
+#include "teamspeak/public_errors.h"
+#include "teamspeak/public_definitions.h"
+#include "teamspeak/public_rare_definitions.h"
+#include "teamspeak/clientlib_publicdefinitions.h"
+
+ts3_server_sim *ts3_server_sim::s_pcActive = nullptr;
+
+// the plugin calls the TS3 functions from its work pool threads
+#define SIM_API_CALL std::lock_guard<std::recursive_mutex> cLock(s_pcActive->m_cMutex); s_pcActive->m_nApiCalls++;
+#define SIM_LOCK     std::lock_guard<std::recursive_mutex> cLock(this->m_cMutex);
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+ts3_server_sim::ts3_server_sim()
+{
+    this->m_nServerID           = 1;
+    this->m_nMyClientID         = 1;
+    this->m_nMyChannelID        = 0;
+    this->m_iInputDeactivated   = INPUT_DEACTIVATED;
+    this->m_nApiCalls           = 0;
+    this->m_nWhisperCalls       = 0;
+    this->m_nFlushCalls         = 0;
+    this->m_nPositionCalls      = 0;
+    this->m_bRecordCalls        = false;
+    this->m_nFlushError         = ERROR_ok;
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+ts3_server_sim::~ts3_server_sim()
+{
+    if (s_pcActive == this)
+        s_pcActive = nullptr;
+}
+
+/* ----------------------------------------------------------------------------
+* create random channel tree and clients
+*/
+void ts3_server_sim::create(const sim_server_param& cParam)
+{
+    std::mt19937 cRandom(cParam.nSeed);
+    int iMaxDepth = (cParam.iMaxDepth < 1) ? 1 : cParam.iMaxDepth;
+
+    // channel tree, parents are always created before their children
+    this->m_vChannel.clear();
+    std::vector<size_t> vParentCandidate;
+    for (int ii = 0; ii < cParam.iNumChannel; ii++)
+    {
+        sim_channel cChannel;
+        cChannel.nChannelID     = (uint64)ii + 1;
+        cChannel.nParentID      = 0;
+        cChannel.iLevel         = 1;
+        cChannel.bIsPermanent   = (cRandom() % 10) != 0;    // some temporary channels
+        cChannel.bDeleted       = false;
+
+        if (!vParentCandidate.empty() && ((cRandom() % iMaxDepth) != 0))
+        {
+            const sim_channel& cParent = this->m_vChannel[vParentCandidate[cRandom() % vParentCandidate.size()]];
+            cChannel.nParentID  = cParent.nChannelID;
+            cChannel.iLevel     = cParent.iLevel + 1;
+        }
+        cChannel.sName = "Channel " + std::to_string(cChannel.nChannelID) + " (level " + std::to_string(cChannel.iLevel) + ")";
+
+        if (cChannel.iLevel < iMaxDepth)
+            vParentCandidate.push_back(this->m_vChannel.size());
+        this->m_vChannel.push_back(cChannel);
+    }
+
+    // own client sits in the deepest channel
+    this->m_nMyChannelID = 0;
+    int iMyLevel = 0;
+    for (size_t ii = 0; ii < this->m_vChannel.size(); ii++)
+    {
+        if (this->m_vChannel[ii].iLevel > iMyLevel)
+        {
+            iMyLevel = this->m_vChannel[ii].iLevel;
+            this->m_nMyChannelID = this->m_vChannel[ii].nChannelID;
+        }
+    }
+
+    // other clients, a part of them uses WhisperMaster frequencies
+    this->m_vClient.clear();
+    for (int ii = 0; ii < cParam.iNumClient; ii++)
+    {
+        sim_client cClient;
+        cClient.nClientID   = (anyID)(ii + 2);
+        cClient.nChannelID  = this->m_vChannel.empty() ? 0 : this->m_vChannel[cRandom() % this->m_vChannel.size()].nChannelID;
+        cClient.bConnected  = true;
+        cClient.sName       = "Client " + std::to_string(cClient.nClientID);
+
+        if ((cParam.iNumFreq > 0) && ((int)(cRandom() % 100) < cParam.iWmClientRatio))
+        {
+            cClient.sMetaData = "#WhisperMaster2000[";
+            for (int jj = 0; jj < cParam.iFreqPerClient; jj++)
+                cClient.sMetaData += std::to_string(1 + cRandom() % cParam.iNumFreq) + ",";
+            if (cParam.iFreqPerClient <= 0)
+                cClient.sMetaData += ",";
+            cClient.sMetaData += "];";
+        }
+        this->m_vClient.push_back(cClient);
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* use this server for all TS3 interface functions
+*/
+void ts3_server_sim::activate()
+{
+    s_pcActive = this;
+}
+
+/* ----------------------------------------------------------------------------
+* function table like delivered by ts3plugin_setFunctionPointers
+*/
+struct TS3Functions ts3_server_sim::get_functions()
+{
+    struct TS3Functions stFunctions;
+    memset(&stFunctions, 0, sizeof(stFunctions));
+
+    stFunctions.freeMemory                          = freeMemory;
+    stFunctions.logMessage                          = logMessage;
+    stFunctions.getCurrentServerConnectionHandlerID = getCurrentServerConnectionHandlerID;
+    stFunctions.getClientID                         = getClientID;
+    stFunctions.getChannelList                      = getChannelList;
+    stFunctions.getChannelClientList                = getChannelClientList;
+    stFunctions.getClientList                       = getClientList;
+    stFunctions.getChannelOfClient                  = getChannelOfClient;
+    stFunctions.getParentChannelOfChannel           = getParentChannelOfChannel;
+    stFunctions.getChannelVariableAsInt             = getChannelVariableAsInt;
+    stFunctions.getChannelVariableAsString          = getChannelVariableAsString;
+    stFunctions.getClientVariableAsString           = getClientVariableAsString;
+    stFunctions.getClientSelfVariableAsString       = getClientSelfVariableAsString;
+    stFunctions.setClientSelfVariableAsString       = setClientSelfVariableAsString;
+    stFunctions.setClientSelfVariableAsInt          = setClientSelfVariableAsInt;
+    stFunctions.flushClientSelfUpdates              = flushClientSelfUpdates;
+    stFunctions.getServerVariableAsString           = getServerVariableAsString;
+    stFunctions.requestClientSetWhisperList         = requestClientSetWhisperList;
+    stFunctions.systemset3DListenerAttributes       = systemset3DListenerAttributes;
+    stFunctions.channelset3DAttributes              = channelset3DAttributes;
+    stFunctions.printMessageToCurrentTab            = printMessageToCurrentTab;
+    stFunctions.getAppPath                          = getAppPath;
+    stFunctions.getResourcesPath                    = getResourcesPath;
+    stFunctions.getConfigPath                       = getConfigPath;
+    stFunctions.getPluginPath                       = getPluginPath;
+    stFunctions.getHotkeyFromKeyword                = getHotkeyFromKeyword;
+    stFunctions.requestMuteClients                  = requestMuteClients;
+    stFunctions.requestUnmuteClients                = requestUnmuteClients;
+    stFunctions.allowWhispersFrom                   = allowWhispersFrom;
+    stFunctions.removeFromAllowedWhispersFrom       = removeFromAllowedWhispersFrom;
+    return stFunctions;
+}
+
+/* ----------------------------------------------------------------------------
+* helper
+*/
+const sim_channel* ts3_server_sim::find_channel(uint64 nChannelID)
+{
+    if ((nChannelID == 0) || (nChannelID > this->m_vChannel.size()) || this->m_vChannel[nChannelID - 1].bDeleted)
+        return nullptr;
+    return &this->m_vChannel[nChannelID - 1];
+}
+
+const sim_client* ts3_server_sim::find_client(anyID nClientID)
+{
+    if ((nClientID < 2) || ((size_t)(nClientID - 2) >= this->m_vClient.size()) || !this->m_vClient[nClientID - 2].bConnected)
+        return nullptr;
+    return &this->m_vClient[nClientID - 2];
+}
+
+void ts3_server_sim::copy_path(char* path, size_t maxLen, const std::string& sPath)
+{
+    if (maxLen == 0)
+        return;
+    size_t nLength = (sPath.size() < maxLen - 1) ? sPath.size() : maxLen - 1;
+    memcpy(path, sPath.c_str(), nLength);
+    path[nLength] = 0;
+}
+
+/* ----------------------------------------------------------------------------
+* change server
+*/
+uint64 ts3_server_sim::add_channel(uint64 nParentID, const std::string& sName, bool bIsPermanent)
+{
+    SIM_LOCK
+    const sim_channel *pcParent = find_channel(nParentID);
+    if ((nParentID != 0) && (pcParent == nullptr))
+        return 0;
+
+    sim_channel cChannel;
+    cChannel.nChannelID     = (uint64)this->m_vChannel.size() + 1;
+    cChannel.nParentID      = nParentID;
+    cChannel.iLevel         = (pcParent == nullptr) ? 1 : pcParent->iLevel + 1;
+    cChannel.bIsPermanent   = bIsPermanent;
+    cChannel.bDeleted       = false;
+    cChannel.sName          = sName;
+    this->m_vChannel.push_back(cChannel);
+    return cChannel.nChannelID;
+}
+
+bool ts3_server_sim::remove_channel(uint64 nChannelID)
+{
+    SIM_LOCK
+    if ((find_channel(nChannelID) == nullptr) || (this->m_nMyChannelID == nChannelID))
+        return false;
+    for (const sim_channel& cChannel : this->m_vChannel)
+        if (!cChannel.bDeleted && (cChannel.nParentID == nChannelID))
+            return false;
+    for (const sim_client& cClient : this->m_vClient)
+        if (cClient.bConnected && (cClient.nChannelID == nChannelID))
+            return false;
+
+    this->m_vChannel[nChannelID - 1].bDeleted = true;
+    return true;
+}
+
+bool ts3_server_sim::move_channel(uint64 nChannelID, uint64 nParentID)
+{
+    SIM_LOCK
+    if ((find_channel(nChannelID) == nullptr) || ((nParentID != 0) && (find_channel(nParentID) == nullptr)))
+        return false;
+    for (uint64 nID = nParentID; nID != 0; nID = this->m_vChannel[nID - 1].nParentID)
+        if (nID == nChannelID)
+            return false;       // into own sub tree
+
+    this->m_vChannel[nChannelID - 1].nParentID = nParentID;
+
+    // levels of the moved sub tree, parents are not always before their children anymore
+    bool bChanged = true;
+    while (bChanged)
+    {
+        bChanged = false;
+        for (sim_channel& cChannel : this->m_vChannel)
+        {
+            int iLevel = (cChannel.nParentID == 0) ? 1 : this->m_vChannel[cChannel.nParentID - 1].iLevel + 1;
+            if (cChannel.iLevel != iLevel)
+            {
+                cChannel.iLevel = iLevel;
+                bChanged = true;
+            }
+        }
+    }
+    return true;
+}
+
+anyID ts3_server_sim::add_client(uint64 nChannelID, const std::string& sName, const std::string& sMetaData)
+{
+    SIM_LOCK
+    if (find_channel(nChannelID) == nullptr)
+        return 0;
+
+    sim_client cClient;
+    cClient.nClientID   = (anyID)(this->m_vClient.size() + 2);
+    cClient.nChannelID  = nChannelID;
+    cClient.bConnected  = true;
+    cClient.sName       = sName;
+    cClient.sMetaData   = sMetaData;
+    this->m_vClient.push_back(cClient);
+    return cClient.nClientID;
+}
+
+bool ts3_server_sim::remove_client(anyID nClientID)
+{
+    SIM_LOCK
+    if (find_client(nClientID) == nullptr)
+        return false;
+    this->m_vClient[nClientID - 2].bConnected = false;
+    this->m_sMuted.erase(nClientID);
+    this->m_sAllowedWhisper.erase(nClientID);
+    this->m_mPosition.erase(nClientID);
+    return true;
+}
+
+TS3_VECTOR ts3_server_sim::get_position(anyID nClientID)
+{
+    SIM_LOCK
+    std::map<anyID, TS3_VECTOR>::const_iterator it = this->m_mPosition.find(nClientID);
+    if (it != this->m_mPosition.end())
+        return it->second;
+    TS3_VECTOR stOrigin = { 0.0f, 0.0f, 0.0f };
+    return stOrigin;
+}
+
+bool ts3_server_sim::move_client(anyID nClientID, uint64 nChannelID)
+{
+    SIM_LOCK
+    if (find_channel(nChannelID) == nullptr)
+        return false;
+    if (nClientID == this->m_nMyClientID)
+    {
+        this->m_nMyChannelID = nChannelID;
+        return true;
+    }
+    if (find_client(nClientID) == nullptr)
+        return false;
+    this->m_vClient[nClientID - 2].nChannelID = nChannelID;
+    return true;
+}
+
+bool ts3_server_sim::set_meta_data(anyID nClientID, const std::string& sMetaData)
+{
+    SIM_LOCK
+    if (nClientID == this->m_nMyClientID)
+    {
+        this->m_sMyMetaData = sMetaData;
+        return true;
+    }
+    if (find_client(nClientID) == nullptr)
+        return false;
+    this->m_vClient[nClientID - 2].sMetaData = sMetaData;
+    return true;
+}
+
+char* ts3_server_sim::copy_string(const std::string& sText)
+{
+    char *pcResult = (char*)malloc(sText.size() + 1);
+    memcpy(pcResult, sText.c_str(), sText.size() + 1);
+    return pcResult;
+}
+
+/* ----------------------------------------------------------------------------
+* TS3 interface, memory is allocated with malloc and released by freeMemory
+*/
+unsigned int ts3_server_sim::freeMemory(void* pointer)
+{
+    free(pointer);
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::logMessage(const char* logMessage, enum LogLevel severity, const char* channel, uint64 logID)
+{
+    static const char* s_apcSeverity[] = { "CRITICAL", "ERROR", "WARNING", "DEBUG", "INFO", "DEVEL" };
+    SIM_API_CALL
+    std::string sEntry = ((severity >= LogLevel_CRITICAL) && (severity <= LogLevel_DEVEL)) ? s_apcSeverity[severity - LogLevel_CRITICAL] : "?";
+    s_pcActive->m_vLog.push_back(sEntry + " " + (channel ? channel : "") + ": " + (logMessage ? logMessage : ""));
+    return ERROR_ok;
+}
+
+uint64 ts3_server_sim::getCurrentServerConnectionHandlerID()
+{
+    SIM_API_CALL
+    return s_pcActive->m_nServerID;
+}
+
+unsigned int ts3_server_sim::getClientID(uint64 serverConnectionHandlerID, anyID* result)
+{
+    SIM_API_CALL
+    *result = s_pcActive->m_nMyClientID;
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::getChannelList(uint64 serverConnectionHandlerID, uint64** result)
+{
+    SIM_API_CALL
+    std::vector<sim_channel>& vChannel = s_pcActive->m_vChannel;
+    *result = (uint64*)malloc((vChannel.size() + 1) * sizeof(uint64));
+    size_t nCount = 0;
+    for (size_t ii = 0; ii < vChannel.size(); ii++)
+        if (!vChannel[ii].bDeleted)
+            (*result)[nCount++] = vChannel[ii].nChannelID;
+    (*result)[nCount] = 0;
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::getChannelClientList(uint64 serverConnectionHandlerID, uint64 channelID, anyID** result)
+{
+    SIM_API_CALL
+    std::vector<anyID> vResult;
+    if (s_pcActive->m_nMyChannelID == channelID)
+        vResult.push_back(s_pcActive->m_nMyClientID);
+    for (size_t ii = 0; ii < s_pcActive->m_vClient.size(); ii++)
+        if (s_pcActive->m_vClient[ii].bConnected && (s_pcActive->m_vClient[ii].nChannelID == channelID))
+            vResult.push_back(s_pcActive->m_vClient[ii].nClientID);
+    vResult.push_back(0);
+
+    *result = (anyID*)malloc(vResult.size() * sizeof(anyID));
+    memcpy(*result, vResult.data(), vResult.size() * sizeof(anyID));
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::getClientList(uint64 serverConnectionHandlerID, anyID** result)
+{
+    SIM_API_CALL
+    std::vector<sim_client>& vClient = s_pcActive->m_vClient;
+    *result = (anyID*)malloc((vClient.size() + 2) * sizeof(anyID));
+    size_t nCount = 0;
+    (*result)[nCount++] = s_pcActive->m_nMyClientID;
+    for (size_t ii = 0; ii < vClient.size(); ii++)
+        if (vClient[ii].bConnected)
+            (*result)[nCount++] = vClient[ii].nClientID;
+    (*result)[nCount] = 0;
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::getChannelOfClient(uint64 serverConnectionHandlerID, anyID clientID, uint64* result)
+{
+    SIM_API_CALL
+    if (clientID == s_pcActive->m_nMyClientID)
+    {
+        *result = s_pcActive->m_nMyChannelID;
+        return ERROR_ok;
+    }
+    const sim_client *pcClient = s_pcActive->find_client(clientID);
+    if (pcClient == nullptr)
+        return ERROR_client_invalid_id;
+    *result = pcClient->nChannelID;
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::getParentChannelOfChannel(uint64 serverConnectionHandlerID, uint64 channelID, uint64* result)
+{
+    SIM_API_CALL
+    const sim_channel *pcChannel = s_pcActive->find_channel(channelID);
+    if (pcChannel == nullptr)
+        return ERROR_channel_invalid_id;
+    *result = pcChannel->nParentID;
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::getChannelVariableAsInt(uint64 serverConnectionHandlerID, uint64 channelID, size_t flag, int* result)
+{
+    SIM_API_CALL
+    const sim_channel *pcChannel = s_pcActive->find_channel(channelID);
+    if (pcChannel == nullptr)
+        return ERROR_channel_invalid_id;
+    *result = (flag == CHANNEL_FLAG_PERMANENT) ? pcChannel->bIsPermanent : 0;
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::getChannelVariableAsString(uint64 serverConnectionHandlerID, uint64 channelID, size_t flag, char** result)
+{
+    SIM_API_CALL
+    const sim_channel *pcChannel = s_pcActive->find_channel(channelID);
+    if (pcChannel == nullptr)
+        return ERROR_channel_invalid_id;
+    *result = copy_string((flag == CHANNEL_NAME) ? pcChannel->sName : std::string());
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::getClientVariableAsString(uint64 serverConnectionHandlerID, anyID clientID, size_t flag, char** result)
+{
+    SIM_API_CALL
+    if (clientID == s_pcActive->m_nMyClientID)
+        return getClientSelfVariableAsString(serverConnectionHandlerID, flag, result);
+
+    const sim_client *pcClient = s_pcActive->find_client(clientID);
+    if (pcClient == nullptr)
+        return ERROR_client_invalid_id;
+    if (flag == CLIENT_NICKNAME)
+        *result = copy_string(pcClient->sName);
+    else if (flag == CLIENT_META_DATA)
+        *result = copy_string(pcClient->sMetaData);
+    else
+        *result = copy_string(std::string());
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::getClientSelfVariableAsString(uint64 serverConnectionHandlerID, size_t flag, char** result)
+{
+    SIM_API_CALL
+    if (flag == CLIENT_NICKNAME)
+        *result = copy_string("Me");
+    else if (flag == CLIENT_META_DATA)
+        *result = copy_string(s_pcActive->m_sMyMetaData);
+    else
+        *result = copy_string(std::string());
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::setClientSelfVariableAsString(uint64 serverConnectionHandlerID, size_t flag, const char* value)
+{
+    SIM_API_CALL
+    if (flag == CLIENT_META_DATA)
+        s_pcActive->m_sMyMetaData = value;
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::setClientSelfVariableAsInt(uint64 serverConnectionHandlerID, size_t flag, int value)
+{
+    SIM_API_CALL
+    if (flag == CLIENT_INPUT_DEACTIVATED)
+    {
+        s_pcActive->m_iInputDeactivated = value;
+        if (s_pcActive->m_bRecordCalls)
+            s_pcActive->m_vCall.push_back((value == INPUT_ACTIVE) ? "ptt 1" : "ptt 0");
+    }
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::flushClientSelfUpdates(uint64 serverConnectionHandlerID, const char* returnCode)
+{
+    SIM_API_CALL
+    s_pcActive->m_nFlushCalls++;
+    if (s_pcActive->m_bRecordCalls)
+        s_pcActive->m_vCall.push_back("flush");
+    return s_pcActive->m_nFlushError;
+}
+
+unsigned int ts3_server_sim::getServerVariableAsString(uint64 serverConnectionHandlerID, size_t flag, char** result)
+{
+    SIM_API_CALL
+    *result = copy_string((flag == VIRTUALSERVER_NAME) ? "Simulated server" : "");
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::requestClientSetWhisperList(uint64 serverConnectionHandlerID, anyID clientID, const uint64* targetChannelIDArray, const anyID* targetClientIDArray, const char* returnCode)
+{
+    SIM_API_CALL
+    s_pcActive->m_nWhisperCalls++;
+    s_pcActive->m_vWhisperChannel.clear();
+    s_pcActive->m_vWhisperClient.clear();
+    for (int ii = 0; (targetChannelIDArray != nullptr) && (targetChannelIDArray[ii] != 0); ii++)
+        s_pcActive->m_vWhisperChannel.push_back(targetChannelIDArray[ii]);
+    for (int ii = 0; (targetClientIDArray != nullptr) && (targetClientIDArray[ii] != 0); ii++)
+        s_pcActive->m_vWhisperClient.push_back(targetClientIDArray[ii]);
+
+    if (s_pcActive->m_bRecordCalls)
+    {
+        std::string sCall = "whisper ";
+        for (size_t ii = 0; ii < s_pcActive->m_vWhisperChannel.size(); ii++)
+            sCall += (ii ? "," : "") + std::to_string(s_pcActive->m_vWhisperChannel[ii]);
+        sCall += s_pcActive->m_vWhisperChannel.empty() ? "- " : " ";
+        for (size_t ii = 0; ii < s_pcActive->m_vWhisperClient.size(); ii++)
+            sCall += (ii ? "," : "") + std::to_string(s_pcActive->m_vWhisperClient[ii]);
+        sCall += s_pcActive->m_vWhisperClient.empty() ? "-" : "";
+        s_pcActive->m_vCall.push_back(sCall);
+    }
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::systemset3DListenerAttributes(uint64 serverConnectionHandlerID, const TS3_VECTOR* position, const TS3_VECTOR* forward, const TS3_VECTOR* up)
+{
+    SIM_API_CALL
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::channelset3DAttributes(uint64 serverConnectionHandlerID, anyID clientID, const TS3_VECTOR* position)
+{
+    SIM_API_CALL
+    if ((position == nullptr) || (s_pcActive->find_client(clientID) == nullptr))
+        return ERROR_client_invalid_id;
+    s_pcActive->m_nPositionCalls++;
+    s_pcActive->m_mPosition[clientID] = *position;
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::printMessageToCurrentTab(const char* message)
+{
+    SIM_API_CALL
+    s_pcActive->m_vChat.push_back(message);
+    return ERROR_ok;
+}
+
+void ts3_server_sim::getAppPath(char* path, size_t maxLen)
+{
+    SIM_API_CALL
+    copy_path(path, maxLen, "");
+}
+
+void ts3_server_sim::getResourcesPath(char* path, size_t maxLen)
+{
+    SIM_API_CALL
+    copy_path(path, maxLen, "");
+}
+
+void ts3_server_sim::getConfigPath(char* path, size_t maxLen)
+{
+    SIM_API_CALL
+    copy_path(path, maxLen, s_pcActive->m_sPluginPath);
+}
+
+void ts3_server_sim::getPluginPath(char* path, size_t maxLen, const char* pluginID)
+{
+    SIM_API_CALL
+    copy_path(path, maxLen, s_pcActive->m_sPluginPath);
+}
+
+unsigned int ts3_server_sim::getHotkeyFromKeyword(const char* pluginID, const char** keywords, char** hotkeys, size_t arrayLen, size_t hotkeyBufSize)
+{
+    SIM_API_CALL
+    for (size_t ii = 0; ii < arrayLen; ii++)
+    {
+        std::map<std::string, std::string>::iterator it = s_pcActive->m_mHotkey.find(keywords[ii]);
+        copy_path(hotkeys[ii], hotkeyBufSize, (it == s_pcActive->m_mHotkey.end()) ? std::string() : it->second);
+    }
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::requestMuteClients(uint64 serverConnectionHandlerID, const anyID* clientIDArray, const char* returnCode)
+{
+    SIM_API_CALL
+    for (int ii = 0; (clientIDArray != nullptr) && (clientIDArray[ii] != 0); ii++)
+        s_pcActive->m_sMuted.insert(clientIDArray[ii]);
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::requestUnmuteClients(uint64 serverConnectionHandlerID, const anyID* clientIDArray, const char* returnCode)
+{
+    SIM_API_CALL
+    for (int ii = 0; (clientIDArray != nullptr) && (clientIDArray[ii] != 0); ii++)
+        s_pcActive->m_sMuted.erase(clientIDArray[ii]);
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::allowWhispersFrom(uint64 serverConnectionHandlerID, anyID clID)
+{
+    SIM_API_CALL
+    s_pcActive->m_sAllowedWhisper.insert(clID);
+    return ERROR_ok;
+}
+
+unsigned int ts3_server_sim::removeFromAllowedWhispersFrom(uint64 serverConnectionHandlerID, anyID clID)
+{
+    SIM_API_CALL
+    s_pcActive->m_sAllowedWhisper.erase(clID);
+    return ERROR_ok;
+}
@@ -0,0 +1,172 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <mutex>
+#include <atomic>
+#include "ts3_functions.h"
+#include "teamspeak/public_definitions.h"
+
+/* ----------------------------------------------------------------------------
+* size of the simulated server
+*/
+struct sim_server_param
+{
+    int         iNumChannel;        // number of channels
+    int         iMaxDepth;          // max. channel level (1 => top level channels only)
+    int         iNumClient;         // number of other clients
+    int         iWmClientRatio;     // percentage of clients using WhisperMaster meta data
+    int         iNumFreq;           // frequencies 1..iNumFreq are used by clients
+    int         iFreqPerClient;     // frequencies per WhisperMaster client
+    unsigned    nSeed;              // random seed, same seed => same server
+};
+
+struct sim_channel
+{
+    uint64      nChannelID;
+    uint64      nParentID;          // 0 => top level
+    int         iLevel;             // 1 => top level
+    bool        bIsPermanent;
+    bool        bDeleted;           // IDs are not reused, deleted channels stay in the list
+    std::string sName;
+};
+
+struct sim_client
+{
+    anyID       nClientID;
+    uint64      nChannelID;
+    bool        bConnected;         // IDs are not reused, disconnected clients stay in the list
+    std::string sName;
+    std::string sMetaData;
+};
+
+/* ----------------------------------------------------------------------------
+* in-memory server behind a TS3Functions table
+*
+* the TS3 interface uses plain function pointers, so the functions work on the
+* server that was activated last (see activate). The change functions only
+* update the server, plugin events are sent by ts3_client_sim. TS3 functions
+* and changes are locked, the getters are only safe after wm2000_flush_events.
+*/
+class ts3_server_sim
+{
+public:
+    ts3_server_sim();
+    ~ts3_server_sim();
+
+    void                create(const sim_server_param& cParam);
+    void                activate();
+    struct TS3Functions get_functions();
+
+    uint64              get_server_id()     { return this->m_nServerID; };
+    anyID               get_my_client_id()  { return this->m_nMyClientID; };
+    uint64              get_my_channel_id() { return this->m_nMyChannelID; };
+    void                set_my_channel_id(uint64 nChannelID) { std::lock_guard<std::recursive_mutex> cLock(this->m_cMutex); this->m_nMyChannelID = nChannelID; };
+
+    const std::vector<sim_channel>& get_channels() { return this->m_vChannel; };
+    const std::vector<sim_client>&  get_clients()  { return this->m_vClient; };
+    const sim_channel*  find_channel(uint64 nChannelID);
+    const sim_client*   find_client(anyID nClientID);
+
+    // change server, returns 0 / false if IDs are invalid
+    uint64              add_channel(uint64 nParentID, const std::string& sName, bool bIsPermanent = true);
+    bool                remove_channel(uint64 nChannelID);      // only empty channels without sub channels
+    bool                move_channel(uint64 nChannelID, uint64 nParentID);
+    anyID               add_client(uint64 nChannelID, const std::string& sName, const std::string& sMetaData = std::string());
+    bool                remove_client(anyID nClientID);
+    bool                move_client(anyID nClientID, uint64 nChannelID);
+    bool                set_meta_data(anyID nClientID, const std::string& sMetaData);
+
+    // client environment
+    void                set_plugin_path(const std::string& sPath) { this->m_sPluginPath = sPath; };
+    void                bind_hotkey(const std::string& sKeyword, const std::string& sKey) { this->m_mHotkey[sKeyword] = sKey; };
+
+    // state set by the plugin
+    const std::vector<uint64>&      get_whisper_channels() { return this->m_vWhisperChannel; };
+    const std::vector<anyID>&       get_whisper_clients()  { return this->m_vWhisperClient; };
+    bool                            get_input_active()     { return this->m_iInputDeactivated == INPUT_ACTIVE; };
+    const std::string&              get_my_meta_data()     { return this->m_sMyMetaData; };
+    bool                            is_muted(anyID nClientID)           { return this->m_sMuted.count(nClientID) != 0; };
+    bool                            is_whisper_allowed(anyID nClientID) { return this->m_sAllowedWhisper.count(nClientID) != 0; };
+    TS3_VECTOR                      get_position(anyID nClientID);      // channelset3DAttributes, origin if never set
+    const std::vector<std::string>& get_calls()            { return this->m_vCall; };
+    void                            clear_calls()          { this->m_vCall.clear(); };
+    const std::vector<std::string>& get_log()              { return this->m_vLog; };
+    const std::vector<std::string>& get_chat()             { return this->m_vChat; };
+    void                            clear_log()            { this->m_vLog.clear(); this->m_vChat.clear(); };
+
+    // statistics
+    std::atomic<size_t> m_nApiCalls;        // number of TS3 function calls (also from the work pool)
+    size_t              m_nWhisperCalls;    // number of requestClientSetWhisperList calls
+    size_t              m_nFlushCalls;      // number of flushClientSelfUpdates calls
+    size_t              m_nPositionCalls;   // number of channelset3DAttributes calls
+
+    // whisper list and PTT calls, "whisper <channel,..|-> <client,..|->", "ptt <0|1>" and "flush"
+    bool                m_bRecordCalls;     // record calls in get_calls (off for benchmarks)
+    unsigned int        m_nFlushError;      // returned by flushClientSelfUpdates, ERROR_ok by default
+
+    std::recursive_mutex m_cMutex;          // TS3 functions and changes, the plugin uses a work pool
+
+protected:
+    static char*        copy_string(const std::string& sText);
+    static void         copy_path(char* path, size_t maxLen, const std::string& sPath);
+
+    // TS3 interface
+    static unsigned int freeMemory(void* pointer);
+    static unsigned int logMessage(const char* logMessage, enum LogLevel severity, const char* channel, uint64 logID);
+    static uint64       getCurrentServerConnectionHandlerID();
+    static unsigned int getClientID(uint64 serverConnectionHandlerID, anyID* result);
+    static unsigned int getChannelList(uint64 serverConnectionHandlerID, uint64** result);
+    static unsigned int getChannelClientList(uint64 serverConnectionHandlerID, uint64 channelID, anyID** result);
+    static unsigned int getClientList(uint64 serverConnectionHandlerID, anyID** result);
+    static unsigned int getChannelOfClient(uint64 serverConnectionHandlerID, anyID clientID, uint64* result);
+    static unsigned int getParentChannelOfChannel(uint64 serverConnectionHandlerID, uint64 channelID, uint64* result);
+    static unsigned int getChannelVariableAsInt(uint64 serverConnectionHandlerID, uint64 channelID, size_t flag, int* result);
+    static unsigned int getChannelVariableAsString(uint64 serverConnectionHandlerID, uint64 channelID, size_t flag, char** result);
+    static unsigned int getClientVariableAsString(uint64 serverConnectionHandlerID, anyID clientID, size_t flag, char** result);
+    static unsigned int getClientSelfVariableAsString(uint64 serverConnectionHandlerID, size_t flag, char** result);
+    static unsigned int setClientSelfVariableAsString(uint64 serverConnectionHandlerID, size_t flag, const char* value);
+    static unsigned int setClientSelfVariableAsInt(uint64 serverConnectionHandlerID, size_t flag, int value);
+    static unsigned int flushClientSelfUpdates(uint64 serverConnectionHandlerID, const char* returnCode);
+    static unsigned int getServerVariableAsString(uint64 serverConnectionHandlerID, size_t flag, char** result);
+    static unsigned int requestClientSetWhisperList(uint64 serverConnectionHandlerID, anyID clientID, const uint64* targetChannelIDArray, const anyID* targetClientIDArray, const char* returnCode);
+    static unsigned int systemset3DListenerAttributes(uint64 serverConnectionHandlerID, const TS3_VECTOR* position, const TS3_VECTOR* forward, const TS3_VECTOR* up);
+    static unsigned int channelset3DAttributes(uint64 serverConnectionHandlerID, anyID clientID, const TS3_VECTOR* position);
+    static unsigned int printMessageToCurrentTab(const char* message);
+    static void         getAppPath(char* path, size_t maxLen);
+    static void         getResourcesPath(char* path, size_t maxLen);
+    static void         getConfigPath(char* path, size_t maxLen);
+    static void         getPluginPath(char* path, size_t maxLen, const char* pluginID);
+    static unsigned int getHotkeyFromKeyword(const char* pluginID, const char** keywords, char** hotkeys, size_t arrayLen, size_t hotkeyBufSize);
+    static unsigned int requestMuteClients(uint64 serverConnectionHandlerID, const anyID* clientIDArray, const char* returnCode);
+    static unsigned int requestUnmuteClients(uint64 serverConnectionHandlerID, const anyID* clientIDArray, const char* returnCode);
+    static unsigned int allowWhispersFrom(uint64 serverConnectionHandlerID, anyID clID);
+    static unsigned int removeFromAllowedWhispersFrom(uint64 serverConnectionHandlerID, anyID clID);
+
+private:
+    static ts3_server_sim *s_pcActive;      // server used by the TS3 interface functions
+
+    uint64                  m_nServerID;
+    anyID                   m_nMyClientID;
+    uint64                  m_nMyChannelID;
+    std::string             m_sMyMetaData;
+    int                     m_iInputDeactivated;
+
+    std::vector<sim_channel> m_vChannel;    // index = channel ID - 1
+    std::vector<sim_client>  m_vClient;     // index = client ID - 2 (own client is ID 1)
+
+    std::string              m_sPluginPath;
+    std::map<std::string, std::string> m_mHotkey;   // keyword => key
+    std::vector<uint64>      m_vWhisperChannel;     // last whisper list
+    std::vector<anyID>       m_vWhisperClient;
+    std::set<anyID>          m_sMuted;
+    std::set<anyID>          m_sAllowedWhisper;
+    std::map<anyID, TS3_VECTOR> m_mPosition;        // 3D position per client
+    std::vector<std::string> m_vLog;                // logMessage, "<severity> <channel>: <text>"
+    std::vector<std::string> m_vChat;               // printMessageToCurrentTab
+    std::vector<std::string> m_vCall;               // recorded calls (m_bRecordCalls)
+};
@@ -0,0 +1,110 @@
+/* ----------------------------------------------------------------------------
+* refresh rate of the main UI under an event burst
+*
+* a second thread calls request_update_ui 1000 times (like the event thread
+* does for a burst of client events), the refreshes on the GUI thread are
+* counted. The exit code is 1 if more than UiRefreshRate refreshes fall into
+* one second or the last request is not followed by a refresh.
+*
+*   wm2000_ui_refresh_test [<dir>]
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <sys/stat.h>
+#include <QtWidgets/QApplication>
+#include "ui/wm2000_main_ui_actions.h"
+
+#define TEST_REQUESTS       1000
+#define TEST_REQUEST_US     2000        // time between requests, burst of 2 s
+#define TEST_REFRESH_RATE   10
+
+/* ----------------------------------------------------------------------------
+* main UI that records the time of every refresh instead of updating the widgets
+*/
+class refresh_counter :
+    public wm2000_main_ui_actions
+{
+public:
+    refresh_counter(config_container *pcConfigData, void(*fUpdate_server)(), std::string sConfigPath)
+        : wm2000_main_ui_actions(pcConfigData, fUpdate_server, sConfigPath) { this->m_cClock.start(); };
+
+    void update_ui() override { this->m_vRefresh_ms.push_back(this->m_cClock.elapsed()); };
+
+    QElapsedTimer           m_cClock;           // started with the UI
+    std::vector<qint64>     m_vRefresh_ms;      // time of each refresh
+};
+
+static void update_server()
+{
+}
+
+int main(int argc, char* argv[])
+{
+    std::string sPath = (argc > 1) ? std::string(argv[1]) : std::string("ui_refresh_test");
+    sPath += "/";
+    mkdir(sPath.c_str(), 0755);
+
+    // config with a known refresh rate, the UI loads it instead of asking for a predefined one
+    config_container cConfig;
+    remove((sPath + "config.xml").c_str());
+    cConfig.s_read_param(sPath + "config.xml");
+    cConfig.s_set_UiRefreshRate(TEST_REFRESH_RATE);
+    cConfig.s_write_param(sPath + "config.xml");
+
+    if (qgetenv("QT_QPA_PLATFORM").isEmpty())
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication cApp(argc, argv);
+    refresh_counter cUi(&cConfig, update_server, sPath);
+
+    // burst from the event thread
+    std::atomic<bool> bDone(false);
+    std::atomic<qint64> nLastRequest_ms(0);
+    std::thread cEvents([&]()
+    {
+        for (int ii = 0; ii < TEST_REQUESTS; ii++)
+        {
+            nLastRequest_ms = cUi.m_cClock.elapsed();
+            cUi.request_update_ui();
+            std::this_thread::sleep_for(std::chrono::microseconds(TEST_REQUEST_US));
+        }
+        bDone = true;
+    });
+
+    // stop two refresh intervals after the burst
+    QTimer cPoll;
+    QObject::connect(&cPoll, &QTimer::timeout, [&]()
+    {
+        if (bDone && (cUi.m_cClock.elapsed() > nLastRequest_ms + 2 * 1000 / TEST_REFRESH_RATE))
+            cApp.quit();
+    });
+    cPoll.start(10);
+    cApp.exec();
+    cEvents.join();
+
+    // refreshes within one second, starting at each refresh
+    const std::vector<qint64>& vRefresh = cUi.m_vRefresh_ms;
+    size_t nMaxPerSecond = 0;
+    for (size_t ii = 0, jj = 0; ii < vRefresh.size(); ii++)
+    {
+        while ((jj < vRefresh.size()) && (vRefresh[jj] < vRefresh[ii] + 1000))
+            jj++;
+        if (jj - ii > nMaxPerSecond)
+            nMaxPerSecond = jj - ii;
+    }
+    bool bRateOk = nMaxPerSecond <= TEST_REFRESH_RATE;
+    bool bLastOk = !vRefresh.empty() && (vRefresh.back() >= nLastRequest_ms);
+
+    printf("%s  %d requests, %d refreshes, max. %d per second (UiRefreshRate %d)\n", bRateOk ? "ok    " : "FAILED",
+        TEST_REQUESTS, (int)vRefresh.size(), (int)nMaxPerSecond, TEST_REFRESH_RATE);
+    printf("%s  last refresh at %lld ms, last request at %lld ms\n", bLastOk ? "ok    " : "FAILED",
+        (long long)(vRefresh.empty() ? -1 : vRefresh.back()), (long long)nLastRequest_ms.load());
+
+    int iFailed = (bRateOk ? 0 : 1) + (bLastOk ? 0 : 1);
+    fprintf(stderr, "%s: %d failed\n", iFailed ? "FAILED" : "passed", iFailed);
+    return iFailed ? 1 : 0;
+}
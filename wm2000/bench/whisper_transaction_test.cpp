@@ -0,0 +1,141 @@
+/* ----------------------------------------------------------------------------
+* whisper_transaction against the recording TS3 stub of ts3_server_sim
+*
+* every step is one hotkey transition, the TS3 calls it causes are compared
+* with the expected sequence. The exit code is 1 if a sequence differs.
+*
+*   wm2000_whisper_test
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "bench/ts3_server_sim.h"
+#include "misc/whisper_transaction.h"
+#include "teamspeak/public_errors.h"
+
+static int s_iFailed = 0;
+
+/* ----------------------------------------------------------------------------
+* helper
+*/
+static std::string join(const std::vector<std::string>& vCall)
+{
+    std::string sText;
+    for (size_t ii = 0; ii < vCall.size(); ii++)
+        sText += (ii ? ", " : "") + vCall[ii];
+    return vCall.empty() ? std::string("(none)") : sText;
+}
+
+static void check(ts3_server_sim& cServer, const char* pcStep, const std::vector<std::string>& vExpected)
+{
+    const std::vector<std::string>& vCall = cServer.get_calls();
+    if (vCall == vExpected)
+        printf("ok      %-22s %s\n", pcStep, join(vCall).c_str());
+    else
+    {
+        printf("FAILED  %-22s expected %s, got %s\n", pcStep, join(vExpected).c_str(), join(vCall).c_str());
+        s_iFailed++;
+    }
+    cServer.clear_calls();
+}
+
+static void check_ptt(whisper_transaction& cTransaction, const char* pcStep, bool bExpected)
+{
+    if (cTransaction.get_ptt() != bExpected)
+    {
+        printf("FAILED  %-22s PTT state %d, expected %d\n", pcStep, cTransaction.get_ptt(), bExpected);
+        s_iFailed++;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    ts3_server_sim cServer;
+    cServer.activate();
+    cServer.m_bRecordCalls = true;
+    struct TS3Functions stFunctions = cServer.get_functions();
+    language_pkg cTranslate;
+
+    const uint64 anChannelA[] = { 3, 4, 0 };
+    const uint64 anChannelB[] = { 5, 0 };
+    const anyID  anClientB[]  = { 7, 0 };
+
+    whisper_transaction cTransaction;
+    cTransaction.init(&stFunctions, &cTranslate, cServer.get_server_id(), cServer.get_my_client_id());
+
+    // the whisper list of TS3 is unknown at first, the reset is sent once
+    cTransaction.begin();
+    cTransaction.reset_whisper_list();
+    cTransaction.commit();
+    check(cServer, "reset", { "whisper - -" });
+
+    cTransaction.begin();
+    cTransaction.reset_whisper_list();
+    cTransaction.commit();
+    check(cServer, "reset again", { });
+
+    // press: targets before PTT
+    cTransaction.begin();
+    cTransaction.set_whisper_list(anChannelA, nullptr);
+    cTransaction.set_ptt(true);
+    cTransaction.commit();
+    check(cServer, "press", { "whisper 3,4 -", "ptt 1", "flush" });
+    check_ptt(cTransaction, "press", true);
+
+    // profile switch mid-press: only the targets change
+    cTransaction.begin();
+    cTransaction.set_whisper_list(anChannelB, anClientB);
+    cTransaction.set_ptt(true);
+    cTransaction.commit();
+    check(cServer, "mid-press switch", { "whisper 5 7" });
+
+    cTransaction.begin();
+    cTransaction.set_whisper_list(anChannelB, anClientB);
+    cTransaction.set_ptt(true);
+    cTransaction.commit();
+    check(cServer, "unchanged", { });
+
+    // release: PTT before the targets
+    cTransaction.begin();
+    cTransaction.set_ptt(false);
+    cTransaction.reset_whisper_list();
+    cTransaction.commit();
+    check(cServer, "release", { "ptt 0", "flush", "whisper - -" });
+    check_ptt(cTransaction, "release", false);
+
+    // press and release within one transition send nothing
+    cTransaction.begin();
+    cTransaction.set_whisper_list(anChannelA, nullptr);
+    cTransaction.set_ptt(true);
+    cTransaction.set_ptt(false);
+    cTransaction.reset_whisper_list();
+    cTransaction.commit();
+    check(cServer, "toggle", { });
+
+    // activation that can't be flushed is released once
+    size_t nLog = cServer.get_log().size();
+    cServer.m_nFlushError = ERROR_not_connected;
+    cTransaction.begin();
+    cTransaction.set_whisper_list(anChannelA, nullptr);
+    cTransaction.set_ptt(true);
+    cTransaction.commit();
+    check(cServer, "flush failure", { "whisper 3,4 -", "ptt 1", "flush", "ptt 0", "flush" });
+    check_ptt(cTransaction, "flush failure", false);
+    if (cServer.get_log().size() == nLog)
+    {
+        printf("FAILED  %-22s no warning logged\n", "flush failure");
+        s_iFailed++;
+    }
+
+    // next press only activates PTT, the targets are still set
+    cServer.m_nFlushError = ERROR_ok;
+    cTransaction.begin();
+    cTransaction.set_whisper_list(anChannelA, nullptr);
+    cTransaction.set_ptt(true);
+    cTransaction.commit();
+    check(cServer, "press after failure", { "ptt 1", "flush" });
+
+    fprintf(stderr, "%s: %d failed\n", s_iFailed ? "FAILED" : "passed", s_iFailed);
+    return s_iFailed ? 1 : 0;
+}
@@ -154,9 +154,20 @@ uint64 * channel_filter::filter_channel_from_list(std::vector<channel_info>* plC
 */
 bool channel_filter::validate_channel_list(std::vector<channel_info>* plChList)
 {
-    // increment InvalidCount for all entrys
-    for (size_t ii = 1; ii < (*plChList).size(); ii++)
-        (*plChList)[ii].iInvalidCount++;
+    std::vector<char> vbFound;
+    bool bResult = find_channels_in_list(plChList, vbFound);
+
+    update_invalid_count(plChList, vbFound);
+    return bResult;
+}
+
+/* ----------------------------------------------------------------------------
+* Mark which channels of the list exist on this server, the list is not changed.
+* Only reads from TS3, can be called for several servers in parallel.
+*/
+bool channel_filter::find_channels_in_list(std::vector<channel_info>* plChList, std::vector<char>& vbFound)
+{
+    vbFound.assign(plChList->size(), 0);
 
     // get actual channel list
     uint64* pnFullChannelList;
@@ -164,37 +175,46 @@ bool channel_filter::validate_channel_list(std::vector<channel_info>* plChList)
     {
         return false;
     }
-    size_t nCountChannel = 0;
-    while (pnFullChannelList[nCountChannel] != 0)
-        nCountChannel++;
 
     // find coresponding channels in list (reverse search)
     int nEntryIndex;
-    for (size_t ii = 0; ii < nCountChannel; ii++)
+    for (size_t ii = 0; pnFullChannelList[ii] != 0; ii++)
     {
         nEntryIndex = this->m_pConfigContainer->s_find_entry(plChList, get_channel_info(pnFullChannelList[ii]));
-
-        // channel was found, set InvalidCount to 0
-        if (nEntryIndex > 0)
-            (*plChList)[nEntryIndex].iInvalidCount = 0;
+        if ((nEntryIndex > 0) && (nEntryIndex < (int)vbFound.size()))
+            vbFound[nEntryIndex] = 1;
     }
 
     //clean up
     this->m_pstTs3Functions->freeMemory(pnFullChannelList);
+    return true;
+}
 
-    // find all entrys that are != 0 and increment them
-    for (std::vector<channel_info>::iterator it = plChList->begin(); it != plChList->end();)
+/* ----------------------------------------------------------------------------
+* Reset InvalidCount of found channels otherwise increment InvalidCount.
+* If InvalidCount reaches max. delete channel from list (entry 0 is kept).
+*/
+void channel_filter::update_invalid_count(std::vector<channel_info>* plChList, const std::vector<char>& vbFound)
+{
+    for (size_t ii = 1; ii < plChList->size(); ii++)
+    {
+        // channel was found, set InvalidCount to 0
+        if ((ii < vbFound.size()) && vbFound[ii])
+            (*plChList)[ii].iInvalidCount = 0;
+        else
+            (*plChList)[ii].iInvalidCount++;
+    }
+
+    for (std::vector<channel_info>::iterator it = plChList->begin() + ((plChList->size() > 0) ? 1 : 0); it != plChList->end();)
     {
         if (it->iInvalidCount >= MAX_INVALIDCOUNT)
         {
             if (DEBUG_LOG) printf("channel %llu deleted from list\n", it->nChannelID);
-            plChList->erase(it);
+            it = plChList->erase(it);
         }
         else
             it++;
     }
-
-    return true;
 }
 
 /* ----------------------------------------------------------------------------
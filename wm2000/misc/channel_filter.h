@@ -22,6 +22,8 @@ public:
     channel_info    get_channel_info(uint64 nChannelID);
 
     bool            validate_channel_list(std::vector<channel_info>* plChList);
+    bool            find_channels_in_list(std::vector<channel_info>* plChList, std::vector<char>& vbFound);   // read only, vbFound[ii] != 0 if entry ii exists
+    static void     update_invalid_count(std::vector<channel_info>* plChList, const std::vector<char>& vbFound);
     void            free_channel_list(uint64* pnChList) { m_pstTs3Functions->freeMemory(pnChList); };
 
     std::string     get_server_name() { return m_sServerName; };
@@ -4,6 +4,7 @@
 #include <string.h>
 #include <assert.h>
 #include <cstring>
+#include <algorithm>
 #include "teamspeak/public_errors.h"
 #include "teamspeak/public_errors_rare.h"
 #include "teamspeak/public_definitions.h"
@@ -58,74 +59,90 @@ void client_filter::init(struct TS3Functions *pstTs3Functions, config_container
 */
 void client_filter::update_client_list(anyID nClientID, uint64 nActChannel)
 {
-    //my own client should not be part of this list
-    if (this->m_nMyClientID == nClientID)
-    {
-        if (nActChannel != INVALID_CHANNEL_ID) m_nMyChannelID = nActChannel;
-
-        //TS3_VECTOR position = { 0.0, 0.0, 0.0 };
-        //TS3_VECTOR up       = { 0.0, 0.0, 0.0 };
-        //TS3_VECTOR forward  = { 0.0, 0.0, 0.0 };
-        //if (this->m_nMyChannelID != INVALID_CHANNEL_ID)
-        //{
-        //    position.x = 0.0;
-        //    position.y = 0.0;
-        //    position.z = 0.0;
-        //
-        //    up.x = 0;
-        //    up.y = 1;
-        //    up.z = 0;
-        //
-        //    this->m_pstTs3Functions->systemset3DListenerAttributes(this->m_nServerID, &position, NULL, &up);
-        //
-        //    //this->m_pstTs3Functions->channelset3DAttributes(this->m_nServerID, nClientID, &position);
-        //    printf("Set own client 3D Audio (%llu != %llu)\n", nActChannel, this->m_nMyChannelID);
-        //}
+    client_update_batch cBatch;
+    cBatch.add(nClientID, nActChannel);
+    update_client_list(cBatch.get_updates());
+}
 
-        return;
-    }
 
+/* ----------------------------------------------------------------------------
+*   get new info from server for a folded batch of events
+*      the client list is locked once, indexed once (larger batches) and compacted once
+*      meta data is only read for new clients and after a variable update
+*/
+void client_filter::update_client_list(const std::vector<client_update>& vUpdate)
+{
     //make sure, no one is working on this
     this->m_cClientListMutex.lock();
 
-    //try to find client
-    int nIndex = find_client(nClientID);
+    //index of the actual list
+    bool bUseIndex = (vUpdate.size() >= CLIENT_INDEX_MIN_BATCH);
+    std::unordered_map<anyID, int> mIndex;
+    if (bUseIndex)
+    {
+        mIndex.reserve(this->m_cClientList.size() + vUpdate.size());
+        for (int ii = 0; ii < this->m_cClientList.size(); ii++)
+            mIndex[this->m_cClientList[ii].nClientID] = ii;
+    }
 
-    if (nActChannel != 0)
+    size_t nRemoved = 0;
+    for (size_t ii = 0; ii < vUpdate.size(); ii++)
     {
-        // user connected or settings changed
-        if (nIndex < 0)
+        const client_update& cUpdate = vUpdate[ii];
+
+        //my own client should not be part of this list
+        if (this->m_nMyClientID == cUpdate.nClientID)
         {
-            //if client was not found, add new entry
-            client_info cNewEntry;
+            if (cUpdate.nChannelID != INVALID_CHANNEL_ID) m_nMyChannelID = cUpdate.nChannelID;
+            continue;
+        }
 
-            //initialize client
-            cNewEntry.nClientID = nClientID;
-            char *pcClientName;
-            if (this->m_pstTs3Functions->getClientVariableAsString(this->m_nServerID, nClientID, CLIENT_NICKNAME, &pcClientName) != ERROR_ok)
-                this->m_pstTs3Functions->logMessage("Error querying client nickname", LogLevel_DEBUG, "WhisperMaster2000", this->m_nServerID);
-            else
+        //try to find client
+        int nIndex;
+        if (bUseIndex)
+        {
+            std::unordered_map<anyID, int>::iterator it = mIndex.find(cUpdate.nClientID);
+            nIndex = (it != mIndex.end()) ? it->second : -1;
+        }
+        else
+            nIndex = find_client(cUpdate.nClientID);
+
+        if (cUpdate.nChannelID == 0)
+        {
+            // user disconnected, entry is removed after the loop
+            if (nIndex >= 0)
             {
-                cNewEntry.sClientName = pcClientName;
-                this->m_pstTs3Functions->freeMemory(pcClientName);
+                this->m_cClientList[nIndex].nClientID = 0;
+                if (bUseIndex) mIndex.erase(cUpdate.nClientID);
+                nRemoved++;
+                printf("Client (%d) removed (%zd)\n", cUpdate.nClientID, this->m_cClientList.size() - nRemoved);
             }
-            
-            cNewEntry.bUseFreqList = false;
-            cNewEntry.iNumFreq = 0;
-            memset(cNewEntry.acFreqList, 0, sizeof(freq_data)*NUM_FREQUENCIES);
-            cNewEntry.nActualChannelID = 0;
+            continue;
+        }
 
-            //add client
+        // user connected or settings changed
+        bool bNewClient = (nIndex < 0) || cUpdate.bRemoved;
+        if (nIndex < 0)
+        {
+            //if client was not found, add new entry
+            client_info cNewEntry;
+            init_client(cNewEntry, cUpdate.nClientID);
             this->m_cClientList.push_back(cNewEntry);
             nIndex = ((int)this->m_cClientList.size()) - 1;
+            if (bUseIndex) mIndex[cUpdate.nClientID] = nIndex;
 
-            printf("Client (%d) added (%zd)\n", nClientID, this->m_cClientList.size());
+            printf("Client (%d) added (%zd)\n", cUpdate.nClientID, this->m_cClientList.size() - nRemoved);
+        }
+        else if (cUpdate.bRemoved)
+        {
+            //disconnected and connected again, same ID might be another user
+            init_client(this->m_cClientList[nIndex], cUpdate.nClientID);
         }
 
         //track actual channel (if nActChannel is unknown when calling this function, it is set to -1)
-        if ((nActChannel != INVALID_CHANNEL_ID) && (this->m_cClientList[nIndex].nActualChannelID != nActChannel))
+        if ((cUpdate.nChannelID != INVALID_CHANNEL_ID) && (this->m_cClientList[nIndex].nActualChannelID != cUpdate.nChannelID))
         {
-            this->m_cClientList[nIndex].nActualChannelID = nActChannel;
+            this->m_cClientList[nIndex].nActualChannelID = cUpdate.nChannelID;
 
             //this->m_pstTs3Functions->allowWhispersFrom(this->m_nServerID, nClientID);
             //this->m_pstTs3Functions->removeFromAllowedWhispersFrom(this->m_nServerID, nClientID);
@@ -133,50 +150,120 @@ void client_filter::update_client_list(anyID nClientID, uint64 nActChannel)
         }
 
         //track frequency list
-        char *pcMetaData;
-        int nError;
-        if (nError = this->m_pstTs3Functions->getClientVariableAsString(this->m_nServerID, nClientID, CLIENT_META_DATA, &pcMetaData) == ERROR_ok)
-        {
-            std::string     sMetaData = pcMetaData;
-            printf("Check client (%d / %d) Meta Data: %s", nClientID, nIndex, pcMetaData);
-            this->m_pstTs3Functions->freeMemory(pcMetaData);
+        if (bNewClient || cUpdate.bMetaDirty)
+            read_meta_data(nIndex);
+    }
 
-            //check if user uses WhisperMaster and add client if yes
-            if (parse_meta_data(sMetaData, nullptr) == 0)
-            {
-                //parse meta data and write to freq. list
-                this->m_cClientList[nIndex].iNumFreq = parse_meta_data(sMetaData, this->m_cClientList[nIndex].acFreqList);
-                this->m_cClientList[nIndex].bUseFreqList = true;
-                printf(" => valid\n");
-            }
-            else if (this->m_cClientList[nIndex].bUseFreqList)
-            {
-                //if client was previously markt as WM2000 user, reset everthing
-                memset(this->m_cClientList[nIndex].acFreqList, 0, sizeof(freq_data)*NUM_FREQUENCIES);
-                this->m_cClientList[nIndex].iNumFreq = 0;
-                this->m_cClientList[nIndex].bUseFreqList = false;
-                printf(" => disabled\n");
-            }
-            else
-                printf(" => invalid (%d)\n", parse_meta_data(sMetaData, nullptr));
+    //remove disconnected clients in one pass (ID 0 is never used by a client)
+    if (nRemoved != 0)
+    {
+        this->m_cClientList.erase(std::remove_if(this->m_cClientList.begin(), this->m_cClientList.end(),
+            [](const client_info& cClient) { return cClient.nClientID == 0; }), this->m_cClientList.end());
+    }
+
+    //release lock
+    this->m_cClientListMutex.unlock();
+}
+
+
+/* ----------------------------------------------------------------------------
+*   initialize client entry, name is read from server
+*/
+void client_filter::init_client(client_info& cClient, anyID nClientID)
+{
+    cClient.nClientID = nClientID;
+    char *pcClientName;
+    if (this->m_pstTs3Functions->getClientVariableAsString(this->m_nServerID, nClientID, CLIENT_NICKNAME, &pcClientName) != ERROR_ok)
+        this->m_pstTs3Functions->logMessage("Error querying client nickname", LogLevel_DEBUG, "WhisperMaster2000", this->m_nServerID);
+    else
+    {
+        cClient.sClientName = pcClientName;
+        this->m_pstTs3Functions->freeMemory(pcClientName);
+    }
+
+    cClient.bUseFreqList = false;
+    cClient.iNumFreq = 0;
+    memset(cClient.acFreqList, 0, sizeof(freq_data)*NUM_FREQUENCIES);
+    cClient.nActualChannelID = 0;
+}
+
+
+/* ----------------------------------------------------------------------------
+*   read meta data of client and update frequency list
+*/
+void client_filter::read_meta_data(int nIndex)
+{
+    anyID nClientID = this->m_cClientList[nIndex].nClientID;
+    char *pcMetaData;
+    int nError;
+    if (nError = this->m_pstTs3Functions->getClientVariableAsString(this->m_nServerID, nClientID, CLIENT_META_DATA, &pcMetaData) == ERROR_ok)
+    {
+        std::string     sMetaData = pcMetaData;
+        printf("Check client (%d / %d) Meta Data: %s", nClientID, nIndex, pcMetaData);
+        this->m_pstTs3Functions->freeMemory(pcMetaData);
+
+        //check if user uses WhisperMaster and add client if yes
+        if (parse_meta_data(sMetaData, nullptr) == 0)
+        {
+            //parse meta data and write to freq. list
+            this->m_cClientList[nIndex].iNumFreq = parse_meta_data(sMetaData, this->m_cClientList[nIndex].acFreqList);
+            this->m_cClientList[nIndex].bUseFreqList = true;
+            printf(" => valid\n");
         }
-        else
+        else if (this->m_cClientList[nIndex].bUseFreqList)
         {
-            printf("FAILED to get client (%d) Meta Data. ERROR: 0x%04X\n", nClientID, nError);
+            //if client was previously markt as WM2000 user, reset everthing
+            memset(this->m_cClientList[nIndex].acFreqList, 0, sizeof(freq_data)*NUM_FREQUENCIES);
+            this->m_cClientList[nIndex].iNumFreq = 0;
+            this->m_cClientList[nIndex].bUseFreqList = false;
+            printf(" => disabled\n");
         }
+        else
+            printf(" => invalid (%d)\n", parse_meta_data(sMetaData, nullptr));
     }
     else
     {
-        // user disconnected
-        if (nIndex >= 0)
-        {
-            this->m_cClientList.erase(this->m_cClientList.begin() + nIndex);
-            printf("Client (%d) removed (%zd)\n", nClientID, this->m_cClientList.size());
-        }
+        printf("FAILED to get client (%d) Meta Data. ERROR: 0x%04X\n", nClientID, nError);
     }
+}
 
-    //release lock
-    this->m_cClientListMutex.unlock();
+
+/* ----------------------------------------------------------------------------
+*   fold event into batch, the last channel wins
+*/
+void client_update_batch::add(anyID nClientID, uint64 nChannelID)
+{
+    this->m_nEvents++;
+
+    std::unordered_map<anyID, size_t>::iterator it = this->m_mIndex.find(nClientID);
+    if (it == this->m_mIndex.end())
+    {
+        client_update cUpdate;
+        cUpdate.nClientID   = nClientID;
+        cUpdate.nChannelID  = nChannelID;
+        cUpdate.bMetaDirty  = (nChannelID == INVALID_CHANNEL_ID);
+        cUpdate.bRemoved    = false;
+        this->m_mIndex[nClientID] = this->m_vUpdate.size();
+        this->m_vUpdate.push_back(cUpdate);
+        return;
+    }
+
+    client_update& cUpdate = this->m_vUpdate[it->second];
+    if (nChannelID == 0)
+    {
+        // disconnected, earlier changes are obsolete
+        cUpdate.nChannelID  = 0;
+        cUpdate.bMetaDirty  = false;
+        cUpdate.bRemoved    = true;
+    }
+    else if (nChannelID == INVALID_CHANNEL_ID)
+    {
+        // variables changed, channel stays
+        cUpdate.bMetaDirty  = true;
+        if (cUpdate.nChannelID == 0) cUpdate.nChannelID = INVALID_CHANNEL_ID;
+    }
+    else
+        cUpdate.nChannelID  = nChannelID;
 }
 
 
@@ -376,6 +463,28 @@ int client_filter::get_next_free_freq(int iStartFreq)
     return iFreeFreq;
 }
 
+/* ----------------------------------------------------------------------------
+*   mark all frequencies that are active for any client (same check as get_next_free_freq)
+*/
+void client_filter::get_used_freqs(std::vector<char>& vbUsed)
+{
+    int iMaxFreq = this->m_pConfigContainer->s_get_MaxNumFreq();
+    vbUsed.assign(iMaxFreq + 1, 0);
+
+    for (int ii = 0; ii < this->m_cClientList.size(); ii++)
+    {
+        for (int jj = 0; jj < this->m_cClientList[ii].iNumFreq; jj++)
+        {
+            int iFreq = this->m_cClientList[ii].acFreqList[jj].nBit.nFreq;
+            if ((iFreq < 1) || (iFreq > iMaxFreq) || vbUsed[iFreq])
+                continue;
+
+            if (find_active_freq(ii, iFreq, false, false) >= 0)
+                vbUsed[iFreq] = 1;
+        }
+    }
+}
+
 /* ----------------------------------------------------------------------------
 * return name of the given channel ID
 */
@@ -4,9 +4,12 @@
 #include "misc/error_handler.h"
 #include "ts3_functions.h"
 #include <boost/thread.hpp>
+#include <unordered_map>
+#include <atomic>
 
 #define INVALID_CHANNEL_ID  0xFFFFFFFFFFFFFFFFll
 #define NUM_FREQUENCIES     REAL_MAXNUMPROFILES+1
+#define CLIENT_INDEX_MIN_BATCH  8       // smaller batches search the client list instead of indexing it
 
 struct freq_def
 {
@@ -37,6 +40,34 @@ struct client_info
     uint64      nActualChannelID;
 };
 
+/* ----------------------------------------------------------------------------
+* client changes of several events, folded per client
+*/
+struct client_update
+{
+    anyID       nClientID;
+    uint64      nChannelID;     // last channel, INVALID_CHANNEL_ID if unknown, 0 if disconnected
+    bool        bMetaDirty;     // meta data has to be read again
+    bool        bRemoved;       // client disconnected before (entry is created again)
+};
+
+class client_update_batch
+{
+public:
+    client_update_batch() { this->m_nEvents = 0; };
+
+    void                            add(anyID nClientID, uint64 nChannelID);    // same parameter as client_filter::update_client_list
+    void                            clear() { this->m_vUpdate.clear(); this->m_mIndex.clear(); this->m_nEvents = 0; };
+    bool                            empty() { return this->m_vUpdate.empty(); };
+    size_t                          get_num_events() { return this->m_nEvents; };
+    std::vector<client_update>&     get_updates() { return this->m_vUpdate; };
+
+private:
+    std::vector<client_update>          m_vUpdate;      // one entry per client, in order of first event
+    std::unordered_map<anyID, size_t>   m_mIndex;       // client => index in m_vUpdate
+    size_t                              m_nEvents;      // number of folded events
+};
+
 class client_filter
 {
 public:
@@ -47,6 +78,7 @@ public:
     bool                set_meta_data();                                                                        // create meta data from profiles and write data to Server
 
     void                update_client_list(anyID nClientID, uint64 nActChannel);                                // get new info from server (connect + update + disconnect)
+    void                update_client_list(const std::vector<client_update>& vUpdate);                          // same for a folded batch, one lock and one pass
     int                 find_client(anyID nClientID);                                                           // find client in m_cClientList
 
     std::vector<int>    get_client_list_idx(int iFreq, bool bCheckIgnore, bool bCheckSquelch, bool bCheckParam = true);             // get vector of client Idx with active freq. iFreq
@@ -54,13 +86,17 @@ public:
     int                 find_active_freq(int iClient, int iFreq, bool bCheckIgnore, bool bCheckSquelch, bool bCheckParam = true);   // get index of active freq in freq list
 
     int                 get_next_free_freq(int iStartFreq);                                                     // return a frequency that is currently unused
+    void                get_used_freqs(std::vector<char>& vbUsed);                                              // vbUsed[iFreq] != 0 if any client uses iFreq
     
     std::string         get_channel_name(uint64 nChannelID);                                                    //return name of the given channel ID
     std::string         get_server_name() { return m_sServerName; };                                            //return name of the actual server
     uint64              get_server_id() { return m_nServerID; };                                                //return id of the actual server
+    uint64              get_my_channel_id() { return m_nMyChannelID; };                                         //return own channel, INVALID_CHANNEL_ID until the first own update
 
 protected:
     int  parse_meta_data(std::string sMetaData, freq_data acFreqList[]);                // parse meta data
+    void init_client(client_info& cClient, anyID nClientID);                           // name from server, no frequencies
+    void read_meta_data(int nIndex);                                                    // frequency list from server
 
 public:
     boost::mutex                m_cClientListMutex;     // mutex to read/write client list from different threads
@@ -74,7 +110,7 @@ private:
 
     uint64                      m_nServerID;
     std::string                 m_sServerName;
-    uint64                      m_nMyChannelID;
+    std::atomic<uint64>         m_nMyChannelID;         // read by info texts (TS3 thread)
     anyID                       m_nMyClientID;
 };
 
@@ -1,6 +1,8 @@
 //#include "stdafx.h"
 #include "config_container.h"
+#ifdef _WIN32
 #include <Shlwapi.h>
+#endif
 
 #if USE_CALL_STACK
 #define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
@@ -15,11 +17,13 @@ config_container::config_container()
 {
     CALL_STACK
     this->m_bIsInitialized      = false;
+    this->m_nGeneration         = 0;
 	//general
     this->m_bExpertMode         = false;
 	this->m_bLGSActive		    = false;
 	this->m_sLanguage			= "german";
     this->m_iMaxNumFreq         = 100;
+    this->m_iUiRefreshRate      = DEFAULT_UI_REFRESH_RATE;
 	this->m_bSaveIgnoreList	    = false;
     this->m_bUseIgnoreListRx    = false;
 	this->m_nMaxNumProfiles	    = DEFAULT_MAXNUMPROFILES;
@@ -40,6 +44,8 @@ config_container::config_container()
     this->m_pbMuteFreq          = nullptr;
     this->m_pbSquelchFreq       = nullptr;
     this->m_pbPrioFreq          = nullptr;
+    this->m_pbRadioFreq         = nullptr;
+    this->m_pbSpatialFreq       = nullptr;
     this->m_pbMasterFreq        = nullptr;
     this->m_psProfileHotKey_down= nullptr;
     this->m_psProfileHotKey_up  = nullptr;
@@ -71,6 +77,7 @@ bool config_container::compare_config(config_container const & other, bool bNeed
         if (!bNeedRestart) bResult &= (this->m_bLGSActive == other.m_bLGSActive);
         bResult &= (this->m_sLanguage == other.m_sLanguage);
         if (!bNeedRestart) bResult &= (this->m_iMaxNumFreq == other.m_iMaxNumFreq);
+        if (!bNeedRestart) bResult &= (this->m_iUiRefreshRate == other.m_iUiRefreshRate);
         if (!bNeedRestart) bResult &= (this->m_bSaveIgnoreList == other.m_bSaveIgnoreList);
         if (!bNeedRestart) bResult &= (this->m_bUseIgnoreListRx == other.m_bUseIgnoreListRx);
         if (!bNeedRestart) bResult &= (this->m_bUseMasterRight == other.m_bUseMasterRight);
@@ -96,6 +103,8 @@ bool config_container::compare_config(config_container const & other, bool bNeed
                 if (!bNeedRestart) bResult &= (this->m_pbMuteFreq[ii]       == other.m_pbMuteFreq[ii]);
                 if (!bNeedRestart) bResult &= (this->m_pbSquelchFreq[ii]    == other.m_pbSquelchFreq[ii]);
                 if (!bNeedRestart) bResult &= (this->m_pbPrioFreq[ii]       == other.m_pbPrioFreq[ii]);
+                if (!bNeedRestart) bResult &= (this->m_pbRadioFreq[ii]      == other.m_pbRadioFreq[ii]);
+                if (!bNeedRestart) bResult &= (this->m_pbSpatialFreq[ii]    == other.m_pbSpatialFreq[ii]);
                 if (!bNeedRestart) bResult &= (this->m_pbMasterFreq[ii]     == other.m_pbMasterFreq[ii]);
             }
         }
@@ -130,6 +139,7 @@ config_container& config_container::operator=(config_container const & other)
     this->m_bLGSActive          = other.m_bLGSActive;
     this->m_sLanguage           = other.m_sLanguage;
     this->m_iMaxNumFreq         = other.m_iMaxNumFreq;
+    this->m_iUiRefreshRate      = other.m_iUiRefreshRate;
     this->m_bSaveIgnoreList     = other.m_bSaveIgnoreList;
     this->m_bUseIgnoreListRx    = other.m_bUseIgnoreListRx;
     this->m_bUseMasterRight     = other.m_bUseMasterRight;
@@ -161,6 +171,8 @@ config_container& config_container::operator=(config_container const & other)
         this->m_pbMuteFreq[ii]          = other.m_pbMuteFreq[ii];
         this->m_pbSquelchFreq[ii]       = other.m_pbSquelchFreq[ii];
         this->m_pbPrioFreq[ii]          = other.m_pbPrioFreq[ii];
+        this->m_pbRadioFreq[ii]         = other.m_pbRadioFreq[ii];
+        this->m_pbSpatialFreq[ii]       = other.m_pbSpatialFreq[ii];
         this->m_pbMasterFreq[ii]        = other.m_pbMasterFreq[ii];
         this->m_psProfileHotKey_down[ii]= other.m_psProfileHotKey_down[ii];
         this->m_psProfileHotKey_up[ii]  = other.m_psProfileHotKey_up[ii];
@@ -168,6 +180,7 @@ config_container& config_container::operator=(config_container const & other)
 
     //mark as initialized
     this->m_bIsInitialized = true;
+    this->m_nGeneration++;
 
     //thread safe end
     this->m_cConfigDataMutex.unlock();
@@ -199,6 +212,8 @@ void config_container::init_channel_list()
     this->m_pbMuteFreq          = new bool[REAL_MAXNUMPROFILES];
     this->m_pbSquelchFreq       = new bool[REAL_MAXNUMPROFILES];
     this->m_pbPrioFreq          = new bool[REAL_MAXNUMPROFILES];
+    this->m_pbRadioFreq         = new bool[REAL_MAXNUMPROFILES];
+    this->m_pbSpatialFreq       = new bool[REAL_MAXNUMPROFILES];
     this->m_pbMasterFreq        = new bool[REAL_MAXNUMPROFILES];
     this->m_psProfileHotKey_down= new std::string[REAL_MAXNUMPROFILES];
     this->m_psProfileHotKey_up  = new std::string[REAL_MAXNUMPROFILES];
@@ -223,6 +238,8 @@ void config_container::init_channel_list()
         this->m_pbMuteFreq[ii]          = false;        // profile is active by default
         this->m_pbSquelchFreq[ii]       = false;        // don't listen with squelch
         this->m_pbPrioFreq[ii]          = false;        // don't use priority calls
+        this->m_pbRadioFreq[ii]         = false;        // received voice is not changed
+        this->m_pbSpatialFreq[ii]       = false;        // received voice is not placed in 3D
         this->m_pbMasterFreq[ii]        = false;        // don't use master calls
         this->m_psProfileHotKey_down[ii]= "";           // will be updated by plugin_base::check_param later
         this->m_psProfileHotKey_up[ii]  = "";           // will be updated by plugin_base::check_param later
@@ -256,6 +273,8 @@ void config_container::cleanup_class()
     if (this->m_pbMuteFreq != nullptr)         delete[] this->m_pbMuteFreq;        this->m_pbMuteFreq = nullptr;
     if (this->m_pbSquelchFreq != nullptr)      delete[] this->m_pbSquelchFreq;     this->m_pbSquelchFreq = nullptr;
     if (this->m_pbPrioFreq != nullptr)         delete[] this->m_pbPrioFreq;        this->m_pbPrioFreq = nullptr;
+    if (this->m_pbRadioFreq != nullptr)        delete[] this->m_pbRadioFreq;       this->m_pbRadioFreq = nullptr;
+    if (this->m_pbSpatialFreq != nullptr)      delete[] this->m_pbSpatialFreq;     this->m_pbSpatialFreq = nullptr;
     if (this->m_pbMasterFreq != nullptr)       delete[] this->m_pbMasterFreq;      this->m_pbMasterFreq = nullptr;
     if (this->m_psProfileHotKey_down != nullptr) delete[] this->m_psProfileHotKey_down; this->m_psProfileHotKey_down = nullptr;
     if (this->m_psProfileHotKey_up != nullptr) delete[] this->m_psProfileHotKey_up; this->m_psProfileHotKey_up = nullptr;
@@ -315,6 +334,7 @@ int config_container::s_read_param( const std::string &filename )
 		this->m_bLGSActive        = tree.get("general.LgsActive",     false);
 		this->m_sLanguage         = tree.get("general.Language",      std::string("german"));
         this->m_iMaxNumFreq       = tree.get("general.MaxFrequency",  (int)MAX_FREQUENCY);
+        this->m_iUiRefreshRate    = tree.get("general.UiRefreshRate", (int)DEFAULT_UI_REFRESH_RATE);
 		this->m_bSaveIgnoreList   = tree.get("general.SaveIgnoreList", false);
         this->m_bUseIgnoreListRx  = tree.get("general.UseIgnoreListRx", false);
         this->m_bUseMasterRight   = tree.get("general.UseMasterRights", false);
@@ -353,6 +373,10 @@ int config_container::s_read_param( const std::string &filename )
             this->m_pbSquelchFreq[ii] = tree.get(buffer, false);
             sprintf_s(buffer, "profile.profile%d.Priority", ii + 1);
             this->m_pbPrioFreq[ii] = tree.get(buffer, false);
+            sprintf_s(buffer, "profile.profile%d.Radio", ii + 1);
+            this->m_pbRadioFreq[ii] = tree.get(buffer, false);
+            sprintf_s(buffer, "profile.profile%d.Spatial", ii + 1);
+            this->m_pbSpatialFreq[ii] = tree.get(buffer, false);
             sprintf_s(buffer, "profile.profile%d.Master", ii + 1);
             this->m_pbMasterFreq[ii] = tree.get(buffer, false);
         }
@@ -361,6 +385,7 @@ int config_container::s_read_param( const std::string &filename )
         this->m_cConfigDataMutex.unlock();
 	}
     this->m_bIsInitialized = true;
+    this->m_nGeneration++;
 	return nConverted;
 }
 
@@ -390,6 +415,7 @@ void config_container::s_write_param(const std::string &filename)
         if(this->m_bUseMasterRight) tree.put("general.UseMasterRights", this->m_bUseMasterRight);
         if (this->m_nMaxNumProfiles != DEFAULT_MAXNUMPROFILES) tree.put("general.MaxNumProfiles", this->m_nMaxNumProfiles); // hidden parameter, hold if it was set by the user
         if (this->m_iMaxNumFreq != MAX_FREQUENCY) tree.put("general.MaxFrequency", this->m_iMaxNumFreq);                              // hidden parameter, hold if it was set by the user
+        if (this->m_iUiRefreshRate != DEFAULT_UI_REFRESH_RATE) tree.put("general.UiRefreshRate", this->m_iUiRefreshRate);             // hidden parameter, hold if it was set by the user
         this->m_nMaxNumProfiles = (this->m_nMaxNumProfiles <= (REAL_MAXNUMPROFILES+1)) ? this->m_nMaxNumProfiles : REAL_MAXNUMPROFILES;   // make sure, size is not too high. Real check has to be external
 
         //profiles
@@ -420,6 +446,10 @@ void config_container::s_write_param(const std::string &filename)
             tree.put(buffer, this->m_pbSquelchFreq[ii]);
             sprintf_s(buffer, "profile.profile%zd.Priority", ii + 1);
             tree.put(buffer, this->m_pbPrioFreq[ii]);
+            sprintf_s(buffer, "profile.profile%zd.Radio", ii + 1);
+            tree.put(buffer, this->m_pbRadioFreq[ii]);
+            sprintf_s(buffer, "profile.profile%zd.Spatial", ii + 1);
+            tree.put(buffer, this->m_pbSpatialFreq[ii]);
             sprintf_s(buffer, "profile.profile%zd.Master", ii + 1);
             if (this->m_bUseMasterRight)
                 tree.put(buffer, this->m_pbMasterFreq[ii]);
@@ -468,6 +498,7 @@ size_t config_container::s_delete_entry(std::vector<channel_info> *plReturn, int
     {
         plReturn->erase(plReturn->begin() + nEntry);
         nResult = plReturn->size();
+        this->m_nGeneration++;
     }
 
     //thread safe end
@@ -515,6 +546,7 @@ int config_container::s_add_entry(std::vector<channel_info> *plReturn, channel_i
         //add only if value doesn't exist
         plReturn->push_back(eEntry);
         iResult = IDNOTFOUND;
+        this->m_nGeneration++;
     }
     //thread safe end
     this->m_cConfigDataMutex.unlock();
@@ -647,6 +679,7 @@ void config_container::s_clear_vector(std::vector<channel_info> *plReturn)
     this->m_cConfigDataMutex.lock();
 
     clear_vector(plReturn);
+    this->m_nGeneration++;
 
     //thread safe end
     this->m_cConfigDataMutex.unlock();
@@ -749,7 +782,7 @@ int config_container::create_vector_from_string(std::vector<channel_info> *plRet
 		nStart += (nLength - nStart)+1;
 
         // convert sub string to parameter
-		nConverted = sscanf_s(sPart.c_str(), "%llu,%d,%llu,%d,%s", &nChannelID, &nIsPermanent, &nChannelParent, &iInvalidCount, sChannelName, (unsigned int)sizeof(sChannelName));
+		nConverted = sscanf_s(sPart.c_str(), "%llu,%d,%llu,%d,%99s", &nChannelID, &nIsPermanent, &nChannelParent, &iInvalidCount, sChannelName, (unsigned int)sizeof(sChannelName));
 		if (nConverted != 5)
 			break;
         
@@ -828,6 +861,7 @@ void config_container::s_set_ExpertMode(bool bValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_bExpertMode = bValue;
 
@@ -853,6 +887,7 @@ void config_container::s_set_MaxNumProfiles(size_t nValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_nMaxNumProfiles = nValue;
 
@@ -890,6 +925,7 @@ void config_container::s_set_Language(std::string sNewLanguage)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     if (sNewLanguage.compare("de") == 0 || sNewLanguage.compare("german") == 0 || sNewLanguage.compare("deutsch") == 0 || sNewLanguage.compare("German") == 0 || sNewLanguage.compare("Deutsch") == 0)
     {
@@ -922,6 +958,7 @@ void config_container::s_set_MaxNumFreq(int iValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_iMaxNumFreq = iValue;
 
@@ -929,6 +966,31 @@ void config_container::s_set_MaxNumFreq(int iValue)
     this->m_cConfigDataMutex.unlock();
 }
 
+int config_container::s_get_UiRefreshRate()
+{
+    int iResult;
+    //thread safe begin
+    this->m_cConfigDataMutex.lock();
+
+    iResult = this->m_iUiRefreshRate;
+
+    //thread safe end
+    this->m_cConfigDataMutex.unlock();
+    return iResult;
+}
+
+void config_container::s_set_UiRefreshRate(int iValue)
+{
+    //thread safe begin
+    this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
+
+    this->m_iUiRefreshRate = iValue;
+
+    //thread safe end
+    this->m_cConfigDataMutex.unlock();
+}
+
 bool config_container::s_get_SaveIgnoreList()
 {
     bool bResult;
@@ -946,6 +1008,7 @@ void config_container::s_set_SaveIgnoreList(bool bValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_bSaveIgnoreList = bValue;
 
@@ -971,6 +1034,7 @@ void config_container::s_set_UseIgnoreListRx(bool bValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_bUseIgnoreListRx = bValue;
 
@@ -996,6 +1060,7 @@ void config_container::s_set_UseMasterRight(bool bValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_bUseMasterRight = bValue;
 
@@ -1050,6 +1115,7 @@ void config_container::s_set_ProfileName(int iProfile, std::string sValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_psProfileName[iProfile] = sValue;
 
@@ -1081,6 +1147,7 @@ void config_container::s_set_ProfileType(int iProfile, eProfileType eValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_pnProfileType[iProfile] = eValue;
 
@@ -1106,6 +1173,7 @@ void config_container::s_set_UseIgnoreListTx(int iProfile, bool bValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_pbUseIgnoreListTx[iProfile] = bValue;
 
@@ -1131,6 +1199,7 @@ void config_container::s_set_AutoActivate(int iProfile, bool bValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_pbAutoActivate[iProfile] = bValue;
 
@@ -1193,6 +1262,7 @@ void config_container::s_set_ServerName(int iProfile, std::string sValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     //if server name changes, cleanup favorite list
     if (sValue.compare(this->m_psServerName[iProfile]) != 0)
@@ -1221,6 +1291,7 @@ void config_container::s_set_UseSubChOfFav(int iProfile, bool bValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_pbUseSubChOfFav[iProfile] = bValue;
 
@@ -1246,6 +1317,7 @@ void config_container::s_set_MaxChLevel(int iProfile, size_t nValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_pnMaxChLevel[iProfile] = nValue;
 
@@ -1270,6 +1342,7 @@ void config_container::s_set_MinChLevel(int iProfile, size_t nValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_pnMinChLevel[iProfile] = nValue;
 
@@ -1295,6 +1368,7 @@ void config_container::s_set_ActiveFreq(int iProfile, int iValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_piActiveFreq[iProfile] = iValue;
 
@@ -1319,6 +1393,7 @@ void config_container::s_set_MuteFreq(int iProfile, bool bValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_pbMuteFreq[iProfile] = bValue;
 
@@ -1343,6 +1418,7 @@ void config_container::s_set_SquelchFreq(int iProfile, bool bValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_pbSquelchFreq[iProfile] = bValue;
 
@@ -1367,6 +1443,7 @@ void config_container::s_set_PrioFreq(int iProfile, bool bValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_pbPrioFreq[iProfile] = bValue;
 
@@ -1374,6 +1451,56 @@ void config_container::s_set_PrioFreq(int iProfile, bool bValue)
     this->m_cConfigDataMutex.unlock();
 }
 
+bool config_container::s_get_RadioFreq(int iProfile)
+{
+    bool bResult;
+    //thread safe begin
+    this->m_cConfigDataMutex.lock();
+
+    bResult = this->m_pbRadioFreq[iProfile];
+
+    //thread safe end
+    this->m_cConfigDataMutex.unlock();
+    return bResult;
+}
+
+void config_container::s_set_RadioFreq(int iProfile, bool bValue)
+{
+    //thread safe begin
+    this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
+
+    this->m_pbRadioFreq[iProfile] = bValue;
+
+    //thread safe end
+    this->m_cConfigDataMutex.unlock();
+}
+
+bool config_container::s_get_SpatialFreq(int iProfile)
+{
+    bool bResult;
+    //thread safe begin
+    this->m_cConfigDataMutex.lock();
+
+    bResult = this->m_pbSpatialFreq[iProfile];
+
+    //thread safe end
+    this->m_cConfigDataMutex.unlock();
+    return bResult;
+}
+
+void config_container::s_set_SpatialFreq(int iProfile, bool bValue)
+{
+    //thread safe begin
+    this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
+
+    this->m_pbSpatialFreq[iProfile] = bValue;
+
+    //thread safe end
+    this->m_cConfigDataMutex.unlock();
+}
+
 bool config_container::s_get_MasterFreq(int iProfile)
 {
     bool bResult;
@@ -1391,6 +1518,7 @@ void config_container::s_set_MasterFreq(int iProfile, bool bValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_pbMasterFreq[iProfile] = bValue;
 
@@ -1416,6 +1544,7 @@ void config_container::s_set_GenHotKey_reset(std::string sValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_sGenHotKey_reset = sValue;
 
@@ -1441,6 +1570,7 @@ void config_container::s_set_GenHotKey_mute(std::string sValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_sGenHotKey_mute = sValue;
 
@@ -1466,6 +1596,7 @@ void config_container::s_set_HotKey_down(int iProfile, std::string sValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_psProfileHotKey_down[iProfile] = sValue;
 
@@ -1491,6 +1622,7 @@ void config_container::s_set_HotKey_up(int iProfile, std::string sValue)
 {
     //thread safe begin
     this->m_cConfigDataMutex.lock();
+    this->m_nGeneration++;
 
     this->m_psProfileHotKey_up[iProfile] = sValue;
 
@@ -6,6 +6,7 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
 #include <boost/thread.hpp>
+#include <atomic>
 #include "teamspeak/public_definitions.h"
 #include "misc/error_handler.h"
 
@@ -27,6 +28,8 @@
 #define MAX_FREQUENCY           100
 #define MAX__MAXFREQUENCY       10000
 
+#define DEFAULT_UI_REFRESH_RATE 20
+
 #define CONFIG_VERSION          1
 
 struct channel_info
@@ -61,6 +64,9 @@ public:
     bool	file_exists(const std::string& filename);
     void    set_file_path(std::string filename) { m_sFilePath = filename; };
 
+    // change counter, incremented on every modification (used to invalidate cached data)
+    uint32_t s_get_Generation() { return this->m_nGeneration; };
+
     // channel list interaction
 	size_t  s_delete_entry(std::vector<channel_info> *plReturn, int nEntry);
 	int     s_add_entry(std::vector<channel_info> *plReturn, uint64 nChannelID, bool bIsPermanent, uint64 nChannelParent, std::string sChannelName);
@@ -82,6 +88,8 @@ public:
     void                        s_set_Language(std::string sValue);     // select language (german / english)
     int                         s_get_MaxNumFreq();                     // max. frequency that can be set
     void                        s_set_MaxNumFreq(int iValue);
+    int                         s_get_UiRefreshRate();                  // max. number of UI refreshes per second
+    void                        s_set_UiRefreshRate(int iValue);
     bool						s_get_SaveIgnoreList();	                // (de-)activate saving the ignore channel list
     void						s_set_SaveIgnoreList(bool bValue);
     bool						s_get_UseIgnoreListRx();	            // use ignore list to filter when receiving data
@@ -124,6 +132,10 @@ public:
     void                        s_set_SquelchFreq(int iProfile, bool bValue);
     bool                        s_get_PrioFreq(int iProfile);           // marks the profile as using priority calls (Tx) of profile
     void                        s_set_PrioFreq(int iProfile, bool bValue);
+    bool                        s_get_RadioFreq(int iProfile);          // radio effect on voice received over the frequency (Rx) of profile
+    void                        s_set_RadioFreq(int iProfile, bool bValue);
+    bool                        s_get_SpatialFreq(int iProfile);        // 3D position of voice received over the frequency (Rx) of profile
+    void                        s_set_SpatialFreq(int iProfile, bool bValue);
     bool                        s_get_MasterFreq(int iProfile);         // marks the profile as using master calls (Tx) of profile
     void                        s_set_MasterFreq(int iProfile, bool bValue);
     std::string                 s_get_HotKey_down(int iProfile);        // list of hotkeys used in this profile 
@@ -164,6 +176,7 @@ private:
     bool                        m_bIsInitialized;   // shows if the class is already filled with valid data
     int                         m_nConfigVersion;   // version that was setup in the config file
     std::string					m_sFilePath;		// path to config file
+    std::atomic<uint32_t>       m_nGeneration;      // change counter
 
     //settings memory
 	//  general
@@ -172,6 +185,7 @@ private:
 	bool						m_bLGSActive;		// (de-)activate LogitechGamingSoftware interface
 	std::string					m_sLanguage;		// select language (german / english)
     int                         m_iMaxNumFreq;      // max. frequency that can be set
+    int                         m_iUiRefreshRate;   // max. number of UI refreshes per second
 	bool						m_bSaveIgnoreList;	// (de-)activate saving the ignore channel list
     bool						m_bUseIgnoreListRx;	// use ignore list to filter when receiving data
     bool						m_bUseMasterRight;	// enables master rights
@@ -195,6 +209,8 @@ private:
     bool                       *m_pbMuteFreq;       // marks the profile as listening or not (Rx)
     bool                       *m_pbSquelchFreq;    // marks the profile as listening to priority calls only (Rx)
     bool                       *m_pbPrioFreq;       // marks the profile as using priority calls (Tx)
+    bool                       *m_pbRadioFreq;      // radio effect on voice received over the frequency (Rx)
+    bool                       *m_pbSpatialFreq;    // 3D position of voice received over the frequency (Rx)
     bool                       *m_pbMasterFreq;     // marks the profile as using master calls (Tx)
     std::string				   *m_psProfileHotKey_down;  // list of hotkeys used in this profile
     std::string				   *m_psProfileHotKey_up;    // list of hotkeys used in this profile
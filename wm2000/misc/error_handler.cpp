@@ -1,41 +1,51 @@
 #include "error_handler.h"
 
+#ifndef WM2000_HEADLESS
 #include <QtWidgets/QMessageBox>
+#endif
 #include <fstream>
+#ifdef _WIN32
 #include <io.h>         // For access().
+#endif
 #include <sys/types.h>  // For stat().
 #include <sys/stat.h>   // For stat().
 
-#include "boost\exception\diagnostic_information.hpp"
-
+#include "boost/exception/diagnostic_information.hpp"
 
-//static variable
-unsigned int(*error_handler::m_pFuncLogMessage)(const char* logMessage, LogLevel severity, const char* channel, uint64 logID) = nullptr;
-bool error_handler::m_bInitDone = false;
 
 #if USE_CALL_STACK
 #define CALL_STACK if(USE_CALL_STACK) this->message_callstack(__FUNCSIG__, (void*)this);
-std::string   error_handler::m_sLogPath = "c:/Users/micha/AppData/Roaming/TS3Client/plugins";
+#define LOG_PATH_DEFAULT "c:/Users/micha/AppData/Roaming/TS3Client/plugins"
 #else
 #define CALL_STACK
-std::string   error_handler::m_sLogPath = "";
+#define LOG_PATH_DEFAULT ""
 #endif
 
 
+/* ----------------------------------------------------------------------------
+* log settings of all instances (constructed on first use)
+*/
+error_handler::log_state& error_handler::get_log_state()
+{
+    static log_state s_cLogState = { nullptr, LOG_PATH_DEFAULT, false };
+    return s_cLogState;
+}
+
+
 /* ----------------------------------------------------------------------------
 * constructor
 */
-error_handler::error_handler()
+error_handler::error_handler() : m_cLogState(get_log_state())
 {
     // clean up call stack
     if (USE_CALL_STACK)
     {
-        std::string sFilePathStack = this->m_sLogPath + c_sStackfileName;
-        if (file_exists(sFilePathStack) && !m_bInitDone)
+        std::string sFilePathStack = this->m_cLogState.sLogPath + c_sStackfileName;
+        if (file_exists(sFilePathStack) && !this->m_cLogState.bInitDone)
         {
             // remove file
             remove(sFilePathStack.c_str());
-            m_bInitDone = true;
+            this->m_cLogState.bInitDone = true;
         }
     }
 };
@@ -46,8 +56,8 @@ error_handler::error_handler()
 */
 void error_handler::init(std::string sLogPath, unsigned int(*funcLogMessage)(const char*, LogLevel, const char*, uint64))
 {
-    this->m_pFuncLogMessage = funcLogMessage;
-    this->m_sLogPath        = sLogPath;
+    this->m_cLogState.pFuncLogMessage = funcLogMessage;
+    this->m_cLogState.sLogPath        = sLogPath;
     CALL_STACK
 }
 
@@ -55,12 +65,12 @@ void error_handler::init(std::string sLogPath, unsigned int(*funcLogMessage)(con
 /* ----------------------------------------------------------------------------
 * write log message to log file
 */
-void error_handler::message_callstack(char * pString, void* pClassPointer)
+void error_handler::message_callstack(const char * pString, void* pClassPointer)
 {
     // write to file if path is valid and we have a error message 
-    if (folderExists(this->m_sLogPath))
+    if (folderExists(this->m_cLogState.sLogPath))
     {
-        std::string sFilePath = this->m_sLogPath + c_sStackfileName;
+        std::string sFilePath = this->m_cLogState.sLogPath + c_sStackfileName;
 
         FILE *pFile;
         fopen_s(&pFile, sFilePath.c_str(), "a");
@@ -75,7 +85,7 @@ void error_handler::message_callstack(char * pString, void* pClassPointer)
     }
     else
     {
-        if (DEBUG_LOG) printf("CallStack path invalid \"%s\"\n", this->m_sLogPath.c_str());
+        if (DEBUG_LOG) printf("CallStack path invalid \"%s\"\n", this->m_cLogState.sLogPath.c_str());
     }
 
     return;
@@ -92,12 +102,12 @@ void error_handler::message_log(char * pString, LogLevel nMode)
     if (DEBUG_LOG) printf("Write message: \"%s\"\n", pString);
 
     // write to TS3 Logger, if function pointer is available   
-    if(this->m_pFuncLogMessage != nullptr) this->m_pFuncLogMessage(pString, nMode, "Whispermaster2000", 0);
+    if(this->m_cLogState.pFuncLogMessage != nullptr) this->m_cLogState.pFuncLogMessage(pString, nMode, "Whispermaster2000", 0);
 
     // write to file if path is valid and we have a error message 
-    if (folderExists(this->m_sLogPath) && ((nMode == LogLevel_ERROR) || ((nMode == LogLevel_DEVEL) && DEBUG_LOG)))
+    if (folderExists(this->m_cLogState.sLogPath) && ((nMode == LogLevel_ERROR) || ((nMode == LogLevel_DEVEL) && DEBUG_LOG)))
     {
-        std::string sFilePath = this->m_sLogPath + c_sLogfileName;
+        std::string sFilePath = this->m_cLogState.sLogPath + c_sLogfileName;
 
         FILE *pFile;
         fopen_s(&pFile, sFilePath.c_str(), "a");
@@ -109,7 +119,7 @@ void error_handler::message_log(char * pString, LogLevel nMode)
     }
     else
     {
-        if (DEBUG_LOG) printf("Logger path invalid \"%s\"\n", this->m_sLogPath.c_str());
+        if (DEBUG_LOG) printf("Logger path invalid \"%s\"\n", this->m_cLogState.sLogPath.c_str());
     }
 
     return;
@@ -126,7 +136,7 @@ void error_handler::error_log(const char * pString)
     char cErrBuffer[nErrBuffSize];
 
     //write error
-    sprintf_s(cErrBuffer, nErrBuffSize, this->m_cTranslate.translate(L"ErrUnknown").c_str(), pString);
+    sprintf_s(cErrBuffer, nErrBuffSize, this->m_cTranslate.translate(L"ErrUnknown"), pString);
     message_log(cErrBuffer, LogLevel_ERROR);
     return;
 }
@@ -137,7 +147,7 @@ void error_handler::error_log(const char * pString, std::exception &e)
     char cErrBuffer[nErrBuffSize];
 
     //write error
-    sprintf_s(cErrBuffer, nErrBuffSize, this->m_cTranslate.translate(L"ErrStdUnknown").c_str(), pString, e.what());
+    sprintf_s(cErrBuffer, nErrBuffSize, this->m_cTranslate.translate(L"ErrStdUnknown"), pString, e.what());
     message_log(cErrBuffer, LogLevel_ERROR);
     return;
 }
@@ -148,7 +158,7 @@ void error_handler::error_log(const char * pString, boost::exception &e)
     char cErrBuffer[nErrBuffSize];
 
     //write error
-    sprintf_s(cErrBuffer, nErrBuffSize, this->m_cTranslate.translate(L"ErrBoostUnknown").c_str(), pString, boost::diagnostic_information_what(e));
+    sprintf_s(cErrBuffer, nErrBuffSize, this->m_cTranslate.translate(L"ErrBoostUnknown"), pString, boost::diagnostic_information_what(e));
     message_log(cErrBuffer, LogLevel_ERROR);
     return;
 }
@@ -176,7 +186,7 @@ void error_handler::debug_log(const char * pString)
 void error_handler::remove_log_file()
 {
     CALL_STACK
-    std::string sFilePathLog = this->m_sLogPath + c_sLogfileName;
+    std::string sFilePathLog = this->m_cLogState.sLogPath + c_sLogfileName;
     if (file_exists(sFilePathLog))
     {
         // read all messages from old file
@@ -185,9 +195,13 @@ void error_handler::remove_log_file()
         t.close();
 
         //inform user about the error
-        QMessageBox cMsgBox(QMessageBox::Information, QString("Information"), QString(this->m_cTranslate.translate(L"ErrExtMessageBox").c_str()), QMessageBox::Ok);
+#ifndef WM2000_HEADLESS
+        QMessageBox cMsgBox(QMessageBox::Information, QString("Information"), QString(this->m_cTranslate.translate(L"ErrExtMessageBox")), QMessageBox::Ok);
         cMsgBox.setDetailedText(QString(str.c_str()));
         cMsgBox.exec();
+#else
+        fprintf(stderr, "%s\n%s\n", this->m_cTranslate.translate(L"ErrExtMessageBox"), str.c_str());
+#endif
 
         // remove file
         remove(sFilePathLog.c_str());
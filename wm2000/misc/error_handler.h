@@ -3,7 +3,9 @@
 #include <stdlib.h>
 #include <string>
 #include "teamspeak/public_definitions.h"
+#include "misc/platform.h"
 #include "language_pkg.h"
+#include <boost/exception/exception.hpp>
 
 //(de-)activate printf's
 #define DEBUG_LOG true
@@ -22,7 +24,7 @@ public:
     void error_log(const char * pString, std::exception &e);
     void error_log(const char * pString, boost::exception &e);
     void message_log(char * pString, LogLevel nMode);
-    void message_callstack(char * pString, void* pClassPointer = nullptr);
+    void message_callstack(const char * pString, void* pClassPointer = nullptr);
 
     void remove_log_file();
 
@@ -30,11 +32,18 @@ public:
     bool folderExists(const std::string& sFoldername);
 
 protected:
-    language_pkg         m_cTranslate;       // language converter
+    // log settings shared by all instances, created by the first constructor:
+    // it is destroyed after every static object that owns an error_handler
+    struct log_state
+    {
+        unsigned int(*pFuncLogMessage)(const char* logMessage, LogLevel severity, const char* channel, uint64 logID);
+        std::string     sLogPath;
+        bool            bInitDone;
+    };
+    static log_state&    get_log_state();
 
-    static unsigned int(*m_pFuncLogMessage)(const char* logMessage, LogLevel severity, const char* channel, uint64 logID);
-    static std::string   m_sLogPath;
-    static bool          m_bInitDone;
+    language_pkg         m_cTranslate;       // language converter
+    log_state&           m_cLogState;        // shared log settings
     const  std::string   c_sLogfileName = "/WhisperMaster2000/wm2000_error_log.txt";
     const  std::string   c_sStackfileName = "/WhisperMaster2000/wm2000_callstack_log.txt";
 
@@ -0,0 +1,91 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+/* ----------------------------------------------------------------------------
+* bounded lock-free queue, many producers / one consumer
+*
+* every cell carries a sequence number (D. Vyukov's bounded queue): a producer
+* reserves a cell with one CAS on the tail and publishes it by advancing the
+* sequence, the consumer frees it by advancing the sequence by nSize. push
+* never blocks, it returns false if the queue is full. Only one thread may
+* call pop at a time (the caller has to serialize consumers).
+*/
+template <class T, size_t nSize>
+class event_queue
+{
+    static_assert((nSize >= 2) && ((nSize & (nSize - 1)) == 0), "queue size must be a power of 2");
+
+public:
+    event_queue()
+    {
+        for (size_t ii = 0; ii < nSize; ii++)
+            this->m_acCell[ii].nSequence.store(ii, std::memory_order_relaxed);
+        this->m_nTail.store(0, std::memory_order_relaxed);
+        this->m_nHead.store(0, std::memory_order_relaxed);
+    };
+
+    // any thread, false => queue is full
+    bool push(const T& cItem)
+    {
+        size_t nPos = this->m_nTail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell& cCell = this->m_acCell[nPos & (nSize - 1)];
+            intptr_t nDiff = (intptr_t)cCell.nSequence.load(std::memory_order_acquire) - (intptr_t)nPos;
+            if (nDiff == 0)
+            {
+                if (this->m_nTail.compare_exchange_weak(nPos, nPos + 1, std::memory_order_relaxed))
+                {
+                    cCell.cItem = cItem;
+                    cCell.nSequence.store(nPos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (nDiff < 0)
+                return false;
+            else
+                nPos = this->m_nTail.load(std::memory_order_relaxed);
+        }
+    };
+
+    // consumer only, false => queue is empty
+    bool pop(T& cItem)
+    {
+        size_t nPos = this->m_nHead.load(std::memory_order_relaxed);
+        cell& cCell = this->m_acCell[nPos & (nSize - 1)];
+        if ((intptr_t)cCell.nSequence.load(std::memory_order_acquire) - (intptr_t)(nPos + 1) < 0)
+            return false;
+
+        cItem = cCell.cItem;
+        cCell.nSequence.store(nPos + nSize, std::memory_order_release);
+        this->m_nHead.store(nPos + 1, std::memory_order_relaxed);
+        return true;
+    };
+
+    // any thread, only a hint while producers are active
+    bool empty()
+    {
+        size_t nPos = this->m_nHead.load(std::memory_order_relaxed);
+        return (intptr_t)this->m_acCell[nPos & (nSize - 1)].nSequence.load(std::memory_order_acquire) - (intptr_t)(nPos + 1) < 0;
+    };
+
+    size_t size()
+    {
+        size_t nTail = this->m_nTail.load(std::memory_order_relaxed);
+        size_t nHead = this->m_nHead.load(std::memory_order_relaxed);
+        return (nTail > nHead) ? nTail - nHead : 0;
+    };
+
+private:
+    struct cell
+    {
+        std::atomic<size_t> nSequence;
+        T                   cItem;
+    };
+
+    alignas(64) std::atomic<size_t> m_nTail;    // next cell for producers
+    alignas(64) std::atomic<size_t> m_nHead;    // next cell for the consumer
+    alignas(64) cell                m_acCell[nSize];
+};
@@ -0,0 +1,523 @@
+#include "misc/event_recorder.h"
+#include <string.h>
+#include <map>
+#include "teamspeak/public_errors.h"
+#include "teamspeak/public_definitions.h"
+#include "teamspeak/clientlib_publicdefinitions.h"
+#include "misc/platform.h"
+
+#if USE_CALL_STACK
+#define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
+#else
+#define CALL_STACK
+#endif
+
+/* ----------------------------------------------------------------------------
+* layout of the record types, see eRecType
+*/
+struct rec_layout
+{
+    const char* pName;
+    size_t      nValues;
+    size_t      nTexts;
+};
+
+static const rec_layout s_acRecLayout[REC_TYPE_END] =
+{
+    { "?",                      0, 0 },
+    { "config",                 0, 1 },     // REC_CONFIG
+    { "channel",                2, 1 },     // REC_CHANNEL
+    { "client",                 2, 2 },     // REC_CLIENT
+    { "my_client",              2, 0 },     // REC_MY_CLIENT
+    { "snapshot_end",           0, 0 },     // REC_SNAPSHOT_END
+    { "onConnectStatusChange",  2, 0 },     // REC_CONNECT_STATUS
+    { "onNewChannel",           2, 0 },     // REC_NEW_CHANNEL
+    { "onNewChannelCreated",    3, 0 },     // REC_NEW_CHANNEL_CREATED
+    { "onDelChannel",           2, 0 },     // REC_DEL_CHANNEL
+    { "onChannelMove",          3, 0 },     // REC_CHANNEL_MOVE
+    { "onUpdateChannelEdited",  2, 0 },     // REC_CHANNEL_EDITED
+    { "onUpdateClient",         2, 0 },     // REC_UPDATE_CLIENT
+    { "onClientMove",           4, 0 },     // REC_CLIENT_MOVE
+    { "onClientMoveSubscr",     4, 0 },     // REC_CLIENT_SUBSCRIPTION
+    { "onClientMoveTimeout",    4, 0 },     // REC_CLIENT_TIMEOUT
+    { "onClientMoveMoved",      5, 0 },     // REC_CLIENT_MOVED
+    { "onTalkStatusChange",     3, 0 },     // REC_TALK_STATUS
+    { "onMenuItem",             3, 0 },     // REC_MENU_ITEM
+    { "onHotkey",               0, 1 },     // REC_HOTKEY
+    { "processCommand",         0, 1 },     // REC_COMMAND
+    { "infoData",               2, 0 },     // REC_INFO_DATA
+};
+
+const char* rec_type_name(eRecType eType)
+{
+    return ((eType > 0) && (eType < REC_TYPE_END)) ? s_acRecLayout[eType].pName : s_acRecLayout[0].pName;
+}
+
+size_t rec_num_values(eRecType eType)
+{
+    return ((eType > 0) && (eType < REC_TYPE_END)) ? s_acRecLayout[eType].nValues : 0;
+}
+
+size_t rec_num_texts(eRecType eType)
+{
+    return ((eType > 0) && (eType < REC_TYPE_END)) ? s_acRecLayout[eType].nTexts : 0;
+}
+
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+event_recorder::event_recorder()
+{
+    this->m_pstTs3Functions = nullptr;
+    this->m_pFile           = nullptr;
+    this->m_bActive         = false;
+    this->m_nNumEvents      = 0;
+    this->m_nLastTime_us    = 0;
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+event_recorder::~event_recorder()
+{
+    stop();
+}
+
+/* ----------------------------------------------------------------------------
+* set interfaces
+*/
+void event_recorder::init(const struct TS3Functions* pstTs3Functions)
+{
+    this->m_pstTs3Functions = pstTs3Functions;
+}
+
+/* ----------------------------------------------------------------------------
+* open log, write config and (if nSnapshotServerID != 0) the state of the server
+*/
+bool event_recorder::start(const std::string& sFileName, const std::string& sConfigFile, uint64 nSnapshotServerID)
+{
+    CALL_STACK
+    try
+    {
+        stop();
+        {
+            boost::lock_guard<boost::mutex> lock(this->m_cFileMutex);
+            FILE *pFile = nullptr;
+            fopen_s(&pFile, sFileName.c_str(), "wb");
+            if (pFile == nullptr)
+                return false;
+            setvbuf(pFile, nullptr, _IOFBF, REC_FILE_BUFSIZE);
+
+            const char cVersion = REC_FILE_VERSION;
+            fwrite(REC_FILE_MAGIC, 1, strlen(REC_FILE_MAGIC), pFile);
+            fwrite(&cVersion, 1, 1, pFile);
+
+            this->m_pFile           = pFile;
+            this->m_sFileName       = sFileName;
+            this->m_nNumEvents      = 0;
+            this->m_nLastTime_us    = 0;
+            this->m_cStart          = std::chrono::steady_clock::now();
+            this->m_bActive         = true;
+        }
+
+        // config at start of recording, replay uses the same settings
+        std::string sConfig;
+        FILE *pConfig = nullptr;
+        fopen_s(&pConfig, sConfigFile.c_str(), "rb");
+        if (pConfig != nullptr)
+        {
+            char cBuffer[4096];
+            size_t nRead;
+            while ((nRead = fread(cBuffer, 1, sizeof(cBuffer), pConfig)) > 0)
+                sConfig.append(cBuffer, nRead);
+            fclose(pConfig);
+        }
+        const char* apText[] = { sConfig.c_str() };
+        write(REC_CONFIG, 0, nullptr, apText);
+
+        if (nSnapshotServerID != 0)
+            write_snapshot(nSnapshotServerID);
+        return true;
+    }
+    catch (std::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (boost::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (...)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__);
+    }
+    return false;
+}
+
+/* ----------------------------------------------------------------------------
+* close log
+*/
+void event_recorder::stop()
+{
+    boost::lock_guard<boost::mutex> lock(this->m_cFileMutex);
+    this->m_bActive = false;
+    if (this->m_pFile != nullptr)
+    {
+        fclose(this->m_pFile);
+        this->m_pFile = nullptr;
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* TS3 callbacks, state records are written before the event
+*/
+void event_recorder::onConnectStatusChange(uint64 nServerID, int iStatus, unsigned int nError)
+{
+    if (!this->m_bActive)
+        return;
+    if ((iStatus == STATUS_CONNECTION_ESTABLISHING) || (iStatus == STATUS_CONNECTION_ESTABLISHED))
+        write_my_client(nServerID);
+    uint64_t anValue[] = { (uint64_t)iStatus, nError };
+    write(REC_CONNECT_STATUS, nServerID, anValue, nullptr);
+}
+
+void event_recorder::onChannel(eRecType eType, uint64 nServerID, uint64 nChannelID, uint64 nParentID, anyID nInvokerID)
+{
+    if (!this->m_bActive)
+        return;
+    if ((eType == REC_NEW_CHANNEL) || (eType == REC_NEW_CHANNEL_CREATED))
+        write_channel(nServerID, nChannelID, nParentID);
+
+    uint64_t anValue[] = { nChannelID, nParentID, nInvokerID };
+    if ((eType == REC_DEL_CHANNEL) || (eType == REC_CHANNEL_EDITED))
+        anValue[1] = nInvokerID;
+    write(eType, nServerID, anValue, nullptr);
+}
+
+void event_recorder::onUpdateClient(uint64 nServerID, anyID nClientID, anyID nInvokerID)
+{
+    if (!this->m_bActive)
+        return;
+    uint64 nChannelID = 0;
+    if ((this->m_pstTs3Functions != nullptr) && (this->m_pstTs3Functions->getChannelOfClient(nServerID, nClientID, &nChannelID) == ERROR_ok))
+        write_client(nServerID, nClientID, nChannelID);    // meta data may have changed
+    uint64_t anValue[] = { nClientID, nInvokerID };
+    write(REC_UPDATE_CLIENT, nServerID, anValue, nullptr);
+}
+
+void event_recorder::onClientMove(eRecType eType, uint64 nServerID, anyID nClientID, uint64 nOldChannelID, uint64 nNewChannelID, int iVisibility, anyID nMoverID)
+{
+    if (!this->m_bActive)
+        return;
+    if ((nOldChannelID == 0) && (nNewChannelID != 0))
+        write_client(nServerID, nClientID, nNewChannelID); // client enters view
+    uint64_t anValue[] = { nClientID, nOldChannelID, nNewChannelID, (uint64_t)iVisibility, nMoverID };
+    write(eType, nServerID, anValue, nullptr);
+}
+
+void event_recorder::onTalkStatusChange(uint64 nServerID, int iStatus, int iIsReceivedWhisper, anyID nClientID)
+{
+    if (!this->m_bActive)
+        return;
+    uint64_t anValue[] = { (uint64_t)iStatus, (uint64_t)iIsReceivedWhisper, nClientID };
+    write(REC_TALK_STATUS, nServerID, anValue, nullptr);
+}
+
+void event_recorder::onMenuItem(uint64 nServerID, int iType, int iMenuID, uint64 nSelectedID)
+{
+    if (!this->m_bActive)
+        return;
+    uint64_t anValue[] = { (uint64_t)iType, (uint64_t)iMenuID, nSelectedID };
+    write(REC_MENU_ITEM, nServerID, anValue, nullptr);
+}
+
+void event_recorder::onHotkey(const char* keyword)
+{
+    if (!this->m_bActive)
+        return;
+    const char* apText[] = { keyword };
+    write(REC_HOTKEY, 0, nullptr, apText);
+}
+
+void event_recorder::onCommand(uint64 nServerID, const char* command)
+{
+    if (!this->m_bActive)
+        return;
+    const char* apText[] = { command };
+    write(REC_COMMAND, nServerID, nullptr, apText);
+}
+
+void event_recorder::onInfoData(uint64 nServerID, uint64 nID, int iType)
+{
+    if (!this->m_bActive)
+        return;
+    uint64_t anValue[] = { nID, (uint64_t)iType };
+    write(REC_INFO_DATA, nServerID, anValue, nullptr);
+}
+
+/* ----------------------------------------------------------------------------
+* channel tree (parents first), own client and all other clients of a server
+*/
+void event_recorder::write_snapshot(uint64 nServerID)
+{
+    if (this->m_pstTs3Functions == nullptr)
+        return;
+
+    uint64 *pnChannelList = nullptr;
+    if (this->m_pstTs3Functions->getChannelList(nServerID, &pnChannelList) == ERROR_ok)
+    {
+        std::map<uint64, uint64> mParent;
+        for (size_t ii = 0; pnChannelList[ii] != 0; ii++)
+        {
+            uint64 nParentID = 0;
+            this->m_pstTs3Functions->getParentChannelOfChannel(nServerID, pnChannelList[ii], &nParentID);
+            mParent[pnChannelList[ii]] = nParentID;
+        }
+        this->m_pstTs3Functions->freeMemory(pnChannelList);
+
+        // a channel is written as soon as its parent is known to the replay
+        std::map<uint64, bool> mWritten;
+        bool bProgress = true;
+        while (bProgress)
+        {
+            bProgress = false;
+            for (const std::pair<const uint64, uint64>& cChannel : mParent)
+            {
+                if (mWritten.count(cChannel.first) || ((cChannel.second != 0) && !mWritten.count(cChannel.second)))
+                    continue;
+                write_channel(nServerID, cChannel.first, cChannel.second);
+                mWritten[cChannel.first] = true;
+                bProgress = true;
+            }
+        }
+    }
+
+    write_my_client(nServerID);
+    anyID nMyClientID = 0;
+    this->m_pstTs3Functions->getClientID(nServerID, &nMyClientID);
+
+    anyID *pnClientList = nullptr;
+    if (this->m_pstTs3Functions->getClientList(nServerID, &pnClientList) == ERROR_ok)
+    {
+        for (size_t ii = 0; pnClientList[ii] != 0; ii++)
+        {
+            uint64 nChannelID = 0;
+            if ((pnClientList[ii] != nMyClientID) && (this->m_pstTs3Functions->getChannelOfClient(nServerID, pnClientList[ii], &nChannelID) == ERROR_ok))
+                write_client(nServerID, pnClientList[ii], nChannelID);
+        }
+        this->m_pstTs3Functions->freeMemory(pnClientList);
+    }
+    write(REC_SNAPSHOT_END, nServerID, nullptr, nullptr);
+}
+
+void event_recorder::write_channel(uint64 nServerID, uint64 nChannelID, uint64 nParentID)
+{
+    char *pcName = nullptr;
+    if ((this->m_pstTs3Functions == nullptr) || (this->m_pstTs3Functions->getChannelVariableAsString(nServerID, nChannelID, CHANNEL_NAME, &pcName) != ERROR_ok))
+        pcName = nullptr;
+
+    uint64_t anValue[] = { nChannelID, nParentID };
+    const char* apText[] = { pcName ? pcName : "" };
+    write(REC_CHANNEL, nServerID, anValue, apText);
+    if (pcName != nullptr)
+        this->m_pstTs3Functions->freeMemory(pcName);
+}
+
+void event_recorder::write_client(uint64 nServerID, anyID nClientID, uint64 nChannelID)
+{
+    char *pcName = nullptr;
+    char *pcMetaData = nullptr;
+    if (this->m_pstTs3Functions != nullptr)
+    {
+        if (this->m_pstTs3Functions->getClientVariableAsString(nServerID, nClientID, CLIENT_NICKNAME, &pcName) != ERROR_ok)
+            pcName = nullptr;
+        if (this->m_pstTs3Functions->getClientVariableAsString(nServerID, nClientID, CLIENT_META_DATA, &pcMetaData) != ERROR_ok)
+            pcMetaData = nullptr;
+    }
+
+    uint64_t anValue[] = { nClientID, nChannelID };
+    const char* apText[] = { pcName ? pcName : "", pcMetaData ? pcMetaData : "" };
+    write(REC_CLIENT, nServerID, anValue, apText);
+    if (pcName != nullptr)
+        this->m_pstTs3Functions->freeMemory(pcName);
+    if (pcMetaData != nullptr)
+        this->m_pstTs3Functions->freeMemory(pcMetaData);
+}
+
+void event_recorder::write_my_client(uint64 nServerID)
+{
+    anyID nMyClientID = 0;
+    uint64 nChannelID = 0;
+    if ((this->m_pstTs3Functions == nullptr) || (this->m_pstTs3Functions->getClientID(nServerID, &nMyClientID) != ERROR_ok) || (nMyClientID == 0))
+        return;
+    this->m_pstTs3Functions->getChannelOfClient(nServerID, nMyClientID, &nChannelID);
+
+    uint64_t anValue[] = { nMyClientID, nChannelID };
+    write(REC_MY_CLIENT, nServerID, anValue, nullptr);
+}
+
+/* ----------------------------------------------------------------------------
+* write one record
+*/
+void event_recorder::write(eRecType eType, uint64 nServerID, const uint64_t* pnValue, const char* const* ppText)
+{
+    boost::lock_guard<boost::mutex> lock(this->m_cFileMutex);
+    if (this->m_pFile == nullptr)
+        return;
+
+    uint64_t nTime_us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - this->m_cStart).count();
+    if (nTime_us < this->m_nLastTime_us)
+        nTime_us = this->m_nLastTime_us;
+
+    fputc((int)eType, this->m_pFile);
+    write_varint(nTime_us - this->m_nLastTime_us);
+    write_varint(nServerID);
+    for (size_t ii = 0; ii < rec_num_values(eType); ii++)
+        write_varint(pnValue[ii]);
+    for (size_t ii = 0; ii < rec_num_texts(eType); ii++)
+        write_text(ppText[ii]);
+
+    this->m_nLastTime_us = nTime_us;
+    this->m_nNumEvents++;
+}
+
+void event_recorder::write_varint(uint64_t nValue)
+{
+    while (nValue >= 0x80)
+    {
+        fputc((int)(nValue & 0x7F) | 0x80, this->m_pFile);
+        nValue >>= 7;
+    }
+    fputc((int)nValue, this->m_pFile);
+}
+
+void event_recorder::write_text(const char* pText)
+{
+    size_t nLength = (pText == nullptr) ? 0 : strlen(pText);
+    write_varint(nLength);
+    if (nLength != 0)
+        fwrite(pText, 1, nLength, this->m_pFile);
+}
+
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+event_reader::event_reader()
+{
+    this->m_pFile       = nullptr;
+    this->m_bError      = false;
+    this->m_nTime_us    = 0;
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+event_reader::~event_reader()
+{
+    close();
+}
+
+/* ----------------------------------------------------------------------------
+* open log and check header
+*/
+bool event_reader::open(const std::string& sFileName)
+{
+    close();
+    this->m_bError      = false;
+    this->m_nTime_us    = 0;
+
+    fopen_s(&this->m_pFile, sFileName.c_str(), "rb");
+    if (this->m_pFile == nullptr)
+        return false;
+    setvbuf(this->m_pFile, nullptr, _IOFBF, REC_FILE_BUFSIZE);
+
+    char cHeader[8] = { 0 };
+    if ((fread(cHeader, 1, sizeof(cHeader), this->m_pFile) != sizeof(cHeader)) || (memcmp(cHeader, REC_FILE_MAGIC, strlen(REC_FILE_MAGIC)) != 0) || (cHeader[7] != REC_FILE_VERSION))
+    {
+        close();
+        this->m_bError = true;
+        return false;
+    }
+    return true;
+}
+
+void event_reader::close()
+{
+    if (this->m_pFile != nullptr)
+    {
+        fclose(this->m_pFile);
+        this->m_pFile = nullptr;
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* read next record
+*/
+bool event_reader::read(rec_event& cEvent)
+{
+    if (this->m_pFile == nullptr)
+        return false;
+
+    int iType = fgetc(this->m_pFile);
+    if (iType == EOF)
+        return false;       // a log of a crashed client may end in the middle of a record => error below
+
+    uint64_t nDelta = 0;
+    uint64_t nServerID = 0;
+    cEvent.eType = (eRecType)iType;
+    if ((iType <= 0) || (iType >= REC_TYPE_END) || !read_varint(nDelta) || !read_varint(nServerID))
+    {
+        this->m_bError = true;
+        return false;
+    }
+    this->m_nTime_us += nDelta;
+    cEvent.nTime_us  = this->m_nTime_us;
+    cEvent.nServerID = nServerID;
+
+    for (size_t ii = 0; ii < REC_MAX_VALUE; ii++)
+        cEvent.aValue[ii] = 0;
+    for (size_t ii = 0; ii < rec_num_values(cEvent.eType); ii++)
+    {
+        if (!read_varint(cEvent.aValue[ii]))
+        {
+            this->m_bError = true;
+            return false;
+        }
+    }
+    for (size_t ii = 0; ii < REC_MAX_TEXT; ii++)
+    {
+        cEvent.asText[ii].clear();
+        if ((ii < rec_num_texts(cEvent.eType)) && !read_text(cEvent.asText[ii]))
+        {
+            this->m_bError = true;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool event_reader::read_varint(uint64_t& nValue)
+{
+    nValue = 0;
+    for (int iShift = 0; iShift < 64; iShift += 7)
+    {
+        int iByte = fgetc(this->m_pFile);
+        if (iByte == EOF)
+            return false;
+        nValue |= (uint64_t)(iByte & 0x7F) << iShift;
+        if ((iByte & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+bool event_reader::read_text(std::string& sText)
+{
+    uint64_t nLength = 0;
+    if (!read_varint(nLength) || (nLength > (1u << 24)))
+        return false;
+    sText.resize((size_t)nLength);
+    return (nLength == 0) || (fread(&sText[0], 1, (size_t)nLength, this->m_pFile) == nLength);
+}
@@ -0,0 +1,173 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <boost/thread.hpp>
+#include "ts3_functions.h"
+#include "misc/error_handler.h"
+
+#define REC_FILE_MAGIC      "WM2KREC"           // 7 characters + format version
+#define REC_FILE_VERSION    1
+#define REC_FILE_BUFSIZE    (64 * 1024)
+
+/* ----------------------------------------------------------------------------
+* record types, values (aValue) and texts (asText) of each type:
+*
+*   state of the server, written before the event which needs it
+*     REC_CONFIG               -                                         config.xml
+*     REC_CHANNEL              channel, parent                           name
+*     REC_CLIENT               client, channel                           name, meta data
+*     REC_MY_CLIENT            client, channel
+*     REC_SNAPSHOT_END         -                 (recording started while connected)
+*
+*   TS3 callbacks (ts3plugin_on...)
+*     REC_CONNECT_STATUS       status, error
+*     REC_NEW_CHANNEL          channel, parent
+*     REC_NEW_CHANNEL_CREATED  channel, parent, invoker
+*     REC_DEL_CHANNEL          channel, invoker
+*     REC_CHANNEL_MOVE         channel, new parent, invoker
+*     REC_CHANNEL_EDITED       channel, invoker
+*     REC_UPDATE_CLIENT        client, invoker
+*     REC_CLIENT_MOVE          client, old channel, new channel, visibility
+*     REC_CLIENT_SUBSCRIPTION  client, old channel, new channel, visibility
+*     REC_CLIENT_TIMEOUT       client, old channel, new channel, visibility
+*     REC_CLIENT_MOVED         client, old channel, new channel, visibility, mover
+*     REC_TALK_STATUS          status, is received whisper, client
+*     REC_MENU_ITEM            type, menu ID, selected ID
+*     REC_HOTKEY               -                                         keyword
+*     REC_COMMAND              -                                         command
+*     REC_INFO_DATA            ID, type
+*/
+enum eRecType
+{
+    REC_CONFIG = 1,
+    REC_CHANNEL,
+    REC_CLIENT,
+    REC_MY_CLIENT,
+    REC_SNAPSHOT_END,
+
+    REC_CONNECT_STATUS,
+    REC_NEW_CHANNEL,
+    REC_NEW_CHANNEL_CREATED,
+    REC_DEL_CHANNEL,
+    REC_CHANNEL_MOVE,
+    REC_CHANNEL_EDITED,
+    REC_UPDATE_CLIENT,
+    REC_CLIENT_MOVE,
+    REC_CLIENT_SUBSCRIPTION,
+    REC_CLIENT_TIMEOUT,
+    REC_CLIENT_MOVED,
+    REC_TALK_STATUS,
+    REC_MENU_ITEM,
+    REC_HOTKEY,
+    REC_COMMAND,
+    REC_INFO_DATA,
+
+    REC_TYPE_END
+};
+
+#define REC_MAX_VALUE   5
+#define REC_MAX_TEXT    2
+
+/* ----------------------------------------------------------------------------
+* one record of the log
+*
+* file: magic, version, then the records. Each record is the type (1 byte),
+* the time since the previous record in us, the server connection handler ID,
+* the values and texts of the type. All numbers are LEB128 varints, texts
+* are length + bytes, so most records need less than 10 bytes.
+*/
+struct rec_event
+{
+    eRecType        eType;
+    uint64_t        nTime_us;           // since start of recording
+    uint64          nServerID;          // 0 for hotkeys
+    uint64_t        aValue[REC_MAX_VALUE];
+    std::string     asText[REC_MAX_TEXT];
+};
+
+const char*         rec_type_name(eRecType eType);
+size_t              rec_num_values(eRecType eType);
+size_t              rec_num_texts(eRecType eType);
+
+/* ----------------------------------------------------------------------------
+* writes all plugin callbacks to a binary log (opt-in, see plugin_interface)
+*
+* the callbacks only carry IDs, so the recorder adds the state the plugin
+* would query (channel names, client meta data, own client). If the recording
+* is started while connected, a snapshot of that server is written first.
+* Every function returns immediately, if no recording is active.
+*/
+class event_recorder
+{
+public:
+    event_recorder();
+    ~event_recorder();
+
+    void                init(const struct TS3Functions* pstTs3Functions);
+    bool                start(const std::string& sFileName, const std::string& sConfigFile, uint64 nSnapshotServerID);
+    void                stop();
+    bool                is_active() { return this->m_bActive; };
+    const std::string&  get_file_name() { return this->m_sFileName; };
+    size_t              get_num_events() { return this->m_nNumEvents; };
+
+    // TS3 callbacks
+    void                onConnectStatusChange(uint64 nServerID, int iStatus, unsigned int nError);
+    void                onChannel(eRecType eType, uint64 nServerID, uint64 nChannelID, uint64 nParentID, anyID nInvokerID);
+    void                onUpdateClient(uint64 nServerID, anyID nClientID, anyID nInvokerID);
+    void                onClientMove(eRecType eType, uint64 nServerID, anyID nClientID, uint64 nOldChannelID, uint64 nNewChannelID, int iVisibility, anyID nMoverID);
+    void                onTalkStatusChange(uint64 nServerID, int iStatus, int iIsReceivedWhisper, anyID nClientID);
+    void                onMenuItem(uint64 nServerID, int iType, int iMenuID, uint64 nSelectedID);
+    void                onHotkey(const char* keyword);
+    void                onCommand(uint64 nServerID, const char* command);
+    void                onInfoData(uint64 nServerID, uint64 nID, int iType);
+
+protected:
+    void                write_snapshot(uint64 nServerID);
+    void                write_channel(uint64 nServerID, uint64 nChannelID, uint64 nParentID);
+    void                write_client(uint64 nServerID, anyID nClientID, uint64 nChannelID);
+    void                write_my_client(uint64 nServerID);
+    void                write(eRecType eType, uint64 nServerID, const uint64_t* pnValue, const char* const* ppText);
+    void                write_varint(uint64_t nValue);
+    void                write_text(const char* pText);
+
+private:
+    error_handler       m_cErrHandler;          // link to error handler
+    const struct TS3Functions* m_pstTs3Functions; // TS3 interface functions
+
+    boost::mutex        m_cFileMutex;           // hotkeys are not sent by the TS3 main thread
+    FILE               *m_pFile;                // nullptr => not recording
+    std::atomic<bool>   m_bActive;              // checked without lock by every callback
+    std::string         m_sFileName;
+    size_t              m_nNumEvents;
+    std::chrono::steady_clock::time_point m_cStart;
+    uint64_t            m_nLastTime_us;         // time of the previous record
+};
+
+/* ----------------------------------------------------------------------------
+* reads a log written by event_recorder
+*/
+class event_reader
+{
+public:
+    event_reader();
+    ~event_reader();
+
+    bool                open(const std::string& sFileName);
+    bool                read(rec_event& cEvent);    // false at end of file or on error
+    bool                has_error() { return this->m_bError; };
+    void                close();
+
+protected:
+    bool                read_varint(uint64_t& nValue);
+    bool                read_text(std::string& sText);
+
+private:
+    FILE               *m_pFile;
+    bool                m_bError;
+    uint64_t            m_nTime_us;
+};
@@ -0,0 +1,201 @@
+#include "misc/gain_kernel.h"
+#include <atomic>
+#if GAIN_KERNEL_X86
+#include <emmintrin.h>
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define GAIN_TARGET_AVX2
+#else
+#define GAIN_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// ramp in Q14 << GAIN_RAMP_SHIFT, exact enough for the longest TS3 buffers
+#define GAIN_RAMP_SHIFT 8
+
+static std::atomic<int> s_iKernel(-1);     // selected eGainKernel, -1 until first use
+
+/* ----------------------------------------------------------------------------
+* kernel selection
+*/
+bool gain_kernel::is_supported(eGainKernel eKernel)
+{
+    switch (eKernel)
+    {
+    case GAIN_KERNEL_SCALAR:
+        return true;
+#if GAIN_KERNEL_X86
+    case GAIN_KERNEL_SSE2:
+        return true;
+    case GAIN_KERNEL_AVX2:
+#ifdef _MSC_VER
+        {
+            // CPU supports AVX2 and the OS saves the YMM registers
+            int aiInfo[4];
+            __cpuid(aiInfo, 1);
+            bool bOsxsave = (aiInfo[2] & (1 << 27)) != 0;
+            bool bAvx     = (aiInfo[2] & (1 << 28)) != 0;
+            if (!bOsxsave || !bAvx || ((_xgetbv(0) & 6) != 6))
+                return false;
+            __cpuidex(aiInfo, 7, 0);
+            return (aiInfo[1] & (1 << 5)) != 0;
+        }
+#else
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+#endif
+    default:
+        return false;
+    }
+}
+
+eGainKernel gain_kernel::get_kernel()
+{
+    int iKernel = s_iKernel.load(std::memory_order_relaxed);
+    if (iKernel < 0)
+    {
+        iKernel = GAIN_KERNEL_SCALAR;
+        for (int ii = GAIN_KERNEL_MAX - 1; ii > GAIN_KERNEL_SCALAR; ii--)
+        {
+            if (is_supported((eGainKernel)ii))
+            {
+                iKernel = ii;
+                break;
+            }
+        }
+        s_iKernel.store(iKernel, std::memory_order_relaxed);
+    }
+    return (eGainKernel)iKernel;
+}
+
+void gain_kernel::set_kernel(eGainKernel eKernel)
+{
+    if (is_supported(eKernel))
+        s_iKernel.store(eKernel, std::memory_order_relaxed);
+}
+
+const char* gain_kernel::get_name(eGainKernel eKernel)
+{
+    static const char* s_apcName[GAIN_KERNEL_MAX] = { "scalar", "sse2", "avx2" };
+    return ((eKernel >= 0) && (eKernel < GAIN_KERNEL_MAX)) ? s_apcName[eKernel] : "unknown";
+}
+
+/* ----------------------------------------------------------------------------
+* apply gain with the selected kernel
+*/
+void gain_kernel::apply(short *psSamples, size_t nSamples, int iStartGain, int iEndGain)
+{
+    apply(get_kernel(), psSamples, nSamples, iStartGain, iEndGain);
+}
+
+void gain_kernel::apply(eGainKernel eKernel, short *psSamples, size_t nSamples, int iStartGain, int iEndGain)
+{
+    if ((psSamples == nullptr) || (nSamples == 0))
+        return;
+
+    switch (eKernel)
+    {
+#if GAIN_KERNEL_X86
+    case GAIN_KERNEL_SSE2:  apply_sse2(psSamples, nSamples, iStartGain, iEndGain); break;
+    case GAIN_KERNEL_AVX2:  apply_avx2(psSamples, nSamples, iStartGain, iEndGain); break;
+#endif
+    default:                apply_scalar(psSamples, nSamples, iStartGain, iEndGain); break;
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* scalar kernel, reference for the others
+*/
+static inline short scale_sample(short sSample, int iGain)
+{
+    int iValue = (sSample * iGain + (GAIN_UNITY >> 1)) >> 14;
+    if (iValue >  32767) iValue =  32767;
+    if (iValue < -32768) iValue = -32768;
+    return (short)iValue;
+}
+
+void gain_kernel::scale_tail(short *psSamples, size_t nSamples, int iGain)
+{
+    for (size_t ii = 0; ii < nSamples; ii++)
+        psSamples[ii] = scale_sample(psSamples[ii], iGain);
+}
+
+void gain_kernel::apply_scalar(short *psSamples, size_t nSamples, int iStartGain, int iEndGain)
+{
+    size_t nBlocks = (nSamples + GAIN_BLOCK_SIZE - 1) / GAIN_BLOCK_SIZE;
+    int iGain = iStartGain << GAIN_RAMP_SHIFT;
+    int iStep = (iEndGain - iStartGain) * (1 << GAIN_RAMP_SHIFT) / (int)nBlocks;
+
+    for (size_t nPos = 0; nPos < nSamples; nPos += GAIN_BLOCK_SIZE)
+    {
+        size_t nCount = (nSamples - nPos < GAIN_BLOCK_SIZE) ? nSamples - nPos : GAIN_BLOCK_SIZE;
+        scale_tail(psSamples + nPos, nCount, iGain >> GAIN_RAMP_SHIFT);
+        iGain += iStep;
+    }
+}
+
+#if GAIN_KERNEL_X86
+/* ----------------------------------------------------------------------------
+* SSE2: 16 x 16 bit => 32 bit products (mullo/mulhi), rounding shift and
+* saturating pack back to 16 bit, two registers per block
+*/
+static inline __m128i scale_sse2(__m128i xSample, __m128i xGain, __m128i xRound)
+{
+    __m128i xLow  = _mm_mullo_epi16(xSample, xGain);
+    __m128i xHigh = _mm_mulhi_epi16(xSample, xGain);
+    __m128i xLo32 = _mm_srai_epi32(_mm_add_epi32(_mm_unpacklo_epi16(xLow, xHigh), xRound), 14);
+    __m128i xHi32 = _mm_srai_epi32(_mm_add_epi32(_mm_unpackhi_epi16(xLow, xHigh), xRound), 14);
+    return _mm_packs_epi32(xLo32, xHi32);
+}
+
+void gain_kernel::apply_sse2(short *psSamples, size_t nSamples, int iStartGain, int iEndGain)
+{
+    size_t nBlocks = (nSamples + GAIN_BLOCK_SIZE - 1) / GAIN_BLOCK_SIZE;
+    int iGain = iStartGain << GAIN_RAMP_SHIFT;
+    int iStep = (iEndGain - iStartGain) * (1 << GAIN_RAMP_SHIFT) / (int)nBlocks;
+    const __m128i xRound = _mm_set1_epi32(GAIN_UNITY >> 1);
+
+    size_t nPos = 0;
+    for (; nPos + GAIN_BLOCK_SIZE <= nSamples; nPos += GAIN_BLOCK_SIZE)
+    {
+        __m128i xGain = _mm_set1_epi16((short)(iGain >> GAIN_RAMP_SHIFT));
+        __m128i *pxData = (__m128i*)(psSamples + nPos);
+        _mm_storeu_si128(pxData,     scale_sse2(_mm_loadu_si128(pxData),     xGain, xRound));
+        _mm_storeu_si128(pxData + 1, scale_sse2(_mm_loadu_si128(pxData + 1), xGain, xRound));
+        iGain += iStep;
+    }
+    scale_tail(psSamples + nPos, nSamples - nPos, iGain >> GAIN_RAMP_SHIFT);
+}
+
+/* ----------------------------------------------------------------------------
+* AVX2: same as SSE2 with one register per block (unpack/pack work per
+* 128 bit lane, so the sample order is kept)
+*/
+GAIN_TARGET_AVX2 static inline __m256i scale_avx2(__m256i ySample, __m256i yGain, __m256i yRound)
+{
+    __m256i yLow  = _mm256_mullo_epi16(ySample, yGain);
+    __m256i yHigh = _mm256_mulhi_epi16(ySample, yGain);
+    __m256i yLo32 = _mm256_srai_epi32(_mm256_add_epi32(_mm256_unpacklo_epi16(yLow, yHigh), yRound), 14);
+    __m256i yHi32 = _mm256_srai_epi32(_mm256_add_epi32(_mm256_unpackhi_epi16(yLow, yHigh), yRound), 14);
+    return _mm256_packs_epi32(yLo32, yHi32);
+}
+
+GAIN_TARGET_AVX2 void gain_kernel::apply_avx2(short *psSamples, size_t nSamples, int iStartGain, int iEndGain)
+{
+    size_t nBlocks = (nSamples + GAIN_BLOCK_SIZE - 1) / GAIN_BLOCK_SIZE;
+    int iGain = iStartGain << GAIN_RAMP_SHIFT;
+    int iStep = (iEndGain - iStartGain) * (1 << GAIN_RAMP_SHIFT) / (int)nBlocks;
+    const __m256i yRound = _mm256_set1_epi32(GAIN_UNITY >> 1);
+
+    size_t nPos = 0;
+    for (; nPos + GAIN_BLOCK_SIZE <= nSamples; nPos += GAIN_BLOCK_SIZE)
+    {
+        __m256i yGain = _mm256_set1_epi16((short)(iGain >> GAIN_RAMP_SHIFT));
+        __m256i *pyData = (__m256i*)(psSamples + nPos);
+        _mm256_storeu_si256(pyData, scale_avx2(_mm256_loadu_si256(pyData), yGain, yRound));
+        iGain += iStep;
+    }
+    scale_tail(psSamples + nPos, nSamples - nPos, iGain >> GAIN_RAMP_SHIFT);
+}
+#endif
@@ -0,0 +1,51 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define GAIN_UNITY          16384   // gains are Q14, max. 32767 (+6 dB)
+#define GAIN_BLOCK_SIZE     16      // samples with the same gain within a ramp (one AVX2 register)
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define GAIN_KERNEL_X86 1
+#else
+#define GAIN_KERNEL_X86 0
+#endif
+
+enum eGainKernel
+{
+    GAIN_KERNEL_SCALAR = 0,
+    GAIN_KERNEL_SSE2,
+    GAIN_KERNEL_AVX2,
+    GAIN_KERNEL_MAX
+};
+
+/* ----------------------------------------------------------------------------
+* gain stage for 16 bit PCM
+*
+* the gain ramps linearly from iStartGain to iEndGain over the buffer, it is
+* changed every GAIN_BLOCK_SIZE samples (interleaved channels are not taken
+* into account, a step is far below audible). Results are rounded and
+* saturated, all kernels return the same samples. The fastest kernel of the
+* CPU is selected at first use.
+*/
+class gain_kernel
+{
+public:
+    static void         apply(short *psSamples, size_t nSamples, int iStartGain, int iEndGain);
+    static void         apply(eGainKernel eKernel, short *psSamples, size_t nSamples, int iStartGain, int iEndGain);
+
+    static bool         is_supported(eGainKernel eKernel);
+    static eGainKernel  get_kernel();
+    static void         set_kernel(eGainKernel eKernel);     // benchmark, ignored if not supported
+    static const char*  get_name(eGainKernel eKernel);
+
+protected:
+    static void         apply_scalar(short *psSamples, size_t nSamples, int iStartGain, int iEndGain);
+#if GAIN_KERNEL_X86
+    static void         apply_sse2(short *psSamples, size_t nSamples, int iStartGain, int iEndGain);
+    static void         apply_avx2(short *psSamples, size_t nSamples, int iStartGain, int iEndGain);
+#endif
+    static void         scale_tail(short *psSamples, size_t nSamples, int iGain);
+};
@@ -0,0 +1,119 @@
+#include "misc/hotkey_table.h"
+
+#if USE_CALL_STACK
+#define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
+#else
+#define CALL_STACK
+#endif
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+hotkey_table::hotkey_table()
+{
+    this->m_pcConfigData        = nullptr;
+    this->m_bIsValid            = false;
+    this->m_nConfigGeneration   = 0;
+
+    // keywords never change, only the actions behind them
+    const size_t nBuffSize = 32;
+    char cBuffer[nBuffSize];
+    this->m_mKeyword[HOTKEY_KEYWORD_RESET] = 0;
+    for (int ii = 1; ii <= REAL_MAXNUMPROFILES; ii++)
+    {
+        sprintf_s(cBuffer, nBuffSize, HOTKEY_KEYWORD_PROFILE, ii);
+        this->m_mKeyword[cBuffer] = ii;
+    }
+
+    for (int ii = 0; ii <= REAL_MAXNUMPROFILES; ii++)
+    {
+        this->m_acAction[ii] = hotkey_action();
+        this->m_acAction[ii].iProfile = ii;
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+hotkey_table::~hotkey_table()
+{
+}
+
+/* ----------------------------------------------------------------------------
+* set interfaces
+*/
+void hotkey_table::init(config_container *pcConfigData)
+{
+    boost::lock_guard<boost::mutex> lock(this->m_cTableMutex);
+    this->m_pcConfigData    = pcConfigData;
+    this->m_bIsValid        = false;
+}
+
+/* ----------------------------------------------------------------------------
+* resolve action of keyword, table is rebuilt first if config changed
+*/
+hotkey_action hotkey_table::find(const char* keyword)
+{
+    return get(find_index(keyword));
+}
+
+/* ----------------------------------------------------------------------------
+* index of keyword in the table, -1 => keyword unknown
+* (the keyword map is built in the constructor only, no lock needed)
+*/
+int hotkey_table::find_index(const char* keyword)
+{
+    std::unordered_map<std::string, int>::const_iterator it = this->m_mKeyword.find(keyword);
+    if (it == this->m_mKeyword.end())
+        return -1;
+    return it->second;
+}
+
+/* ----------------------------------------------------------------------------
+* action of a table index (see find_index), rebuilt if config has changed
+*/
+hotkey_action hotkey_table::get(int iIndex)
+{
+    boost::lock_guard<boost::mutex> lock(this->m_cTableMutex);
+
+    if ((iIndex < 0) || (iIndex > REAL_MAXNUMPROFILES) || (this->m_pcConfigData == nullptr))
+        return hotkey_action();
+
+    if (!this->m_bIsValid || (this->m_nConfigGeneration != this->m_pcConfigData->s_get_Generation()))
+    {
+        this->m_nConfigGeneration = this->m_pcConfigData->s_get_Generation();
+        rebuild();
+        this->m_bIsValid = true;
+    }
+    return this->m_acAction[iIndex];
+}
+
+/* ----------------------------------------------------------------------------
+* copy settings of all profiles
+*/
+void hotkey_table::rebuild()
+{
+    CALL_STACK
+    this->m_acAction[0].eAction = HOTKEY_RESET;
+
+    int iMaxNumProfiles = (int)this->m_pcConfigData->s_get_MaxNumProfiles();
+    for (int ii = 1; ii <= REAL_MAXNUMPROFILES; ii++)
+    {
+        hotkey_action& cAction = this->m_acAction[ii];
+        if (ii > iMaxNumProfiles)
+        {
+            cAction.eAction = HOTKEY_OUT_OF_RANGE;
+            continue;
+        }
+
+        cAction.eAction             = HOTKEY_PROFILE;
+        cAction.eType               = this->m_pcConfigData->s_get_ProfileType(ii - 1);
+        cAction.bAutoActivate       = this->m_pcConfigData->s_get_AutoActivate(ii - 1);
+        cAction.bUseIgnoreListTx    = this->m_pcConfigData->s_get_UseIgnoreListTx(ii - 1);
+        cAction.bUseSubChOfFav      = this->m_pcConfigData->s_get_UseSubChOfFav(ii - 1);
+        cAction.bPrioFreq           = this->m_pcConfigData->s_get_PrioFreq(ii - 1);
+        cAction.iActiveFreq         = this->m_pcConfigData->s_get_ActiveFreq(ii - 1);
+        cAction.nMinChLevel         = this->m_pcConfigData->s_get_MinChLevel(ii - 1);
+        cAction.nMaxChLevel         = this->m_pcConfigData->s_get_MaxChLevel(ii - 1);
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <boost/thread.hpp>
+#include "misc/config_container.h"
+#include "misc/error_handler.h"
+
+// keywords registered in plugin_base::initHotkeys
+#define HOTKEY_KEYWORD_PROFILE  "profile_%d"        // profile number 1..REAL_MAXNUMPROFILES
+#define HOTKEY_KEYWORD_RESET    "reset"
+
+enum eHotkeyAction
+{
+    HOTKEY_UNKNOWN = 0,     // keyword not registered by this plugin
+    HOTKEY_RESET,           // restore default whisper list
+    HOTKEY_PROFILE,         // toggle/use profile
+    HOTKEY_OUT_OF_RANGE     // profile number > s_get_MaxNumProfiles (hotkey of an older config)
+};
+
+/* ----------------------------------------------------------------------------
+* pre-resolved hotkey, all settings the hotkey needs are copied from the config
+*/
+struct hotkey_action
+{
+    eHotkeyAction   eAction;
+    int             iProfile;           // profile number (1..REAL_MAXNUMPROFILES), 0 for reset
+    eProfileType    eType;
+    bool            bAutoActivate;
+    bool            bUseIgnoreListTx;
+    bool            bUseSubChOfFav;
+    bool            bPrioFreq;
+    int             iActiveFreq;
+    size_t          nMinChLevel;
+    size_t          nMaxChLevel;
+};
+
+/* ----------------------------------------------------------------------------
+* maps all keywords to a dense table of actions
+*
+* the table is rebuilt only after the config changed (see s_get_Generation),
+* a hotkey event is one hash lookup of the keyword without any parsing.
+*/
+class hotkey_table
+{
+public:
+    hotkey_table();
+    ~hotkey_table();
+
+    void                init(config_container *pcConfigData);
+    hotkey_action       find(const char* keyword);
+    int                 find_index(const char* keyword);    // -1 => keyword unknown
+    hotkey_action       get(int iIndex);                    // find(keyword) == get(find_index(keyword))
+
+protected:
+    void                rebuild();
+
+private:
+    config_container   *m_pcConfigData;         // configuration container
+    error_handler       m_cErrHandler;          // link to error handler
+
+    boost::mutex        m_cTableMutex;          // hotkey events and config changes from different threads
+    bool                m_bIsValid;             // table was built at least once
+    uint32_t            m_nConfigGeneration;    // generation of config used for last rebuild
+
+    hotkey_action                               m_acAction[REAL_MAXNUMPROFILES + 1]; // index 0 = reset, ii = profile ii
+    std::unordered_map<std::string, int>        m_mKeyword;     // keyword => index in m_acAction
+};
@@ -0,0 +1,268 @@
+//#include "stdafx.h"
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdint.h>
+#define INVALID_HANDLE_VALUE ((void*)(intptr_t)-1)     // m_hFile holds the file descriptor
+#endif
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include "misc/language_file.h"
+#include "misc/platform.h"
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+language_file::language_file()
+{
+    this->m_hFile       = INVALID_HANDLE_VALUE;
+    this->m_hMapping    = nullptr;
+    this->m_pView       = nullptr;
+    this->m_nSize       = 0;
+    this->m_pcKeys      = nullptr;
+    this->m_nNumKeys    = 0;
+    this->m_pcStrings   = nullptr;
+    this->m_nStringSize = 0;
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+language_file::~language_file()
+{
+    close();
+}
+
+/* ----------------------------------------------------------------------------
+* map language pack into memory (read only, pages are loaded by the OS on first access)
+*/
+bool language_file::open(const std::string& sFileName)
+{
+    close();
+
+#ifndef _WIN32
+    int iFile = ::open(sFileName.c_str(), O_RDONLY);
+    if (iFile < 0)
+    {
+        return false;
+    }
+    this->m_hFile = (void*)(intptr_t)iFile;
+
+    struct stat stStatus;
+    if (fstat(iFile, &stStatus) != 0 || stStatus.st_size < (off_t)sizeof(language_file_header) || stStatus.st_size > 0x7FFFFFFF)
+    {
+        close();
+        return false;
+    }
+    this->m_nSize = (size_t)stStatus.st_size;
+
+    void* pView = mmap(nullptr, this->m_nSize, PROT_READ, MAP_SHARED, iFile, 0);
+    if (pView == MAP_FAILED)
+    {
+        close();
+        return false;
+    }
+    this->m_pView = (const uint8_t*)pView;
+    if (!validate())
+    {
+        close();
+        return false;
+    }
+    return true;
+#else
+    this->m_hFile = CreateFileA(sFileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (this->m_hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER nFileSize;
+    if (!GetFileSizeEx(this->m_hFile, &nFileSize) || nFileSize.QuadPart < (LONGLONG)sizeof(language_file_header) || nFileSize.QuadPart > 0x7FFFFFFF)
+    {
+        close();
+        return false;
+    }
+    this->m_nSize = (size_t)nFileSize.QuadPart;
+
+    this->m_hMapping = CreateFileMappingA(this->m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (this->m_hMapping == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    this->m_pView = (const uint8_t*)MapViewOfFile(this->m_hMapping, FILE_MAP_READ, 0, 0, 0);
+    if (this->m_pView == nullptr || !validate())
+    {
+        close();
+        return false;
+    }
+    return true;
+#endif
+}
+
+/* ----------------------------------------------------------------------------
+* check header and key table, so lookups don't need any range checks
+*/
+bool language_file::validate()
+{
+    const language_file_header* pcHeader = (const language_file_header*)this->m_pView;
+    if (pcHeader->nMagic != LANGUAGE_FILE_MAGIC || pcHeader->nVersion != LANGUAGE_FILE_VERSION)
+    {
+        return false;
+    }
+
+    uint64_t nKeyTableEnd = (uint64_t)pcHeader->nKeyTableOffset + (uint64_t)pcHeader->nNumKeys * sizeof(language_file_key);
+    uint64_t nStringEnd   = (uint64_t)pcHeader->nStringOffset + (uint64_t)pcHeader->nStringSize;
+    if ((pcHeader->nKeyTableOffset % sizeof(uint32_t)) != 0 || nKeyTableEnd > this->m_nSize || nStringEnd > this->m_nSize || pcHeader->nStringSize == 0)
+    {
+        return false;
+    }
+
+    const language_file_key* pcKeys = (const language_file_key*)(this->m_pView + pcHeader->nKeyTableOffset);
+    const char* pcStrings = (const char*)(this->m_pView + pcHeader->nStringOffset);
+    if (pcStrings[pcHeader->nStringSize - 1] != 0)
+    {
+        return false;
+    }
+
+    for (uint32_t nIdx = 0; nIdx < pcHeader->nNumKeys; nIdx++)
+    {
+        if (pcKeys[nIdx].nKeyOffset >= pcHeader->nStringSize || pcKeys[nIdx].nTextOffset >= pcHeader->nStringSize)
+        {
+            return false;
+        }
+        if (nIdx > 0 && pcKeys[nIdx - 1].nHash > pcKeys[nIdx].nHash)
+        {
+            return false;
+        }
+    }
+
+    this->m_pcKeys      = pcKeys;
+    this->m_nNumKeys    = pcHeader->nNumKeys;
+    this->m_pcStrings   = pcStrings;
+    this->m_nStringSize = pcHeader->nStringSize;
+    return true;
+}
+
+/* ----------------------------------------------------------------------------
+* unmap language pack
+*/
+void language_file::close()
+{
+#ifndef _WIN32
+    if (this->m_pView != nullptr)
+    {
+        munmap((void*)this->m_pView, this->m_nSize);
+    }
+    if (this->m_hFile != INVALID_HANDLE_VALUE)
+    {
+        ::close((int)(intptr_t)this->m_hFile);
+    }
+#else
+    if (this->m_pView != nullptr)
+    {
+        UnmapViewOfFile(this->m_pView);
+    }
+    if (this->m_hMapping != nullptr)
+    {
+        CloseHandle(this->m_hMapping);
+    }
+    if (this->m_hFile != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(this->m_hFile);
+    }
+#endif
+
+    this->m_hFile       = INVALID_HANDLE_VALUE;
+    this->m_hMapping    = nullptr;
+    this->m_pView       = nullptr;
+    this->m_nSize       = 0;
+    this->m_pcKeys      = nullptr;
+    this->m_nNumKeys    = 0;
+    this->m_pcStrings   = nullptr;
+    this->m_nStringSize = 0;
+}
+
+/* ----------------------------------------------------------------------------
+* binary search key in table, returns nullptr if key is not part of this pack
+*/
+const char* language_file::find(const char* sKey, uint32_t nHash)
+{
+    if (this->m_pcKeys == nullptr)
+    {
+        return nullptr;
+    }
+
+    const language_file_key* pcFirst = std::lower_bound(this->m_pcKeys, this->m_pcKeys + this->m_nNumKeys, nHash,
+        [](const language_file_key& cKey, uint32_t nValue) { return cKey.nHash < nValue; });
+
+    for (; pcFirst < this->m_pcKeys + this->m_nNumKeys && pcFirst->nHash == nHash; pcFirst++)
+    {
+        if (strcmp(this->m_pcStrings + pcFirst->nKeyOffset, sKey) == 0)
+        {
+            return this->m_pcStrings + pcFirst->nTextOffset;
+        }
+    }
+    return nullptr;
+}
+
+/* ----------------------------------------------------------------------------
+* generate language pack from string table (only rows translated to eLang)
+*/
+bool language_file::write(const std::string& sFileName, const char* sLanguage, const lang_entry* pcTable, size_t nTableSize, eLanguage eLang)
+{
+    std::vector<const lang_entry*> vcRows;
+    for (size_t nIdx = 0; nIdx < nTableSize; nIdx++)
+    {
+        if (pcTable[nIdx].asText[eLang] != nullptr)
+        {
+            vcRows.push_back(&pcTable[nIdx]);
+        }
+    }
+    std::sort(vcRows.begin(), vcRows.end(), [](const lang_entry* pcA, const lang_entry* pcB)
+    {
+        return (pcA->nHash != pcB->nHash) ? (pcA->nHash < pcB->nHash) : (strcmp(pcA->sKey, pcB->sKey) < 0);
+    });
+
+    // string area: all keys first, texts behind them
+    std::string sStrings;
+    std::vector<language_file_key> vcKeys(vcRows.size());
+    for (size_t nIdx = 0; nIdx < vcRows.size(); nIdx++)
+    {
+        vcKeys[nIdx].nHash      = vcRows[nIdx]->nHash;
+        vcKeys[nIdx].nKeyOffset = (uint32_t)sStrings.size();
+        sStrings.append(vcRows[nIdx]->sKey);
+        sStrings.push_back(0);
+    }
+    for (size_t nIdx = 0; nIdx < vcRows.size(); nIdx++)
+    {
+        vcKeys[nIdx].nTextOffset = (uint32_t)sStrings.size();
+        sStrings.append(vcRows[nIdx]->asText[eLang]);
+        sStrings.push_back(0);
+    }
+
+    language_file_header cHeader = {};
+    cHeader.nMagic          = LANGUAGE_FILE_MAGIC;
+    cHeader.nVersion        = LANGUAGE_FILE_VERSION;
+    strncpy_s(cHeader.acLanguage, sizeof(cHeader.acLanguage), sLanguage, _TRUNCATE);
+    cHeader.nNumKeys        = (uint32_t)vcKeys.size();
+    cHeader.nKeyTableOffset = (uint32_t)sizeof(cHeader);
+    cHeader.nStringOffset   = (uint32_t)(sizeof(cHeader) + vcKeys.size() * sizeof(language_file_key));
+    cHeader.nStringSize     = (uint32_t)sStrings.size();
+
+    std::ofstream cFile(sFileName, std::ios::binary | std::ios::trunc);
+    if (!cFile.is_open())
+    {
+        return false;
+    }
+    cFile.write((const char*)&cHeader, sizeof(cHeader));
+    cFile.write((const char*)vcKeys.data(), vcKeys.size() * sizeof(language_file_key));
+    cFile.write(sStrings.data(), sStrings.size());
+    return cFile.good();
+}
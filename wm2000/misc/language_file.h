@@ -0,0 +1,61 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string>
+#include "misc/language_pkg.h"
+
+/* ----------------------------------------------------------------------------
+* binary language pack layout (little endian, all offsets in bytes)
+*
+*   header | key table (sorted by hash, then key) | string area
+*
+* the string area holds all keys first and all texts after them, every string
+* is NUL terminated, so lookups never touch text pages that are not used.
+*/
+#define LANGUAGE_FILE_MAGIC     0x504C4D57  // "WMLP"
+#define LANGUAGE_FILE_VERSION   1
+
+struct language_file_header
+{
+    uint32_t    nMagic;
+    uint32_t    nVersion;
+    char        acLanguage[4];      // short name ("en", "de", ...)
+    uint32_t    nNumKeys;
+    uint32_t    nKeyTableOffset;    // from start of file
+    uint32_t    nStringOffset;      // from start of file
+    uint32_t    nStringSize;
+};
+
+struct language_file_key
+{
+    uint32_t    nHash;              // lang_hash() of key
+    uint32_t    nKeyOffset;         // into string area
+    uint32_t    nTextOffset;        // into string area
+};
+
+class language_file
+{
+public:
+    language_file();
+    ~language_file();
+
+    bool         open(const std::string& sFileName);
+    void         close();
+    bool         is_open() { return (this->m_pcKeys != nullptr); };
+    const char*  find(const char* sKey, uint32_t nHash);
+
+    static bool  write(const std::string& sFileName, const char* sLanguage, const lang_entry* pcTable, size_t nTableSize, eLanguage eLang);
+
+private:
+    bool         validate();
+
+    void*                       m_hFile;            // file handle
+    void*                       m_hMapping;         // file mapping handle
+    const uint8_t*              m_pView;            // mapped file, read only
+    size_t                      m_nSize;            // size of mapped file
+    const language_file_key*    m_pcKeys;           // key table inside mapped file
+    uint32_t                    m_nNumKeys;         // number of keys
+    const char*                 m_pcStrings;        // string area inside mapped file
+    uint32_t                    m_nStringSize;      // size of string area
+};
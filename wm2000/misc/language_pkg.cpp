@@ -1,912 +1,1075 @@
-//#include "stdafx.h"
+﻿//#include "stdafx.h"
 #ifdef _WIN32
 #pragma warning (disable : 4100)  /* Disable Unreferenced parameter warning */
 #include <Windows.h>
-#endif
-
 #include <stringapiset.h>
+#else
+#include <locale>
+#include <codecvt>
+#endif
+#include <vector>
+#include <algorithm>
+#include <unordered_set>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/lock_guard.hpp>
 #include "misc/language_pkg.h"
+#include "misc/language_file.h"
+#include "misc/platform.h"
+
+// one table row: key, english text, german text (nullptr => fall back to english)
+#define LANG_ENTRY(key, en, de) { lang_hash(key), key, { en, de } }
 
 /* ----------------------------------------------------------------------------
-* constructor: set all strings
+* process wide string table, shared by all language_pkg instances
+*  - all texts are stored as pre-encoded UTF-8 literals
+*  - nothing is built at runtime, constructing a language_pkg is free
 */
-language_pkg::language_pkg()
+static constexpr lang_entry s_acLangTable[] =
 {
-    this->m_wLanguage = L"de";
-
     // template
     //-------------------------------------------------------------------------------------
-    this->m_cLangPkg.add(L"en.temp", std::wstring(L""));
-    this->m_cLangPkg.add(L"de.temp", std::wstring(L""));
-
-    // run specific inits
-    init_base();
-    init_plugin_para_chk();
-    init_plugin_hotkey();
-    init_plugin_menu();
-    init_plugin_info();
-    init_ui_main();
-    init_ui_freq();
-    init_ui_client_tree();
-    init_ui_about();
-    init_error_handler();
+    LANG_ENTRY("temp",
+        u8"",
+        u8""),
 
     // Test
     //-------------------------------------------------------------------------------------
 
-    // test1
-    this->m_cLangPkg.add(L"en.test1", std::wstring(L"This is test number %d (\"\"). There are many tests, but this one is mine.\n"));
-    this->m_cLangPkg.add(L"de.test1", std::wstring(L"Das ist der test nummer %d (\"\"). Es gibt viele tests, aber das ist meiner.\n"));
-
-    // test2
-    this->m_cLangPkg.add(L"en.test2", std::wstring(L"Another test %d\n"));
-}
+    LANG_ENTRY("test1",
+        u8"This is test number %d (\"äöüß\"). There are many tests, but this one is mine.\n",
+        u8"Das ist der test nummer %d (\"äöüß\"). Es gibt viele tests, aber das ist meiner.\n"),
 
+    LANG_ENTRY("test2",
+        u8"Another test %d\n",
+        nullptr),
 
-/* ----------------------------------------------------------------------------
-* set all strings needed by basic functions (called by constructor)
-*/
-void language_pkg::init_base()
-{
     // Base data
     //-------------------------------------------------------------------------------------
 
     // base_name (dosn't use language based on xml file)
-    this->m_cLangPkg.add(L"en.base_name", std::wstring(L"WhisperMaster2000"));
-    //this->m_cLangPkg.add(L"de.base_name", std::wstring(L"WhisperMaster2000"));
+    LANG_ENTRY("base_name",
+        u8"WhisperMaster2000",
+        nullptr),
 
     // base_user (dosn't use language based on xml file)
-    this->m_cLangPkg.add(L"en.base_user", std::wstring(L"wardogmuc | Michael"));
-    //this->m_cLangPkg.add(L"de.base_user", std::wstring(L"wardogmuc | Michael"));
+    LANG_ENTRY("base_user",
+        u8"wardogmuc | Michael",
+        nullptr),
 
     // base_version (dosn't use language based on xml file)
-    this->m_cLangPkg.add(L"en.base_version", std::wstring(L"Alpha 00.06        ")); //Length increased to 20 elements, caused by an unknown problem if this particular string is too short
-    //this->m_cLangPkg.add(L"de.base_version", std::wstring(L""));
+    //Length increased to 20 elements, caused by an unknown problem if this particular string is too short
+    LANG_ENTRY("base_version",
+        u8"Alpha 00.06        ",
+        nullptr),
 
     // base_description (dosn't use language based on xml file)
-    this->m_cLangPkg.add(L"en.base_description", std::wstring(L"WhisperMaster2000 helps you to master your communication with your friends without seting up whisperlists manually every time the people in your group are changing."));
-    this->m_cLangPkg.add(L"de.base_description", std::wstring(L"WhisperMaster2000 hilft dir die Kommunikation mit deinen Teamkameraden zu meistern, ohne jedesmal deine Whisperlisten ndern zu mssen, weil sich die Gruppe verndert."));
-}
+    LANG_ENTRY("base_description",
+        u8"WhisperMaster2000 helps you to master your communication with your friends without seting up whisperlists manually every time the people in your group are changing.",
+        u8"WhisperMaster2000 hilft dir die Kommunikation mit deinen Teamkameraden zu meistern, ohne jedesmal deine Whisperlisten ändern zu müssen, weil sich die Gruppe verändert."),
 
-
-/* ----------------------------------------------------------------------------
-* set all strings needed by parameter check (called by constructor)
-*/
-void language_pkg::init_plugin_para_chk()
-{
     // Parameter check
     //-------------------------------------------------------------------------------------
 
-    // check_Init
-    this->m_cLangPkg.add(L"en.check_Init", std::wstring(L"Start initialization."));
-    this->m_cLangPkg.add(L"de.check_Init", std::wstring(L"Starte Initialisierung."));
-
-    // conn_ParamCheck
-    this->m_cLangPkg.add(L"en.conn_ParamCheck", std::wstring(L"Check on connect"));
-    //this->m_cLangPkg.add(L"de.conn_ParamCheck", std::wstring(L""));
+    LANG_ENTRY("check_Init",
+        u8"Start initialization.",
+        u8"Starte Initialisierung."),
 
-    // conn_ErrName
-    this->m_cLangPkg.add(L"en.conn_ErrName", std::wstring(L"Unknown error querying server name. => plugin_base::onConnect()"));
-    //this->m_cLangPkg.add(L"de.conn_ErrName", std::wstring(L""));
+    LANG_ENTRY("conn_ParamCheck",
+        u8"Check on connect",
+        nullptr),
 
-    // conn_WrongConn
-    this->m_cLangPkg.add(L"en.conn_WrongConn", std::wstring(L"Status connection established was received, but error 'not connected' occured. => plugin_base::onConnect()"));
-    //this->m_cLangPkg.add(L"de.conn_WrongConn", std::wstring(L""));
+    LANG_ENTRY("conn_ErrName",
+        u8"Unknown error querying server name. => plugin_base::onConnect()",
+        nullptr),
 
-    // conn_ErrWriteFreq
-    this->m_cLangPkg.add(L"en.conn_ErrWriteFreq", std::wstring(L"Initial writing of frequency list to server has returned an error."));
-    //this->m_cLangPkg.add(L"de.conn_ErrWriteFreq", std::wstring(L""));
+    LANG_ENTRY("conn_WrongConn",
+        u8"Status connection established was received, but error 'not connected' occured. => plugin_base::onConnect()",
+        nullptr),
 
-    // check_nMaxNumProfiles
-    this->m_cLangPkg.add(L"en.check_nMaxNumProfiles", std::wstring(L"Setting 'general.MaxNumProfiles' (%zd) is too high, set value to default (%d)."));
-    this->m_cLangPkg.add(L"de.check_nMaxNumProfiles", std::wstring(L"Einstellung 'general.MaxNumProfiles' (%zd) ist zu hoch, setze Wert auf Standard (%d)."));
+    LANG_ENTRY("conn_ErrWriteFreq",
+        u8"Initial writing of frequency list to server has returned an error.",
+        nullptr),
 
-    // check_psProfileType
-    this->m_cLangPkg.add(L"en.check_psProfileType", std::wstring(L"Setting 'profile%d.ProfileName' is invalid, set new name to \"%s\"."));
-    //this->m_cLangPkg.add(L"de.check_psProfileType", std::wstring(L"Einstellung 'm_nMaxNumProfiles' (%zd) ist zu hoch, setze Wert auf Standard (%d)."));
+    LANG_ENTRY("check_nMaxNumProfiles",
+        u8"Setting 'general.MaxNumProfiles' (%zd) is too high, set value to default (%d).",
+        u8"Einstellung 'general.MaxNumProfiles' (%zd) ist zu hoch, setze Wert auf Standard (%d)."),
 
-    // check_psProfileName
-    this->m_cLangPkg.add(L"en.check_psProfileName", std::wstring(L"Setting 'profile%d.ProfileType' (%s) is invalid, set value to default (%s)."));
-    //this->m_cLangPkg.add(L"de.check_psProfileName", std::wstring(L"Einstellung 'm_nMaxNumProfiles' (%zd) ist zu hoch, setze Wert auf Standard (%d)."));
+    LANG_ENTRY("check_psProfileType",
+        u8"Setting 'profile%d.ProfileName' is invalid, set new name to \"%s\".",
+        nullptr),
 
-    // check_MinChLevel_High
-    this->m_cLangPkg.add(L"en.check_MinChLevel_High", std::wstring(L"Setting 'profile%d.MinChLevel' (%zd) is too high, set value to default (%d)."));
-    //this->m_cLangPkg.add(L"de.check_MinChLevel_High", std::wstring(L""));
+    LANG_ENTRY("check_psProfileName",
+        u8"Setting 'profile%d.ProfileType' (%s) is invalid, set value to default (%s).",
+        nullptr),
 
-    // check_MinChLevel_Low
-    this->m_cLangPkg.add(L"en.check_MinChLevel_Low", std::wstring(L"Setting 'profile%d.MinChLevel' (%zd) is too low, set value to default (%d)."));
-    //this->m_cLangPkg.add(L"de.check_MinChLevel_Low", std::wstring(L""));
+    LANG_ENTRY("check_MinChLevel_High",
+        u8"Setting 'profile%d.MinChLevel' (%zd) is too high, set value to default (%d).",
+        nullptr),
 
-    // check_MaxChLevel_High
-    this->m_cLangPkg.add(L"en.check_MaxChLevel_High", std::wstring(L"Setting 'profile%d.MaxChLevel' (%zd) is too high, set value to default (%d)."));
-    //this->m_cLangPkg.add(L"de.check_MaxChLevel_High", std::wstring(L""));
+    LANG_ENTRY("check_MinChLevel_Low",
+        u8"Setting 'profile%d.MinChLevel' (%zd) is too low, set value to default (%d).",
+        nullptr),
 
-    // check_Min2MaxChLevel
-    this->m_cLangPkg.add(L"en.check_Min2MaxChLevel", std::wstring(L"Setting 'profile%d.MaxChLevel' is lower then 'profile%d.MinChLevel' (%zd < %zd), set 'MaxChLevel' to default (%d)."));
-    //this->m_cLangPkg.add(L"de.check_Min2MaxChLevel", std::wstring(L""));
+    LANG_ENTRY("check_MaxChLevel_High",
+        u8"Setting 'profile%d.MaxChLevel' (%zd) is too high, set value to default (%d).",
+        nullptr),
 
-    // check_MaxFreq
-    this->m_cLangPkg.add(L"en.check_MaxFreq", std::wstring(L"Setting 'MaxFrequency' %d is out of limits (%d to %d), set to default %d."));
-    //this->m_cLangPkg.add(L"de.check_MaxFreq", std::wstring(L""));
+    LANG_ENTRY("check_Min2MaxChLevel",
+        u8"Setting 'profile%d.MaxChLevel' is lower then 'profile%d.MinChLevel' (%zd < %zd), set 'MaxChLevel' to default (%d).",
+        nullptr),
 
-    // check_ActiveFreq
-    this->m_cLangPkg.add(L"en.check_ActiveFreq", std::wstring(L"Setting 'profile%d.ActiveFreq' %d is out of limits (%d to %d), disable 'ActiveFreq'."));
-    //this->m_cLangPkg.add(L"de.check_ActiveFreq", std::wstring(L""));
+    LANG_ENTRY("check_MaxFreq",
+        u8"Setting 'MaxFrequency' %d is out of limits (%d to %d), set to default %d.",
+        nullptr),
 
-    // check_ValidServer
-    this->m_cLangPkg.add(L"en.check_ValidServer", std::wstring(L"Setting 'profile%d.ProfileType' is favorite/audio, but no 'profile%d.ValidServer' selected. Profile%d will be disabled until you select a channel!"));
-    //this->m_cLangPkg.add(L"de.check_ValidServer", std::wstring(L""));
+    LANG_ENTRY("check_ActiveFreq",
+        u8"Setting 'profile%d.ActiveFreq' %d is out of limits (%d to %d), disable 'ActiveFreq'.",
+        nullptr),
 
-    // check_Connect_ValidServer
-    this->m_cLangPkg.add(L"en.check_Connect_ValidServer", std::wstring(L"Setting 'profile%d.ServerName' (%s) missmatch with connected server (%s). Profile%d will be disabled until you select a channel."));
-    //this->m_cLangPkg.add(L"de.check_Connect_ValidServer", std::wstring(L""));
+    LANG_ENTRY("check_ValidServer",
+        u8"Setting 'profile%d.ProfileType' is favorite/audio, but no 'profile%d.ValidServer' selected. Profile%d will be disabled until you select a channel!",
+        nullptr),
 
-    // check_Connect_Hotkey
-    this->m_cLangPkg.add(L"en.check_Connect_Hotkey", std::wstring(L"No hotkey is set for profile \"%s\"."));
-    //this->m_cLangPkg.add(L"de.check_Connect_Hotkey", std::wstring(L""));
-}
+    LANG_ENTRY("check_Connect_ValidServer",
+        u8"Setting 'profile%d.ServerName' (%s) missmatch with connected server (%s). Profile%d will be disabled until you select a channel.",
+        nullptr),
 
+    LANG_ENTRY("check_Connect_Hotkey",
+        u8"No hotkey is set for profile \"%s\".",
+        nullptr),
 
-/* ----------------------------------------------------------------------------
-* set all strings needed by hotkey creation / handling (called by constructor)
-*/
-void language_pkg::init_plugin_hotkey()
-{
     // Hotkeys creation
     //-------------------------------------------------------------------------------------
 
-    // hotkey_UseFav
-    this->m_cLangPkg.add(L"en.hotkey_UseFav", std::wstring(L"Use profile %d (favorite) and activate whispering"));
-    this->m_cLangPkg.add(L"de.hotkey_UseFav", std::wstring(L"Nutze Profil %d (favorite) und aktiviere whispering"));
+    LANG_ENTRY("hotkey_UseFav",
+        u8"Use profile %d (favorite) and activate whispering",
+        u8"Nutze Profil %d (favorite) und aktiviere whispering"),
 
-    // hotkey_ToggleFav
-    this->m_cLangPkg.add(L"en.hotkey_ToggleFav", std::wstring(L"Toggle profile %d (favorite)"));
-    this->m_cLangPkg.add(L"de.hotkey_ToggleFav", std::wstring(L"Schalte Profil %d (favorite) um"));
+    LANG_ENTRY("hotkey_ToggleFav",
+        u8"Toggle profile %d (favorite)",
+        u8"Schalte Profil %d (favorite) um"),
 
-    // hotkey_UseLevel
-    this->m_cLangPkg.add(L"en.hotkey_UseLevel", std::wstring(L"Use profile %d (level) and activate whispering"));
-    this->m_cLangPkg.add(L"de.hotkey_UseLevel", std::wstring(L"Nutze Profil %d (level) und aktiviere whispering"));
+    LANG_ENTRY("hotkey_UseLevel",
+        u8"Use profile %d (level) and activate whispering",
+        u8"Nutze Profil %d (level) und aktiviere whispering"),
 
-    // hotkey_ToggleLevel
-    this->m_cLangPkg.add(L"en.hotkey_ToggleLevel", std::wstring(L"Toggle profile %d (level)"));
-    this->m_cLangPkg.add(L"de.hotkey_ToggleLevel", std::wstring(L"Schalte Profil %d (level) um"));
+    LANG_ENTRY("hotkey_ToggleLevel",
+        u8"Toggle profile %d (level)",
+        u8"Schalte Profil %d (level) um"),
 
-    // hotkey_UseFreq
-    this->m_cLangPkg.add(L"en.hotkey_UseFreq", std::wstring(L"Use profile %d (frequency) and activate whispering"));
-    this->m_cLangPkg.add(L"de.hotkey_UseFreq", std::wstring(L"Nutze Profil %d (Frequenz) und aktiviere whispering"));
-
-    // hotkey_ToggleFreq
-    this->m_cLangPkg.add(L"en.hotkey_ToggleFreq", std::wstring(L"Toggle profile %d (frequency)"));
-    this->m_cLangPkg.add(L"de.hotkey_ToggleFreq", std::wstring(L"Schalte Profil %d (Frequenz) um"));
-
-    // hotkey_Reset
-    this->m_cLangPkg.add(L"en.hotkey_Reset", std::wstring(L"Deactivate whispering"));
-    this->m_cLangPkg.add(L"de.hotkey_Reset", std::wstring(L"Deaktiviere whispering"));
+    LANG_ENTRY("hotkey_UseFreq",
+        u8"Use profile %d (frequency) and activate whispering",
+        u8"Nutze Profil %d (Frequenz) und aktiviere whispering"),
 
+    LANG_ENTRY("hotkey_ToggleFreq",
+        u8"Toggle profile %d (frequency)",
+        u8"Schalte Profil %d (Frequenz) um"),
 
+    LANG_ENTRY("hotkey_Reset",
+        u8"Deactivate whispering",
+        u8"Deaktiviere whispering"),
 
     // Hotkey event handler
     //-------------------------------------------------------------------------------------
 
-    // hotkey_NotConn
-    this->m_cLangPkg.add(L"en.hotkey_NotConn", std::wstring(L"Hotkey event was received, but no server is connected. Hotkey will be ignored."));
-    this->m_cLangPkg.add(L"de.hotkey_NotConn", std::wstring(L"Hotkey Ereignis wurde empfangen, aber kein Server ist verbunden. Hotkey wird ignoriert."));
+    LANG_ENTRY("hotkey_NotConn",
+        u8"Hotkey event was received, but no server is connected. Hotkey will be ignored.",
+        u8"Hotkey Ereignis wurde empfangen, aber kein Server ist verbunden. Hotkey wird ignoriert."),
 
-    // hotkey_ErrReset
-    this->m_cLangPkg.add(L"en.hotkey_ErrReset", std::wstring(L"Unknown error while cleaning up whisperlist. => plugin_base::onHotkeyEvent()"));
-    this->m_cLangPkg.add(L"de.hotkey_ErrReset", std::wstring(L"Unbekannter Fehler beim zurcksetzen der whisperliste aufgetretten. => plugin_base::onHotkeyEvent()"));
+    LANG_ENTRY("hotkey_ErrReset",
+        u8"Unknown error while cleaning up whisperlist. => plugin_base::onHotkeyEvent()",
+        u8"Unbekannter Fehler beim zurücksetzen der whisperliste aufgetretten. => plugin_base::onHotkeyEvent()"),
 
-    // hotkey_ErrActivate1
-    this->m_cLangPkg.add(L"en.hotkey_ErrActivate1", std::wstring(L"Error while (de-)activating Push-To-Talk (set variable) [Error code : 0x%04X]"));
-    //this->m_cLangPkg.add(L"de.hotkey_ErrActivate", std::wstring(L"Unbekannter Fehler beim zurcksetzen der whisperliste aufgetretten."));
+    LANG_ENTRY("hotkey_ErrActivate1",
+        u8"Error while (de-)activating Push-To-Talk (set variable) [Error code : 0x%04X]",
+        nullptr),
 
-    // hotkey_ErrActivate2
-    this->m_cLangPkg.add(L"en.hotkey_ErrActivate2", std::wstring(L"Error while (de-)activating Push-To-Talk (flush). [Error code : 0x%04X]"));
-    //this->m_cLangPkg.add(L"de.hotkey_ErrActivate", std::wstring(L"Unbekannter Fehler beim zurcksetzen der whisperliste aufgetretten."));
+    LANG_ENTRY("hotkey_ErrActivate2",
+        u8"Error while (de-)activating Push-To-Talk (flush). [Error code : 0x%04X]",
+        nullptr),
 
-    // hotkey_MaxNum
-    this->m_cLangPkg.add(L"en.hotkey_MaxNum", std::wstring(L"You are using a hotkey of profile %d, but the max. number of profiles is %d. Hotkey will be ignored."));
-    this->m_cLangPkg.add(L"de.hotkey_MaxNum", std::wstring(L"Sie verwenden einen Hokey des Profils %d, aber die max. Anzahl der Profile ist %d. Hotkey wird ignoriert."));
+    LANG_ENTRY("hotkey_MaxNum",
+        u8"You are using a hotkey of profile %d, but the max. number of profiles is %d. Hotkey will be ignored.",
+        u8"Sie verwenden einen Hokey des Profils %d, aber die max. Anzahl der Profile ist %d. Hotkey wird ignoriert."),
 
-    // hotkey_Off
-    this->m_cLangPkg.add(L"en.hotkey_Off", std::wstring(L"You are using a hotkey of profile %d, but the type is '%s'. Hotkey will be ignored."));
-    this->m_cLangPkg.add(L"de.hotkey_Off", std::wstring(L"Sie verwenden einen Hotkey des Profils %d, aber dessen Typ ist aber '%s'. Hotkey wird ignoriert."));
+    LANG_ENTRY("hotkey_Off",
+        u8"You are using a hotkey of profile %d, but the type is '%s'. Hotkey will be ignored.",
+        u8"Sie verwenden einen Hotkey des Profils %d, aber dessen Typ ist aber '%s'. Hotkey wird ignoriert."),
 
-    // hotkey_LevelOutRange
-    this->m_cLangPkg.add(L"en.hotkey_LevelOutRange", std::wstring(L"Selected channel range (%zd - %zd) of profile \"%s\" doesn't match the actual channel level (%zd). No whispertarget can be found."));
-    //this->m_cLangPkg.add(L"de.hotkey_LevelOutRange", std::wstring(L"Sie verwenden einen Hotkey des Profils %d, aber dessen Typ ist aber '%s'. Hotkey wird ignoriert."));
+    LANG_ENTRY("hotkey_LevelOutRange",
+        u8"Selected channel range (%zd - %zd) of profile \"%s\" doesn't match the actual channel level (%zd). No whispertarget can be found.",
+        nullptr),
 
-    // hotkey_NoActiveClients
-    this->m_cLangPkg.add(L"en.hotkey_NoActiveClients", std::wstring(L"Selected frequency (%d) of profile \"%s\" is not active on any other client."));
-    //this->m_cLangPkg.add(L"de.hotkey_NoActiveClients", std::wstring(L""));
-}
+    LANG_ENTRY("hotkey_NoActiveClients",
+        u8"Selected frequency (%d) of profile \"%s\" is not active on any other client.",
+        nullptr),
 
-
-/* ----------------------------------------------------------------------------
-* set all strings needed by menu creation / handling (called by constructor)
-*/
-void language_pkg::init_plugin_menu()
-{
     // Menu creation
     //-------------------------------------------------------------------------------------
 
-    // menu_SetIgnore
-    this->m_cLangPkg.add(L"en.menu_SetIgnore", std::wstring(L"Ignore channel %s"));
-    this->m_cLangPkg.add(L"de.menu_SetIgnore", std::wstring(L"Ignoriere Kanal %s"));
-
-    // menu_ToggleFav
-    this->m_cLangPkg.add(L"en.menu_ToggleFav", std::wstring(L"Toggle favorite (%s) %s"));
-    this->m_cLangPkg.add(L"de.menu_ToggleFav", std::wstring(L"Schalte Favorit um (%s) %s"));
-
-    // menu_ToggleAudio
-    this->m_cLangPkg.add(L"en.menu_ToggleAudio", std::wstring(L"Toggle audio (%s) %s"));
-    this->m_cLangPkg.add(L"de.menu_ToggleAudio", std::wstring(L"Schalte Audio um (%s) %s"));
+    LANG_ENTRY("menu_SetIgnore",
+        u8"Ignore channel %s",
+        u8"Ignoriere Kanal %s"),
 
-    // menu_SetStartLev
-    this->m_cLangPkg.add(L"en.menu_SetStartLev", std::wstring(L"Set start level (%s)"));
-    this->m_cLangPkg.add(L"de.menu_SetStartLev", std::wstring(L"Setze Start-Level (%s)"));
+    LANG_ENTRY("menu_ToggleFav",
+        u8"Toggle favorite (%s) %s",
+        u8"Schalte Favorit um (%s) %s"),
 
-    // menu_SetEndLev
-    this->m_cLangPkg.add(L"en.menu_SetEndLev", std::wstring(L"Set end level (%s)"));
-    this->m_cLangPkg.add(L"de.menu_SetEndLev", std::wstring(L"Setze End-Level (%s)"));
+    LANG_ENTRY("menu_ToggleAudio",
+        u8"Toggle audio (%s) %s",
+        u8"Schalte Audio um (%s) %s"),
 
-    // menu_OpenSettings
-    this->m_cLangPkg.add(L"en.menu_OpenSettings", std::wstring(L"Settings"));
-    this->m_cLangPkg.add(L"de.menu_OpenSettings", std::wstring(L"Einstellungen"));
+    LANG_ENTRY("menu_SetStartLev",
+        u8"Set start level (%s)",
+        u8"Setze Start-Level (%s)"),
 
-    // menu_ShowList
-    this->m_cLangPkg.add(L"en.menu_ShowList", std::wstring(L"Show all lists"));
-    this->m_cLangPkg.add(L"de.menu_ShowList", std::wstring(L"Zeige alle Listen"));
+    LANG_ENTRY("menu_SetEndLev",
+        u8"Set end level (%s)",
+        u8"Setze End-Level (%s)"),
 
-    // menu_DelIgnore
-    this->m_cLangPkg.add(L"en.menu_DelIgnore", std::wstring(L"Delete list (Ignore)"));
-    this->m_cLangPkg.add(L"de.menu_DelIgnore", std::wstring(L"Lsche Liste (Ignorieren)"));
+    LANG_ENTRY("menu_OpenSettings",
+        u8"Settings",
+        u8"Einstellungen"),
 
-    // menu_DelProfile
-    this->m_cLangPkg.add(L"en.menu_DelProfile", std::wstring(L"Delete list (%s)"));
-    this->m_cLangPkg.add(L"de.menu_DelProfile", std::wstring(L"Lsche Liste (%s)"));
+    LANG_ENTRY("menu_ShowList",
+        u8"Show all lists",
+        u8"Zeige alle Listen"),
 
-    // menu_SetFreq
-    this->m_cLangPkg.add(L"en.menu_SetFreq", std::wstring(L"Set frequency"));
-    //this->m_cLangPkg.add(L"de.menu_SetFreq", std::wstring(L""));
+    LANG_ENTRY("menu_DelIgnore",
+        u8"Delete list (Ignore)",
+        u8"Lösche Liste (Ignorieren)"),
 
-    // menu_MuteProfile
-    this->m_cLangPkg.add(L"en.menu_MuteProfile", std::wstring(L"Un-/Mute frequency (%s)"));
-    //this->m_cLangPkg.add(L"de.menu_MuteProfile", std::wstring(L""));
+    LANG_ENTRY("menu_DelProfile",
+        u8"Delete list (%s)",
+        u8"Lösche Liste (%s)"),
 
-    // menu_help
-    this->m_cLangPkg.add(L"en.menu_help", std::wstring(L"Help"));
-    this->m_cLangPkg.add(L"de.menu_help", std::wstring(L"Hilfe"));
+    LANG_ENTRY("menu_SetFreq",
+        u8"Set frequency",
+        nullptr),
 
+    LANG_ENTRY("menu_MuteProfile",
+        u8"Un-/Mute frequency (%s)",
+        nullptr),
 
+    LANG_ENTRY("menu_help",
+        u8"Help",
+        u8"Hilfe"),
 
     // Menu event handler
     //-------------------------------------------------------------------------------------
 
-    // menuEv_NameChange
-    this->m_cLangPkg.add(L"en.menuEv_NameChange", std::wstring(L"Server name of profile \"%s\" has changed from \"%s\" to \"%s\"."));
-    //this->m_cLangPkg.add(L"de.menuEv_NameChange", std::wstring(L""));
+    LANG_ENTRY("menuEv_NameChange",
+        u8"Server name of profile \"%s\" has changed from \"%s\" to \"%s\".",
+        nullptr),
 
-    // menuEv_HelpNotFound
-    this->m_cLangPkg.add(L"en.menuEv_HelpNotFound", std::wstring(L"Help file not found. (%s)"));
-    //this->m_cLangPkg.add(L"de.menuEv_HelpNotFound", std::wstring(L""));
+    LANG_ENTRY("menuEv_HelpNotFound",
+        u8"Help file not found. (%s)",
+        nullptr),
 
-    // menuEv_ListFull
-    this->m_cLangPkg.add(L"en.menuEv_ListFull", std::wstring(L"Adding an entry to list \"%s\" not possible. List is full %zd out of %zd entrys."));
-    //this->m_cLangPkg.add(L"de.menuEv_ListFull", std::wstring(L""));
+    LANG_ENTRY("menuEv_ListFull",
+        u8"Adding an entry to list \"%s\" not possible. List is full %zd out of %zd entrys.",
+        nullptr),
 
-    // menuEv_IgnoreInfo
-    this->m_cLangPkg.add(L"en.menuEv_IgnoreInfo", std::wstring(L"[B]Ignore list (%zd entries):[/B]\n"));
-    //this->m_cLangPkg.add(L"de.menuEv_IgnoreInfo", std::wstring(L""));
+    LANG_ENTRY("menuEv_IgnoreInfo",
+        u8"[B]Ignore list (%zd entries):[/B]\n",
+        nullptr),
 
-    // menuEv_FavoriteInfo
-    this->m_cLangPkg.add(L"en.menuEv_FavoriteInfo", std::wstring(L"[B]Favorite list of \"%s\" (%zd entries):[/B]\n"));
-    //this->m_cLangPkg.add(L"de.menuEv_FavoriteInfo", std::wstring(L""));
+    LANG_ENTRY("menuEv_FavoriteInfo",
+        u8"[B]Favorite list of \"%s\" (%zd entries):[/B]\n",
+        nullptr),
 
-    // menuEv_LevelInfo1
-    this->m_cLangPkg.add(L"en.menuEv_LevelInfo1", std::wstring(L"[B]Level of \"%s\" (from level %zd to %zd):[/B]\n"));
-    //this->m_cLangPkg.add(L"de.menuEv_LevelInfo1", std::wstring(L""));
+    LANG_ENTRY("menuEv_LevelInfo1",
+        u8"[B]Level of \"%s\" (from level %zd to %zd):[/B]\n",
+        nullptr),
 
-    // menuEv_LevelInfo2
-    this->m_cLangPkg.add(L"en.menuEv_LevelInfo2", std::wstring(L"[B]Level of \"%s\" (from level %zd):[/B]\n"));
-    //this->m_cLangPkg.add(L"de.menuEv_LevelInfo2", std::wstring(L""));
+    LANG_ENTRY("menuEv_LevelInfo2",
+        u8"[B]Level of \"%s\" (from level %zd):[/B]\n",
+        nullptr),
 
-    // menuEv_NoChInRange
-    this->m_cLangPkg.add(L"en.menuEv_NoChInRange", std::wstring(L"+____ No channels in range\n"));
-    //this->m_cLangPkg.add(L"de.menuEv_NoChInRange", std::wstring(L""));
+    LANG_ENTRY("menuEv_NoChInRange",
+        u8"+____ No channels in range\n",
+        nullptr),
 
-    // menuEv_NoChInList
-    this->m_cLangPkg.add(L"en.menuEv_NoChInList", std::wstring(L"+____ No channels in list\n"));
-    //this->m_cLangPkg.add(L"de.menuEv_NoChInList", std::wstring(L""));
+    LANG_ENTRY("menuEv_NoChInList",
+        u8"+____ No channels in list\n",
+        nullptr),
 
-    // menuEv_FreqInfo
-    this->m_cLangPkg.add(L"en.menuEv_FreqInfo", std::wstring(L"[B]Clients with active freq. %d of \"%s\" (%zd clients)%s:[/B]\n"));
-    //this->m_cLangPkg.add(L"de.menuEv_FreqInfo", std::wstring(L""));
+    LANG_ENTRY("menuEv_FreqInfo",
+        u8"[B]Clients with active freq. %d of \"%s\" (%zd clients)%s:[/B]\n",
+        nullptr),
 
-    // menuEv_FreqDisabled
-    this->m_cLangPkg.add(L"en.menuEv_FreqDisabled", std::wstring(L"+____ Frequency is disabled\n"));
-    //this->m_cLangPkg.add(L"de.menuEv_FreqDisabled", std::wstring(L""));
+    LANG_ENTRY("menuEv_FreqDisabled",
+        u8"+____ Frequency is disabled\n",
+        nullptr),
 
-    // menuEv_NoClientInList
-    this->m_cLangPkg.add(L"en.menuEv_NoClientInList", std::wstring(L"+____ No clients in list\n"));
-    //this->m_cLangPkg.add(L"de.menuEv_NoClientInList", std::wstring(L""));
+    LANG_ENTRY("menuEv_NoClientInList",
+        u8"+____ No clients in list\n",
+        nullptr),
 
-    // menuEv_FreqChangeInfo
-    this->m_cLangPkg.add(L"en.menuEv_FreqChangeInfo", std::wstring(L"Info: Send \"WM2000:freq:%d 10\" to set frequency (10) of the selected profile (%d). Use frequency \"0\" to disable profile. Use \"free\" instead of a frequency number to select next unused frequency."));
-    //this->m_cLangPkg.add(L"de.menuEv_FreqChangeInfo", std::wstring(L""));
-}
+    LANG_ENTRY("menuEv_FreqChangeInfo",
+        u8"Info: Send \"WM2000:freq:%d 10\" to set frequency (10) of the selected profile (%d). Use frequency \"0\" to disable profile. Use \"free\" instead of a frequency number to select next unused frequency.",
+        nullptr),
 
-    
-/* ----------------------------------------------------------------------------
-* set all strings needed by info window handling (called by constructor)
-*/
-void language_pkg::init_plugin_info()
-{
     // INFO sub window
     //-------------------------------------------------------------------------------------
 
-    // info_Title
-    this->m_cLangPkg.add(L"en.info_Title", std::wstring(L"WM2000 / Active profile"));
-    this->m_cLangPkg.add(L"de.info_Title", std::wstring(L"WM2000 / Aktive Profile"));
+    LANG_ENTRY("info_Title",
+        u8"WM2000 / Active profile",
+        u8"WM2000 / Aktive Profile"),
 
-    // info_Default
-    this->m_cLangPkg.add(L"en.info_Default", std::wstring(L"None"));
-    this->m_cLangPkg.add(L"de.info_Default", std::wstring(L"Keine"));
+    LANG_ENTRY("info_Default",
+        u8"None",
+        u8"Keine"),
 
-    // info_Freq
-    this->m_cLangPkg.add(L"en.info_Freq", std::wstring(L"Active freq.: "));
-    this->m_cLangPkg.add(L"de.info_Freq", std::wstring(L"Aktive Freq.: "));
+    LANG_ENTRY("info_Freq",
+        u8"Active freq.: ",
+        u8"Aktive Freq.: "),
 
-    // info_FreqDisabled
-    this->m_cLangPkg.add(L"en.info_FreqDisabled", std::wstring(L"No active freq."));
-    this->m_cLangPkg.add(L"de.info_FreqDisabled", std::wstring(L"Keine aktiven Freq."));
+    LANG_ENTRY("info_FreqDisabled",
+        u8"No active freq.",
+        u8"Keine aktiven Freq."),
 
-    // info_NoWM2000
-    this->m_cLangPkg.add(L"en.info_NoWM2000", std::wstring(L"WM2000 not active"));
-    this->m_cLangPkg.add(L"de.info_NoWM2000", std::wstring(L"WM2000 nicht aktiv"));
+    LANG_ENTRY("info_NoWM2000",
+        u8"WM2000 not active",
+        u8"WM2000 nicht aktiv"),
 
-    // info_Ignore
-    this->m_cLangPkg.add(L"en.info_Ignore", std::wstring(L"[B]Ignored[/B]"));
-    this->m_cLangPkg.add(L"de.info_Ignore", std::wstring(L"[B]Ignoriert[/B]"));
-}
+    LANG_ENTRY("info_Ignore",
+        u8"[B]Ignored[/B]",
+        u8"[B]Ignoriert[/B]"),
 
+    LANG_ENTRY("info_ActTalk",
+        u8"[B]Talking[/B] for %u s",
+        u8"[B]Spricht[/B] seit %u s"),
 
-/* ----------------------------------------------------------------------------
-* set all strings needed by Main UI (called by constructor)
-*/
-void language_pkg::init_ui_main()
-{
-    // general config UI
-    //-------------------------------------------------------------------------------------
+    LANG_ENTRY("info_ActWhisper",
+        u8"[B]Whispering[/B] for %u s",
+        u8"[B]Flüstert[/B] seit %u s"),
 
-    // gUi_pbOk
-    this->m_cLangPkg.add(L"en.gUi_pbOk", std::wstring(L"Ok"));
-    //this->m_cLangPkg.add(L"de.gUi_pbOk", std::wstring(L""));
+    LANG_ENTRY("info_ActFreq",
+        u8"Freq. %d: %u talking (%u whisper), %u:%02u min, %u s ago",
+        u8"Freq. %d: %u sprechen (%u flüstern), %u:%02u min, vor %u s"),
 
-    // gUi_pbCancel
-    this->m_cLangPkg.add(L"en.gUi_pbCancel", std::wstring(L"Cancel"));
-    this->m_cLangPkg.add(L"de.gUi_pbCancel", std::wstring(L"Abbrechen"));
+    // general config UI
+    //-------------------------------------------------------------------------------------
 
-    // gUi_pbApply
-    this->m_cLangPkg.add(L"en.gUi_pbApply", std::wstring(L"Apply"));
-    this->m_cLangPkg.add(L"de.gUi_pbApply", std::wstring(L"bernehmen"));
+    LANG_ENTRY("gUi_pbOk",
+        u8"Ok",
+        nullptr),
 
+    LANG_ENTRY("gUi_pbCancel",
+        u8"Cancel",
+        u8"Abbrechen"),
 
+    LANG_ENTRY("gUi_pbApply",
+        u8"Apply",
+        u8"Übernehmen"),
 
     // Main config UI
     //-------------------------------------------------------------------------------------
 
-    // mUi_fmTitle
-    this->m_cLangPkg.add(L"en.mUi_fmTitle", std::wstring(L"WM2000 plugin main settings"));
-    this->m_cLangPkg.add(L"de.mUi_fmTitle", std::wstring(L"WM2000 plugin Einstellungen"));
+    LANG_ENTRY("mUi_fmTitle",
+        u8"WM2000 plugin main settings",
+        u8"WM2000 plugin Einstellungen"),
 
-    // mUi_MenuTitle
-    this->m_cLangPkg.add(L"en.mUi_MenuTitle", std::wstring(L"File"));
-    this->m_cLangPkg.add(L"de.mUi_MenuTitle", std::wstring(L"Datei"));
+    LANG_ENTRY("mUi_MenuTitle",
+        u8"File",
+        u8"Datei"),
 
-    // mUi_MenuLoad
-    this->m_cLangPkg.add(L"en.mUi_MenuLoad", std::wstring(L"Load"));
-    this->m_cLangPkg.add(L"de.mUi_MenuLoad", std::wstring(L"Lade"));
+    LANG_ENTRY("mUi_MenuLoad",
+        u8"Load",
+        u8"Lade"),
 
-    // mUi_ToolMenuLoad
-    this->m_cLangPkg.add(L"en.mUi_ToolMenuLoad", std::wstring(L"Load default settings"));
-    this->m_cLangPkg.add(L"de.mUi_ToolMenuLoad", std::wstring(L"Lade Grundeinstellungen"));
+    LANG_ENTRY("mUi_ToolMenuLoad",
+        u8"Load default settings",
+        u8"Lade Grundeinstellungen"),
 
-    // mUi_MenuSave
-    this->m_cLangPkg.add(L"en.mUi_MenuSave", std::wstring(L"Save"));
-    this->m_cLangPkg.add(L"de.mUi_MenuSave", std::wstring(L"Speichern"));
+    LANG_ENTRY("mUi_MenuSave",
+        u8"Save",
+        u8"Speichern"),
 
-    // mUi_MenuSaveAs
-    this->m_cLangPkg.add(L"en.mUi_MenuSaveAs", std::wstring(L"Save as"));
-    this->m_cLangPkg.add(L"de.mUi_MenuSaveAs", std::wstring(L"Speichern unter"));
+    LANG_ENTRY("mUi_MenuSaveAs",
+        u8"Save as",
+        u8"Speichern unter"),
 
-    // mUi_ToolMenuSave
-    this->m_cLangPkg.add(L"en.mUi_ToolMenuSave", std::wstring(L"Save settings"));
-    this->m_cLangPkg.add(L"de.mUi_ToolMenuSave", std::wstring(L"Speichere Einstellungen"));
+    LANG_ENTRY("mUi_ToolMenuSave",
+        u8"Save settings",
+        u8"Speichere Einstellungen"),
 
-    // mUi_MenuClose
-    this->m_cLangPkg.add(L"en.mUi_MenuClose", std::wstring(L"Close"));
-    this->m_cLangPkg.add(L"de.mUi_MenuClose", std::wstring(L"Beenden"));
+    LANG_ENTRY("mUi_MenuClose",
+        u8"Close",
+        u8"Beenden"),
 
-    // mUi_ToolMenuClose
-    this->m_cLangPkg.add(L"en.mUi_ToolMenuClose", std::wstring(L"Save settings and close window"));
-    this->m_cLangPkg.add(L"de.mUi_ToolMenuClose", std::wstring(L"Speichere Einstellungen und schliee das Fenster"));
+    LANG_ENTRY("mUi_ToolMenuClose",
+        u8"Save settings and close window",
+        u8"Speichere Einstellungen und schließe das Fenster"),
 
-    // mUi_MenuEditTitle
-    this->m_cLangPkg.add(L"en.mUi_MenuEditTitle", std::wstring(L"Edit"));
-    this->m_cLangPkg.add(L"de.mUi_MenuEditTitle", std::wstring(L"Bearbeiten"));
+    LANG_ENTRY("mUi_MenuEditTitle",
+        u8"Edit",
+        u8"Bearbeiten"),
 
-    // mUi_MenuUndo
-    this->m_cLangPkg.add(L"en.mUi_MenuUndo", std::wstring(L"Undo"));
-    this->m_cLangPkg.add(L"de.mUi_MenuUndo", std::wstring(L"Rckgngig"));
+    LANG_ENTRY("mUi_MenuUndo",
+        u8"Undo",
+        u8"Rückgängig"),
 
-    // mUi_ToolMenuUndo
-    this->m_cLangPkg.add(L"en.mUi_ToolMenuUndo", std::wstring(L"Undo all changed settings"));
-    this->m_cLangPkg.add(L"de.mUi_ToolMenuUndo", std::wstring(L"Mache alle nderungen rckgngig"));
+    LANG_ENTRY("mUi_ToolMenuUndo",
+        u8"Undo all changed settings",
+        u8"Mache alle Änderungen rückgängig"),
 
-    // mUi_MenuViewTitle
-    this->m_cLangPkg.add(L"en.mUi_MenuViewTitle", std::wstring(L"View"));
-    this->m_cLangPkg.add(L"de.mUi_MenuViewTitle", std::wstring(L"Ansicht"));
-    
-    // mUi_MenuExpert
-    this->m_cLangPkg.add(L"en.mUi_MenuExpert", std::wstring(L"Expert"));
-    this->m_cLangPkg.add(L"de.mUi_MenuExpert", std::wstring(L"Experte"));
+    LANG_ENTRY("mUi_MenuViewTitle",
+        u8"View",
+        u8"Ansicht"),
 
-    // mUi_ToolMenuExpert
-    this->m_cLangPkg.add(L"en.mUi_ToolMenuExpert", std::wstring(L"Enables/Disables some expert settings"));
-    this->m_cLangPkg.add(L"de.mUi_ToolMenuExpert", std::wstring(L"Aktiviert/Deaktiviert einige experten Einstellungen"));
+    LANG_ENTRY("mUi_MenuExpert",
+        u8"Expert",
+        u8"Experte"),
 
-    // mUi_MenuOpenFreq
-    this->m_cLangPkg.add(L"en.mUi_MenuOpenFreq", std::wstring(L"Set Frequency"));
-    this->m_cLangPkg.add(L"de.mUi_MenuOpenFreq", std::wstring(L"Setze Frequenz"));
+    LANG_ENTRY("mUi_ToolMenuExpert",
+        u8"Enables/Disables some expert settings",
+        u8"Aktiviert/Deaktiviert einige experten Einstellungen"),
 
-    // mUi_ToolMenuOpenFreq
-    this->m_cLangPkg.add(L"en.mUi_ToolMenuOpenFreq", std::wstring(L"Opens the \"Set Frequency\" window"));
-    this->m_cLangPkg.add(L"de.mUi_ToolMenuOpenFreq", std::wstring(L"ffnet das \"Setze Frequenz\" Fenster"));
+    LANG_ENTRY("mUi_MenuOpenFreq",
+        u8"Set Frequency",
+        u8"Setze Frequenz"),
 
-    // mUi_MenuHelpTitle
-    this->m_cLangPkg.add(L"en.mUi_MenuHelpTitle", std::wstring(L"Help"));
-    this->m_cLangPkg.add(L"de.mUi_MenuHelpTitle", std::wstring(L"Hilfe"));
+    LANG_ENTRY("mUi_ToolMenuOpenFreq",
+        u8"Opens the \"Set Frequency\" window",
+        u8"Öffnet das \"Setze Frequenz\" Fenster"),
 
-    // mUi_MenuAbout
-    this->m_cLangPkg.add(L"en.mUi_MenuAbout", std::wstring(L"About WM2000"));
-    this->m_cLangPkg.add(L"de.mUi_MenuAbout", std::wstring(L"ber WM2000"));
+    LANG_ENTRY("mUi_MenuHelpTitle",
+        u8"Help",
+        u8"Hilfe"),
 
-    // mUi_TabGeneral
-    this->m_cLangPkg.add(L"en.mUi_TabGeneral", std::wstring(L"General"));
-    this->m_cLangPkg.add(L"de.mUi_TabGeneral", std::wstring(L"Allgemein"));
+    LANG_ENTRY("mUi_MenuAbout",
+        u8"About WM2000",
+        u8"Über WM2000"),
 
-    // mUi_TabGeneralTip
-    this->m_cLangPkg.add(L"en.mUi_TabGeneralTip", std::wstring(L"General settings"));
-    this->m_cLangPkg.add(L"de.mUi_TabGeneralTip", std::wstring(L"Allgemeine Einstellungen"));
+    LANG_ENTRY("mUi_TabGeneral",
+        u8"General",
+        u8"Allgemein"),
 
-    // mUi_TabGeneralWhat
-    this->m_cLangPkg.add(L"en.mUi_TabGeneralWhat", std::wstring(L"Open tab with general settings."));
-    this->m_cLangPkg.add(L"de.mUi_TabGeneralWhat", std::wstring(L"ffne tab mit allgemeneinen Einstellungen."));
+    LANG_ENTRY("mUi_TabGeneralTip",
+        u8"General settings",
+        u8"Allgemeine Einstellungen"),
 
-    // mUi_NumProfile
-    this->m_cLangPkg.add(L"en.mUi_NumProfile", std::wstring(L"Number of profiles:"));
-    this->m_cLangPkg.add(L"de.mUi_NumProfile", std::wstring(L"Anzahl Profile:"));
+    LANG_ENTRY("mUi_TabGeneralWhat",
+        u8"Open tab with general settings.",
+        u8"Öffne tab mit allgemeneinen Einstellungen."),
 
-    // mUi_Language
-    this->m_cLangPkg.add(L"en.mUi_Language", std::wstring(L"Language:"));
-    this->m_cLangPkg.add(L"de.mUi_Language", std::wstring(L"Sprache:"));
+    LANG_ENTRY("mUi_NumProfile",
+        u8"Number of profiles:",
+        u8"Anzahl Profile:"),
 
-    // mUi_LanguageEn
-    this->m_cLangPkg.add(L"en.mUi_LanguageEn", std::wstring(L"English"));
-    this->m_cLangPkg.add(L"de.mUi_LanguageEn", std::wstring(L"Englisch"));
+    LANG_ENTRY("mUi_Language",
+        u8"Language:",
+        u8"Sprache:"),
 
-    // mUi_LanguageDe
-    this->m_cLangPkg.add(L"en.mUi_LanguageDe", std::wstring(L"German"));
-    this->m_cLangPkg.add(L"de.mUi_LanguageDe", std::wstring(L"Deutsch"));
+    LANG_ENTRY("mUi_LanguageEn",
+        u8"English",
+        u8"Englisch"),
 
-    // mUi_HotKeyReset
-    this->m_cLangPkg.add(L"en.mUi_HotKeyReset", std::wstring(L"Reset hotkeys:"));
-    this->m_cLangPkg.add(L"de.mUi_HotKeyReset", std::wstring(L"Reset Hotkeys:"));
+    LANG_ENTRY("mUi_LanguageDe",
+        u8"German",
+        u8"Deutsch"),
 
-    // mUi_HotKeyMute
-    this->m_cLangPkg.add(L"en.mUi_HotKeyMute", std::wstring(L"Global mute:"));
-    this->m_cLangPkg.add(L"de.mUi_HotKeyMute", std::wstring(L"Globales Mute:"));
+    LANG_ENTRY("mUi_HotKeyReset",
+        u8"Reset hotkeys:",
+        u8"Reset Hotkeys:"),
 
-    // mUi_HotKeyDefault
-    this->m_cLangPkg.add(L"en.mUi_HotKeyDefault", std::wstring(L"No Hotkey"));
-    this->m_cLangPkg.add(L"de.mUi_HotKeyDefault", std::wstring(L"Kein Hotkey"));
+    LANG_ENTRY("mUi_HotKeyMute",
+        u8"Global mute:",
+        u8"Globales Mute:"),
 
-    // mUi_HotKeyDown
-    this->m_cLangPkg.add(L"en.mUi_HotKeyDown", std::wstring(L"Hotkey \"press\":"));
-    this->m_cLangPkg.add(L"de.mUi_HotKeyDown", std::wstring(L"Hotkey \"drcken\":"));
+    LANG_ENTRY("mUi_HotKeyDefault",
+        u8"No Hotkey",
+        u8"Kein Hotkey"),
 
-    // mUi_HotKeyUp
-    this->m_cLangPkg.add(L"en.mUi_HotKeyUp", std::wstring(L"Hotkey \"release\":"));
-    this->m_cLangPkg.add(L"de.mUi_HotKeyUp", std::wstring(L"Hotkey \"loslassen\":"));
+    LANG_ENTRY("mUi_HotKeyDown",
+        u8"Hotkey \"press\":",
+        u8"Hotkey \"drücken\":"),
 
-    // mUi_Ignore
-    this->m_cLangPkg.add(L"en.mUi_Ignore", std::wstring(L"Ignore list"));
-    this->m_cLangPkg.add(L"de.mUi_Ignore", std::wstring(L"Ignore-Liste"));
+    LANG_ENTRY("mUi_HotKeyUp",
+        u8"Hotkey \"release\":",
+        u8"Hotkey \"loslassen\":"),
 
-    // mUi_DelIgnore
-    this->m_cLangPkg.add(L"en.mUi_DelIgnore", std::wstring(L"Delete list"));
-    this->m_cLangPkg.add(L"de.mUi_DelIgnore", std::wstring(L"Liste lschen"));
+    LANG_ENTRY("mUi_Ignore",
+        u8"Ignore list",
+        u8"Ignore-Liste"),
 
-    // mUi_UseForRx
-    this->m_cLangPkg.add(L"en.mUi_UseForRx", std::wstring(L"Use for receiving:"));
-    this->m_cLangPkg.add(L"de.mUi_UseForRx", std::wstring(L"Verwenden zum Empfangen:"));
+    LANG_ENTRY("mUi_DelIgnore",
+        u8"Delete list",
+        u8"Liste löschen"),
 
-    // mUi_AutoSave
-    this->m_cLangPkg.add(L"en.mUi_AutoSave", std::wstring(L"Auto save configuration:"));
-    this->m_cLangPkg.add(L"de.mUi_AutoSave", std::wstring(L"Automatisch speichern:"));
+    LANG_ENTRY("mUi_UseForRx",
+        u8"Use for receiving:",
+        u8"Verwenden zum Empfangen:"),
 
-    // mUi_ProfileName
-    this->m_cLangPkg.add(L"en.mUi_ProfileName", std::wstring(L"Name of profile"));
-    this->m_cLangPkg.add(L"de.mUi_ProfileName", std::wstring(L"Name des Profils"));
+    LANG_ENTRY("mUi_AutoSave",
+        u8"Auto save configuration:",
+        u8"Automatisch speichern:"),
 
-    // mUi_ProfileType
-    this->m_cLangPkg.add(L"en.mUi_ProfileType", std::wstring(L"Type of profile:"));
-    this->m_cLangPkg.add(L"de.mUi_ProfileType", std::wstring(L"Profiltyp:"));
+    LANG_ENTRY("mUi_ProfileName",
+        u8"Name of profile",
+        u8"Name des Profils"),
 
-    // mUi_ProfileOff
-    this->m_cLangPkg.add(L"en.mUi_ProfileOff", std::wstring(L"Deactivated"));
-    this->m_cLangPkg.add(L"de.mUi_ProfileOff", std::wstring(L"Deaktiviert"));
+    LANG_ENTRY("mUi_ProfileType",
+        u8"Type of profile:",
+        u8"Profiltyp:"),
 
-    // mUi_ProfileFav
-    this->m_cLangPkg.add(L"en.mUi_ProfileFav", std::wstring(L"Favorite"));
-    this->m_cLangPkg.add(L"de.mUi_ProfileFav", std::wstring(L"Favorit"));
+    LANG_ENTRY("mUi_ProfileOff",
+        u8"Deactivated",
+        u8"Deaktiviert"),
 
-    // mUi_ProfileLevel
-    this->m_cLangPkg.add(L"en.mUi_ProfileLevel", std::wstring(L"Level"));
-    this->m_cLangPkg.add(L"de.mUi_ProfileLevel", std::wstring(L"Level"));
+    LANG_ENTRY("mUi_ProfileFav",
+        u8"Favorite",
+        u8"Favorit"),
 
-    // mUi_ProfileFreq
-    this->m_cLangPkg.add(L"en.mUi_ProfileFreq", std::wstring(L"Frequency"));
-    this->m_cLangPkg.add(L"de.mUi_ProfileFreq", std::wstring(L"Frequenz"));
+    LANG_ENTRY("mUi_ProfileLevel",
+        u8"Level",
+        u8"Level"),
 
-    // mUi_UseIgnoreTx
-    this->m_cLangPkg.add(L"en.mUi_UseIgnoreTx", std::wstring(L"Use ignore list for transmit:"));
-    this->m_cLangPkg.add(L"de.mUi_UseIgnoreTx", std::wstring(L"Verwende Ignore-List zum senden:"));
+    LANG_ENTRY("mUi_ProfileFreq",
+        u8"Frequency",
+        u8"Frequenz"),
 
-    // mUi_AutoPtt
-    this->m_cLangPkg.add(L"en.mUi_AutoPtt", std::wstring(L"Auto activate (PTT):"));
-    this->m_cLangPkg.add(L"de.mUi_AutoPtt", std::wstring(L"Auto aktivieren (PTT):"));
+    LANG_ENTRY("mUi_UseIgnoreTx",
+        u8"Use ignore list for transmit:",
+        u8"Verwende Ignore-List zum senden:"),
 
-    // mUi_ProfileOffGb
-    this->m_cLangPkg.add(L"en.mUi_ProfileOffGb", std::wstring(L"Profile deactivated"));
-    this->m_cLangPkg.add(L"de.mUi_ProfileOffGb", std::wstring(L"Profil deaktiviert"));
+    LANG_ENTRY("mUi_AutoPtt",
+        u8"Auto activate (PTT):",
+        u8"Auto aktivieren (PTT):"),
 
-    // mUi_ProfileLevelGb
-    this->m_cLangPkg.add(L"en.mUi_ProfileLevelGb", std::wstring(L"Channel Level"));
-    this->m_cLangPkg.add(L"de.mUi_ProfileLevelGb", std::wstring(L"Channel-Level"));
+    LANG_ENTRY("mUi_ProfileOffGb",
+        u8"Profile deactivated",
+        u8"Profil deaktiviert"),
 
-    // mUi_LowerLevel
-    this->m_cLangPkg.add(L"en.mUi_LowerLevel", std::wstring(L"Lower bound:"));
-    this->m_cLangPkg.add(L"de.mUi_LowerLevel", std::wstring(L"Untere Grenze:"));
+    LANG_ENTRY("mUi_ProfileLevelGb",
+        u8"Channel Level",
+        u8"Channel-Level"),
 
-    // mUi_UpperLevel
-    this->m_cLangPkg.add(L"en.mUi_UpperLevel", std::wstring(L"Upper bound (optional):"));
-    this->m_cLangPkg.add(L"de.mUi_UpperLevel", std::wstring(L"Obere Grenze (Optional):"));
+    LANG_ENTRY("mUi_LowerLevel",
+        u8"Lower bound:",
+        u8"Untere Grenze:"),
 
-    // mUi_UseSubCh
-    this->m_cLangPkg.add(L"en.mUi_UseSubCh", std::wstring(L"Use sub-channel:"));
-    this->m_cLangPkg.add(L"de.mUi_UseSubCh", std::wstring(L"Verwende sub-channel:"));
+    LANG_ENTRY("mUi_UpperLevel",
+        u8"Upper bound (optional):",
+        u8"Obere Grenze (Optional):"),
 
-    // mUi_TransFreq
-    this->m_cLangPkg.add(L"en.mUi_TransFreq", std::wstring(L"Transceiver frequency:"));
-    this->m_cLangPkg.add(L"de.mUi_TransFreq", std::wstring(L"Sendeempfnger Frequenz:"));
+    LANG_ENTRY("mUi_UseSubCh",
+        u8"Use sub-channel:",
+        u8"Verwende sub-channel:"),
 
-    // mUi_NextFreq
-    this->m_cLangPkg.add(L"en.mUi_NextFreq", std::wstring(L"Next free"));
-    this->m_cLangPkg.add(L"de.mUi_NextFreq", std::wstring(L"Nchste freie"));
+    LANG_ENTRY("mUi_TransFreq",
+        u8"Transceiver frequency:",
+        u8"Sendeempfänger Frequenz:"),
 
-    // mUi_ProfMode
-    this->m_cLangPkg.add(L"en.mUi_ProfMode", std::wstring(L"Mode:"));
-    this->m_cLangPkg.add(L"de.mUi_ProfMode", std::wstring(L"Modus:"));
+    LANG_ENTRY("mUi_NextFreq",
+        u8"Next free",
+        u8"Nächste freie"),
 
-    // mUi_ProfModeOff
-    this->m_cLangPkg.add(L"en.mUi_ProfModeOff", std::wstring(L"Off"));
-    this->m_cLangPkg.add(L"de.mUi_ProfModeOff", std::wstring(L"Off"));
+    LANG_ENTRY("mUi_ProfMode",
+        u8"Mode:",
+        u8"Modus:"),
 
-    // mUi_ProfModeNorm
-    this->m_cLangPkg.add(L"en.mUi_ProfModeNorm", std::wstring(L"Normal"));
-    this->m_cLangPkg.add(L"de.mUi_ProfModeNorm", std::wstring(L"Normal"));
+    LANG_ENTRY("mUi_ProfModeOff",
+        u8"Off",
+        u8"Off"),
 
-    // mUi_ProfModeMute
-    this->m_cLangPkg.add(L"en.mUi_ProfModeMute", std::wstring(L"Mute"));
-    this->m_cLangPkg.add(L"de.mUi_ProfModeMute", std::wstring(L"Stumm"));
+    LANG_ENTRY("mUi_ProfModeNorm",
+        u8"Normal",
+        u8"Normal"),
 
-    // mUi_ProfModeSquelch
-    this->m_cLangPkg.add(L"en.mUi_ProfModeSquelch", std::wstring(L"Squelch"));
-    this->m_cLangPkg.add(L"de.mUi_ProfModeSquelch", std::wstring(L"Squelch"));
+    LANG_ENTRY("mUi_ProfModeMute",
+        u8"Mute",
+        u8"Stumm"),
 
-    // mUi_UsePrio
-    this->m_cLangPkg.add(L"en.mUi_UsePrio", std::wstring(L"Transmit with priority:"));
-    this->m_cLangPkg.add(L"de.mUi_UsePrio", std::wstring(L"Sende mit Prioritt:"));
+    LANG_ENTRY("mUi_ProfModeSquelch",
+        u8"Squelch",
+        u8"Squelch"),
 
-    // mUi_UseMaster
-    this->m_cLangPkg.add(L"en.mUi_UseMaster", std::wstring(L"Transmit with master rights:"));
-    this->m_cLangPkg.add(L"de.mUi_UseMaster", std::wstring(L"Sende mit Master rechten:"));
+    LANG_ENTRY("mUi_UsePrio",
+        u8"Transmit with priority:",
+        u8"Sende mit Priorität:"),
 
-    // mUi_NameProfTab
-    this->m_cLangPkg.add(L"en.mUi_NameProfTab", std::wstring(L"%d. %s"));
-    this->m_cLangPkg.add(L"de.mUi_NameProfTab", std::wstring(L"%d. %s"));
+    LANG_ENTRY("mUi_UseMaster",
+        u8"Transmit with master rights:",
+        u8"Sende mit Master rechten:"),
 
-    // mUi_ToolProfTab
-    this->m_cLangPkg.add(L"en.mUi_ToolProfTab", std::wstring(L"Show/change settings of profile \"%s\""));
-    this->m_cLangPkg.add(L"de.mUi_ToolProfTab", std::wstring(L"Zeige/ndere Einstellungen fr Profil \"%s\""));
+    LANG_ENTRY("mUi_NameProfTab",
+        u8"%d. %s",
+        u8"%d. %s"),
 
-    // mUi_gb_led
-    this->m_cLangPkg.add(L"en.mUi_gb_led", std::wstring(L"LED keyboard backlight"));
-    this->m_cLangPkg.add(L"de.mUi_gb_led", std::wstring(L"LED Tastatur Beleuchtung"));
+    LANG_ENTRY("mUi_ToolProfTab",
+        u8"Show/change settings of profile \"%s\"",
+        u8"Zeige/ändere Einstellungen für Profil \"%s\""),
 
-    // mUi_pb_led_color
-    this->m_cLangPkg.add(L"en.mUi_pb_led_color", std::wstring(L"Color ..."));
-    this->m_cLangPkg.add(L"de.mUi_pb_led_color", std::wstring(L"Farbe ..."));
+    LANG_ENTRY("mUi_gb_led",
+        u8"LED keyboard backlight",
+        u8"LED Tastatur Beleuchtung"),
 
-    // mUi_pb_led_test
-    this->m_cLangPkg.add(L"en.mUi_pb_led_test", std::wstring(L"Test"));
-    this->m_cLangPkg.add(L"de.mUi_pb_led_test", std::wstring(L"Test"));
+    LANG_ENTRY("mUi_pb_led_color",
+        u8"Color ...",
+        u8"Farbe ..."),
 
-    // mUi_cb_led_key
-    this->m_cLangPkg.add(L"en.mUi_cb_led_key", std::wstring(L"No key selected"));
-    this->m_cLangPkg.add(L"de.mUi_cb_led_key", std::wstring(L"Keine Taste"));
+    LANG_ENTRY("mUi_pb_led_test",
+        u8"Test",
+        u8"Test"),
 
-    // mUi_cb_led_type1
-    this->m_cLangPkg.add(L"en.mUi_cb_led_type1", std::wstring(L"No LED back light"));
-    this->m_cLangPkg.add(L"de.mUi_cb_led_type1", std::wstring(L"Keine LED-Beleuchtung"));
+    LANG_ENTRY("mUi_cb_led_key",
+        u8"No key selected",
+        u8"Keine Taste"),
 
-    // mUi_cb_led_type2
-    this->m_cLangPkg.add(L"en.mUi_cb_led_type2", std::wstring(L"Logitech (LGS)"));
-    this->m_cLangPkg.add(L"de.mUi_cb_led_type2", std::wstring(L"Logitech (LGS)"));
+    LANG_ENTRY("mUi_cb_led_type1",
+        u8"No LED back light",
+        u8"Keine LED-Beleuchtung"),
 
-    // mUi_msg_NeedsRestart
-    this->m_cLangPkg.add(L"en.mUi_msg_NeedsRestart", std::wstring(L"Some of the changed settings requier a restart of TeamSpeak3.\nPlease restart TeamSpeak3 now!"));
-    this->m_cLangPkg.add(L"de.mUi_msg_NeedsRestart", std::wstring(L"Einige der genderten Einstellung bentigen einen Neustart von TeamSpeak3 um endgltig zu wirken.\nBitte starten sie TeamSpeak3 daher jetzt neu!"));
+    LANG_ENTRY("mUi_cb_led_type2",
+        u8"Logitech (LGS)",
+        u8"Logitech (LGS)"),
 
-    // mUi_msg_load_title
-    this->m_cLangPkg.add(L"en.mUi_msg_load_title", std::wstring(L"Load configuration"));
-    this->m_cLangPkg.add(L"de.mUi_msg_load_title", std::wstring(L"Lade Einstellungen"));
+    LANG_ENTRY("mUi_msg_NeedsRestart",
+        u8"Some of the changed settings requier a restart of TeamSpeak3.\nPlease restart TeamSpeak3 now!",
+        u8"Einige der geänderten Einstellung benötigen einen Neustart von TeamSpeak3 um endgültig zu wirken.\nBitte starten sie TeamSpeak3 daher jetzt neu!"),
 
-    // mUi_msg_load_text
-    this->m_cLangPkg.add(L"en.mUi_msg_load_text", std::wstring(L"Select a configuration to load:"));
-    this->m_cLangPkg.add(L"de.mUi_msg_load_text", std::wstring(L"Whle die zu ladende Konfiguration:"));
+    LANG_ENTRY("mUi_msg_load_title",
+        u8"Load configuration",
+        u8"Lade Einstellungen"),
 
-    // mUi_msg_firstload_text
-    this->m_cLangPkg.add(L"en.mUi_msg_firstload_text", std::wstring(L"You are starting the WhisperMaster2000 for the first time,\nplease select a a basic configuration to load:"));
-    this->m_cLangPkg.add(L"de.mUi_msg_firstload_text", std::wstring(L"Du startest den WhisperMaster2000 das erste mal,\nbitte whle eine Basiskonfiguration:"));
+    LANG_ENTRY("mUi_msg_load_text",
+        u8"Select a configuration to load:",
+        u8"Wähle die zu ladende Konfiguration:"),
 
-    // mUi_msg_load_nofile
-    this->m_cLangPkg.add(L"en.mUi_msg_load_nofile", std::wstring(L"No file found to load configuration from."));
-    this->m_cLangPkg.add(L"de.mUi_msg_load_nofile", std::wstring(L"Keine Datei gefunden um Einstellungen zu laden."));
+    LANG_ENTRY("mUi_msg_firstload_text",
+        u8"You are starting the WhisperMaster2000 for the first time,\nplease select a a basic configuration to load:",
+        u8"Du startest den WhisperMaster2000 das erste mal,\nbitte wähle eine Basiskonfiguration:"),
 
-    // mUi_msg_saveas_title
-    this->m_cLangPkg.add(L"en.mUi_msg_saveas_title", std::wstring(L"Save configuration to file"));
-    this->m_cLangPkg.add(L"de.mUi_msg_saveas_title", std::wstring(L"Speichere Einstellungen in Datei"));
+    LANG_ENTRY("mUi_msg_load_nofile",
+        u8"No file found to load configuration from.",
+        u8"Keine Datei gefunden um Einstellungen zu laden."),
 
-    // mUi_msg_saveas_conf
-    this->m_cLangPkg.add(L"en.mUi_msg_saveas_conf", std::wstring(L"Configuration (*.xml)"));
-    this->m_cLangPkg.add(L"de.mUi_msg_saveas_conf", std::wstring(L"Konfiguration (*.xml)"));
-}
+    LANG_ENTRY("mUi_msg_saveas_title",
+        u8"Save configuration to file",
+        u8"Speichere Einstellungen in Datei"),
 
+    LANG_ENTRY("mUi_msg_saveas_conf",
+        u8"Configuration (*.xml)",
+        u8"Konfiguration (*.xml)"),
 
-/* ----------------------------------------------------------------------------
-* set all strings needed by frequency UI (called by constructor)
-*/
-void language_pkg::init_ui_freq()
-{
     // Freq config UI
     //-------------------------------------------------------------------------------------
 
-    // fUi_fmTitle
-    this->m_cLangPkg.add(L"en.fUi_fmTitle", std::wstring(L"Set frequency of profiles"));
-    this->m_cLangPkg.add(L"de.fUi_fmTitle", std::wstring(L"Setze Frequenz der Profile"));
+    LANG_ENTRY("fUi_fmTitle",
+        u8"Set frequency of profiles",
+        u8"Setze Frequenz der Profile"),
 
-    // fUi_tabProfileDummy
-    this->m_cLangPkg.add(L"en.fUi_tabProfileDummy", std::wstring(L"0. No \"Frequency\" profile found"));
-    this->m_cLangPkg.add(L"de.fUi_tabProfileDummy", std::wstring(L"0. Keine \"Frequency\" Profile gefunden"));
+    LANG_ENTRY("fUi_tabProfileDummy",
+        u8"0. No \"Frequency\" profile found",
+        u8"0. Keine \"Frequency\" Profile gefunden"),
 
-    // fUi_WhatIsTabProfile
-    this->m_cLangPkg.add(L"en.fUi_WhatIsTabProfile", std::wstring(L"Selects the <b>Profile</b> to change."));
-    this->m_cLangPkg.add(L"de.fUi_WhatIsTabProfile", std::wstring(L"Selektiert das gerade aktive <b>Profil</b>."));
+    LANG_ENTRY("fUi_WhatIsTabProfile",
+        u8"Selects the <b>Profile</b> to change.",
+        u8"Selektiert das gerade aktive <b>Profil</b>."),
 
-    // fUi_pbSetFreq
-    this->m_cLangPkg.add(L"en.fUi_pbSetFreq", std::wstring(L"Set"));
-    this->m_cLangPkg.add(L"de.fUi_pbSetFreq", std::wstring(L"Setze"));
+    LANG_ENTRY("fUi_pbSetFreq",
+        u8"Set",
+        u8"Setze"),
 
-    // fUi_WhatIsSetFreq
-    this->m_cLangPkg.add(L"en.fUi_WhatIsSetFreq", std::wstring(L"Open a dialog to <b>Set</b> a specific frequency manually."));
-    this->m_cLangPkg.add(L"de.fUi_WhatIsSetFreq", std::wstring(L"ffne einen Dialog um manuell eine bestimte Frequenz zu <b>Setzen</b>"));
+    LANG_ENTRY("fUi_WhatIsSetFreq",
+        u8"Open a dialog to <b>Set</b> a specific frequency manually.",
+        u8"Öffne einen Dialog um manuell eine bestimte Frequenz zu <b>Setzen</b>"),
 
-    // fUi_WhatIsDialFreq
-    this->m_cLangPkg.add(L"en.fUi_WhatIsDialFreq", std::wstring(L"Changes the actual <b>Active frequency</b>."));
-    this->m_cLangPkg.add(L"de.fUi_WhatIsDialFreq", std::wstring(L"Verndert die aktuell <b>Aktive Frequenz</b>."));
+    LANG_ENTRY("fUi_WhatIsDialFreq",
+        u8"Changes the actual <b>Active frequency</b>.",
+        u8"Verändert die aktuell <b>Aktive Frequenz</b>."),
 
-    // fUi_WhatIsLcdFreq
-    this->m_cLangPkg.add(L"en.fUi_WhatIsLcdFreq", std::wstring(L"Shows the actual <b>Active frequency</b>."));
-    this->m_cLangPkg.add(L"de.fUi_WhatIsLcdFreq", std::wstring(L"Zeigt die aktuell <b>Aktive Frequenz</b>."));
+    LANG_ENTRY("fUi_WhatIsLcdFreq",
+        u8"Shows the actual <b>Active frequency</b>.",
+        u8"Zeigt die aktuell <b>Aktive Frequenz</b>."),
 
-    // fUi_pbNextFreq
-    this->m_cLangPkg.add(L"en.fUi_pbNextFreq", std::wstring(L"Next"));
-    this->m_cLangPkg.add(L"de.fUi_pbNextFreq", std::wstring(L"Nchste"));
+    LANG_ENTRY("fUi_pbNextFreq",
+        u8"Next",
+        u8"Nächste"),
 
-    // fUi_WhatIsNextFreq
-    this->m_cLangPkg.add(L"en.fUi_WhatIsNextFreq", std::wstring(L"Automatically set the <b>Next</b> unused frequency."));
-    this->m_cLangPkg.add(L"de.fUi_WhatIsNextFreq", std::wstring(L"Setze automatisch die <b>Nchste</b> unbenutzte Frequenz."));
+    LANG_ENTRY("fUi_WhatIsNextFreq",
+        u8"Automatically set the <b>Next</b> unused frequency.",
+        u8"Setze automatisch die <b>Nächste</b> unbenutzte Frequenz."),
 
-    // fUi_gbFreq
-    this->m_cLangPkg.add(L"en.fUi_gbFreq", std::wstring(L"Frequency"));
-    this->m_cLangPkg.add(L"de.fUi_gbFreq", std::wstring(L"Frequenz"));
+    LANG_ENTRY("fUi_gbFreq",
+        u8"Frequency",
+        u8"Frequenz"),
 
-    // fUi_gbGeneral
-    this->m_cLangPkg.add(L"en.fUi_gbGeneral", std::wstring(L"General"));
-    this->m_cLangPkg.add(L"de.fUi_gbGeneral", std::wstring(L"Allgemein"));
+    LANG_ENTRY("fUi_gbGeneral",
+        u8"General",
+        u8"Allgemein"),
 
-    // fUi_lbPriority
-    this->m_cLangPkg.add(L"en.fUi_lbPriority", std::wstring(L"Priority call"));
-    this->m_cLangPkg.add(L"de.fUi_lbPriority", std::wstring(L"Priorisiert senden"));
+    LANG_ENTRY("fUi_lbPriority",
+        u8"Priority call",
+        u8"Priorisiert senden"),
 
-    // fUi_WhatIsPriority
-    this->m_cLangPkg.add(L"en.fUi_WhatIsPriority", std::wstring(L"<b>Priority call</b> can be used to talk to clients that have suppressed normal calls via <b>Squelch</b>-Mode."));
-    this->m_cLangPkg.add(L"de.fUi_WhatIsPriority", std::wstring(L"<b>Priorisiertes senden</b> wird verwendet, um clients zu erreichen, die normale funksprche per <b>Squelch</b>-Mode unterdrckthaben."));
+    LANG_ENTRY("fUi_WhatIsPriority",
+        u8"<b>Priority call</b> can be used to talk to clients that have suppressed normal calls via <b>Squelch</b>-Mode.",
+        u8"<b>Priorisiertes senden</b> wird verwendet, um clients zu erreichen, die normale funksprüche per <b>Squelch</b>-Mode unterdrückthaben."),
 
-    // fUi_WhatIsDialState
-    this->m_cLangPkg.add(L"en.fUi_WhatIsDialState", std::wstring(L"<b>Off</b> disables the communication. In Mode-<b>Normal</b> you can hear all transmissions and talk to all active clients. In Mode-<b>Mute</b> all transmissions are muted, but you cann still talk to all active clients. In Mode-<b>Squelch</b> you can hear only priority calls, but you can talk to all active clients."));
-    this->m_cLangPkg.add(L"de.fUi_WhatIsDialState", std::wstring(L"<b>Off</b> deaktiviert smtliche Kommunikation. Im Modus-<b>Normal</b> kann man mit allen aktiven clients sprechen und diese hren. Im Modus-<b>Mute</b> werden keine Transmissionen empfangen, aber man kann weiterhin mit allen aktiven Clients sprechen. Im Modus-<b>Squelch</b> kann man nur Priorisierte Transmissionen empfangen, whrend man weiter mit allen aktiven Clients sprechen kann."));
+    LANG_ENTRY("fUi_lbRadio",
+        u8"Radio sound",
+        u8"Funkklang"),
 
-    // fUi_FreqFull
-    this->m_cLangPkg.add(L"en.fUi_FreqFull", std::wstring(L"All frequencies are currently in use."));
-    //this->m_cLangPkg.add(L"de.fUi_FreqFull", std::wstring(L""));
+    LANG_ENTRY("fUi_WhatIsRadio",
+        u8"<b>Radio sound</b> filters calls received on this frequency like a radio (band-pass, slight distortion, noise gate). Calls of other profiles are not changed.",
+        u8"<b>Funkklang</b> filtert auf dieser Frequenz empfangene Funksprüche wie ein Funkgerät (Bandpass, leichte Verzerrung, Rauschsperre). Funksprüche anderer Profile werden nicht verändert."),
 
-    // fUi_FreqUsed
-    this->m_cLangPkg.add(L"en.fUi_FreqUsed", std::wstring(L"Selected frequency is already in use by another profile."));
-    //this->m_cLangPkg.add(L"de.textEv_FreqUsed", std::wstring(L""));
-}
+    LANG_ENTRY("fUi_lbSpatial",
+        u8"3D position",
+        u8"3D-Position"),
+
+    LANG_ENTRY("fUi_WhatIsSpatial",
+        u8"<b>3D position</b> places calls received on this frequency at a direction of their own, frequencies are spread from left to right in profile order. The 3D sound of the TeamSpeak client has to be enabled.",
+        u8"<b>3D-Position</b> lässt auf dieser Frequenz empfangene Funksprüche aus einer eigenen Richtung kommen, die Frequenzen werden in Profilreihenfolge von links nach rechts verteilt. Der 3D-Sound des TeamSpeak-Clients muss aktiviert sein."),
+
+    LANG_ENTRY("fUi_WhatIsDialState",
+        u8"<b>Off</b> disables the communication. In Mode-<b>Normal</b> you can hear all transmissions and talk to all active clients. In Mode-<b>Mute</b> all transmissions are muted, but you cann still talk to all active clients. In Mode-<b>Squelch</b> you can hear only priority calls, but you can talk to all active clients.",
+        u8"<b>Off</b> deaktiviert sämtliche Kommunikation. Im Modus-<b>Normal</b> kann man mit allen aktiven clients sprechen und diese hören. Im Modus-<b>Mute</b> werden keine Transmissionen empfangen, aber man kann weiterhin mit allen aktiven Clients sprechen. Im Modus-<b>Squelch</b> kann man nur Priorisierte Transmissionen empfangen, während man weiter mit allen aktiven Clients sprechen kann."),
+
+    LANG_ENTRY("fUi_FreqFull",
+        u8"All frequencies are currently in use.",
+        nullptr),
+
+    LANG_ENTRY("fUi_FreqUsed",
+        u8"Selected frequency is already in use by another profile.",
+        nullptr),
 
-/* ----------------------------------------------------------------------------
-* set all strings needed by clientTreeWidget UI (called by constructor)
-*/
-void language_pkg::init_ui_client_tree()
-{
     // clientTreeWidget UI
     //-------------------------------------------------------------------------------------
-    // ctUi_treeHeaderRx
-    this->m_cLangPkg.add(L"en.ctUi_treeHeaderRx", std::wstring(L"Active clients"));
-    this->m_cLangPkg.add(L"de.ctUi_treeHeaderRx", std::wstring(L"Aktive Clients"));
+    LANG_ENTRY("ctUi_treeHeaderRx",
+        u8"Active clients",
+        u8"Aktive Clients"),
 
-    // ctUi_treeHeaderState
-    this->m_cLangPkg.add(L"en.ctUi_treeHeaderState", std::wstring(L"State"));
-    this->m_cLangPkg.add(L"de.ctUi_treeHeaderState", std::wstring(L"Status"));
+    LANG_ENTRY("ctUi_treeHeaderState",
+        u8"State",
+        u8"Status"),
 
-    // ctUi_WhatIsTreeItem
-    this->m_cLangPkg.add(L"en.ctUi_WhatIsTreeItem", std::wstring(L"This list shows all clients that can be reached at this frequency. Under <b>State</b> you can find the actual Mode that is used by the client."));
-    this->m_cLangPkg.add(L"de.ctUi_WhatIsTreeItem", std::wstring(L"In dieser Liste werden die gerade auf dieser Frequenz <b>Aktiven Clients</b> angezeigt. Unter <b>Status</b> wird der vom jeweiligen Client gerade verwendete Betriebsmodus angezeigt."));
+    LANG_ENTRY("ctUi_WhatIsTreeItem",
+        u8"This list shows all clients that can be reached at this frequency. Under <b>State</b> you can find the actual Mode that is used by the client.",
+        u8"In dieser Liste werden die gerade auf dieser Frequenz <b>Aktiven Clients</b> angezeigt. Unter <b>Status</b> wird der vom jeweiligen Client gerade verwendete Betriebsmodus angezeigt."),
 
-    // ctUi_treeItemStateNone
-    this->m_cLangPkg.add(L"en.ctUi_treeItemStateNone", std::wstring(L""));
-    this->m_cLangPkg.add(L"de.ctUi_treeItemStateNone", std::wstring(L""));
+    LANG_ENTRY("ctUi_treeItemStateNone",
+        u8"",
+        u8""),
 
-    // ctUi_treeItemStateActive
-    this->m_cLangPkg.add(L"en.ctUi_treeItemStateActive", std::wstring(L"Active"));
-    this->m_cLangPkg.add(L"de.ctUi_treeItemStateActive", std::wstring(L"Aktiv"));
+    LANG_ENTRY("ctUi_treeItemStateActive",
+        u8"Active",
+        u8"Aktiv"),
 
-    // ctUi_treeItemStateMute
-    this->m_cLangPkg.add(L"en.ctUi_treeItemStateMute", std::wstring(L"Muted"));
-    this->m_cLangPkg.add(L"de.ctUi_treeItemStateMute", std::wstring(L"Muted"));
+    LANG_ENTRY("ctUi_treeItemStateMute",
+        u8"Muted",
+        u8"Muted"),
 
-    // ctUi_treeItemStateSquelch
-    this->m_cLangPkg.add(L"en.ctUi_treeItemStateSquelch", std::wstring(L"Squelch"));
-    this->m_cLangPkg.add(L"de.ctUi_treeItemStateSquelch", std::wstring(L"Squelch"));
+    LANG_ENTRY("ctUi_treeItemStateSquelch",
+        u8"Squelch",
+        u8"Squelch"),
 
-    // ctUi_treeItemStatePriority
-    this->m_cLangPkg.add(L"en.ctUi_treeItemStatePriority", std::wstring(L"Priority"));
-    this->m_cLangPkg.add(L"de.ctUi_treeItemStatePriority", std::wstring(L"Prioritt"));
+    LANG_ENTRY("ctUi_treeItemStatePriority",
+        u8"Priority",
+        u8"Priorität"),
 
-    // ctUi_treeItemStateError
-    this->m_cLangPkg.add(L"en.ctUi_treeItemStateError", std::wstring(L"Error"));
-    this->m_cLangPkg.add(L"de.ctUi_treeItemStateError", std::wstring(L"Fehler"));
+    LANG_ENTRY("ctUi_treeItemStateError",
+        u8"Error",
+        u8"Fehler"),
 
-    // ctUi_contextIgnore
-    this->m_cLangPkg.add(L"en.ctUi_contextIgnore", std::wstring(L"Ignore"));
-    this->m_cLangPkg.add(L"de.ctUi_contextIgnore", std::wstring(L"Ignorieren"));
+    LANG_ENTRY("ctUi_treeItemStateTalking",
+        u8"Talking",
+        u8"Spricht"),
 
-    // ctUi_contextIgnoreTool
-    this->m_cLangPkg.add(L"en.ctUi_contextIgnoreTool", std::wstring(L"Add selected channel to Ignore list"));
-    this->m_cLangPkg.add(L"de.ctUi_contextIgnoreTool", std::wstring(L"Fge selektierten Channel zur Ignorieren Liste hinzu"));
+    LANG_ENTRY("ctUi_treeItemStateWhisper",
+        u8"Whispering",
+        u8"Flüstert"),
 
-    // ctUi_contextFav
-    this->m_cLangPkg.add(L"en.ctUi_contextFav", std::wstring(L"Remove"));
-    this->m_cLangPkg.add(L"de.ctUi_contextFav", std::wstring(L"Entfernen"));
+    LANG_ENTRY("ctUi_treeItemStateTalkTime",
+        u8"%1 talking (%2 whisper), %3:%4 min",
+        u8"%1 sprechen (%2 flüstern), %3:%4 min"),
 
-    // ctUi_contextFavTool
-    this->m_cLangPkg.add(L"en.ctUi_contextFavTool", std::wstring(L"Remove selected channel from Favorite/Ignore list"));
-    this->m_cLangPkg.add(L"de.ctUi_contextFavTool", std::wstring(L"Entferne selektierten Channel von der Favoriten/Ignorieren Liste"));
+    LANG_ENTRY("ctUi_contextIgnore",
+        u8"Ignore",
+        u8"Ignorieren"),
 
+    LANG_ENTRY("ctUi_contextIgnoreTool",
+        u8"Add selected channel to Ignore list",
+        u8"Füge selektierten Channel zur Ignorieren Liste hinzu"),
 
-    // ctUi_Level
-    this->m_cLangPkg.add(L"en.ctUi_Level", std::wstring(L"Level "));
-    this->m_cLangPkg.add(L"de.ctUi_Level", std::wstring(L"Level "));
+    LANG_ENTRY("ctUi_contextFav",
+        u8"Remove",
+        u8"Entfernen"),
 
-    // ctUi_Ignore
-    this->m_cLangPkg.add(L"en.ctUi_Ignore", std::wstring(L"Ignored"));
-    this->m_cLangPkg.add(L"de.ctUi_Ignore", std::wstring(L"Ignoriert"));
+    LANG_ENTRY("ctUi_contextFavTool",
+        u8"Remove selected channel from Favorite/Ignore list",
+        u8"Entferne selektierten Channel von der Favoriten/Ignorieren Liste"),
 
-    // ctUi_SubChannel
-    this->m_cLangPkg.add(L"en.ctUi_SubChannel", std::wstring(L"Sub Channel"));
-    this->m_cLangPkg.add(L"de.ctUi_SubChannel", std::wstring(L"Sub Channel"));
+    LANG_ENTRY("ctUi_Level",
+        u8"Level ",
+        u8"Level "),
 
-    // ctUi_Favorite
-    this->m_cLangPkg.add(L"en.ctUi_Favorite", std::wstring(L"Favorite"));
-    this->m_cLangPkg.add(L"de.ctUi_Favorite", std::wstring(L"Favorit"));
+    LANG_ENTRY("ctUi_Ignore",
+        u8"Ignored",
+        u8"Ignoriert"),
 
-    // ctUi_NoChannel
-    this->m_cLangPkg.add(L"en.ctUi_NoChannel", std::wstring(L"No Channel found"));
-    this->m_cLangPkg.add(L"de.ctUi_NoChannel", std::wstring(L"Kein Channel gefunden"));
-}
+    LANG_ENTRY("ctUi_SubChannel",
+        u8"Sub Channel",
+        u8"Sub Channel"),
+
+    LANG_ENTRY("ctUi_Favorite",
+        u8"Favorite",
+        u8"Favorit"),
+
+    LANG_ENTRY("ctUi_NoChannel",
+        u8"No Channel found",
+        u8"Kein Channel gefunden"),
 
-/* ----------------------------------------------------------------------------
-* set all strings needed by about UI (called by constructor)
-*/
-void language_pkg::init_ui_about()
-{
     // About UI
     //-------------------------------------------------------------------------------------
 
-    // aUi_fmTitle
-    this->m_cLangPkg.add(L"en.aUi_fmTitle", std::wstring(L"About WhisperMaster2000"));
-    this->m_cLangPkg.add(L"de.aUi_fmTitle", std::wstring(L"ber WhisperMaster2000"));
+    LANG_ENTRY("aUi_fmTitle",
+        u8"About WhisperMaster2000",
+        u8"Über WhisperMaster2000"),
 
-    // aUi_Version
-    this->m_cLangPkg.add(L"en.aUi_Version", std::wstring(L"Version:"));
-    this->m_cLangPkg.add(L"de.aUi_Version", std::wstring(L"Version:"));
+    LANG_ENTRY("aUi_Version",
+        u8"Version:",
+        u8"Version:"),
 
-    // aUi_Author
-    this->m_cLangPkg.add(L"en.aUi_Author", std::wstring(L"Author:"));
-    this->m_cLangPkg.add(L"de.aUi_Author", std::wstring(L"Autor:"));
+    LANG_ENTRY("aUi_Author",
+        u8"Author:",
+        u8"Autor:"),
 
-    // aUi_GnuError
-    this->m_cLangPkg.add(L"en.aUi_GnuError", std::wstring(L"Something went wrong when trying to read \"./WhisperMaster2000/license_gpl_v3.txt\".\nPlease contact author for more information.\nOr download GNU GPL Version 3 from https://www.gnu.org/licenses/#GPL."));
-    this->m_cLangPkg.add(L"de.aUi_GnuError", std::wstring(L"Etwas ist beim laden von \"./WhisperMaster2000/license_gpl_v3.txt\" schief gegangen.\nBitte kontaktieren sie den Autor fr mehr informationen.\nOder laden sie die GNU GPL Version 3 von https://www.gnu.org/licenses/#GPL herrunter."));
-}
+    LANG_ENTRY("aUi_GnuError",
+        u8"Something went wrong when trying to read \"./WhisperMaster2000/license_gpl_v3.txt\".\nPlease contact author for more information.\nOr download GNU GPL Version 3 from https://www.gnu.org/licenses/#GPL.",
+        u8"Etwas ist beim laden von \"./WhisperMaster2000/license_gpl_v3.txt\" schief gegangen.\nBitte kontaktieren sie den Autor für mehr informationen.\nOder laden sie die GNU GPL Version 3 von https://www.gnu.org/licenses/#GPL herrunter."),
 
+    // Console commands
+    //-------------------------------------------------------------------------------------
+
+    LANG_ENTRY("cmd_LangpackDone",
+        u8"Language packs written to \"%s\".",
+        u8"Sprachpakete wurden nach \"%s\" geschrieben."),
+
+    LANG_ENTRY("cmd_LangpackErr",
+        u8"Could not write language packs to \"%s\".",
+        u8"Sprachpakete konnten nicht nach \"%s\" geschrieben werden."),
+
+    LANG_ENTRY("cmd_RecordStart",
+        u8"Recording plugin events to \"%s\".",
+        u8"Plugin-Ereignisse werden in \"%s\" aufgezeichnet."),
+
+    LANG_ENTRY("cmd_RecordStop",
+        u8"Recording stopped, %u events written to \"%s\".",
+        u8"Aufzeichnung beendet, %u Ereignisse in \"%s\" geschrieben."),
+
+    LANG_ENTRY("cmd_RecordErr",
+        u8"Could not write recording to \"%s\".",
+        u8"Aufzeichnung konnte nicht nach \"%s\" geschrieben werden."),
 
-/* ----------------------------------------------------------------------------
-* set all strings needed by error handling routines (called by constructor)
-*/
-void language_pkg::init_error_handler()
-{
     // general error messages
     //-------------------------------------------------------------------------------------
 
-    // error_ErrQueryChName
-    this->m_cLangPkg.add(L"en.error_ErrQueryChName", std::wstring(L"Error while querying channel name. [%s Error code : 0x%04X]"));
-    //this->m_cLangPkg.add(L"de.error_ErrQueryChName", std::wstring(L"Unbekannter Fehler beim zurcksetzen der whisperliste aufgetretten."));
-
-    // error_ErrCreateWhisper
-    this->m_cLangPkg.add(L"en.error_ErrCreateWhisper", std::wstring(L"Unknown error while creating whisperlist. [%s Error code : 0x%04X]"));
-    //this->m_cLangPkg.add(L"de.error_ErrCreateWhisper", std::wstring(L"Unbekannter Fehler beim zurcksetzen der whisperliste aufgetretten."));
+    LANG_ENTRY("error_ErrQueryChName",
+        u8"Error while querying channel name. [%s Error code : 0x%04X]",
+        nullptr),
 
+    LANG_ENTRY("error_ErrCreateWhisper",
+        u8"Unknown error while creating whisperlist. [%s Error code : 0x%04X]",
+        nullptr),
 
     // Error handler
     //-------------------------------------------------------------------------------------
 
-    // ErrUnknown
-    this->m_cLangPkg.add(L"en.ErrUnknown", std::wstring(L"An unknown error was detected in function %s. Please restart client!"));
-    //this->m_cLangPkg.add(L"de.ErrUnknown", std::wstring(L""));
+    LANG_ENTRY("ErrUnknown",
+        u8"An unknown error was detected in function %s. Please restart client!",
+        nullptr),
+
+    LANG_ENTRY("ErrStdUnknown",
+        u8"An unknown std::exception was detected in function %s. Please restart client! (%s)",
+        nullptr),
+
+    LANG_ENTRY("ErrBoostUnknown",
+        u8"An unknown boost::exception was detected in function %s. Please restart client! (%s)",
+        nullptr),
+
+    LANG_ENTRY("ErrExtUnknown",
+        u8"An unknown error was detected in external function %s. Please restart client!",
+        nullptr),
+
+    LANG_ENTRY("ErrExtMessageBox",
+        u8"There where errors on your last seasion with the WisperMaster2000. Please report the error messages to the developer.",
+        nullptr)
+};
+
+static constexpr size_t LANG_TABLE_SIZE = sizeof(s_acLangTable) / sizeof(s_acLangTable[0]);
+static constexpr size_t LANG_INDEX_SIZE = 512;  // power of 2, keep load factor below 50%
+static constexpr uint16_t LANG_INDEX_EMPTY = 0xFFFF;
+static_assert(LANG_TABLE_SIZE * 2 <= LANG_INDEX_SIZE, "language table grew too large, increase LANG_INDEX_SIZE");
+
+/* ----------------------------------------------------------------------------
+* open addressing hash index into s_acLangTable (built by the compiler)
+*/
+struct lang_index
+{
+    uint16_t anSlot[LANG_INDEX_SIZE];
+};
+
+static constexpr lang_index build_lang_index()
+{
+    lang_index cIndex = {};
+    for (size_t nSlot = 0; nSlot < LANG_INDEX_SIZE; nSlot++)
+    {
+        cIndex.anSlot[nSlot] = LANG_INDEX_EMPTY;
+    }
+
+    for (size_t nEntry = 0; nEntry < LANG_TABLE_SIZE; nEntry++)
+    {
+        size_t nSlot = s_acLangTable[nEntry].nHash & (LANG_INDEX_SIZE - 1);
+        while (cIndex.anSlot[nSlot] != LANG_INDEX_EMPTY)
+        {
+            nSlot = (nSlot + 1) & (LANG_INDEX_SIZE - 1);
+        }
+        cIndex.anSlot[nSlot] = (uint16_t)nEntry;
+    }
+    return cIndex;
+}
+
+static constexpr lang_index s_cLangIndex = build_lang_index();
+
+/* ----------------------------------------------------------------------------
+* texts of one language with english fallback already resolved (index = table row)
+*/
+struct lang_texts
+{
+    const char* asText[LANG_TABLE_SIZE];
+};
+
+static constexpr lang_texts build_lang_texts(eLanguage eLang)
+{
+    lang_texts cTexts = {};
+    for (size_t nEntry = 0; nEntry < LANG_TABLE_SIZE; nEntry++)
+    {
+        const char* sText = s_acLangTable[nEntry].asText[eLang];
+        cTexts.asText[nEntry] = (sText != nullptr) ? sText : s_acLangTable[nEntry].asText[LANGUAGE_EN];
+    }
+    return cTexts;
+}
+
+static constexpr lang_texts s_acLangTexts[LANGUAGE_COUNT] =
+{
+    build_lang_texts(LANGUAGE_EN),
+    build_lang_texts(LANGUAGE_DE)
+};
 
-    // ErrStdUnknown
-    this->m_cLangPkg.add(L"en.ErrStdUnknown", std::wstring(L"An unknown std::exception was detected in function %s. Please restart client! (%s)"));
-    //this->m_cLangPkg.add(L"de.ErrStdUnknown", std::wstring(L""));
+static const char* const s_asLanguageName[LANGUAGE_COUNT] = { "en", "de" };
 
-    // ErrBoostUnknown
-    this->m_cLangPkg.add(L"en.ErrBoostUnknown", std::wstring(L"An unknown boost::exception was detected in function %s. Please restart client! (%s)"));
-    //this->m_cLangPkg.add(L"de.ErrBoostUnknown", std::wstring(L""));
+/* ----------------------------------------------------------------------------
+* external language packs (process wide)
+*  - a pack is mapped the first time its language gets selected
+*  - english is only mapped if the selected pack misses a string
+*  - resolved arrays are never freed, pointers into them stay valid
+*/
+struct lang_file_state
+{
+    boost::mutex                cMutex;
+    std::string                 sPath;
+    language_file               acFile[LANGUAGE_COUNT];
+    bool                        abTried[LANGUAGE_COUNT] = {};
+    std::vector<const char*>    avTexts[LANGUAGE_COUNT];
+};
+
+static lang_file_state& get_lang_file_state()
+{
+    static lang_file_state s_cState;
+    return s_cState;
+}
 
-    // ErrExtUnknown
-    this->m_cLangPkg.add(L"en.ErrExtUnknown", std::wstring(L"An unknown error was detected in external function %s. Please restart client!"));
-    //this->m_cLangPkg.add(L"de.ErrExtUnknown", std::wstring(L""));
+static std::string get_lang_file_name(const std::string& sPath, eLanguage eLang)
+{
+    return sPath + std::string("lang_") + s_asLanguageName[eLang] + std::string(".wmlp");
+}
 
-    // ErrExtMessageBox
-    this->m_cLangPkg.add(L"en.ErrExtMessageBox", std::wstring(L"There where errors on your last seasion with the WisperMaster2000. Please report the error messages to the developer."));
-    //this->m_cLangPkg.add(L"de.ErrExtMessageBox", std::wstring(L""));
+static bool open_lang_file(lang_file_state& cState, eLanguage eLang)
+{
+    if (!cState.abTried[eLang])
+    {
+        cState.abTried[eLang] = true;
+        cState.acFile[eLang].open(get_lang_file_name(cState.sPath, eLang));
+    }
+    return cState.acFile[eLang].is_open();
 }
 
+/* ----------------------------------------------------------------------------
+* arguments a text expects when it is used as format string: printf
+* conversions in order (flags, width and precision only count if given as
+* '*'), then the sorted place markers of QString::arg (%1 - %9)
+*/
+static std::string get_format_signature(const char* sText)
+{
+    std::string sConversion;
+    std::string sMarker;
+    for (const char* pcChar = sText; *pcChar != 0; pcChar++)
+    {
+        if (*pcChar != '%')
+            continue;
+        if (pcChar[1] == '%')
+        {
+            pcChar++;
+            continue;
+        }
+
+        const char* pcSpec = pcChar + 1;
+        std::string sSpec;
+        while ((*pcSpec != 0) && (strchr("-+ #0'", *pcSpec) != nullptr))
+            pcSpec++;
+        for (bool bPrecision = false; ; bPrecision = true)
+        {
+            if (*pcSpec == '*')
+            {
+                sSpec += '*';
+                pcSpec++;
+            }
+            while ((*pcSpec >= '0') && (*pcSpec <= '9'))
+                pcSpec++;
+            if (bPrecision || (*pcSpec != '.'))
+                break;
+            pcSpec++;
+        }
+        while ((*pcSpec != 0) && (strchr("hlLqjzt", *pcSpec) != nullptr))
+            sSpec += *pcSpec++;
+
+        // conversions of the same argument type are exchangeable (%x for %u)
+        const char* pcType = ((*pcSpec != 0) ? strchr("diouxXeEfFgGaAcspn", *pcSpec) : nullptr);
+        if (pcType != nullptr)
+        {
+            sConversion += sSpec + "ddttttffffffffcspn"[pcType - "diouxXeEfFgGaAcspn"] + ' ';
+            pcChar = pcSpec;
+        }
+        else if ((pcChar[1] >= '1') && (pcChar[1] <= '9'))
+        {
+            sMarker += pcChar[1];
+            pcChar++;
+        }
+    }
+    std::sort(sMarker.begin(), sMarker.end());
+    return sConversion + "| " + sMarker;
+}
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+language_pkg::language_pkg()
+{
+    this->m_pasTexts.store(s_acLangTexts[LANGUAGE_DE].asText);
+}
+
+/* ----------------------------------------------------------------------------
+* copy constructor
+*/
+language_pkg::language_pkg(const language_pkg& other)
+{
+    this->m_pasTexts.store(other.m_pasTexts.load());
+}
 
 /* ----------------------------------------------------------------------------
 * destructor
@@ -915,6 +1078,85 @@ language_pkg::~language_pkg()
 {
 }
 
+/* ----------------------------------------------------------------------------
+* copy selected language
+*/
+language_pkg& language_pkg::operator=(const language_pkg& other)
+{
+    this->m_pasTexts.store(other.m_pasTexts.load());
+    return *this;
+}
+
+/* ----------------------------------------------------------------------------
+* set folder of language packs (only the first call counts)
+*/
+void language_pkg::set_language_path(const std::string& sPath)
+{
+    lang_file_state& cState = get_lang_file_state();
+    boost::lock_guard<boost::mutex> lock(cState.cMutex);
+
+    if (cState.sPath.empty())
+    {
+        cState.sPath = sPath;
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* generate language packs of all languages from the built-in table
+*/
+bool language_pkg::export_language_files(const std::string& sPath)
+{
+    bool bRetVal = true;
+    for (int iLang = 0; iLang < LANGUAGE_COUNT; iLang++)
+    {
+        bRetVal &= language_file::write(get_lang_file_name(sPath, (eLanguage)iLang), s_asLanguageName[iLang], s_acLangTable, LANG_TABLE_SIZE, (eLanguage)iLang);
+    }
+    return bRetVal;
+}
+
+/* ----------------------------------------------------------------------------
+* get texts of a language, map language pack on first use (built-in table if no pack exists)
+*/
+const char* const* language_pkg::get_texts(eLanguage eLang)
+{
+    lang_file_state& cState = get_lang_file_state();
+    boost::lock_guard<boost::mutex> lock(cState.cMutex);
+
+    if (!cState.avTexts[eLang].empty())
+    {
+        return cState.avTexts[eLang].data();
+    }
+    if (cState.sPath.empty() || !open_lang_file(cState, eLang))
+    {
+        return s_acLangTexts[eLang].asText;
+    }
+
+    // texts are used as format strings: a text of a pack that expects other
+    // arguments than the built-in one is replaced by the built-in text
+    std::vector<const char*>& vTexts = cState.avTexts[eLang];
+    vTexts.resize(LANG_TABLE_SIZE);
+    for (size_t nEntry = 0; nEntry < LANG_TABLE_SIZE; nEntry++)
+    {
+        const lang_entry& cEntry = s_acLangTable[nEntry];
+        const char* sText = cState.acFile[eLang].find(cEntry.sKey, cEntry.nHash);
+
+        //...fall back language is always english
+        if (sText == nullptr && eLang != LANGUAGE_EN && open_lang_file(cState, LANGUAGE_EN))
+        {
+            sText = cState.acFile[LANGUAGE_EN].find(cEntry.sKey, cEntry.nHash);
+        }
+
+        const char* sBuiltIn = s_acLangTexts[eLang].asText[nEntry];
+        if ((sText != nullptr) && (get_format_signature(sText) != get_format_signature(sBuiltIn)))
+        {
+            printf("PLUGIN: language pack: \"%s\" expects other arguments, built-in text is used\n", cEntry.sKey);
+            sText = nullptr;
+        }
+        vTexts[nEntry] = (sText != nullptr) ? sText : sBuiltIn;
+    }
+    return vTexts.data();
+}
+
 /* ----------------------------------------------------------------------------
 * set actual language
 */
@@ -924,63 +1166,109 @@ void language_pkg::set_language(const char* sNewLanguage)
 }
 
 /* ----------------------------------------------------------------------------
-* set actual language
+* set actual language (only swaps the text table, safe while other threads translate)
 */
 void language_pkg::set_language(std::string sNewLanguage)
 {
     if (sNewLanguage.compare("de") == 0 || sNewLanguage.compare("german") == 0 || sNewLanguage.compare("deutsch") == 0)
     {
-        this->m_wLanguage = L"de";
+        this->m_pasTexts.store(get_texts(LANGUAGE_DE), std::memory_order_release);
     }
     else
     {
-        this->m_wLanguage = L"en";
+        this->m_pasTexts.store(get_texts(LANGUAGE_EN), std::memory_order_release);
     }
-
     return;
 }
 
+/* ----------------------------------------------------------------------------
+* get actual language
+*/
+std::string language_pkg::get_language()
+{
+    const char* const* pasTexts = this->m_pasTexts.load(std::memory_order_acquire);
+    lang_file_state& cState = get_lang_file_state();
+    boost::lock_guard<boost::mutex> lock(cState.cMutex);
+
+    bool bEnglish = (pasTexts == s_acLangTexts[LANGUAGE_EN].asText) || (!cState.avTexts[LANGUAGE_EN].empty() && pasTexts == cState.avTexts[LANGUAGE_EN].data());
+    return bEnglish ? std::string("en") : std::string("de");
+}
+
+/* ----------------------------------------------------------------------------
+* search string id in table, returns LANG_TABLE_SIZE if string id is unknown
+*/
+size_t language_pkg::find_entry(const char* sStringName)
+{
+    size_t nSlot = lang_hash(sStringName) & (LANG_INDEX_SIZE - 1);
+
+    while (s_cLangIndex.anSlot[nSlot] != LANG_INDEX_EMPTY)
+    {
+        size_t nEntry = s_cLangIndex.anSlot[nSlot];
+        if (strcmp(s_acLangTable[nEntry].sKey, sStringName) == 0)
+        {
+            return nEntry;
+        }
+        nSlot = (nSlot + 1) & (LANG_INDEX_SIZE - 1);
+    }
+    return LANG_TABLE_SIZE;
+}
 
 /* ----------------------------------------------------------------------------
 * get string in selected language
 */
 void language_pkg::translate(const char* sStringName, char* cStrBuffer, size_t nBuffSize)
 {
-    sprintf_s(cStrBuffer, (size_t)256, "%s", wtranslate(utf8_decode(std::string(sStringName))).c_str());
+    sprintf_s(cStrBuffer, nBuffSize, "%s", translate(sStringName));
 }
 
 /* ----------------------------------------------------------------------------
 * get string in selected language
+*  - returned pointer references the static table and stays valid forever
+*  - unknown ids return the id itself
 */
-std::string language_pkg::translate(const char* sStringName)
+const char* language_pkg::translate(const char* sStringName)
 {
-    return wtranslate(utf8_decode(std::string(sStringName)));
+    size_t nEntry = find_entry(sStringName);
+    if (nEntry >= LANG_TABLE_SIZE)
+    {
+        return sStringName;
+    }
+    return this->m_pasTexts.load(std::memory_order_acquire)[nEntry];
 }
 
-
 /* ----------------------------------------------------------------------------
-* get wstring in selected language
+* unknown wide string ids, narrowed once and kept until the process ends
 */
-std::string language_pkg::translate(const wchar_t* sStringName)
+static const char* get_unknown_id(const std::string& sStringName)
 {
-    return wtranslate(std::wstring(sStringName));
+    static boost::mutex s_cMutex;
+    static std::unordered_set<std::string> s_sUnknown;
+
+    boost::lock_guard<boost::mutex> lock(s_cMutex);
+    return s_sUnknown.insert(sStringName).first->c_str();
 }
 
 /* ----------------------------------------------------------------------------
-* get wstring in selected language
+* get string in selected language (wide string id)
+*  - unknown ids return the id itself (UTF-8), like translate(const char*)
 */
-std::string language_pkg::wtranslate(std::wstring sStringName)
+const char* language_pkg::translate(const wchar_t* sStringName)
 {
-    //try to use user prefered language, but...
-    std::wstring temp_lang = m_wLanguage;
-    temp_lang.append(L".");
-    temp_lang.append(sStringName);
-
-    //...fall back language is always english
-    std::wstring temp_default = L"en.";
-    temp_default.append(sStringName);
+    // string ids are plain ASCII, so they can be narrowed without conversion
+    char cKey[64];
+    size_t nIdx = 0;
+    for (; nIdx < sizeof(cKey) - 1 && sStringName[nIdx] > 0 && sStringName[nIdx] < 0x80; nIdx++)
+    {
+        cKey[nIdx] = (char)sStringName[nIdx];
+    }
+    cKey[nIdx] = 0;
 
-    return utf8_encode(this->m_cLangPkg.get(temp_lang, this->m_cLangPkg.get(temp_default, temp_lang)));
+    size_t nEntry = (sStringName[nIdx] == 0) ? find_entry(cKey) : LANG_TABLE_SIZE;
+    if (nEntry >= LANG_TABLE_SIZE)
+    {
+        return get_unknown_id((sStringName[nIdx] == 0) ? std::string(cKey) : utf8_encode(sStringName));
+    }
+    return this->m_pasTexts.load(std::memory_order_acquire)[nEntry];
 }
 
 /* ----------------------------------------------------------------------------
@@ -989,10 +1277,14 @@ std::string language_pkg::wtranslate(std::wstring sStringName)
 std::string language_pkg::utf8_encode(const std::wstring &wstr)
 {
     if (wstr.empty()) return std::string();
+#ifndef _WIN32
+    return std::wstring_convert<std::codecvt_utf8<wchar_t>>().to_bytes(wstr);
+#else
     int size_needed = WideCharToMultiByte(CP_UTF8, 0, &wstr[0], (int)wstr.size(), NULL, 0, NULL, NULL);
     std::string strTo(size_needed, 0);
     WideCharToMultiByte(CP_UTF8, 0, &wstr[0], (int)wstr.size(), &strTo[0], size_needed, NULL, NULL);
     return strTo;
+#endif
 }
 
 /* ----------------------------------------------------------------------------
@@ -1001,8 +1293,12 @@ std::string language_pkg::utf8_encode(const std::wstring &wstr)
 std::wstring language_pkg::utf8_decode(const std::string &str)
 {
     if (str.empty()) return std::wstring();
+#ifndef _WIN32
+    return std::wstring_convert<std::codecvt_utf8<wchar_t>>().from_bytes(str);
+#else
     int size_needed = MultiByteToWideChar(CP_UTF8, 0, &str[0], (int)str.size(), NULL, 0);
     std::wstring wstrTo(size_needed, 0);
     MultiByteToWideChar(CP_UTF8, 0, &str[0], (int)str.size(), &wstrTo[0], size_needed);
     return wstrTo;
+#endif
 }
\ No newline at end of file
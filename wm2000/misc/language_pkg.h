@@ -3,40 +3,71 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
-#include <boost/property_tree/ptree.hpp>
+#include <stdint.h>
+#include <string>
+#include <atomic>
+
+/* ----------------------------------------------------------------------------
+* supported languages, used as column index into the string table
+*/
+enum eLanguage
+{
+    LANGUAGE_EN = 0,
+    LANGUAGE_DE,
+    LANGUAGE_COUNT
+};
+
+/* ----------------------------------------------------------------------------
+* one row of the string table (key and UTF-8 text for every language)
+*/
+struct lang_entry
+{
+    uint32_t    nHash;
+    const char* sKey;
+    const char* asText[LANGUAGE_COUNT];
+};
+
+/* ----------------------------------------------------------------------------
+* FNV-1a hash of a string id, usable at compile time
+*/
+constexpr uint32_t lang_hash(const char* sKey)
+{
+    uint32_t nHash = 2166136261u;
+    while (*sKey != 0)
+    {
+        nHash = (nHash ^ (uint8_t)*sKey) * 16777619u;
+        sKey++;
+    }
+    return nHash;
+}
 
 class language_pkg
 {
 public:
     language_pkg();
+    language_pkg(const language_pkg& other);
     ~language_pkg();
 
-    std::string  translate(const char* sStringName);
+    language_pkg& operator=(const language_pkg& other);
+
+    const char*  translate(const char* sStringName);
     void         translate(const char* sStringName, char* cStrBuffer, size_t nBuffSize);
+    const char*  translate(const wchar_t* sStringName);
 
-    std::string  translate(const wchar_t* sStringName);
-    std::string  wtranslate(std::wstring sStringName);
     std::string  utf8_encode(const std::wstring &wstr);
     std::wstring utf8_decode(const std::string &str);
 
     void         set_language(const char* sNewLanguage);
     void         set_language(std::string sNewLanguage);
-    std::string  get_language() { return utf8_encode(m_wLanguage); };
+    std::string  get_language();
+
+    static void  set_language_path(const std::string& sPath);
+    static bool  export_language_files(const std::string& sPath);
 
 protected:
-    void         init_base();
-    void         init_plugin_para_chk();
-    void         init_plugin_hotkey();
-    void         init_plugin_menu();
-    void         init_plugin_info();
-    void         init_ui_main();
-    void         init_ui_freq();
-    void         init_ui_client_tree();
-    void         init_ui_about();
-    void         init_error_handler();
+    size_t       find_entry(const char* sStringName);
+    static const char* const* get_texts(eLanguage eLang);
 
 private:
-    std::wstring                 m_wLanguage;
-    boost::property_tree::wptree m_cLangPkg;
+    std::atomic<const char* const*> m_pasTexts;   // resolved texts of the selected language (index = table row)
 };
-
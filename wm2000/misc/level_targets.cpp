@@ -0,0 +1,99 @@
+#include "misc/level_targets.h"
+
+#if USE_CALL_STACK
+#define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
+#else
+#define CALL_STACK
+#endif
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+level_targets::level_targets()
+{
+    this->m_pcChannelFilter = nullptr;
+    this->m_pcConfigData    = nullptr;
+    for (int ii = 0; ii < REAL_MAXNUMPROFILES; ii++)
+        this->m_acTarget[ii].bIsValid = false;
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+level_targets::~level_targets()
+{
+}
+
+/* ----------------------------------------------------------------------------
+* set interfaces
+*/
+void level_targets::init(channel_filter *pcChannelFilter, config_container *pcConfigData)
+{
+    this->m_pcChannelFilter = pcChannelFilter;
+    this->m_pcConfigData    = pcConfigData;
+    for (int ii = 0; ii < REAL_MAXNUMPROFILES; ii++)
+        this->m_acTarget[ii].bIsValid = false;
+}
+
+/* ----------------------------------------------------------------------------
+* build the lists of all level profiles for a new own channel
+*/
+void level_targets::rebuild(uint64 nMyChannelID, uint32_t nChannelGeneration)
+{
+    CALL_STACK
+    if ((this->m_pcChannelFilter == nullptr) || (this->m_pcConfigData == nullptr))
+        return;
+
+    uint32_t nConfigGeneration = this->m_pcConfigData->s_get_Generation();
+    for (int ii = 0; (ii < this->m_pcConfigData->s_get_MaxNumProfiles()) && (ii < REAL_MAXNUMPROFILES); ii++)
+    {
+        if (this->m_pcConfigData->s_get_ProfileType(ii) != PROFILE_LEVEL)
+            continue;
+
+        build(this->m_acTarget[ii], nMyChannelID, this->m_pcConfigData->s_get_MinChLevel(ii), this->m_pcConfigData->s_get_MaxChLevel(ii),
+            this->m_pcConfigData->s_get_UseIgnoreListTx(ii), nChannelGeneration, nConfigGeneration);
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* cached list of one profile, rebuilt if anything of the key changed
+*/
+const uint64* level_targets::get(int iProfile, uint64 nMyChannelID, size_t nMinChLevel, size_t nMaxChLevel, bool bCheckIgnore, uint32_t nChannelGeneration)
+{
+    if ((iProfile < 0) || (iProfile >= REAL_MAXNUMPROFILES) || (this->m_pcChannelFilter == nullptr) || (this->m_pcConfigData == nullptr))
+        return nullptr;
+
+    level_target& cTarget = this->m_acTarget[iProfile];
+    uint32_t nConfigGeneration = this->m_pcConfigData->s_get_Generation();
+    if (!cTarget.bIsValid || (cTarget.nMyChannelID != nMyChannelID) || (cTarget.nMinChLevel != nMinChLevel) || (cTarget.nMaxChLevel != nMaxChLevel) ||
+        (cTarget.bCheckIgnore != bCheckIgnore) || (cTarget.nChannelGeneration != nChannelGeneration) || (cTarget.nConfigGeneration != nConfigGeneration))
+    {
+        build(cTarget, nMyChannelID, nMinChLevel, nMaxChLevel, bCheckIgnore, nChannelGeneration, nConfigGeneration);
+    }
+
+    return cTarget.vChannel.empty() ? nullptr : cTarget.vChannel.data();
+}
+
+/* ----------------------------------------------------------------------------
+* filter the channel list of one profile
+*/
+void level_targets::build(level_target& cTarget, uint64 nMyChannelID, size_t nMinChLevel, size_t nMaxChLevel, bool bCheckIgnore, uint32_t nChannelGeneration, uint32_t nConfigGeneration)
+{
+    cTarget.vChannel.clear();
+    uint64 *pnFilteredList = this->m_pcChannelFilter->get_channel_list_from_level(nMyChannelID, nMinChLevel, nMaxChLevel, bCheckIgnore);
+    if (pnFilteredList != nullptr)
+    {
+        for (int jj = 0; pnFilteredList[jj] != 0; jj++)
+            cTarget.vChannel.push_back(pnFilteredList[jj]);
+        cTarget.vChannel.push_back(0);
+        this->m_pcChannelFilter->free_channel_list(pnFilteredList);
+    }
+
+    cTarget.bIsValid            = true;
+    cTarget.nMyChannelID        = nMyChannelID;
+    cTarget.nMinChLevel         = nMinChLevel;
+    cTarget.nMaxChLevel         = nMaxChLevel;
+    cTarget.bCheckIgnore        = bCheckIgnore;
+    cTarget.nChannelGeneration  = nChannelGeneration;
+    cTarget.nConfigGeneration   = nConfigGeneration;
+}
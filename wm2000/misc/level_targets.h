@@ -0,0 +1,56 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <vector>
+#include "misc/config_container.h"
+#include "misc/channel_filter.h"
+#include "misc/error_handler.h"
+
+/* ----------------------------------------------------------------------------
+* filtered channel list of one level profile and the state it was built for
+*/
+struct level_target
+{
+    bool                bIsValid;           // entry was built at least once
+    uint64              nMyChannelID;       // own channel the levels are relative to
+    size_t              nMinChLevel;
+    size_t              nMaxChLevel;
+    bool                bCheckIgnore;
+    uint32_t            nChannelGeneration; // channel tree the list was built from
+    uint32_t            nConfigGeneration;  // config the list was built from (ignore list)
+    std::vector<uint64> vChannel;           // 0 terminated, empty if own channel is out of range
+};
+
+/* ----------------------------------------------------------------------------
+* whisper targets of all level profiles
+*
+* level profiles are relative to the own channel, so the lists only change if
+* I move, the channel tree changes or the config changes. rebuild() is called
+* by the event processing after an own move, the hotkey only checks the key of
+* its entry and rebuilds it on a miss. Not thread safe, events and hotkeys of a
+* server are serialized by the caller.
+*/
+class level_targets
+{
+public:
+    level_targets();
+    ~level_targets();
+
+    void                init(channel_filter *pcChannelFilter, config_container *pcConfigData);
+    void                rebuild(uint64 nMyChannelID, uint32_t nChannelGeneration);    // all level profiles of the config
+
+    // 0 terminated channel list of profile iProfile (0 based), nullptr if the own channel is out of range
+    // the pointer is valid until the next call
+    const uint64*       get(int iProfile, uint64 nMyChannelID, size_t nMinChLevel, size_t nMaxChLevel, bool bCheckIgnore, uint32_t nChannelGeneration);
+
+protected:
+    void                build(level_target& cTarget, uint64 nMyChannelID, size_t nMinChLevel, size_t nMaxChLevel, bool bCheckIgnore, uint32_t nChannelGeneration, uint32_t nConfigGeneration);
+
+private:
+    channel_filter     *m_pcChannelFilter;      // link to channel filter of server
+    config_container   *m_pcConfigData;         // configuration container
+    error_handler       m_cErrHandler;          // link to error handler
+
+    level_target        m_acTarget[REAL_MAXNUMPROFILES];
+};
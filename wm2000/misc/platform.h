@@ -0,0 +1,75 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+/* ----------------------------------------------------------------------------
+* MSVC runtime functions used in base/ and misc/
+*
+* the plugin is built with MSVC only, the headless build (see CMakeLists.txt)
+* maps the few secure CRT functions to the C library. On Windows this file
+* does nothing.
+*/
+#ifndef _WIN32
+#include <unistd.h>
+
+#ifndef __FUNCSIG__
+#define __FUNCSIG__ __PRETTY_FUNCTION__
+#endif
+
+#define _TRUNCATE   ((size_t)-1)
+#define _access     access
+#define fprintf_s   fprintf
+#define sscanf_s    sscanf          // "%s" needs a width in the format, the size argument is ignored
+
+inline int sprintf_s(char *pcBuffer, size_t nBuffSize, const char *pcFormat, ...)
+{
+    va_list args;
+    va_start(args, pcFormat);
+    int iResult = vsnprintf(pcBuffer, nBuffSize, pcFormat, args);
+    va_end(args);
+    return iResult;
+}
+
+template <size_t nBuffSize>
+inline int sprintf_s(char (&pcBuffer)[nBuffSize], const char *pcFormat, ...)
+{
+    va_list args;
+    va_start(args, pcFormat);
+    int iResult = vsnprintf(pcBuffer, nBuffSize, pcFormat, args);
+    va_end(args);
+    return iResult;
+}
+
+inline int strcpy_s(char *pcDest, size_t nDestSize, const char *pcSource)
+{
+    if ((pcDest == nullptr) || (nDestSize == 0))
+        return 1;
+    strncpy(pcDest, pcSource, nDestSize - 1);
+    pcDest[nDestSize - 1] = '\0';
+    return 0;
+}
+
+inline int strncpy_s(char *pcDest, size_t nDestSize, const char *pcSource, size_t nCount)
+{
+    if ((pcDest == nullptr) || (nDestSize == 0))
+        return 1;
+    size_t nLength = strnlen(pcSource, (nCount < nDestSize - 1) ? nCount : nDestSize - 1);
+    memcpy(pcDest, pcSource, nLength);
+    pcDest[nLength] = '\0';
+    return 0;
+}
+
+inline int fopen_s(FILE **ppFile, const char *pcFileName, const char *pcMode)
+{
+    *ppFile = fopen(pcFileName, pcMode);
+    return (*ppFile == nullptr) ? 1 : 0;
+}
+
+inline int localtime_s(struct tm *pstTime, const time_t *pnTime)
+{
+    return (localtime_r(pnTime, pstTime) == nullptr) ? 1 : 0;
+}
+#endif
@@ -0,0 +1,218 @@
+#include "misc/profile_membership.h"
+
+#if USE_CALL_STACK
+#define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
+#else
+#define CALL_STACK
+#endif
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+profile_membership::profile_membership()
+{
+    this->m_pcChannelFilter     = nullptr;
+    this->m_pcConfigData        = nullptr;
+    this->m_bIsValid            = false;
+    this->m_nChannelGeneration  = 0;
+    this->m_nMyChannelID        = 0;
+    this->m_nConfigGeneration   = 0;
+    this->m_nIgnoreTx           = 0;
+    for (int ii = 0; ii <= PROFILE_AUDIO; ii++)
+        this->m_anType[ii] = 0;
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+profile_membership::~profile_membership()
+{
+}
+
+/* ----------------------------------------------------------------------------
+* set interfaces
+*/
+void profile_membership::init(channel_filter *pcChannelFilter, config_container *pcConfigData)
+{
+    this->m_pcChannelFilter = pcChannelFilter;
+    this->m_pcConfigData    = pcConfigData;
+    this->m_bIsValid        = false;
+}
+
+/* ----------------------------------------------------------------------------
+* rebuild all sets, if channels or config changed since last call, or my
+* channel changed and a level profile exists
+*/
+void profile_membership::update(uint32_t nChannelGeneration, uint64 nMyChannelID, uint32_t nConfigGeneration)
+{
+    boost::lock_guard<boost::mutex> lock(this->m_cMembershipMutex);
+
+    if (this->m_bIsValid && (this->m_nChannelGeneration == nChannelGeneration) && (this->m_nConfigGeneration == nConfigGeneration) &&
+        ((this->m_nMyChannelID == nMyChannelID) || (this->m_anType[PROFILE_LEVEL] == 0)))
+        return;
+
+    rebuild();
+    this->m_bIsValid            = true;
+    this->m_nChannelGeneration  = nChannelGeneration;
+    this->m_nMyChannelID        = nMyChannelID;
+    this->m_nConfigGeneration   = nConfigGeneration;
+}
+
+/* ----------------------------------------------------------------------------
+* filter channel lists of all profiles (one filter call per profile)
+*/
+void profile_membership::rebuild()
+{
+    CALL_STACK
+    this->m_mChannel.clear();
+    this->m_mFreq.clear();
+    this->m_mName.clear();
+    this->m_mLevel.clear();
+    this->m_nIgnoreTx = 0;
+    for (int ii = 0; ii <= PROFILE_AUDIO; ii++)
+        this->m_anType[ii] = 0;
+    for (int ii = 0; ii < REAL_MAXNUMPROFILES; ii++)
+        this->m_avChannel[ii].clear();
+
+    if ((this->m_pcChannelFilter == nullptr) || (this->m_pcConfigData == nullptr))
+        return;
+
+    // mark channels of ignore list
+    uint64 *pnFilteredList = this->m_pcChannelFilter->filter_channel_from_list(this->m_pcConfigData->s_get_IgnoreList(), false, false);
+    if (pnFilteredList != nullptr)
+    {
+        for (int jj = 0; pnFilteredList[jj] != 0; jj++)
+            this->m_mChannel[pnFilteredList[jj]].bIgnored = true;
+        this->m_pcChannelFilter->free_channel_list(pnFilteredList);
+    }
+
+    for (int ii = 0; ii < this->m_pcConfigData->s_get_MaxNumProfiles(); ii++)
+    {
+        eProfileType eType = this->m_pcConfigData->s_get_ProfileType(ii);
+        if ((eType >= PROFILE_OFF) && (eType <= PROFILE_AUDIO))
+            this->m_anType[eType] |= PROFILE_BIT(ii);
+
+        if (this->m_pcConfigData->s_get_UseIgnoreListTx(ii))
+            this->m_nIgnoreTx |= PROFILE_BIT(ii);
+
+        switch (eType)
+        {
+        case PROFILE_FAVORITE:
+        case PROFILE_AUDIO:
+            if (this->m_pcConfigData->s_get_UseSubChOfFav(ii))
+            {
+                // all channels incl. sub channels are marked as sub channel first, the channels of the list itself are reset afterwards
+                add_channels(ii, this->m_pcChannelFilter->filter_channel_from_list(this->m_pcConfigData->s_get_FavoriteList(ii), true, false), true);
+                pnFilteredList = this->m_pcChannelFilter->filter_channel_from_list(this->m_pcConfigData->s_get_FavoriteList(ii), false, false);
+                if (pnFilteredList != nullptr)
+                {
+                    for (int jj = 0; pnFilteredList[jj] != 0; jj++)
+                        this->m_mChannel[pnFilteredList[jj]].nSubChannel &= ~PROFILE_BIT(ii);
+                    this->m_pcChannelFilter->free_channel_list(pnFilteredList);
+                }
+            }
+            else
+                add_channels(ii, this->m_pcChannelFilter->filter_channel_from_list(this->m_pcConfigData->s_get_FavoriteList(ii), false, false), false);
+            break;
+        case PROFILE_LEVEL:
+            add_channels(ii, this->m_pcChannelFilter->filter_channel_from_level(this->m_pcConfigData->s_get_MinChLevel(ii), this->m_pcConfigData->s_get_MaxChLevel(ii), false), false);
+            break;
+        case PROFILE_FREQUENCY:
+            // frequency 0 is never part of a client frequency list
+            if (this->m_pcConfigData->s_get_ActiveFreq(ii) > 0)
+                this->m_mFreq[this->m_pcConfigData->s_get_ActiveFreq(ii)] |= PROFILE_BIT(ii);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* add filtered channel list to profile, list is freed afterwards
+*/
+void profile_membership::add_channels(int iProfile, uint64 *pnChannelList, bool bSubChannel)
+{
+    if (pnChannelList == nullptr)
+        return;
+
+    for (int jj = 0; pnChannelList[jj] != 0; jj++)
+    {
+        channel_membership& cEntry = this->m_mChannel[pnChannelList[jj]];
+        cEntry.nProfiles |= PROFILE_BIT(iProfile);
+        if (bSubChannel)
+            cEntry.nSubChannel |= PROFILE_BIT(iProfile);
+        this->m_avChannel[iProfile].push_back(pnChannelList[jj]);
+    }
+    this->m_pcChannelFilter->free_channel_list(pnChannelList);
+}
+
+/* ----------------------------------------------------------------------------
+* lookup functions, call update() first
+*/
+channel_membership profile_membership::get_channel(uint64 nChannelID)
+{
+    boost::lock_guard<boost::mutex> lock(this->m_cMembershipMutex);
+
+    std::unordered_map<uint64, channel_membership>::iterator it = this->m_mChannel.find(nChannelID);
+    if (it == this->m_mChannel.end())
+        return channel_membership();
+    return it->second;
+}
+
+profile_mask profile_membership::get_freq_profiles(int iFreq)
+{
+    boost::lock_guard<boost::mutex> lock(this->m_cMembershipMutex);
+
+    std::unordered_map<int, profile_mask>::iterator it = this->m_mFreq.find(iFreq);
+    return (it == this->m_mFreq.end()) ? 0 : it->second;
+}
+
+profile_mask profile_membership::get_ignore_tx_profiles()
+{
+    boost::lock_guard<boost::mutex> lock(this->m_cMembershipMutex);
+    return this->m_nIgnoreTx;
+}
+
+profile_mask profile_membership::get_type_profiles(eProfileType eType)
+{
+    boost::lock_guard<boost::mutex> lock(this->m_cMembershipMutex);
+    if ((eType < PROFILE_OFF) || (eType > PROFILE_AUDIO))
+        return 0;
+    return this->m_anType[eType];
+}
+
+std::vector<uint64> profile_membership::get_profile_channels(int iProfile)
+{
+    boost::lock_guard<boost::mutex> lock(this->m_cMembershipMutex);
+    if ((iProfile < 0) || (iProfile >= REAL_MAXNUMPROFILES))
+        return std::vector<uint64>();
+    return this->m_avChannel[iProfile];
+}
+
+/* ----------------------------------------------------------------------------
+* channel name and level, read from TS3 on first use only
+*/
+std::string profile_membership::get_channel_name(uint64 nChannelID)
+{
+    boost::lock_guard<boost::mutex> lock(this->m_cMembershipMutex);
+
+    std::unordered_map<uint64, std::string>::iterator it = this->m_mName.find(nChannelID);
+    if (it != this->m_mName.end())
+        return it->second;
+    if (this->m_pcChannelFilter == nullptr)
+        return std::string();
+    return this->m_mName[nChannelID] = this->m_pcChannelFilter->get_channel_name(nChannelID);
+}
+
+size_t profile_membership::get_channel_level(uint64 nChannelID)
+{
+    boost::lock_guard<boost::mutex> lock(this->m_cMembershipMutex);
+
+    std::unordered_map<uint64, size_t>::iterator it = this->m_mLevel.find(nChannelID);
+    if (it != this->m_mLevel.end())
+        return it->second;
+    if (this->m_pcChannelFilter == nullptr)
+        return 0;
+    return this->m_mLevel[nChannelID] = this->m_pcChannelFilter->get_channel_level(nChannelID);
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <boost/thread.hpp>
+#include "misc/config_container.h"
+#include "misc/channel_filter.h"
+#include "misc/error_handler.h"
+
+/* ----------------------------------------------------------------------------
+* set of profiles, bit ii is set if profile ii is part of the set
+*/
+typedef uint32_t profile_mask;
+static_assert(REAL_MAXNUMPROFILES <= 32, "profile_mask is too small for REAL_MAXNUMPROFILES");
+
+#define PROFILE_BIT(ii) ((profile_mask)1 << (ii))
+
+/* ----------------------------------------------------------------------------
+* profiles a channel belongs to
+*/
+struct channel_membership
+{
+    profile_mask    nProfiles;      // level/favorite/audio profiles that contain the channel
+    profile_mask    nSubChannel;    // favorite/audio profiles that contain the channel as sub channel only
+    bool            bIgnored;       // channel is part of the ignore list
+};
+
+/* ----------------------------------------------------------------------------
+* answers "which profiles contain this channel / frequency" for all profiles at once
+*
+* the channel lists of all profiles are filtered once after a channel or config
+* change (see update), every following lookup is one hash lookup and some bit
+* tests. Moves of other clients don't change the lists, an own move only
+* matters if a level profile exists.
+*/
+class profile_membership
+{
+public:
+    profile_membership();
+    ~profile_membership();
+
+    void                init(channel_filter *pcChannelFilter, config_container *pcConfigData);
+    void                update(uint32_t nChannelGeneration, uint64 nMyChannelID, uint32_t nConfigGeneration);
+
+    channel_membership  get_channel(uint64 nChannelID);
+    profile_mask        get_freq_profiles(int iFreq);       // frequency profiles using iFreq
+    profile_mask        get_ignore_tx_profiles();           // profiles that use the ignore list for Tx
+    profile_mask        get_type_profiles(eProfileType eType);
+
+    std::vector<uint64> get_profile_channels(int iProfile);      // filtered channels of a level/favorite/audio profile, same order as hotkey
+    std::string         get_channel_name(uint64 nChannelID);    // cached until next rebuild
+    size_t              get_channel_level(uint64 nChannelID);   // cached until next rebuild
+
+protected:
+    void                rebuild();
+    void                add_channels(int iProfile, uint64 *pnChannelList, bool bSubChannel);
+
+private:
+    channel_filter     *m_pcChannelFilter;      // link to channel filter of server
+    config_container   *m_pcConfigData;         // configuration container
+    error_handler       m_cErrHandler;          // link to error handler
+
+    boost::mutex        m_cMembershipMutex;     // lookups and rebuild from different threads
+    bool                m_bIsValid;             // data were built at least once
+    uint32_t            m_nChannelGeneration;   // generation of channels used for last rebuild
+    uint64              m_nMyChannelID;         // own channel used for last rebuild (level profiles)
+    uint32_t            m_nConfigGeneration;    // generation of config used for last rebuild
+
+    std::unordered_map<uint64, channel_membership>  m_mChannel;    // all channels that are part of any list
+    std::unordered_map<int, profile_mask>           m_mFreq;       // active frequency => frequency profiles
+    profile_mask        m_nIgnoreTx;            // profiles that use the ignore list for Tx
+    profile_mask        m_anType[PROFILE_AUDIO + 1]; // profiles per type
+    std::vector<uint64> m_avChannel[REAL_MAXNUMPROFILES]; // filtered channels per profile
+
+    std::unordered_map<uint64, std::string>         m_mName;       // channel names read so far
+    std::unordered_map<uint64, size_t>              m_mLevel;      // channel levels read so far
+};
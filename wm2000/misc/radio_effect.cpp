@@ -0,0 +1,146 @@
+#include "misc/radio_effect.h"
+#include "misc/gain_kernel.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#if GAIN_KERNEL_X86
+#include <emmintrin.h>
+#endif
+
+#define RADIO_CENTER_FREQ       1000.0      // band-pass center (Hz)
+#define RADIO_Q                 0.5         // => -3 dB at about 400 Hz and 2.4 kHz
+#define RADIO_DRIVE             2.0f        // boost into the clipper
+#define RADIO_OUTPUT            0.5f        // level after the clipper (full scale = 1), unity gain for quiet voice
+#define RADIO_GATE_THRESHOLD    0.01f       // block peak of the band (-40 dBFS)
+#define RADIO_GATE_FLOOR        0.1f        // gain of a closed gate (-20 dB)
+#define RADIO_GATE_RELEASE      0.93f       // per block, closed after about 45 ms
+#define RADIO_DENORMAL          1e-20f      // filter state below is flushed
+
+/* ----------------------------------------------------------------------------
+* constructor, coefficients for 48 kHz (RBJ band-pass, 0 dB peak gain)
+*/
+radio_effect::radio_effect()
+{
+    const double dPi    = 3.14159265358979323846;
+    double dOmega       = 2.0 * dPi * RADIO_CENTER_FREQ / RADIO_SAMPLE_RATE;
+    double dAlpha       = sin(dOmega) / (2.0 * RADIO_Q);
+    double dA0          = 1.0 + dAlpha;
+    this->m_fB0         = (float)(dAlpha / dA0);
+    this->m_fA1         = (float)(-2.0 * cos(dOmega) / dA0);
+    this->m_fA2         = (float)((1.0 - dAlpha) / dA0);
+}
+
+/* ----------------------------------------------------------------------------
+* state for a new owner, gate open to not cut the first syllable
+*/
+void radio_effect::reset(radio_state& cState, anyID nClientID)
+{
+    memset(&cState, 0, sizeof(cState));
+    cState.nClientID    = nClientID;
+    cState.fGate        = 1.0f;
+}
+
+/* ----------------------------------------------------------------------------
+* edit voice data in place (interleaved, iSampleCount samples per channel)
+*/
+void radio_effect::process(radio_state& cState, short *psSamples, int iSampleCount, int iChannels) const
+{
+    if ((psSamples == nullptr) || (iSampleCount <= 0) || (iChannels <= 0) || (iChannels > RADIO_MAX_CHANNELS))
+        return;
+
+    float afBuffer[RADIO_BLOCK_FRAMES * RADIO_MAX_CHANNELS];
+    for (int iFrame = 0; iFrame < iSampleCount; iFrame += RADIO_BLOCK_FRAMES)
+    {
+        int iFrames = std::min(RADIO_BLOCK_FRAMES, iSampleCount - iFrame);
+        short *psBlock = psSamples + (size_t)iFrame * iChannels;
+
+        float fPeak = 0.0f;
+        filter_block(cState, psBlock, afBuffer, iFrames, iChannels, fPeak);
+
+        // opens at once, closes slowly
+        float fGate = (fPeak >= RADIO_GATE_THRESHOLD) ? 1.0f : std::max(RADIO_GATE_FLOOR, cState.fGate * RADIO_GATE_RELEASE);
+        shape_block(afBuffer, psBlock, (size_t)iFrames * iChannels, cState.fGate, fGate);
+        cState.fGate = fGate;
+    }
+
+    // silence lets the filter state decay into denormals, which are slow
+    for (int iChannel = 0; iChannel < iChannels; iChannel++)
+    {
+        if (fabsf(cState.afZ1[iChannel]) < RADIO_DENORMAL) cState.afZ1[iChannel] = 0.0f;
+        if (fabsf(cState.afZ2[iChannel]) < RADIO_DENORMAL) cState.afZ2[iChannel] = 0.0f;
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* band-pass of one block into pfOut (full scale = 1), fPeak is the largest
+* filtered sample
+*/
+void radio_effect::filter_block(radio_state& cState, const short *psSamples, float *pfOut, int iFrames, int iChannels, float& fPeak) const
+{
+    const float fScale = 1.0f / 32768.0f;
+    int iSamples = iFrames * iChannels;
+    for (int iChannel = 0; iChannel < iChannels; iChannel++)
+    {
+        float fZ1 = cState.afZ1[iChannel];
+        float fZ2 = cState.afZ2[iChannel];
+        for (int ii = iChannel; ii < iSamples; ii += iChannels)
+        {
+            float fIn  = psSamples[ii] * fScale;
+            float fOut = this->m_fB0 * fIn + fZ1;
+            fZ1 = fZ2 - this->m_fA1 * fOut;
+            fZ2 = -this->m_fB0 * fIn - this->m_fA2 * fOut;
+            pfOut[ii] = fOut;
+            fPeak = std::max(fPeak, fabsf(fOut));
+        }
+        cState.afZ1[iChannel] = fZ1;
+        cState.afZ2[iChannel] = fZ2;
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* soft clipping (rational tanh approximation, exact 1 at 3), gate ramp and
+* conversion back to 16 bit
+*/
+static inline float shape_sample(float fIn, float fGate)
+{
+    float fValue = std::min(3.0f, std::max(-3.0f, fIn * RADIO_DRIVE));
+    float fSquare = fValue * fValue;
+    float fOut = fValue * (27.0f + fSquare) / (27.0f + 9.0f * fSquare) * fGate * (RADIO_OUTPUT * 32767.0f);
+    return std::min(32767.0f, std::max(-32768.0f, fOut));
+}
+
+#if GAIN_KERNEL_X86
+static inline __m128 shape_sse2(__m128 xIn, __m128 xGate)
+{
+    const __m128 xLimit = _mm_set1_ps(3.0f);
+    const __m128 x27    = _mm_set1_ps(27.0f);
+    __m128 xValue  = _mm_mul_ps(xIn, _mm_set1_ps(RADIO_DRIVE));
+    xValue         = _mm_min_ps(xLimit, _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), xLimit), xValue));
+    __m128 xSquare = _mm_mul_ps(xValue, xValue);
+    __m128 xOut    = _mm_div_ps(_mm_mul_ps(xValue, _mm_add_ps(x27, xSquare)), _mm_add_ps(x27, _mm_mul_ps(_mm_set1_ps(9.0f), xSquare)));
+    return _mm_mul_ps(xOut, _mm_mul_ps(xGate, _mm_set1_ps(RADIO_OUTPUT * 32767.0f)));
+}
+#endif
+
+void radio_effect::shape_block(const float *pfIn, short *psSamples, size_t nSamples, float fStartGate, float fEndGate)
+{
+    float fStep = (fEndGate - fStartGate) / (float)nSamples;
+    size_t nPos = 0;
+
+#if GAIN_KERNEL_X86
+    // 8 samples per step, cvtps rounds to nearest, packs saturates
+    __m128 xGate = _mm_add_ps(_mm_set1_ps(fStartGate), _mm_mul_ps(_mm_set1_ps(fStep), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f)));
+    __m128 xStep = _mm_set1_ps(4.0f * fStep);
+    for (; nPos + 8 <= nSamples; nPos += 8)
+    {
+        __m128 xLow  = shape_sse2(_mm_loadu_ps(pfIn + nPos), xGate);
+        xGate = _mm_add_ps(xGate, xStep);
+        __m128 xHigh = shape_sse2(_mm_loadu_ps(pfIn + nPos + 4), xGate);
+        xGate = _mm_add_ps(xGate, xStep);
+        _mm_storeu_si128((__m128i*)(psSamples + nPos), _mm_packs_epi32(_mm_cvtps_epi32(xLow), _mm_cvtps_epi32(xHigh)));
+    }
+#endif
+
+    for (; nPos < nSamples; nPos++)
+        psSamples[nPos] = (short)lrintf(shape_sample(pfIn[nPos], fStartGate + fStep * (float)nPos));
+}
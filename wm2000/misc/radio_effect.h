@@ -0,0 +1,49 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "teamspeak/public_definitions.h"
+
+#define RADIO_SAMPLE_RATE       48000   // TS3 playback rate
+#define RADIO_MAX_CHANNELS      8       // buffers with more channels are not changed
+#define RADIO_BLOCK_FRAMES      64      // frames per block (gate decision, stack buffer)
+
+/* ----------------------------------------------------------------------------
+* state of the effect for one client, only used by the audio thread
+*/
+struct radio_state
+{
+    anyID       nClientID;
+    uint32_t    nLastUse;                       // LRU stamp of the owner, 0 => free
+    float       fGate;                          // gate gain at the end of the last block
+    float       afZ1[RADIO_MAX_CHANNELS];       // biquad state per channel (transposed direct form II)
+    float       afZ2[RADIO_MAX_CHANNELS];
+};
+
+/* ----------------------------------------------------------------------------
+* "radio" sound for voice received over a frequency
+*
+* band-pass biquad (about 400 Hz - 2.4 kHz), soft clipping of the boosted
+* signal and a light noise gate (-20 dB below about -40 dBFS). The buffer is
+* processed in blocks of RADIO_BLOCK_FRAMES on the stack, nothing is
+* allocated. The biquad is recursive and runs per channel, clipping, gate
+* and conversion back to 16 bit use SSE2.
+*/
+class radio_effect
+{
+public:
+    radio_effect();
+
+    static void         reset(radio_state& cState, anyID nClientID);
+    void                process(radio_state& cState, short *psSamples, int iSampleCount, int iChannels) const;
+
+protected:
+    void                filter_block(radio_state& cState, const short *psSamples, float *pfOut, int iFrames, int iChannels, float& fPeak) const;
+    static void         shape_block(const float *pfIn, short *psSamples, size_t nSamples, float fStartGate, float fEndGate);
+
+private:
+    float               m_fB0;                  // band-pass coefficients, b1 = 0 and b2 = -b0
+    float               m_fA1;
+    float               m_fA2;
+};
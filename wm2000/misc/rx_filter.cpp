@@ -0,0 +1,300 @@
+#include "misc/rx_filter.h"
+#include <string.h>
+
+#if USE_CALL_STACK
+#define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
+#else
+#define CALL_STACK
+#endif
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+rx_filter::rx_filter()
+{
+    this->m_pcClientFilter      = nullptr;
+    this->m_pcChannelFilter     = nullptr;
+    this->m_pcConfigData        = nullptr;
+    this->m_bIsValid            = false;
+    this->m_nConfigGeneration   = 0;
+    this->m_nChannelGeneration  = 0;
+    this->m_bUseIgnoreListRx    = false;
+    this->m_nPrioTalkers        = 0;
+    this->m_nRadioUse           = 0;
+    for (size_t ii = 0; ii < RX_FILTER_NUM_CLIENTS; ii++)
+    {
+        this->m_anClient[ii].store(0, std::memory_order_relaxed);
+        this->m_anGain[ii]      = GAIN_UNITY;
+        this->m_anRadioSlot[ii] = 0;
+    }
+    for (size_t ii = 0; ii < RX_RADIO_SLOTS; ii++)
+        radio_effect::reset(this->m_acRadio[ii], 0);
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+rx_filter::~rx_filter()
+{
+}
+
+/* ----------------------------------------------------------------------------
+* set interfaces
+*/
+void rx_filter::init(client_filter *pcClientFilter, channel_filter *pcChannelFilter, config_container *pcConfigData)
+{
+    this->m_pcClientFilter  = pcClientFilter;
+    this->m_pcChannelFilter = pcChannelFilter;
+    this->m_pcConfigData    = pcConfigData;
+    this->m_bIsValid        = false;
+}
+
+/* ----------------------------------------------------------------------------
+* update flags after client events, rebuild all after config or channel changes
+*/
+void rx_filter::update(const std::vector<client_update> *pvUpdate, uint32_t nChannelGeneration)
+{
+    if ((this->m_pcClientFilter == nullptr) || (this->m_pcChannelFilter == nullptr) || (this->m_pcConfigData == nullptr))
+        return;
+
+    // channel changes only matter for the ignore list
+    // a rebuild sets the flags of all clients
+    bool bChannelChanged = (nChannelGeneration != this->m_nChannelGeneration) && this->m_bUseIgnoreListRx;
+    bool bRebuild = !this->m_bIsValid || (this->m_pcConfigData->s_get_Generation() != this->m_nConfigGeneration) || bChannelChanged;
+    this->m_nChannelGeneration = nChannelGeneration;
+    if (bRebuild)
+        rebuild();
+
+    if ((pvUpdate == nullptr) || pvUpdate->empty())
+        return;
+
+    boost::lock_guard<boost::mutex> lock(this->m_pcClientFilter->m_cClientListMutex);
+    for (size_t ii = 0; ii < pvUpdate->size(); ii++)
+    {
+        anyID nClientID = (*pvUpdate)[ii].nClientID;
+        if (!bRebuild)
+        {
+            int nIndex = this->m_pcClientFilter->find_client(nClientID);
+            set_flags(nClientID, (nIndex >= 0) ? get_flags(this->m_pcClientFilter->m_cClientList[nIndex]) : 0);
+        }
+
+        // TS3 does not send the end of the talk of a client that left, its priority call has to end the ducking
+        if ((*pvUpdate)[ii].nChannelID == 0)
+            set_talk_status(nClientID, false, false);
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* flags of all clients
+*/
+void rx_filter::rebuild()
+{
+    CALL_STACK
+    this->m_nConfigGeneration = this->m_pcConfigData->s_get_Generation();
+    this->m_bUseIgnoreListRx  = this->m_pcConfigData->s_get_UseIgnoreListRx() && (this->m_pcConfigData->s_get_IgnoreList()->size() > 1);
+    this->m_mIgnored.clear();
+    update_freqs();
+
+    std::vector<uint8_t> vnFlags(RX_FILTER_NUM_CLIENTS, 0);
+    {
+        boost::lock_guard<boost::mutex> lock(this->m_pcClientFilter->m_cClientListMutex);
+        for (size_t ii = 0; ii < this->m_pcClientFilter->m_cClientList.size(); ii++)
+        {
+            const client_info& cClient = this->m_pcClientFilter->m_cClientList[ii];
+            vnFlags[cClient.nClientID] = get_flags(cClient);
+        }
+    }
+
+    for (size_t ii = 0; ii < RX_FILTER_NUM_CLIENTS; ii++)
+        set_flags((anyID)ii, vnFlags[ii]);
+    this->m_bIsValid = true;
+}
+
+/* ----------------------------------------------------------------------------
+* frequencies of my frequency profiles, a frequency used by several profiles
+* is heard if any of them hears it
+*/
+void rx_filter::update_freqs()
+{
+    this->m_mFreq.clear();
+    for (int ii = 0; ii < this->m_pcConfigData->s_get_MaxNumProfiles(); ii++)
+    {
+        if ((this->m_pcConfigData->s_get_ProfileType(ii) != PROFILE_FREQUENCY) || (this->m_pcConfigData->s_get_ActiveFreq(ii) == 0))
+            continue;
+
+        uint8_t& nHeard = this->m_mFreq[this->m_pcConfigData->s_get_ActiveFreq(ii)];
+        if (this->m_pcConfigData->s_get_MuteFreq(ii))
+            continue;
+        nHeard |= RX_FREQ_PRIORITY;
+        if (this->m_pcConfigData->s_get_RadioFreq(ii))
+            nHeard |= RX_FREQ_RADIO;
+        if (!this->m_pcConfigData->s_get_SquelchFreq(ii))
+            nHeard |= RX_FREQ_NORMAL;
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* flags of one client, client list has to be locked by the caller
+*/
+uint8_t rx_filter::get_flags(const client_info& cClient)
+{
+    if (this->m_bUseIgnoreListRx && is_ignored(cClient.nActualChannelID))
+        return RX_FLAG_BLOCKED;
+
+    if (!cClient.bUseFreqList)
+        return 0;
+
+    // blocked only if all shared frequencies are blocked, other whispers (level, favorite) are not frequency based
+    bool bShared   = false;
+    bool bHeard    = false;
+    bool bPriority = false;
+    bool bRadio    = false;
+    for (int jj = 0; jj < cClient.iNumFreq; jj++)
+    {
+        std::unordered_map<int, uint8_t>::const_iterator it = this->m_mFreq.find(cClient.acFreqList[jj].nBit.nFreq);
+        if (it == this->m_mFreq.end())
+            continue;
+
+        bShared = true;
+        bool bPrioCall = cClient.acFreqList[jj].nBit.nPriority != 0;
+        if (it->second & (bPrioCall ? RX_FREQ_PRIORITY : RX_FREQ_NORMAL))
+        {
+            bHeard = true;
+            bPriority |= bPrioCall;
+            bRadio |= (it->second & RX_FREQ_RADIO) != 0;
+        }
+    }
+
+    uint8_t nFlags = 0;
+    if (bShared && !bHeard) nFlags |= RX_FLAG_BLOCKED;
+    if (bPriority)          nFlags |= RX_FLAG_PRIORITY;
+    if (bHeard && bRadio)   nFlags |= RX_FLAG_RADIO;
+    return nFlags;
+}
+
+/* ----------------------------------------------------------------------------
+* ignore list lookup, cached per channel until the next rebuild
+*/
+bool rx_filter::is_ignored(uint64 nChannelID)
+{
+    std::unordered_map<uint64, bool>::iterator it = this->m_mIgnored.find(nChannelID);
+    if (it != this->m_mIgnored.end())
+        return it->second;
+
+    bool bIgnored = this->m_pcChannelFilter->find_channel_in_list(this->m_pcConfigData->s_get_IgnoreList(), nChannelID) >= 0;
+    this->m_mIgnored[nChannelID] = bIgnored;
+    return bIgnored;
+}
+
+/* ----------------------------------------------------------------------------
+* replace blocked/priority flags, the talk status flags are kept
+*/
+void rx_filter::set_flags(anyID nClientID, uint8_t nFlags)
+{
+    std::atomic<uint8_t>& nEntry = this->m_anClient[nClientID];
+    uint8_t nOld = nEntry.load(std::memory_order_relaxed);
+    uint8_t nNew;
+    do
+    {
+        nNew = (nOld & (RX_FLAG_WHISPER | RX_FLAG_DUCKING)) | nFlags;
+        if (nNew == nOld)
+            return;
+    } while (!nEntry.compare_exchange_weak(nOld, nNew, std::memory_order_relaxed));
+}
+
+/* ----------------------------------------------------------------------------
+* talk status of a client, a priority call ducks the other whispers until it ends
+*/
+void rx_filter::set_talk_status(anyID nClientID, bool bTalking, bool bWhisper)
+{
+    std::atomic<uint8_t>& nEntry = this->m_anClient[nClientID];
+    if (bTalking && bWhisper)
+    {
+        uint8_t nOld = nEntry.fetch_or(RX_FLAG_WHISPER, std::memory_order_relaxed);
+        if (((nOld & (RX_FLAG_PRIORITY | RX_FLAG_BLOCKED | RX_FLAG_DUCKING)) == RX_FLAG_PRIORITY))
+        {
+            nEntry.fetch_or(RX_FLAG_DUCKING, std::memory_order_relaxed);
+            this->m_nPrioTalkers++;
+        }
+    }
+    else
+    {
+        uint8_t nOld = nEntry.fetch_and((uint8_t)~(RX_FLAG_WHISPER | RX_FLAG_DUCKING), std::memory_order_relaxed);
+        if (nOld & RX_FLAG_DUCKING)
+            this->m_nPrioTalkers--;
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* decision for the voice data of one client
+*/
+eRxAction rx_filter::get_action(anyID nClientID)
+{
+    uint8_t nFlags = this->m_anClient[nClientID].load(std::memory_order_relaxed);
+    if (!(nFlags & RX_FLAG_WHISPER))
+        return RX_PASS;
+    if (nFlags & RX_FLAG_BLOCKED)
+        return RX_ZERO;
+    if (!(nFlags & RX_FLAG_PRIORITY) && (this->m_nPrioTalkers.load(std::memory_order_relaxed) > 0))
+        return RX_ATTENUATE;
+    return RX_PASS;
+}
+
+/* ----------------------------------------------------------------------------
+* edit voice data of one client (interleaved, iSampleCount samples per channel)
+*/
+eRxAction rx_filter::process(anyID nClientID, short *psSamples, int iSampleCount, int iChannels)
+{
+    eRxAction eAction = get_action(nClientID);
+    if ((psSamples == nullptr) || (iSampleCount <= 0) || (iChannels <= 0))
+        return eAction;
+
+    int iStartGain = this->m_anGain[nClientID];
+    int iEndGain   = (eAction == RX_PASS) ? GAIN_UNITY : ((eAction == RX_ATTENUATE) ? RX_DUCK_GAIN : 0);
+    this->m_anGain[nClientID] = (uint16_t)iEndGain;
+
+    size_t nSamples = (size_t)iSampleCount * iChannels;
+    if (iEndGain == 0)
+    {
+        memset(psSamples, 0, nSamples * sizeof(short));
+        return eAction;
+    }
+
+    const uint8_t nRadio = RX_FLAG_WHISPER | RX_FLAG_RADIO;
+    if ((this->m_anClient[nClientID].load(std::memory_order_relaxed) & nRadio) == nRadio)
+        this->m_cRadio.process(get_radio_state(nClientID), psSamples, iSampleCount, iChannels);
+
+    if ((iStartGain != GAIN_UNITY) || (iEndGain != GAIN_UNITY))
+        gain_kernel::apply(psSamples, nSamples, iStartGain, iEndGain);
+    return eAction;
+}
+
+/* ----------------------------------------------------------------------------
+* radio state of a client, the least recently used slot is taken over if the
+* client has none (audio thread)
+*/
+radio_state& rx_filter::get_radio_state(anyID nClientID)
+{
+    this->m_nRadioUse++;
+    if (this->m_nRadioUse == 0)
+    {
+        // wrapped after years of audio, restart the LRU order
+        for (size_t ii = 0; ii < RX_RADIO_SLOTS; ii++)
+            this->m_acRadio[ii].nLastUse = 0;
+        this->m_nRadioUse = 1;
+    }
+
+    radio_state *pcState = &this->m_acRadio[this->m_anRadioSlot[nClientID]];
+    if ((pcState->nLastUse == 0) || (pcState->nClientID != nClientID))
+    {
+        uint8_t nSlot = 0;
+        for (uint8_t ii = 1; ii < RX_RADIO_SLOTS; ii++)
+            if (this->m_acRadio[ii].nLastUse < this->m_acRadio[nSlot].nLastUse)
+                nSlot = ii;
+        this->m_anRadioSlot[nClientID] = nSlot;
+        pcState = &this->m_acRadio[nSlot];
+        radio_effect::reset(*pcState, nClientID);
+    }
+    pcState->nLastUse = this->m_nRadioUse;
+    return *pcState;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <atomic>
+#include <unordered_map>
+#include <vector>
+#include "misc/config_container.h"
+#include "misc/channel_filter.h"
+#include "misc/client_filter.h"
+#include "misc/error_handler.h"
+#include "misc/gain_kernel.h"
+#include "misc/radio_effect.h"
+
+#define RX_FILTER_NUM_CLIENTS   65536   // one entry per anyID
+#define RX_DUCK_GAIN            (GAIN_UNITY / 4)    // gain of normal whispers while a priority call is received (-12 dB)
+#define RX_RADIO_SLOTS          16      // clients with radio effect state at the same time
+
+// flags per client
+#define RX_FLAG_BLOCKED         0x01    // whisper is dropped (muted/squelched frequency, ignored channel)
+#define RX_FLAG_PRIORITY        0x02    // priority call on a frequency I listen to
+#define RX_FLAG_WHISPER         0x04    // client is whispering to me (talk status)
+#define RX_FLAG_DUCKING         0x08    // client is counted in m_nPrioTalkers
+#define RX_FLAG_RADIO           0x10    // whisper is heard on a frequency with radio effect
+
+// calls heard on one of my frequencies
+#define RX_FREQ_NORMAL          0x01
+#define RX_FREQ_PRIORITY        0x02
+#define RX_FREQ_RADIO           0x04    // radio effect on calls heard on the frequency
+
+enum eRxAction
+{
+    RX_PASS = 0,
+    RX_ATTENUATE,
+    RX_ZERO
+};
+
+/* ----------------------------------------------------------------------------
+* receive side of the frequency settings (Mute, Squelch, UseIgnoreListRx)
+*
+* the decision per talking client is prepared by the event processing and
+* stored as flags per client ID, the audio thread only reads one atomic byte
+* and the number of priority talkers. Whispers of clients that share only
+* muted (or squelched, without priority) frequencies with me or that are in
+* an ignored channel are dropped, normal whispers are ducked while a
+* priority call is received. Channel voice is never changed.
+*
+* gain changes (ducking and back, unmuting) are ramped over one buffer, dropping
+* is done at once. Whispers heard on a frequency with radio effect get the
+* effect before the gain. The gain and the radio slot per client are only
+* used by the audio thread, radio states are taken from a small pool (least
+* recently used one is reassigned).
+*/
+class rx_filter
+{
+public:
+    rx_filter();
+    ~rx_filter();
+
+    void                init(client_filter *pcClientFilter, channel_filter *pcChannelFilter, config_container *pcConfigData);
+
+    // event processing: flags of the updated clients (nullptr => none), all clients after config or channel changes
+    void                update(const std::vector<client_update> *pvUpdate, uint32_t nChannelGeneration);
+
+    // TS3 callbacks, any thread
+    void                set_talk_status(anyID nClientID, bool bTalking, bool bWhisper);
+    eRxAction           get_action(anyID nClientID);
+    eRxAction           process(anyID nClientID, short *psSamples, int iSampleCount, int iChannels);
+
+protected:
+    void                rebuild();
+    void                update_freqs();
+    uint8_t             get_flags(const client_info& cClient);
+    bool                is_ignored(uint64 nChannelID);
+    void                set_flags(anyID nClientID, uint8_t nFlags);
+    radio_state&        get_radio_state(anyID nClientID);
+
+private:
+    client_filter      *m_pcClientFilter;       // link to client filter of server
+    channel_filter     *m_pcChannelFilter;      // link to channel filter of server
+    config_container   *m_pcConfigData;         // configuration container
+    error_handler       m_cErrHandler;          // link to error handler
+
+    bool                m_bIsValid;             // flags were built at least once
+    uint32_t            m_nConfigGeneration;    // config the flags were built with
+    uint32_t            m_nChannelGeneration;   // channel tree the flags were built with (ignore list)
+    bool                m_bUseIgnoreListRx;
+
+    std::unordered_map<int, uint8_t>    m_mFreq;    // my frequency => RX_FREQ_*
+    std::unordered_map<uint64, bool>    m_mIgnored; // channels checked against the ignore list so far
+
+    std::atomic<uint8_t>    m_anClient[RX_FILTER_NUM_CLIENTS];  // RX_FLAG_* per client ID
+    std::atomic<int>        m_nPrioTalkers;                     // clients with RX_FLAG_DUCKING
+    uint16_t                m_anGain[RX_FILTER_NUM_CLIENTS];    // gain at the end of the last buffer per client (audio thread)
+    uint8_t                 m_anRadioSlot[RX_FILTER_NUM_CLIENTS];   // index in m_acRadio per client (audio thread)
+
+    radio_effect            m_cRadio;
+    radio_state             m_acRadio[RX_RADIO_SLOTS];          // audio thread
+    uint32_t                m_nRadioUse;                        // LRU stamp of the last radio buffer
+};
@@ -0,0 +1,127 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#define SERVER_REGISTRY_MIN_SLOTS 16    // initial hash table size (power of 2)
+
+/* ----------------------------------------------------------------------------
+* owner of one entry per serverConnectionHandlerID
+*
+* the entries are kept dense in a vector (iteration over all servers), an open
+* addressing hash table (linear probing, max. half full) maps the ID to the
+* position in that vector. find is O(1) without allocation, erase moves the
+* last entry into the gap and hands the entry back to the caller, so the caller
+* decides when it is destroyed. Not thread safe, the owner serializes changes.
+*/
+template <class T>
+class server_registry
+{
+public:
+    server_registry()
+    {
+        this->m_vSlot.assign(SERVER_REGISTRY_MIN_SLOTS, -1);
+        this->m_nShift = 64 - 4;
+    };
+
+    // nullptr if the ID is unknown
+    T* find(uint64_t nID) const
+    {
+        int iPos = this->m_vSlot[find_slot(nID)];
+        return (iPos >= 0) ? this->m_vEntry[iPos].second.get() : nullptr;
+    };
+
+    // takes ownership, nullptr (and pcEntry is destroyed) if the ID exists already
+    T* insert(uint64_t nID, std::unique_ptr<T> pcEntry)
+    {
+        if ((this->m_vEntry.size() + 1) * 2 > this->m_vSlot.size())
+            rehash(this->m_vSlot.size() * 2);
+
+        size_t nSlot = find_slot(nID);
+        if (this->m_vSlot[nSlot] >= 0)
+            return nullptr;
+
+        this->m_vSlot[nSlot] = (int)this->m_vEntry.size();
+        this->m_vEntry.push_back(std::make_pair(nID, std::move(pcEntry)));
+        return this->m_vEntry.back().second.get();
+    };
+
+    // entry is removed and returned to the caller, empty if the ID is unknown
+    std::unique_ptr<T> erase(uint64_t nID)
+    {
+        size_t nSlot = find_slot(nID);
+        int iPos = this->m_vSlot[nSlot];
+        if (iPos < 0)
+            return std::unique_ptr<T>();
+
+        // backward shift deletion, no tombstones needed
+        size_t nMask = this->m_vSlot.size() - 1;
+        for (size_t nNext = (nSlot + 1) & nMask; this->m_vSlot[nNext] >= 0; nNext = (nNext + 1) & nMask)
+        {
+            size_t nHome = home_slot(this->m_vEntry[this->m_vSlot[nNext]].first);
+            bool bStays = (nSlot <= nNext) ? ((nSlot < nHome) && (nHome <= nNext)) : ((nSlot < nHome) || (nHome <= nNext));
+            if (bStays)
+                continue;
+            this->m_vSlot[nSlot] = this->m_vSlot[nNext];
+            nSlot = nNext;
+        }
+        this->m_vSlot[nSlot] = -1;
+
+        // close the gap in the dense vector with the last entry
+        std::unique_ptr<T> pcEntry = std::move(this->m_vEntry[iPos].second);
+        size_t nLast = this->m_vEntry.size() - 1;
+        if ((size_t)iPos != nLast)
+        {
+            this->m_vSlot[find_slot(this->m_vEntry[nLast].first)] = iPos;
+            this->m_vEntry[iPos] = std::move(this->m_vEntry[nLast]);
+        }
+        this->m_vEntry.pop_back();
+        return pcEntry;
+    };
+
+    // destroys all entries
+    void clear()
+    {
+        this->m_vEntry.clear();
+        this->m_vSlot.assign(this->m_vSlot.size(), -1);
+    };
+
+    // iteration, the order changes on erase
+    size_t  size() const            { return this->m_vEntry.size(); };
+    T*      at(size_t nIndex) const { return this->m_vEntry[nIndex].second.get(); };
+
+private:
+    size_t home_slot(uint64_t nID) const
+    {
+        // Fibonacci hashing, IDs are small consecutive numbers
+        return (size_t)((nID * 0x9E3779B97F4A7C15ull) >> this->m_nShift);
+    };
+
+    // slot of nID or the empty slot where it would be inserted
+    size_t find_slot(uint64_t nID) const
+    {
+        size_t nMask = this->m_vSlot.size() - 1;
+        size_t nSlot = home_slot(nID);
+        while ((this->m_vSlot[nSlot] >= 0) && (this->m_vEntry[this->m_vSlot[nSlot]].first != nID))
+            nSlot = (nSlot + 1) & nMask;
+        return nSlot;
+    };
+
+    void rehash(size_t nSlots)
+    {
+        this->m_vSlot.assign(nSlots, -1);
+        this->m_nShift = 64;
+        for (size_t nSize = nSlots; nSize > 1; nSize >>= 1)
+            this->m_nShift--;
+
+        for (size_t ii = 0; ii < this->m_vEntry.size(); ii++)
+            this->m_vSlot[find_slot(this->m_vEntry[ii].first)] = (int)ii;
+    };
+
+private:
+    std::vector<std::pair<uint64_t, std::unique_ptr<T>>>    m_vEntry;   // dense, ID + owned entry
+    std::vector<int>                                        m_vSlot;    // hash table, index in m_vEntry or -1
+    unsigned int                                            m_nShift;   // 64 - log2(number of slots)
+};
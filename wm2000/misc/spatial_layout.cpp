@@ -0,0 +1,235 @@
+#include "misc/spatial_layout.h"
+#include <math.h>
+#include <string.h>
+#include "teamspeak/public_errors.h"
+
+#if USE_CALL_STACK
+#define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
+#else
+#define CALL_STACK
+#endif
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+spatial_layout::spatial_layout()
+{
+    this->m_pstTs3Functions     = nullptr;
+    this->m_pcClientFilter      = nullptr;
+    this->m_pcConfigData        = nullptr;
+    this->m_nServerID           = 0;
+    this->m_bIsValid            = false;
+    this->m_nConfigGeneration   = 0;
+    memset(this->m_anState, 0, sizeof(this->m_anState));
+    memset(this->m_aiSent, SPATIAL_CENTER, sizeof(this->m_aiSent));
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+spatial_layout::~spatial_layout()
+{
+}
+
+/* ----------------------------------------------------------------------------
+* set interfaces, I'm at the center, look in X direction and Z is upwards
+*/
+void spatial_layout::init(struct TS3Functions *pstTs3Functions, client_filter *pcClientFilter, config_container *pcConfigData, uint64 nServerID)
+{
+    CALL_STACK
+    this->m_pstTs3Functions = pstTs3Functions;
+    this->m_pcClientFilter  = pcClientFilter;
+    this->m_pcConfigData    = pcConfigData;
+    this->m_nServerID       = nServerID;
+    this->m_bIsValid        = false;
+
+    const TS3_VECTOR position   = { 0.0, 0.0, 0.0 };
+    const TS3_VECTOR forward    = { 1.0, 0.0, 0.0 };
+    const TS3_VECTOR up         = { 0.0, 0.0, 1.0 };
+    if (this->m_pstTs3Functions->systemset3DListenerAttributes(this->m_nServerID, &position, &forward, &up) != ERROR_ok)
+        if (DEBUG_LOG) printf("PLUGIN: error while init 3D audio\n");
+}
+
+/* ----------------------------------------------------------------------------
+* clients changed (frequencies, disconnect), talking clients are checked again
+*/
+void spatial_layout::update(const std::vector<client_update> *pvUpdate)
+{
+    if ((this->m_pcClientFilter == nullptr) || (this->m_pcConfigData == nullptr))
+        return;
+
+    check_config();
+    for (size_t ii = 0; (pvUpdate != nullptr) && (ii < pvUpdate->size()); ii++)
+    {
+        const client_update& cUpdate = (*pvUpdate)[ii];
+        if (cUpdate.nChannelID == 0)
+        {
+            // TS3 forgets the position of a client that left, the ID may be used again
+            this->m_anState[cUpdate.nClientID] &= SPATIAL_DIRTY;
+            this->m_aiSent[cUpdate.nClientID] = SPATIAL_CENTER;
+        }
+        else if (this->m_anState[cUpdate.nClientID] & SPATIAL_TALKING)
+        {
+            set_dirty(cUpdate.nClientID);
+        }
+    }
+    commit();
+}
+
+/* ----------------------------------------------------------------------------
+* talk status of a client, placed when the talking starts
+*/
+void spatial_layout::set_talk_status(anyID nClientID, bool bTalking, bool bWhisper)
+{
+    if ((this->m_pcClientFilter == nullptr) || (this->m_pcConfigData == nullptr))
+        return;
+
+    check_config();
+    uint8_t& nState = this->m_anState[nClientID];
+    nState &= SPATIAL_DIRTY;
+    if (bTalking)
+    {
+        nState |= SPATIAL_TALKING | (bWhisper ? SPATIAL_WHISPER : 0);
+        set_dirty(nClientID);
+    }
+    commit();
+}
+
+/* ----------------------------------------------------------------------------
+* all placed clients back to the center (plugin is unloaded)
+*/
+void spatial_layout::reset()
+{
+    CALL_STACK
+    if (this->m_pstTs3Functions == nullptr)
+        return;
+
+    for (size_t ii = 0; ii < SPATIAL_NUM_CLIENTS; ii++)
+        if (this->m_aiSent[ii] != SPATIAL_CENTER)
+            set_position((anyID)ii, SPATIAL_CENTER);
+    this->m_vDirty.clear();
+    memset(this->m_anState, 0, sizeof(this->m_anState));
+}
+
+/* ----------------------------------------------------------------------------
+* volume by distance: placed clients are not attenuated, clients further away
+* keep the volume of the rolloff set in TS3 (fVolume)
+*/
+float spatial_layout::get_rolloff(float fDistance, float fVolume)
+{
+    return (fDistance <= SPATIAL_DISTANCE_MAX) ? 1.0f : fVolume;
+}
+
+/* ----------------------------------------------------------------------------
+* layout after config changes, all talking clients are checked again
+*/
+void spatial_layout::check_config()
+{
+    if (this->m_bIsValid && (this->m_pcConfigData->s_get_Generation() == this->m_nConfigGeneration))
+        return;
+
+    rebuild_slots();
+    for (size_t ii = 0; ii < SPATIAL_NUM_CLIENTS; ii++)
+        if (this->m_anState[ii] & SPATIAL_TALKING)
+            set_dirty((anyID)ii);
+}
+
+/* ----------------------------------------------------------------------------
+* my frequencies with 3D switch => slot, spread evenly over the front
+*/
+void spatial_layout::rebuild_slots()
+{
+    CALL_STACK
+    this->m_nConfigGeneration = this->m_pcConfigData->s_get_Generation();
+    this->m_bIsValid = true;
+    this->m_mSlot.clear();
+    this->m_vSlot.clear();
+
+    std::vector<int> viFreq;
+    for (int ii = 0; ii < this->m_pcConfigData->s_get_MaxNumProfiles(); ii++)
+    {
+        int iFreq = this->m_pcConfigData->s_get_ActiveFreq(ii);
+        if ((this->m_pcConfigData->s_get_ProfileType(ii) != PROFILE_FREQUENCY) || (iFreq == 0) || !this->m_pcConfigData->s_get_SpatialFreq(ii))
+            continue;
+        if (this->m_mSlot.find(iFreq) != this->m_mSlot.end())
+            continue;
+        this->m_mSlot[iFreq] = (int8_t)viFreq.size();
+        viFreq.push_back(iFreq);
+    }
+
+    // left to right, a single frequency is in front of me (Y points to the left)
+    const double dPi = 3.14159265358979323846;
+    for (size_t ii = 0; ii < viFreq.size(); ii++)
+    {
+        double dAzimuth = (viFreq.size() == 1) ? 0.0 : SPATIAL_MAX_AZIMUTH * (2.0 * ii / (viFreq.size() - 1) - 1.0);
+        double dRadian  = dAzimuth * dPi / 180.0;
+        TS3_VECTOR stPosition = { (float)(SPATIAL_DISTANCE * cos(dRadian)), (float)(-SPATIAL_DISTANCE * sin(dRadian)), 0.0f };
+        this->m_vSlot.push_back(stPosition);
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* slot of a whispering client, client list has to be locked by the caller
+*/
+int8_t spatial_layout::get_slot(const client_info& cClient)
+{
+    int8_t iSlot = SPATIAL_CENTER;
+    if (!cClient.bUseFreqList)
+        return iSlot;
+
+    for (int jj = 0; jj < cClient.iNumFreq; jj++)
+    {
+        std::unordered_map<int, int8_t>::const_iterator it = this->m_mSlot.find(cClient.acFreqList[jj].nBit.nFreq);
+        if ((it != this->m_mSlot.end()) && ((iSlot == SPATIAL_CENTER) || (it->second < iSlot)))
+            iSlot = it->second;
+    }
+    return iSlot;
+}
+
+void spatial_layout::set_dirty(anyID nClientID)
+{
+    if (this->m_anState[nClientID] & SPATIAL_DIRTY)
+        return;
+    this->m_anState[nClientID] |= SPATIAL_DIRTY;
+    this->m_vDirty.push_back(nClientID);
+}
+
+/* ----------------------------------------------------------------------------
+* send the positions of all changed clients, silent clients are left where
+* they are until they talk again
+*/
+void spatial_layout::commit()
+{
+    if (this->m_vDirty.empty())
+        return;
+
+    boost::lock_guard<boost::mutex> lock(this->m_pcClientFilter->m_cClientListMutex);
+    for (size_t ii = 0; ii < this->m_vDirty.size(); ii++)
+    {
+        anyID nClientID = this->m_vDirty[ii];
+        uint8_t& nState = this->m_anState[nClientID];
+        nState &= (uint8_t)~SPATIAL_DIRTY;
+        if (!(nState & SPATIAL_TALKING))
+            continue;
+
+        int8_t iSlot = SPATIAL_CENTER;
+        if (nState & SPATIAL_WHISPER)
+        {
+            int nIndex = this->m_pcClientFilter->find_client(nClientID);
+            if (nIndex >= 0)
+                iSlot = get_slot(this->m_pcClientFilter->m_cClientList[nIndex]);
+        }
+        if (iSlot != this->m_aiSent[nClientID])
+            set_position(nClientID, iSlot);
+    }
+    this->m_vDirty.clear();
+}
+
+void spatial_layout::set_position(anyID nClientID, int8_t iSlot)
+{
+    const TS3_VECTOR stCenter = { 0.0f, 0.0f, 0.0f };
+    const TS3_VECTOR *pstPosition = (iSlot == SPATIAL_CENTER) ? &stCenter : &this->m_vSlot[iSlot];
+    if (this->m_pstTs3Functions->channelset3DAttributes(this->m_nServerID, nClientID, pstPosition) != ERROR_ok)
+        if (DEBUG_LOG) printf("PLUGIN: error while setting 3D position of client %d\n", nClientID);
+    this->m_aiSent[nClientID] = iSlot;
+}
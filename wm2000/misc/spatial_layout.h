@@ -0,0 +1,73 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+#include "misc/config_container.h"
+#include "misc/client_filter.h"
+#include "misc/error_handler.h"
+#include "ts3_functions.h"
+
+#define SPATIAL_NUM_CLIENTS     65536   // one entry per anyID
+#define SPATIAL_CENTER          -1      // slot of clients that are not placed (TS3 default position)
+#define SPATIAL_MAX_AZIMUTH     60.0    // degrees left/right of the front for the outermost frequency
+#define SPATIAL_DISTANCE        1.0f    // distance of placed clients, no attenuation up to here
+#define SPATIAL_DISTANCE_MAX    1.001f  // SPATIAL_DISTANCE with the rounding of the positions sent to TS3
+
+// talk state per client
+#define SPATIAL_TALKING         0x01
+#define SPATIAL_WHISPER         0x02
+#define SPATIAL_DIRTY           0x04    // in m_vDirty
+
+/* ----------------------------------------------------------------------------
+* 3D position of whispers received over a frequency
+*
+* every frequency of my frequency profiles with the 3D switch gets its own
+* azimuth in front of me (profile order, left to right), a client whispering
+* to me is placed at the leftmost of these frequencies it uses. Other voice
+* stays at the center. Clients are only looked
+* at when their talk status or frequencies change or the layout itself
+* changes, the position is sent to TS3 in commit() and only if it differs
+* from the last one sent. Event processing only, the rolloff is stateless.
+*/
+class spatial_layout
+{
+public:
+    spatial_layout();
+    ~spatial_layout();
+
+    void                init(struct TS3Functions *pstTs3Functions, client_filter *pcClientFilter, config_container *pcConfigData, uint64 nServerID);
+
+    // event processing, each call sends the changed positions
+    void                update(const std::vector<client_update> *pvUpdate);
+    void                set_talk_status(anyID nClientID, bool bTalking, bool bWhisper);
+    void                reset();                                    // all placed clients back to the center
+
+    static float        get_rolloff(float fDistance, float fVolume);    // volume, fVolume of TS3 beyond the placed clients, any thread
+
+protected:
+    void                check_config();
+    void                rebuild_slots();
+    int8_t              get_slot(const client_info& cClient);
+    void                set_dirty(anyID nClientID);
+    void                commit();
+    void                set_position(anyID nClientID, int8_t iSlot);
+
+private:
+    struct TS3Functions *m_pstTs3Functions;     // TS3 interface functions
+    client_filter      *m_pcClientFilter;       // link to client filter of server
+    config_container   *m_pcConfigData;         // configuration container
+    error_handler       m_cErrHandler;          // link to error handler
+    uint64              m_nServerID;            // ID of connected Server
+
+    bool                m_bIsValid;             // slots were built at least once
+    uint32_t            m_nConfigGeneration;    // config the slots were built with
+
+    std::unordered_map<int, int8_t> m_mSlot;    // frequency => slot
+    std::vector<TS3_VECTOR>         m_vSlot;    // position per slot
+
+    uint8_t             m_anState[SPATIAL_NUM_CLIENTS];     // SPATIAL_* per client ID
+    int8_t              m_aiSent[SPATIAL_NUM_CLIENTS];      // slot last sent to TS3 per client ID
+    std::vector<anyID>  m_vDirty;                           // clients to check in commit()
+};
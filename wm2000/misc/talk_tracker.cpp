@@ -0,0 +1,356 @@
+#include "misc/talk_tracker.h"
+#include <string.h>
+
+#if USE_CALL_STACK
+#define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
+#else
+#define CALL_STACK
+#endif
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+talk_tracker::talk_tracker()
+{
+    this->m_pcClientFilter      = nullptr;
+    this->m_pcConfigData        = nullptr;
+    this->m_bIsValid            = false;
+    this->m_nConfigGeneration   = 0;
+    this->m_cEpoch              = std::chrono::steady_clock::now();
+    memset(this->m_aiFreq, 0, sizeof(this->m_aiFreq));
+
+    for (int ii = 0; ii < REAL_MAXNUMPROFILES; ii++)
+    {
+        talk_counter& cCounter = this->m_acCounter[ii];
+        cCounter.nSequence          = 0;
+        cCounter.iFreq              = 0;
+        cCounter.nTalkers           = 0;
+        cCounter.nWhispers          = 0;
+        cCounter.nTalkTime          = 0;
+        cCounter.nWhisperTime       = 0;
+        cCounter.nTalkStartSum      = 0;
+        cCounter.nWhisperStartSum   = 0;
+        cCounter.nLastActivity      = 0;
+        cCounter.nLastTalker        = 0;
+    }
+    for (size_t ii = 0; ii < TRACKER_NUM_CLIENTS; ii++)
+    {
+        talk_entry& cEntry = this->m_acClient[ii];
+        cEntry.nProfiles    = 0;
+        cEntry.nCounted     = 0;
+        cEntry.nCountStart  = 0;
+        cEntry.nState       = 0;
+        cEntry.nStart       = 0;
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+talk_tracker::~talk_tracker()
+{
+}
+
+/* ----------------------------------------------------------------------------
+* set interfaces
+*/
+void talk_tracker::init(client_filter *pcClientFilter, config_container *pcConfigData)
+{
+    CALL_STACK
+    this->m_pcClientFilter  = pcClientFilter;
+    this->m_pcConfigData    = pcConfigData;
+    this->m_bIsValid        = false;
+}
+
+/* ----------------------------------------------------------------------------
+* profiles of the updated clients, all clients after config changes
+*/
+void talk_tracker::update(const std::vector<client_update> *pvUpdate)
+{
+    if ((this->m_pcClientFilter == nullptr) || (this->m_pcConfigData == nullptr))
+        return;
+
+    // a rebuild sets the profiles of all clients
+    bool bRebuild = !this->m_bIsValid || (this->m_pcConfigData->s_get_Generation() != this->m_nConfigGeneration);
+    if (bRebuild)
+        rebuild();
+
+    if ((pvUpdate == nullptr) || pvUpdate->empty())
+        return;
+
+    uint64_t nNow = get_time();
+    boost::lock_guard<boost::mutex> lock(this->m_pcClientFilter->m_cClientListMutex);
+    for (size_t ii = 0; ii < pvUpdate->size(); ii++)
+    {
+        anyID nClientID = (*pvUpdate)[ii].nClientID;
+        if (!bRebuild)
+        {
+            int nIndex = this->m_pcClientFilter->find_client(nClientID);
+            set_profiles(nClientID, (nIndex >= 0) ? get_profiles(this->m_pcClientFilter->m_cClientList[nIndex]) : 0, nNow);
+        }
+
+        // TS3 does not send the end of the talk of a client that left
+        if ((*pvUpdate)[ii].nChannelID == 0)
+            set_talk_status(nClientID, false, false);
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* start or end of a talk, counted in the profiles the client shares with me
+*/
+void talk_tracker::set_talk_status(anyID nClientID, bool bTalking, bool bWhisper)
+{
+    talk_entry& cEntry = this->m_acClient[nClientID];
+    uint8_t nState = cEntry.nState.load(std::memory_order_relaxed);
+    uint64_t nNow = get_time();
+
+    // a running talk ends first (talk changes to whisper or start without end)
+    if (nState & TRACKER_TALKING)
+    {
+        count(cEntry.nCounted, nClientID, false, (nState & TRACKER_WHISPER) != 0, cEntry.nCountStart, nNow);
+        cEntry.nCounted = 0;
+        cEntry.nState.store(0, std::memory_order_release);
+    }
+
+    if (bTalking)
+    {
+        cEntry.nStart.store(nNow, std::memory_order_relaxed);
+        cEntry.nState.store(TRACKER_TALKING | (bWhisper ? TRACKER_WHISPER : 0), std::memory_order_release);
+        cEntry.nCounted = cEntry.nProfiles;
+        cEntry.nCountStart = nNow;
+        count(cEntry.nCounted, nClientID, true, bWhisper, nNow, nNow);
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* copy of the statistics of one profile, false if the profile is not tracked
+*/
+bool talk_tracker::get_activity(int iProfile, talk_activity& cActivity)
+{
+    memset(&cActivity, 0, sizeof(cActivity));
+    if ((iProfile < 0) || (iProfile >= REAL_MAXNUMPROFILES))
+        return false;
+
+    // retry while the writer changes the counter (sequence odd or changed), the acquire
+    // loads keep the second read of the sequence behind the fields
+    talk_counter& cCounter = this->m_acCounter[iProfile];
+    uint64_t nTalkStartSum, nWhisperStartSum, nLastActivity;
+    while (true)
+    {
+        uint32_t nSequence = cCounter.nSequence.load(std::memory_order_acquire);
+        if (nSequence & 1)
+            continue;
+
+        cActivity.iFreq             = cCounter.iFreq.load(std::memory_order_acquire);
+        cActivity.nTalkers          = cCounter.nTalkers.load(std::memory_order_acquire);
+        cActivity.nWhispers         = cCounter.nWhispers.load(std::memory_order_acquire);
+        cActivity.nTalkTime_ms      = cCounter.nTalkTime.load(std::memory_order_acquire);
+        cActivity.nWhisperTime_ms   = cCounter.nWhisperTime.load(std::memory_order_acquire);
+        cActivity.nLastTalker       = cCounter.nLastTalker.load(std::memory_order_acquire);
+        nTalkStartSum               = cCounter.nTalkStartSum.load(std::memory_order_acquire);
+        nWhisperStartSum            = cCounter.nWhisperStartSum.load(std::memory_order_acquire);
+        nLastActivity               = cCounter.nLastActivity.load(std::memory_order_acquire);
+
+        if (cCounter.nSequence.load(std::memory_order_relaxed) == nSequence)
+            break;
+    }
+
+    // running talks up to now
+    uint64_t nNow = get_time();
+    cActivity.nTalkTime_ms      += cActivity.nTalkers * nNow - nTalkStartSum;
+    cActivity.nWhisperTime_ms   += cActivity.nWhispers * nNow - nWhisperStartSum;
+    cActivity.iIdle_ms          = (nLastActivity == 0) ? -1 : (int64_t)(nNow - nLastActivity);
+    return cActivity.iFreq != 0;
+}
+
+/* ----------------------------------------------------------------------------
+* talk state of a client
+*/
+uint8_t talk_tracker::get_client(anyID nClientID, uint64_t& nDuration_ms)
+{
+    const talk_entry& cEntry = this->m_acClient[nClientID];
+    uint8_t nState = cEntry.nState.load(std::memory_order_acquire);
+    uint64_t nStart = cEntry.nStart.load(std::memory_order_relaxed);
+    uint64_t nNow = get_time();
+    nDuration_ms = ((nState & TRACKER_TALKING) && (nNow > nStart)) ? nNow - nStart : 0;
+    return nState;
+}
+
+/* ----------------------------------------------------------------------------
+* frequencies of my profiles and profiles of all clients, the statistics of
+* a profile start again when its frequency changes
+*/
+void talk_tracker::rebuild()
+{
+    CALL_STACK
+    this->m_nConfigGeneration = this->m_pcConfigData->s_get_Generation();
+    this->m_bIsValid = true;
+    uint64_t nNow = get_time();
+
+    int aiFreq[REAL_MAXNUMPROFILES];
+    profile_mask nChanged = 0;
+    for (int ii = 0; ii < REAL_MAXNUMPROFILES; ii++)
+    {
+        bool bUsed = (ii < this->m_pcConfigData->s_get_MaxNumProfiles()) && (this->m_pcConfigData->s_get_ProfileType(ii) == PROFILE_FREQUENCY);
+        aiFreq[ii] = bUsed ? this->m_pcConfigData->s_get_ActiveFreq(ii) : 0;
+        if (aiFreq[ii] != this->m_aiFreq[ii])
+            nChanged |= PROFILE_BIT(ii);
+    }
+
+    if (nChanged != 0)
+    {
+        // running talks leave the changed profiles, then their statistics are cleared
+        for (size_t ii = 0; ii < TRACKER_NUM_CLIENTS; ii++)
+            if (this->m_acClient[ii].nCounted & nChanged)
+                set_profiles((anyID)ii, this->m_acClient[ii].nProfiles & ~nChanged, nNow);
+
+        for (int ii = 0; ii < REAL_MAXNUMPROFILES; ii++)
+        {
+            if (!(nChanged & PROFILE_BIT(ii)))
+                continue;
+            talk_counter& cCounter = this->m_acCounter[ii];
+            cCounter.nSequence.fetch_add(1, std::memory_order_relaxed);
+            cCounter.iFreq.store(aiFreq[ii], std::memory_order_release);
+            cCounter.nTalkTime.store(0, std::memory_order_release);
+            cCounter.nWhisperTime.store(0, std::memory_order_release);
+            cCounter.nLastActivity.store(0, std::memory_order_release);
+            cCounter.nLastTalker.store(0, std::memory_order_release);
+            cCounter.nSequence.fetch_add(1, std::memory_order_release);
+            this->m_aiFreq[ii] = aiFreq[ii];
+        }
+    }
+
+    std::vector<profile_mask> vnProfiles(TRACKER_NUM_CLIENTS, 0);
+    {
+        boost::lock_guard<boost::mutex> lock(this->m_pcClientFilter->m_cClientListMutex);
+        for (size_t ii = 0; ii < this->m_pcClientFilter->m_cClientList.size(); ii++)
+        {
+            const client_info& cClient = this->m_pcClientFilter->m_cClientList[ii];
+            vnProfiles[cClient.nClientID] = get_profiles(cClient);
+        }
+    }
+
+    for (size_t ii = 0; ii < TRACKER_NUM_CLIENTS; ii++)
+        set_profiles((anyID)ii, vnProfiles[ii], nNow);
+}
+
+/* ----------------------------------------------------------------------------
+* frequency profiles that share a frequency with the client, client list has
+* to be locked by the caller
+*/
+profile_mask talk_tracker::get_profiles(const client_info& cClient)
+{
+    profile_mask nProfiles = 0;
+    if (!cClient.bUseFreqList)
+        return nProfiles;
+
+    for (int jj = 0; jj < cClient.iNumFreq; jj++)
+        for (int ii = 0; ii < REAL_MAXNUMPROFILES; ii++)
+            if ((this->m_aiFreq[ii] != 0) && ((int)cClient.acFreqList[jj].nBit.nFreq == this->m_aiFreq[ii]))
+                nProfiles |= PROFILE_BIT(ii);
+    return nProfiles;
+}
+
+/* ----------------------------------------------------------------------------
+* new profiles of a client, a running talk moves over at once
+*/
+void talk_tracker::set_profiles(anyID nClientID, profile_mask nProfiles, uint64_t nNow)
+{
+    talk_entry& cEntry = this->m_acClient[nClientID];
+    cEntry.nProfiles = nProfiles;
+
+    uint8_t nState = cEntry.nState.load(std::memory_order_relaxed);
+    if (!(nState & TRACKER_TALKING) || (cEntry.nCounted == nProfiles))
+        return;
+
+    // the part of the talk in the old profiles is finished
+    bool bWhisper = (nState & TRACKER_WHISPER) != 0;
+    count(cEntry.nCounted & ~nProfiles, nClientID, false, bWhisper, cEntry.nCountStart, nNow);
+
+    // in the new ones it starts now, the kept profiles restart with it to share one start time
+    profile_mask nAdded = nProfiles & ~cEntry.nCounted;
+    if (nAdded != 0)
+    {
+        restart(cEntry.nCounted & nProfiles, bWhisper, cEntry.nCountStart, nNow);
+        count(nAdded, nClientID, true, bWhisper, nNow, nNow);
+        cEntry.nCountStart = nNow;
+    }
+    cEntry.nCounted = nProfiles;
+}
+
+/* ----------------------------------------------------------------------------
+* running talk in some profiles starts again at nNow, the time since nStart is
+* finished talk time, talkers and last activity stay as they are
+*/
+void talk_tracker::restart(profile_mask nProfiles, bool bWhisper, uint64_t nStart, uint64_t nNow)
+{
+    uint64_t nTime = nNow - nStart;
+    for (int ii = 0; (nProfiles != 0) && (ii < REAL_MAXNUMPROFILES); ii++)
+    {
+        if (!(nProfiles & PROFILE_BIT(ii)))
+            continue;
+        nProfiles &= ~PROFILE_BIT(ii);
+
+        talk_counter& cCounter = this->m_acCounter[ii];
+        cCounter.nSequence.fetch_add(1, std::memory_order_relaxed);
+        cCounter.nTalkStartSum.store(cCounter.nTalkStartSum.load(std::memory_order_relaxed) + nTime, std::memory_order_release);
+        cCounter.nTalkTime.store(cCounter.nTalkTime.load(std::memory_order_relaxed) + nTime, std::memory_order_release);
+        if (bWhisper)
+        {
+            cCounter.nWhisperStartSum.store(cCounter.nWhisperStartSum.load(std::memory_order_relaxed) + nTime, std::memory_order_release);
+            cCounter.nWhisperTime.store(cCounter.nWhisperTime.load(std::memory_order_relaxed) + nTime, std::memory_order_release);
+        }
+        cCounter.nSequence.fetch_add(1, std::memory_order_release);
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* start (bStart) or end of a talk in some profiles, nStart is the start time
+* of the talk
+*/
+void talk_tracker::count(profile_mask nProfiles, anyID nClientID, bool bStart, bool bWhisper, uint64_t nStart, uint64_t nNow)
+{
+    for (int ii = 0; (nProfiles != 0) && (ii < REAL_MAXNUMPROFILES); ii++)
+    {
+        if (!(nProfiles & PROFILE_BIT(ii)))
+            continue;
+        nProfiles &= ~PROFILE_BIT(ii);
+
+        // only one writer, the field stores (release) stay behind the odd sequence number
+        talk_counter& cCounter = this->m_acCounter[ii];
+        cCounter.nSequence.fetch_add(1, std::memory_order_relaxed);
+        if (bStart)
+        {
+            cCounter.nTalkers.store(cCounter.nTalkers.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            cCounter.nTalkStartSum.store(cCounter.nTalkStartSum.load(std::memory_order_relaxed) + nStart, std::memory_order_release);
+            if (bWhisper)
+            {
+                cCounter.nWhispers.store(cCounter.nWhispers.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+                cCounter.nWhisperStartSum.store(cCounter.nWhisperStartSum.load(std::memory_order_relaxed) + nStart, std::memory_order_release);
+            }
+        }
+        else
+        {
+            cCounter.nTalkers.store(cCounter.nTalkers.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+            cCounter.nTalkStartSum.store(cCounter.nTalkStartSum.load(std::memory_order_relaxed) - nStart, std::memory_order_release);
+            cCounter.nTalkTime.store(cCounter.nTalkTime.load(std::memory_order_relaxed) + (nNow - nStart), std::memory_order_release);
+            if (bWhisper)
+            {
+                cCounter.nWhispers.store(cCounter.nWhispers.load(std::memory_order_relaxed) - 1, std::memory_order_release);
+                cCounter.nWhisperStartSum.store(cCounter.nWhisperStartSum.load(std::memory_order_relaxed) - nStart, std::memory_order_release);
+                cCounter.nWhisperTime.store(cCounter.nWhisperTime.load(std::memory_order_relaxed) + (nNow - nStart), std::memory_order_release);
+            }
+        }
+        cCounter.nLastActivity.store(nNow, std::memory_order_release);
+        cCounter.nLastTalker.store(nClientID, std::memory_order_release);
+        cCounter.nSequence.fetch_add(1, std::memory_order_release);
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* time stamp in ms, 0 is never returned
+*/
+uint64_t talk_tracker::get_time()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - this->m_cEpoch).count() + 1;
+}
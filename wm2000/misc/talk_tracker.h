@@ -0,0 +1,108 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include "misc/config_container.h"
+#include "misc/client_filter.h"
+#include "misc/profile_membership.h"
+#include "misc/error_handler.h"
+
+#define TRACKER_NUM_CLIENTS     65536   // one entry per anyID
+
+// talk state per client
+#define TRACKER_TALKING         0x01
+#define TRACKER_WHISPER         0x02    // whispering to me
+
+/* ----------------------------------------------------------------------------
+* activity of one frequency profile (copy for readers)
+*/
+struct talk_activity
+{
+    int         iFreq;              // frequency the statistics belong to, 0 => profile is not tracked
+    uint32_t    nTalkers;           // clients talking now
+    uint32_t    nWhispers;          // part of nTalkers, whispering to me
+    uint64_t    nTalkTime_ms;       // all talks since the frequency was set, running ones included
+    uint64_t    nWhisperTime_ms;    // part of nTalkTime_ms
+    int64_t     iIdle_ms;           // time since the last start or stop, -1 => no activity yet
+    anyID       nLastTalker;        // client of the last start or stop
+};
+
+/* ----------------------------------------------------------------------------
+* active talkers and talk time per frequency profile
+*
+* the frequency profiles a client shares with me are prepared by the event
+* processing (client updates, config changes), a talk event then only
+* touches the client entry and the counters of these profiles and allocates
+* nothing.
+*
+* the event processing is the only writer, readers (info text, UI) may run
+* on any thread: the counters of a profile are published with a sequence
+* number, a reader retries if the writer was active meanwhile. Talk time of
+* running talks is the number of talkers times now minus the sum of their
+* start times, so readers see it grow without any event.
+*/
+class talk_tracker
+{
+public:
+    talk_tracker();
+    ~talk_tracker();
+
+    void                init(client_filter *pcClientFilter, config_container *pcConfigData);
+
+    // event processing
+    void                update(const std::vector<client_update> *pvUpdate);    // nullptr => config only
+    void                set_talk_status(anyID nClientID, bool bTalking, bool bWhisper);
+
+    // any thread
+    bool                get_activity(int iProfile, talk_activity& cActivity);
+    uint8_t             get_client(anyID nClientID, uint64_t& nDuration_ms);   // TRACKER_* and time since start
+
+protected:
+    // counters of one profile, written by the event processing only
+    struct talk_counter
+    {
+        std::atomic<uint32_t>   nSequence;          // odd while the writer changes the counter
+        std::atomic<int>        iFreq;
+        std::atomic<uint32_t>   nTalkers;
+        std::atomic<uint32_t>   nWhispers;
+        std::atomic<uint64_t>   nTalkTime;          // finished talks (ms)
+        std::atomic<uint64_t>   nWhisperTime;
+        std::atomic<uint64_t>   nTalkStartSum;      // start times of running talks (ms)
+        std::atomic<uint64_t>   nWhisperStartSum;
+        std::atomic<uint64_t>   nLastActivity;      // time of the last start or stop, 0 => none
+        std::atomic<anyID>      nLastTalker;
+    };
+
+    // talk of one client, the first three members are only used by the event processing
+    struct talk_entry
+    {
+        profile_mask            nProfiles;          // frequency profiles shared with me
+        profile_mask            nCounted;           // profiles the running talk is counted in
+        uint64_t                nCountStart;        // start of the talk in nCounted (ms), moves to the time profiles were added
+        std::atomic<uint8_t>    nState;             // TRACKER_*
+        std::atomic<uint64_t>   nStart;             // start of the running talk (ms)
+    };
+
+    void                rebuild();
+    profile_mask        get_profiles(const client_info& cClient);
+    void                set_profiles(anyID nClientID, profile_mask nProfiles, uint64_t nNow);
+    void                count(profile_mask nProfiles, anyID nClientID, bool bStart, bool bWhisper, uint64_t nStart, uint64_t nNow);
+    void                restart(profile_mask nProfiles, bool bWhisper, uint64_t nStart, uint64_t nNow);
+    uint64_t            get_time();
+
+private:
+    client_filter      *m_pcClientFilter;       // link to client filter of server
+    config_container   *m_pcConfigData;         // configuration container
+    error_handler       m_cErrHandler;          // link to error handler
+
+    bool                m_bIsValid;             // profiles were built at least once
+    uint32_t            m_nConfigGeneration;    // config the profiles were built with
+    int                 m_aiFreq[REAL_MAXNUMPROFILES];          // frequency per profile, 0 => not tracked
+
+    talk_counter        m_acCounter[REAL_MAXNUMPROFILES];
+    talk_entry          m_acClient[TRACKER_NUM_CLIENTS];
+    std::chrono::steady_clock::time_point m_cEpoch;             // time stamps are ms since m_cEpoch + 1, 0 => none
+};
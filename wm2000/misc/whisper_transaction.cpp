@@ -0,0 +1,178 @@
+#include "misc/whisper_transaction.h"
+#include "teamspeak/public_errors.h"
+#include "teamspeak/public_errors_rare.h"
+#include "teamspeak/public_definitions.h"
+#include "teamspeak/clientlib_publicdefinitions.h"
+
+#if USE_CALL_STACK
+#define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
+#else
+#define CALL_STACK
+#endif
+
+// some helper to use with language_pkg
+#define TRANSLATE_PTR(a) this->m_pcTranslate->translate(a)
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+whisper_transaction::whisper_transaction()
+{
+    this->m_pstTs3Functions = nullptr;
+    this->m_pcTranslate     = nullptr;
+    this->m_nServerID       = 0;
+    this->m_nMyClientID     = 0;
+
+    this->m_bWhisperKnown   = false;
+    this->m_bPttState       = false;
+    this->m_bNewPttState    = false;
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+whisper_transaction::~whisper_transaction()
+{
+}
+
+/* ----------------------------------------------------------------------------
+* set interfaces
+*/
+void whisper_transaction::init(struct TS3Functions *pstTs3Functions, language_pkg *pcTranslate, uint64 nServerID, anyID nMyClientID)
+{
+    this->m_pstTs3Functions = pstTs3Functions;
+    this->m_pcTranslate     = pcTranslate;
+    this->m_nServerID       = nServerID;
+    this->m_nMyClientID     = nMyClientID;
+}
+
+/* ----------------------------------------------------------------------------
+* start new transition, wanted state = committed state
+*/
+void whisper_transaction::begin()
+{
+    this->m_vNewChannel     = this->m_vChannel;
+    this->m_vNewClient      = this->m_vClient;
+    this->m_bNewPttState    = this->m_bPttState;
+}
+
+/* ----------------------------------------------------------------------------
+* record wanted state
+*/
+void whisper_transaction::reset_whisper_list()
+{
+    this->m_vNewChannel.clear();
+    this->m_vNewClient.clear();
+}
+
+void whisper_transaction::set_whisper_list(const uint64 *pnChannelList, const anyID *pnClientList)
+{
+    reset_whisper_list();
+    for (int ii = 0; (pnChannelList != nullptr) && (pnChannelList[ii] != 0); ii++)
+        this->m_vNewChannel.push_back(pnChannelList[ii]);
+    for (int ii = 0; (pnClientList != nullptr) && (pnClientList[ii] != 0); ii++)
+        this->m_vNewClient.push_back(pnClientList[ii]);
+}
+
+void whisper_transaction::set_ptt(bool bActive)
+{
+    this->m_bNewPttState = bActive;
+}
+
+/* ----------------------------------------------------------------------------
+* send changes to TS3
+*/
+void whisper_transaction::commit()
+{
+    CALL_STACK
+    if (this->m_pstTs3Functions == nullptr)
+        return;
+
+    if (this->m_bNewPttState)
+    {
+        // set targets first, PTT must never be active with the targets of the old profile
+        commit_whisper_list();
+        if (!commit_ptt(true))
+            commit_ptt(false);
+    }
+    else
+    {
+        // release PTT first, otherwise the old PTT talks to the default channel for a moment
+        commit_ptt(false);
+        commit_whisper_list();
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* send whisper list, if it differs from the committed one
+*/
+void whisper_transaction::commit_whisper_list()
+{
+    const size_t nBuffSize = 512;
+    char cBuffer[nBuffSize];
+
+    if (this->m_bWhisperKnown && (this->m_vNewChannel == this->m_vChannel) && (this->m_vNewClient == this->m_vClient))
+        return;
+
+    bool bReset = this->m_vNewChannel.empty() && this->m_vNewClient.empty();
+
+    // TS3 expects zero terminated lists or NULL
+    std::vector<uint64> vChannel = this->m_vNewChannel;
+    std::vector<anyID>  vClient  = this->m_vNewClient;
+    vChannel.push_back(0);
+    vClient.push_back(0);
+
+    unsigned int nError = this->m_pstTs3Functions->requestClientSetWhisperList(this->m_nServerID, this->m_nMyClientID,
+        this->m_vNewChannel.empty() ? NULL : vChannel.data(), this->m_vNewClient.empty() ? NULL : vClient.data(), NULL);
+    if (nError != ERROR_ok)
+    {
+        // state of TS3 is unknown now => send again on next commit
+        this->m_bWhisperKnown = false;
+        if (bReset)
+        {
+            this->m_pstTs3Functions->logMessage(TRANSLATE_PTR("hotkey_ErrReset"), LogLevel_ERROR, "WhisperMaster2000", this->m_nServerID);
+        }
+        else
+        {
+            sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("error_ErrCreateWhisper"), "plugin_base::onHotkeyEvent", nError);
+            this->m_pstTs3Functions->logMessage(cBuffer, LogLevel_ERROR, "WhisperMaster2000", this->m_nServerID);
+        }
+        return;
+    }
+
+    this->m_bWhisperKnown   = true;
+    this->m_vChannel        = this->m_vNewChannel;
+    this->m_vClient         = this->m_vNewClient;
+}
+
+/* ----------------------------------------------------------------------------
+* (de-)activate PTT, if it differs from the committed state
+*   returns false, if activation was sent but could not be flushed
+*/
+bool whisper_transaction::commit_ptt(bool bActive)
+{
+    unsigned int nError = ERROR_ok;
+    const size_t nBuffSize = 512;
+    char cBuffer[nBuffSize];
+
+    if (this->m_bPttState == bActive)
+        return true;
+
+    nError = this->m_pstTs3Functions->setClientSelfVariableAsInt(this->m_nServerID, CLIENT_INPUT_DEACTIVATED, bActive ? INPUT_ACTIVE : INPUT_DEACTIVATED);
+    if (nError != ERROR_ok)
+    {
+        sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("hotkey_ErrActivate1"), nError);
+        this->m_pstTs3Functions->logMessage(cBuffer, LogLevel_ERROR, "WhisperMaster2000", this->m_nServerID);
+        return true;
+    }
+
+    this->m_bPttState = bActive;
+    nError = this->m_pstTs3Functions->flushClientSelfUpdates(this->m_nServerID, NULL);
+    if ((nError != ERROR_ok) && (nError != ERROR_undefined) && (nError != ERROR_ok_no_update))
+    {
+        sprintf_s(cBuffer, nBuffSize, TRANSLATE_PTR("hotkey_ErrActivate2"), nError);
+        this->m_pstTs3Functions->logMessage(cBuffer, LogLevel_WARNING, "WhisperMaster2000", this->m_nServerID);
+        return !bActive;
+    }
+    return true;
+}
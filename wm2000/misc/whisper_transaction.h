@@ -0,0 +1,55 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <vector>
+#include "misc/language_pkg.h"
+#include "misc/error_handler.h"
+#include "ts3_functions.h"
+
+/* ----------------------------------------------------------------------------
+* collects whisper list and PTT changes of one hotkey transition
+*
+* set_*() only record the wanted state, commit() sends the difference to the
+* last committed state: no call for an unchanged whisper list, no flush
+* without a changed self variable. On activation the whisper list is set
+* before PTT, on deactivation PTT is released before the whisper list.
+*/
+class whisper_transaction
+{
+public:
+    whisper_transaction();
+    ~whisper_transaction();
+
+    void                init(struct TS3Functions *pstTs3Functions, language_pkg *pcTranslate, uint64 nServerID, anyID nMyClientID);
+
+    void                begin();
+    void                reset_whisper_list();
+    void                set_whisper_list(const uint64 *pnChannelList, const anyID *pnClientList);
+    void                set_ptt(bool bActive);
+    void                commit();
+
+    bool                get_ptt() { return this->m_bPttState; };
+
+protected:
+    void                commit_whisper_list();
+    bool                commit_ptt(bool bActive);
+
+private:
+    struct TS3Functions *m_pstTs3Functions;     // TS3 interface functions
+    language_pkg        *m_pcTranslate;         // language converter
+    error_handler        m_cErrHandler;         // link to error handler
+    uint64               m_nServerID;           // ID of connected Server
+    anyID                m_nMyClientID;         // ID of own client on this Server
+
+    // committed state
+    bool                 m_bWhisperKnown;       // whisper list was set by this class at least once
+    std::vector<uint64>  m_vChannel;            // channels of committed whisper list (empty => reset)
+    std::vector<anyID>   m_vClient;             // clients of committed whisper list
+    bool                 m_bPttState;           // state of PTT activation
+
+    // wanted state
+    std::vector<uint64>  m_vNewChannel;
+    std::vector<anyID>   m_vNewClient;
+    bool                 m_bNewPttState;
+};
@@ -0,0 +1,255 @@
+#include "misc/work_pool.h"
+
+#if USE_CALL_STACK
+#define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
+#else
+#define CALL_STACK
+#endif
+
+// pool and queue of the calling thread, nullptr / -1 for threads outside of a pool
+static thread_local work_pool  *s_pcOwnPool  = nullptr;
+static thread_local int         s_iOwnQueue  = -1;
+
+/* ----------------------------------------------------------------------------
+* constructor
+*/
+work_pool::work_pool()
+{
+    this->m_nPending    = 0;
+    this->m_nIdle       = 0;
+    this->m_nNextQueue  = 0;
+    this->m_bStop       = false;
+}
+
+/* ----------------------------------------------------------------------------
+* destructor
+*/
+work_pool::~work_pool()
+{
+    stop();
+}
+
+/* ----------------------------------------------------------------------------
+* start worker threads
+*/
+void work_pool::start(size_t nThreads)
+{
+    CALL_STACK
+    if (!this->m_vWorker.empty())
+        return;
+
+    if (nThreads == 0)
+    {
+        unsigned int nCores = boost::thread::hardware_concurrency();
+        nThreads = (nCores > 1) ? nCores - 1 : 1;
+    }
+    if (nThreads > WORK_POOL_MAX_THREADS)
+        nThreads = WORK_POOL_MAX_THREADS;
+
+    this->m_bStop = false;
+    for (size_t ii = 0; ii < nThreads; ii++)
+        this->m_vQueue.push_back(new task_queue());
+    for (size_t ii = 0; ii < nThreads; ii++)
+        this->m_vWorker.push_back(new boost::thread(&work_pool::worker_loop, this, (int)ii));
+}
+
+/* ----------------------------------------------------------------------------
+* stop worker threads, tasks that were not started yet run in this thread
+*/
+void work_pool::stop()
+{
+    CALL_STACK
+    if (this->m_vWorker.empty())
+        return;
+
+    this->m_bStop = true;
+    {
+        boost::lock_guard<boost::mutex> lock(this->m_cWakeMutex);
+        this->m_cWakeCond.notify_all();
+    }
+    for (size_t ii = 0; ii < this->m_vWorker.size(); ii++)
+    {
+        this->m_vWorker[ii]->join();
+        delete this->m_vWorker[ii];
+    }
+    this->m_vWorker.clear();
+
+    task fTask;
+    for (size_t ii = 0; ii < this->m_vQueue.size(); ii++)
+        while (pop_task((int)ii, fTask))
+            run_task(fTask);
+
+    for (size_t ii = 0; ii < this->m_vQueue.size(); ii++)
+        delete this->m_vQueue[ii];
+    this->m_vQueue.clear();
+}
+
+/* ----------------------------------------------------------------------------
+* queue task for the workers
+*/
+void work_pool::submit(task fTask)
+{
+    if (this->m_vWorker.empty())
+    {
+        run_task(fTask);
+        return;
+    }
+
+    // workers keep their follow-up tasks local, other threads spread them
+    int iQueue = (s_pcOwnPool == this) ? s_iOwnQueue : (int)(this->m_nNextQueue++ % this->m_vQueue.size());
+    this->m_nPending++;
+    {
+        boost::lock_guard<boost::mutex> lock(this->m_vQueue[iQueue]->cMutex);
+        this->m_vQueue[iQueue]->dTask.push_back(std::move(fTask));
+    }
+
+    // pairs with worker_loop: either the worker sees m_nPending or we see it idle
+    if (this->m_nIdle > 0)
+    {
+        boost::lock_guard<boost::mutex> lock(this->m_cWakeMutex);
+        this->m_cWakeCond.notify_one();
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* run all tasks in parallel and wait for them (fork/join)
+*/
+void work_pool::run_all(const std::vector<task>& vTask)
+{
+    CALL_STACK
+    if (vTask.empty())
+        return;
+
+    std::shared_ptr<task_batch> pcBatch = std::make_shared<task_batch>();
+    pcBatch->vTask  = vTask;
+    pcBatch->nNext  = 0;
+    pcBatch->nDone  = 0;
+
+    // helpers claim tasks of the batch until it is empty, at most one per task
+    size_t nHelper = (vTask.size() - 1 < this->m_vWorker.size()) ? vTask.size() - 1 : this->m_vWorker.size();
+    for (size_t ii = 0; ii < nHelper; ii++)
+    {
+        error_handler *pcErrHandler = &this->m_cErrHandler;
+        submit([pcBatch, pcErrHandler]() { run_batch(pcBatch, pcErrHandler); });
+    }
+
+    // tasks claimed by helpers may still run, the last one signals the batch
+    run_batch(pcBatch, &this->m_cErrHandler);
+    boost::unique_lock<boost::mutex> lock(pcBatch->cDoneMutex);
+    while (pcBatch->nDone.load(std::memory_order_acquire) < pcBatch->vTask.size())
+        pcBatch->cDoneCond.wait(lock);
+}
+
+/* ----------------------------------------------------------------------------
+* claim and run tasks of a batch
+*/
+void work_pool::run_batch(const std::shared_ptr<task_batch>& pcBatch, error_handler *pcErrHandler)
+{
+    for (size_t nIndex = pcBatch->nNext++; nIndex < pcBatch->vTask.size(); nIndex = pcBatch->nNext++)
+    {
+        try
+        {
+            pcBatch->vTask[nIndex]();
+        }
+        catch (std::exception &e)
+        {
+            pcErrHandler->error_log(__FUNCSIG__, e);
+        }
+        catch (boost::exception &e)
+        {
+            pcErrHandler->error_log(__FUNCSIG__, e);
+        }
+        catch (...)
+        {
+            pcErrHandler->error_log(__FUNCSIG__);
+        }
+        if (pcBatch->nDone.fetch_add(1, std::memory_order_acq_rel) + 1 == pcBatch->vTask.size())
+        {
+            boost::lock_guard<boost::mutex> lock(pcBatch->cDoneMutex);
+            pcBatch->cDoneCond.notify_all();
+        }
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* newest task of the own queue, else the oldest task of another queue
+*/
+bool work_pool::pop_task(int iQueue, task& fTask)
+{
+    size_t nQueues = this->m_vQueue.size();
+    for (size_t ii = 0; ii < nQueues; ii++)
+    {
+        task_queue *pcQueue = this->m_vQueue[(iQueue + ii) % nQueues];
+        boost::lock_guard<boost::mutex> lock(pcQueue->cMutex);
+        if (pcQueue->dTask.empty())
+            continue;
+
+        if (ii == 0)
+        {
+            fTask = std::move(pcQueue->dTask.back());
+            pcQueue->dTask.pop_back();
+        }
+        else
+        {
+            fTask = std::move(pcQueue->dTask.front());
+            pcQueue->dTask.pop_front();
+        }
+        this->m_nPending--;
+        return true;
+    }
+    return false;
+}
+
+/* ----------------------------------------------------------------------------
+* run one task, exceptions are logged
+*/
+void work_pool::run_task(task& fTask)
+{
+    try
+    {
+        fTask();
+    }
+    catch (std::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (boost::exception &e)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__, e);
+    }
+    catch (...)
+    {
+        this->m_cErrHandler.error_log(__FUNCSIG__);
+    }
+}
+
+/* ----------------------------------------------------------------------------
+* worker thread
+*/
+void work_pool::worker_loop(int iIndex)
+{
+    CALL_STACK
+    s_pcOwnPool = this;
+    s_iOwnQueue = iIndex;
+
+    task fTask;
+    while (!this->m_bStop)
+    {
+        if (pop_task(iIndex, fTask))
+        {
+            run_task(fTask);
+            fTask = nullptr;
+            continue;
+        }
+
+        // timeout only as safety net, submit wakes a worker
+        boost::unique_lock<boost::mutex> lock(this->m_cWakeMutex);
+        this->m_nIdle++;
+        if ((this->m_nPending == 0) && !this->m_bStop)
+            this->m_cWakeCond.wait_for(lock, boost::chrono::milliseconds(100));
+        this->m_nIdle--;
+    }
+
+    s_pcOwnPool = nullptr;
+    s_iOwnQueue = -1;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <boost/thread.hpp>
+#include "misc/error_handler.h"
+
+#define WORK_POOL_MAX_THREADS 4         // small pool, work is spread over a few server tabs
+
+/* ----------------------------------------------------------------------------
+* small work-stealing thread pool
+*
+* every worker has its own task deque: submit from a worker pushes to its own
+* deque (run LIFO by the owner), other threads push round robin. An idle worker
+* steals the oldest task of another deque. run_all spreads a batch of tasks
+* over the workers and the calling thread and returns when all are done, the
+* caller only runs tasks of its own batch.
+*/
+class work_pool
+{
+public:
+    typedef std::function<void()> task;
+
+    work_pool();
+    ~work_pool();
+
+    void                start(size_t nThreads = 0);         // 0 => number of cores - 1, max. WORK_POOL_MAX_THREADS
+    void                stop();                             // join workers, remaining tasks run in the calling thread
+    size_t              get_num_threads()   { return this->m_vWorker.size(); };
+
+    void                submit(task fTask);                 // without workers the task runs in the calling thread
+    void                run_all(const std::vector<task>& vTask);
+
+protected:
+    struct task_queue
+    {
+        boost::mutex        cMutex;
+        std::deque<task>    dTask;
+    };
+
+    struct task_batch
+    {
+        std::vector<task>   vTask;
+        std::atomic<size_t> nNext;          // next task to claim
+        std::atomic<size_t> nDone;
+        boost::mutex        cDoneMutex;     // caller of run_all waits for the last task
+        boost::condition_variable cDoneCond;
+    };
+
+    bool                pop_task(int iQueue, task& fTask);
+    void                run_task(task& fTask);
+    static void         run_batch(const std::shared_ptr<task_batch>& pcBatch, error_handler *pcErrHandler);
+    void                worker_loop(int iIndex);
+
+private:
+    error_handler                   m_cErrHandler;      // link to error handler
+
+    std::vector<task_queue*>        m_vQueue;           // one per worker
+    std::vector<boost::thread*>     m_vWorker;
+    boost::mutex                    m_cWakeMutex;       // workers wait for new tasks
+    boost::condition_variable       m_cWakeCond;
+    std::atomic<size_t>             m_nPending;         // tasks in all queues
+    std::atomic<size_t>             m_nIdle;            // workers waiting for m_cWakeCond
+    std::atomic<size_t>             m_nNextQueue;       // round robin for other threads
+    std::atomic<bool>               m_bStop;
+};
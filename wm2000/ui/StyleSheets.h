@@ -1,8 +1,8 @@
 #pragma once
 
-#include <QtWidgets\QProxyStyle>
-#include <QtWidgets\QTabBar>
-#include <QtWidgets\QStyleOption>
+#include <QtWidgets/QProxyStyle>
+#include <QtWidgets/QTabBar>
+#include <QtWidgets/QStyleOption>
 
 class CustomTabStyle : public QProxyStyle
 {
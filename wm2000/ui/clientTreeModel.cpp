@@ -0,0 +1,340 @@
+#include "clientTreeModel.h"
+#include <map>
+#include <limits>
+#include <algorithm>
+
+#if USE_CALL_STACK
+#define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
+#else
+#define CALL_STACK
+#endif
+
+/*
+*   Constructor of model
+*/
+clientTreeModel::clientTreeModel(QObject *parent)
+    : QAbstractItemModel(parent)
+{
+    CALL_STACK
+    m_cRoot.iType   = -1;
+    m_cRoot.nId     = 0;
+    m_cRoot.iLevel  = -1;
+    m_cRoot.pParent = nullptr;
+    m_cRoot.iRow    = 0;
+    m_cRoot.nFetchLimit = std::numeric_limits<size_t>::max();   // server rows are always created
+
+    // prepare fonts
+    m_cServerFont.setBold(true);
+    m_cServerFont.setUnderline(true);
+    m_cServerFont.setWeight(75);
+
+    m_cChFont.setBold(true);
+    m_cChFont.setWeight(75);
+}
+
+
+/*
+*   destructor of model
+*/
+clientTreeModel::~clientTreeModel()
+{
+    CALL_STACK
+    for (tree_node *pChild : m_cRoot.vpChildren)
+        delete_node(pChild);
+}
+
+
+/*
+*   set header text
+*/
+void clientTreeModel::set_header(const QString& sName, const QString& sState)
+{
+    m_sHeader[0] = sName;
+    m_sHeader[1] = sState;
+    emit headerDataChanged(Qt::Horizontal, 0, 1);
+}
+
+
+/*
+*   update model to the given rows
+*   rows are identified by type and ID, existing rows are kept (including their expand state)
+*   sub rows are only created when the view fetches them (see fetchMore)
+*/
+void clientTreeModel::apply(std::vector<client_tree_row> vcRows)
+{
+    CALL_STACK
+    apply_children(&m_cRoot, vcRows);
+}
+
+
+/*
+*   update children of one node: remove, move, insert or change only rows that differ
+*     only the part of the rows that was fetched by the view is compared, the rest is kept in vcRows
+*/
+void clientTreeModel::apply_children(tree_node *pParent, std::vector<client_tree_row>& vcRows)
+{
+    QModelIndex cParentIdx = index_from_node(pParent);
+    bool bHadRows = !pParent->vcRows.empty();
+
+    //node gets its first sub rows, create them directly so the view notices the new children
+    if (pParent->vcRows.empty() && pParent->nFetchLimit == 0)
+        pParent->nFetchLimit = CLIENT_TREE_FETCH_SIZE;
+
+    int iTarget = (int)std::min(pParent->nFetchLimit, vcRows.size());
+
+    //collect wanted keys of fetched part
+    std::map<std::pair<int, uint64>, int> mWanted;
+    for (int ii = 0; ii < iTarget; ii++)
+        mWanted[std::make_pair(vcRows[ii].iType, vcRows[ii].nId)] = ii;
+
+    //remove rows that are not wanted anymore or moved behind the fetched part (backwards, in blocks)
+    int iLast = (int)pParent->vpChildren.size() - 1;
+    while (iLast >= 0)
+    {
+        tree_node *pNode = pParent->vpChildren[iLast];
+        if (mWanted.find(std::make_pair(pNode->iType, pNode->nId)) != mWanted.end())
+        {
+            iLast--;
+            continue;
+        }
+
+        int iFirst = iLast;
+        while (iFirst > 0 && mWanted.find(std::make_pair(pParent->vpChildren[iFirst - 1]->iType, pParent->vpChildren[iFirst - 1]->nId)) == mWanted.end())
+            iFirst--;
+
+        beginRemoveRows(cParentIdx, iFirst, iLast);
+        for (int ii = iFirst; ii <= iLast; ii++)
+            delete_node(pParent->vpChildren[ii]);
+        pParent->vpChildren.erase(pParent->vpChildren.begin() + iFirst, pParent->vpChildren.begin() + iLast + 1);
+        renumber(pParent, iFirst);
+        endRemoveRows();
+
+        iLast = iFirst - 1;
+    }
+
+    //walk through wanted rows, all remaining rows are part of the wanted list
+    for (int ii = 0; ii < iTarget; ii++)
+    {
+        client_tree_row& cRow = vcRows[ii];
+        tree_node *pNode = nullptr;
+
+        if ((ii < (int)pParent->vpChildren.size()) && (pParent->vpChildren[ii]->iType == cRow.iType) && (pParent->vpChildren[ii]->nId == cRow.nId))
+        {
+            pNode = pParent->vpChildren[ii];
+        }
+        else
+        {
+            //row exists at a later position => move it
+            for (int jj = ii + 1; jj < (int)pParent->vpChildren.size(); jj++)
+            {
+                if ((pParent->vpChildren[jj]->iType == cRow.iType) && (pParent->vpChildren[jj]->nId == cRow.nId))
+                {
+                    beginMoveRows(cParentIdx, jj, jj, cParentIdx, ii);
+                    pNode = pParent->vpChildren[jj];
+                    pParent->vpChildren.erase(pParent->vpChildren.begin() + jj);
+                    pParent->vpChildren.insert(pParent->vpChildren.begin() + ii, pNode);
+                    renumber(pParent, ii);
+                    endMoveRows();
+                    break;
+                }
+            }
+        }
+
+        if (pNode == nullptr)
+        {
+            //new row, sub rows are created when the view fetches them
+            beginInsertRows(cParentIdx, ii, ii);
+            pParent->vpChildren.insert(pParent->vpChildren.begin() + ii, create_node(pParent, cRow));
+            renumber(pParent, ii);
+            endInsertRows();
+            continue;
+        }
+
+        //existing row, report changed text only
+        if ((pNode->sName != cRow.sName) || (pNode->sState != cRow.sState) || (pNode->iLevel != cRow.iLevel))
+        {
+            pNode->sName  = cRow.sName;
+            pNode->sState = cRow.sState;
+            pNode->iLevel = cRow.iLevel;
+            emit dataChanged(index_from_node(pNode, 0), index_from_node(pNode, 1));
+        }
+        apply_children(pNode, cRow.vcChildren);
+    }
+
+    //keep all rows, the ones behind the fetched part are created on request
+    pParent->vcRows = std::move(vcRows);
+
+    //no created sub rows tell the view about a changed expand state (see hasChildren)
+    if ((pParent != &m_cRoot) && pParent->vpChildren.empty() && (bHadRows != !pParent->vcRows.empty()))
+        emit dataChanged(index_from_node(pParent, 0), index_from_node(pParent, 1));
+}
+
+
+/*
+*   create node from row, sub rows are moved to the node but not created yet
+*/
+clientTreeModel::tree_node* clientTreeModel::create_node(tree_node *pParent, client_tree_row& cRow)
+{
+    tree_node *pNode = new tree_node;
+    pNode->iType        = cRow.iType;
+    pNode->nId          = cRow.nId;
+    pNode->sName        = cRow.sName;
+    pNode->sState       = cRow.sState;
+    pNode->iLevel       = cRow.iLevel;
+    pNode->pParent      = pParent;
+    pNode->iRow         = 0;
+    pNode->vcRows       = std::move(cRow.vcChildren);
+    pNode->nFetchLimit  = 0;
+    return pNode;
+}
+
+
+/*
+*   delete node and all sub nodes
+*/
+void clientTreeModel::delete_node(tree_node *pNode)
+{
+    for (tree_node *pChild : pNode->vpChildren)
+        delete_node(pChild);
+    delete pNode;
+}
+
+
+/*
+*   update row numbers after a change at position iFirst
+*/
+void clientTreeModel::renumber(tree_node *pParent, int iFirst)
+{
+    for (int ii = iFirst; ii < (int)pParent->vpChildren.size(); ii++)
+        pParent->vpChildren[ii]->iRow = ii;
+}
+
+
+/*
+*   helper to convert between index and node
+*/
+clientTreeModel::tree_node* clientTreeModel::node_from_index(const QModelIndex &index) const
+{
+    if (index.isValid())
+        return static_cast<tree_node*>(index.internalPointer());
+    return const_cast<tree_node*>(&m_cRoot);
+}
+
+QModelIndex clientTreeModel::index_from_node(tree_node *pNode, int column) const
+{
+    if ((pNode == nullptr) || (pNode == &m_cRoot))
+        return QModelIndex();
+    return createIndex(pNode->iRow, column, pNode);
+}
+
+
+/*
+*   QAbstractItemModel interface
+*/
+QModelIndex clientTreeModel::index(int row, int column, const QModelIndex &parent) const
+{
+    tree_node *pParent = node_from_index(parent);
+    if ((row < 0) || (row >= (int)pParent->vpChildren.size()) || (column < 0) || (column > 1))
+        return QModelIndex();
+    return createIndex(row, column, pParent->vpChildren[row]);
+}
+
+QModelIndex clientTreeModel::parent(const QModelIndex &child) const
+{
+    if (!child.isValid())
+        return QModelIndex();
+    return index_from_node(node_from_index(child)->pParent);
+}
+
+int clientTreeModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.column() > 0)
+        return 0;
+    return (int)node_from_index(parent)->vpChildren.size();
+}
+
+int clientTreeModel::columnCount(const QModelIndex &parent) const
+{
+    return 2;
+}
+
+bool clientTreeModel::hasChildren(const QModelIndex &parent) const
+{
+    if (parent.column() > 0)
+        return false;
+    return !node_from_index(parent)->vcRows.empty();
+}
+
+bool clientTreeModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (parent.column() > 0)
+        return false;
+    tree_node *pNode = node_from_index(parent);
+    return pNode->vpChildren.size() < pNode->vcRows.size();
+}
+
+void clientTreeModel::fetchMore(const QModelIndex &parent)
+{
+    CALL_STACK
+    if (parent.column() > 0)
+        return;
+
+    //create next block of sub rows
+    tree_node *pNode = node_from_index(parent);
+    int iFirst = (int)pNode->vpChildren.size();
+    int iLast  = (int)std::min(pNode->vcRows.size(), pNode->vpChildren.size() + CLIENT_TREE_FETCH_SIZE) - 1;
+    if (iLast < iFirst)
+        return;
+
+    beginInsertRows(parent, iFirst, iLast);
+    for (int ii = iFirst; ii <= iLast; ii++)
+    {
+        pNode->vpChildren.push_back(create_node(pNode, pNode->vcRows[ii]));
+        pNode->vpChildren.back()->iRow = ii;
+    }
+    //rows added later inside the fetched block are created directly
+    pNode->nFetchLimit = std::max(pNode->nFetchLimit, (size_t)iFirst + CLIENT_TREE_FETCH_SIZE);
+    endInsertRows();
+}
+
+QVariant clientTreeModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid())
+        return QVariant();
+
+    tree_node *pNode = node_from_index(index);
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        return (index.column() == 0) ? pNode->sName : pNode->sState;
+    case Qt::FontRole:
+        if ((index.column() == 0) && (pNode->iType == ITEM_SERVER))
+            return m_cServerFont;
+        if ((index.column() == 0) && (pNode->iType == ITEM_CHANNEL))
+            return m_cChFont;
+        break;
+    case ROLE_TYPE:
+        return pNode->iType;
+    case ROLE_ID:
+        return (qulonglong)pNode->nId;
+    case ROLE_LEVEL:
+        return pNode->iLevel;
+    default:
+        break;
+    }
+    return QVariant();
+}
+
+QVariant clientTreeModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if ((orientation == Qt::Horizontal) && (role == Qt::DisplayRole) && (section >= 0) && (section <= 1))
+        return m_sHeader[section];
+    return QVariant();
+}
+
+Qt::ItemFlags clientTreeModel::flags(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return Qt::NoItemFlags;
+    return Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled;
+}
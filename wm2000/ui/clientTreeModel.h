@@ -0,0 +1,94 @@
+#pragma once
+#include <QtCore/QAbstractItemModel>
+#include <QtGui/QFont>
+#include <vector>
+
+#include "teamspeak/public_definitions.h"
+#include "misc/error_handler.h"
+
+#define CLIENT_TREE_FETCH_SIZE  100     // number of rows created per fetchMore() call
+
+/*
+*   one row of the client tree, used to describe the wanted content of the model
+*/
+struct client_tree_row
+{
+    int                             iType;          // clientTreeModel::eItemType
+    uint64                          nId;            // server, channel or client ID
+    QString                         sName;          // text of column 0
+    QString                         sState;         // text of column 1
+    int                             iLevel;         // channel level (-1 if not used)
+    std::vector<client_tree_row>    vcChildren;     // sub rows
+};
+
+class clientTreeModel :
+    public QAbstractItemModel
+{
+    Q_OBJECT
+
+public:
+    clientTreeModel(QObject *parent = Q_NULLPTR);
+    ~clientTreeModel();
+
+    enum eItemRole
+    {
+        ROLE_TYPE = Qt::UserRole,
+        ROLE_ID,
+        ROLE_LEVEL
+    };
+
+    enum eItemType
+    {
+        ITEM_MIN,
+        ITEM_SERVER = ITEM_MIN,
+        ITEM_CHANNEL,
+        ITEM_CLIENT,
+        ITEM_MAX = ITEM_CLIENT
+    };
+
+    //update model, only changed rows are reported to the view
+    void set_header(const QString& sName, const QString& sState);
+    void apply(std::vector<client_tree_row> vcRows);
+
+    //QAbstractItemModel interface
+    QModelIndex     index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex     parent(const QModelIndex &child) const override;
+    int             rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int             columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    bool            hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    bool            canFetchMore(const QModelIndex &parent) const override;
+    void            fetchMore(const QModelIndex &parent) override;
+    QVariant        data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant        headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags   flags(const QModelIndex &index) const override;
+
+protected:
+    struct tree_node
+    {
+        int                         iType;
+        uint64                      nId;
+        QString                     sName;
+        QString                     sState;
+        int                         iLevel;
+        tree_node                  *pParent;
+        int                         iRow;           // position inside pParent->vpChildren
+        std::vector<client_tree_row> vcRows;        // wanted sub rows, children of fetched rows are moved to their node
+        size_t                      nFetchLimit;    // number of sub rows requested by the view
+        std::vector<tree_node*>     vpChildren;     // owned by this node, created for the first nFetchLimit sub rows only
+    };
+
+    tree_node*  node_from_index(const QModelIndex &index) const;
+    QModelIndex index_from_node(tree_node *pNode, int column = 0) const;
+
+    void        apply_children(tree_node *pParent, std::vector<client_tree_row>& vcRows);
+    tree_node*  create_node(tree_node *pParent, client_tree_row& cRow);
+    void        delete_node(tree_node *pNode);
+    void        renumber(tree_node *pParent, int iFirst);
+
+protected:
+    tree_node                   m_cRoot;            // invisible root, children are the server rows
+    QString                     m_sHeader[2];       // header text
+    QFont                       m_cServerFont;
+    QFont                       m_cChFont;
+    error_handler               m_cErrHandler;      // link to error handler
+};
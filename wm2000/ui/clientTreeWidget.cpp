@@ -1,6 +1,6 @@
 #include "clientTreeWidget.h"
 
-#define TRANSLATE(a) QString(this->m_cTranslate.translate(a).c_str())
+#define TRANSLATE(a) QString(this->m_cTranslate.translate(a))
 #if USE_CALL_STACK
 #define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
 #else
@@ -11,22 +11,26 @@
 *   Constructor of widget
 */
 clientTreeWidget::clientTreeWidget(QWidget *parent)
-    : QTreeWidget(parent)
+    : QTreeView(parent)
 {
     CALL_STACK
     m_pcConfigData      = nullptr;
-    m_qTreeWidgetItem   = nullptr;
     m_iActProfile       = -1;
     m_pcActionIgnore    = nullptr;
     m_pcActionDelete    = nullptr;
-
-    // prepare fonts
-    m_cServerFont.setBold(true);
-    m_cServerFont.setUnderline(true);
-    m_cServerFont.setWeight(75);
-
-    m_cChFont.setBold(true);
-    m_cChFont.setWeight(75);
+    m_pcWorkPool        = nullptr;
+
+    // model is owned by the view, new server/channel rows are expanded like before
+    m_pcModel = new clientTreeModel(this);
+    this->setModel(m_pcModel);
+    connect(m_pcModel, &QAbstractItemModel::rowsInserted, this, &clientTreeWidget::expand_new_rows);
+
+    // rows are built in background, only the diff is applied on the GUI thread
+    m_cRequest.nRequestId = 0;
+    m_bRequestPending   = false;
+    m_bWorkerStop       = false;
+    m_nRequestId        = 0;
+    m_cWorker = boost::thread(&clientTreeWidget::worker_loop, this);
 }
 
 
@@ -36,9 +40,6 @@ void clientTreeWidget::init(config_container *pcConfigData, QIcon *pcIgnoreIcon,
     m_pcConfigData = pcConfigData;
 
     //init header
-    this->clear();
-    m_qTreeWidgetItem = new QTreeWidgetItem();
-    this->setHeaderItem(m_qTreeWidgetItem);
     this->setColumnWidth(0, 200);
 
     //add context menu
@@ -52,7 +53,7 @@ void clientTreeWidget::init(config_container *pcConfigData, QIcon *pcIgnoreIcon,
     m_pcContextMenu->addAction(m_pcActionDelete);
 
     this->setContextMenuPolicy(Qt::CustomContextMenu);
-    connect(this, &QTreeWidget::customContextMenuRequested, this, &clientTreeWidget::prepare_context_menu);
+    connect(this, &QTreeView::customContextMenuRequested, this, &clientTreeWidget::prepare_context_menu);
 
     //add text
     this->set_language(this->m_pcConfigData->s_get_Language());
@@ -70,8 +71,7 @@ void clientTreeWidget::set_language(std::string sNewLanguage)
     this->m_cTranslate.set_language(sNewLanguage);
 
     //update all "user"
-    m_qTreeWidgetItem->setText(0, TRANSLATE(L"ctUi_treeHeaderRx"));
-    m_qTreeWidgetItem->setText(1, TRANSLATE(L"ctUi_treeHeaderState"));
+    m_pcModel->set_header(TRANSLATE(L"ctUi_treeHeaderRx"), TRANSLATE(L"ctUi_treeHeaderState"));
     this->setWhatsThis(TRANSLATE(L"ctUi_WhatIsTreeItem"));
 
     this->m_pcActionIgnore->setText(TRANSLATE(L"ctUi_contextIgnore"));
@@ -92,6 +92,13 @@ void clientTreeWidget::set_language(std::string sNewLanguage)
 clientTreeWidget::~clientTreeWidget()
 {
     CALL_STACK
+    {
+        boost::lock_guard<boost::mutex> lock(this->m_cRequestMutex);
+        this->m_bWorkerStop = true;
+    }
+    this->m_cRequestCond.notify_one();
+    if (this->m_cWorker.joinable())
+        this->m_cWorker.join();
 }
 
 /*
@@ -101,15 +108,15 @@ void clientTreeWidget::prepare_context_menu(const QPoint & pos)
 {
     CALL_STACK
     //get info about the selected item and bail out early, if no element is selected
-    QTreeWidgetItem *nd = this->itemAt(pos);
+    QModelIndex nd = this->indexAt(pos).siblingAtColumn(0);
     
     //if the Profile index or clientList is invalid, bail out early
-    if ((nd != nullptr) && (this->m_vcClientFilter.size() != 0))
+    if (nd.isValid() && (this->m_vcClientFilter.size() != 0))
     {
-        eItemType eType = (eItemType)nd->data(0, ROLE_TYPE).toInt();
-        uint64    nItemId = nd->data(0, ROLE_ID).toULongLong();
+        clientTreeModel::eItemType eType = (clientTreeModel::eItemType)nd.data(clientTreeModel::ROLE_TYPE).toInt();
+        uint64    nItemId = nd.data(clientTreeModel::ROLE_ID).toULongLong();
 
-        if ((eType >= ITEM_MIN) && (eType <= ITEM_MAX))
+        if ((eType >= clientTreeModel::ITEM_MIN) && (eType <= clientTreeModel::ITEM_MAX))
         {
             bool isFav = false;
             bool isIgnore = false;
@@ -119,10 +126,10 @@ void clientTreeWidget::prepare_context_menu(const QPoint & pos)
                 isFav = this->m_pcConfigData->s_get_ProfileType(m_iActProfile) == PROFILE_FAVORITE;
 
             // create menu
-            m_pcActionIgnore->setEnabled((eType == eItemType::ITEM_CHANNEL) && !isIgnore);
+            m_pcActionIgnore->setEnabled((eType == clientTreeModel::ITEM_CHANNEL) && !isIgnore);
             disconnect(m_cConnIgnore);
             m_cConnIgnore = connect(m_pcActionIgnore, &QAction::triggered, this, [=]() { emit channel_ignore_triggered(m_iActProfile, nItemId); });
-            m_pcActionDelete->setEnabled((eType == eItemType::ITEM_CHANNEL) && (isFav || isIgnore));
+            m_pcActionDelete->setEnabled((eType == clientTreeModel::ITEM_CHANNEL) && (isFav || isIgnore));
             disconnect(m_cConnDelete);
             m_cConnDelete = connect(m_pcActionDelete, &QAction::triggered, this, [=]() { emit channel_remove_triggered(m_iActProfile, nItemId); });
 
@@ -138,7 +145,7 @@ void clientTreeWidget::prepare_context_menu(const QPoint & pos)
 /*
 *   add entity of client filter
 */
-void clientTreeWidget::add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter)
+void clientTreeWidget::add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker)
 {
     CALL_STACK
     //lock other threads
@@ -170,6 +177,7 @@ void clientTreeWidget::add_pointer(client_filter *pcClientFilter, channel_filter
     //add entry
     if (!bItemFound)
         this->m_vcChannelFilter.push_back(pcChannelFilter);
+    this->m_mTalkTracker[pcClientFilter] = pcTalkTracker;
 
     //request unlock
     this->m_cClientTreeMutex.unlock();
@@ -181,7 +189,7 @@ void clientTreeWidget::add_pointer(client_filter *pcClientFilter, channel_filter
 /*
 *   delete entity of client_filter
 */
-void clientTreeWidget::delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter)
+void clientTreeWidget::delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker)
 {
     CALL_STACK
     //lock other threads
@@ -204,6 +212,7 @@ void clientTreeWidget::delete_pointer(client_filter *pcClientFilter, channel_fil
             break;
         }
     }
+    this->m_mTalkTracker.erase(pcClientFilter);
 
     //request unlock
     this->m_cClientTreeMutex.unlock();
@@ -218,18 +227,37 @@ void clientTreeWidget::delete_pointer(client_filter *pcClientFilter, channel_fil
 */
 void clientTreeWidget::update_meta_data()
 {
-    //update frequency at all server
+    //update frequency at all server (in parallel)
     this->m_cClientTreeMutex.lock();
+    std::vector<work_pool::task> vTask;
     for (std::vector<client_filter*>::iterator it = this->m_vcClientFilter.begin(); it != this->m_vcClientFilter.end(); it++)
     {
-        (*it)->m_cClientListMutex.lock();
-        (*it)->set_meta_data();
-        (*it)->m_cClientListMutex.unlock();
+        client_filter *pcFilter = *it;
+        vTask.push_back([pcFilter]() {
+            pcFilter->m_cClientListMutex.lock();
+            pcFilter->set_meta_data();
+            pcFilter->m_cClientListMutex.unlock();
+        });
     }
+    run_tasks(vTask);
     this->m_cClientTreeMutex.unlock();
 }
 
 
+/*
+*   run tasks for all server in work pool and wait for them
+*/
+void clientTreeWidget::run_tasks(const std::vector<work_pool::task>& vTask)
+{
+    CALL_STACK
+    if (this->m_pcWorkPool != nullptr)
+        this->m_pcWorkPool->run_all(vTask);
+    else
+        for (size_t ii = 0; ii < vTask.size(); ii++)
+            vTask[ii]();
+}
+
+
 /*
 *   return next frequency, that is not used bei any active client
 */
@@ -243,13 +271,34 @@ int clientTreeWidget::get_NextUnusedFreq()
     //if no clients connected
     if (this->m_vcClientFilter.size() != 0)
     {
-        //find frequency that is free in all instances
-        for (std::vector<client_filter*>::iterator it = this->m_vcClientFilter.begin(); it != this->m_vcClientFilter.end(); it++)
+        //collect used frequencies of all instances in parallel
+        std::vector<std::vector<char>> vvUsed(this->m_vcClientFilter.size());
+        std::vector<work_pool::task> vTask;
+        for (size_t ii = 0; ii < this->m_vcClientFilter.size(); ii++)
         {
-            //use iFreq-1 to make sure, that even if first instance sets one freq as free, that it is checked with all following instances
-            iFreq = (*it)->get_next_free_freq(iFreq - 1);
-            if (iFreq == 0)
-                break;
+            client_filter *pcFilter = this->m_vcClientFilter[ii];
+            std::vector<char> *pvUsed = &vvUsed[ii];
+            vTask.push_back([pcFilter, pvUsed]() {
+                pcFilter->m_cClientListMutex.lock();
+                pcFilter->get_used_freqs(*pvUsed);
+                pcFilter->m_cClientListMutex.unlock();
+            });
+        }
+        run_tasks(vTask);
+
+        //find frequency that is free in all instances and not used by our own frequency profiles
+        iFreq = 0;
+        for (int ii = 1; (ii <= this->m_pcConfigData->s_get_MaxNumFreq()) && (iFreq == 0); ii++)
+        {
+            bool bUsed = false;
+            for (size_t jj = 0; jj < vvUsed.size(); jj++)
+                bUsed |= (ii < (int)vvUsed[jj].size()) && vvUsed[jj][ii];
+
+            for (int jj = 0; (jj < this->m_pcConfigData->s_get_MaxNumProfiles()) && !bUsed; jj++)
+                bUsed = (this->m_pcConfigData->s_get_ProfileType(jj) == PROFILE_FREQUENCY) && (this->m_pcConfigData->s_get_ActiveFreq(jj) == ii);
+
+            if (!bUsed)
+                iFreq = ii;
         }
     }
 
@@ -260,36 +309,142 @@ int clientTreeWidget::get_NextUnusedFreq()
 }
 
 
+/*
+*   expand server and channel rows that were added to the model
+*     expanding lets the view fetch the first sub rows, which end up here again
+*/
+void clientTreeWidget::expand_new_rows(const QModelIndex &parent, int first, int last)
+{
+    for (int ii = first; ii <= last; ii++)
+    {
+        QModelIndex cIndex = this->m_pcModel->index(ii, 0, parent);
+        if (!this->m_pcModel->hasChildren(cIndex))
+            continue;
+
+        this->expand(cIndex);
+    }
+}
+
+
 /*
 *   update tree client/channel list
+*     only a snapshot of the settings is taken here, the rows are built by the worker thread
 */
 void clientTreeWidget::create_tree_entry(int iActProfile)
 {
     CALL_STACK
-    //make sure, that we are alone from now on
-    this->m_cClientTreeMutex.lock();
+    m_iActProfile = iActProfile;
 
-    //clear all old entries
-    this->clear();
+    tree_request cRequest;
+    cRequest.iActProfile    = iActProfile;
+    cRequest.eType          = PROFILE_OFF;
+    cRequest.iActiveFreq    = 0;
+    cRequest.nMinChLevel    = 0;
+    cRequest.nMaxChLevel    = 0;
+    cRequest.bUseIgnoreTx   = false;
+    cRequest.bUseSubChOfFav = false;
+
+    //lists are not thread safe, copy them while we are on the GUI thread
+    if (this->m_pcConfigData != nullptr)
+    {
+        if (iActProfile >= 0)
+        {
+            cRequest.eType          = this->m_pcConfigData->s_get_ProfileType(iActProfile);
+            cRequest.iActiveFreq    = this->m_pcConfigData->s_get_ActiveFreq(iActProfile);
+            cRequest.nMinChLevel    = this->m_pcConfigData->s_get_MinChLevel(iActProfile);
+            cRequest.nMaxChLevel    = this->m_pcConfigData->s_get_MaxChLevel(iActProfile);
+            cRequest.bUseIgnoreTx   = this->m_pcConfigData->s_get_UseIgnoreListTx(iActProfile);
+            cRequest.bUseSubChOfFav = this->m_pcConfigData->s_get_UseSubChOfFav(iActProfile);
+            if (cRequest.eType == PROFILE_FAVORITE)
+                cRequest.vcFavoriteList = *this->m_pcConfigData->s_get_FavoriteList(iActProfile);
+        }
+        cRequest.vcIgnoreList = *this->m_pcConfigData->s_get_IgnoreList();
+    }
 
-    m_iActProfile = iActProfile;
+    //replace older request, that was not started yet
+    {
+        boost::lock_guard<boost::mutex> lock(this->m_cRequestMutex);
+        cRequest.nRequestId = ++this->m_nRequestId;
+        this->m_cRequest = std::move(cRequest);
+        this->m_bRequestPending = true;
+    }
+    this->m_cRequestCond.notify_one();
+    return;
+}
+
+
+/*
+*   worker thread, always builds the latest request
+*/
+void clientTreeWidget::worker_loop()
+{
+    while (true)
+    {
+        tree_request cRequest;
+        {
+            boost::unique_lock<boost::mutex> lock(this->m_cRequestMutex);
+            while (!this->m_bRequestPending && !this->m_bWorkerStop)
+                this->m_cRequestCond.wait(lock);
+            if (this->m_bWorkerStop)
+                return;
+
+            cRequest = std::move(this->m_cRequest);
+            this->m_bRequestPending = false;
+        }
+
+        try
+        {
+            std::shared_ptr<std::vector<client_tree_row>> pvcRows = std::make_shared<std::vector<client_tree_row>>();
+            build_rows(cRequest, *pvcRows);
+
+            //newer request is waiting, skip GUI update
+            if (cRequest.nRequestId != this->m_nRequestId)
+                continue;
+
+            uint64 nRequestId = cRequest.nRequestId;
+            QMetaObject::invokeMethod(this, [this, pvcRows, nRequestId]() { apply_rows(nRequestId, *pvcRows); }, Qt::QueuedConnection);
+        }
+        catch (std::exception &e)
+        {
+            this->m_cErrHandler.error_log(__FUNCSIG__, e);
+        }
+        catch (boost::exception &e)
+        {
+            this->m_cErrHandler.error_log(__FUNCSIG__, e);
+        }
+        catch (...)
+        {
+            this->m_cErrHandler.error_log(__FUNCSIG__);
+        }
+    }
+}
+
+
+/*
+*   build rows of request (worker thread)
+*/
+void clientTreeWidget::build_rows(tree_request& cRequest, std::vector<client_tree_row>& vcRows)
+{
+    CALL_STACK
+    //make sure, that no filter is removed while we are reading
+    boost::lock_guard<boost::mutex> lock(this->m_cClientTreeMutex);
 
     //if the Profile index or clientList is invalid, bail out early
-    if ((this->m_vcClientFilter.size() != 0) && (this->m_vcChannelFilter.size() != 0) && (iActProfile >= 0))
+    if ((this->m_vcClientFilter.size() != 0) && (this->m_vcChannelFilter.size() != 0) && (cRequest.iActProfile >= 0))
     {
         //call
-        switch (this->m_pcConfigData->s_get_ProfileType(iActProfile))
+        switch (cRequest.eType)
         {
         case PROFILE_OFF:
             break;
         case PROFILE_LEVEL:
-            create_tree_entry_level(iActProfile);
+            create_tree_entry_level(cRequest, vcRows);
             break;
         case PROFILE_FAVORITE:
-            create_tree_entry_fav(iActProfile);
+            create_tree_entry_fav(cRequest, vcRows);
             break;
         case PROFILE_FREQUENCY:
-            create_tree_entry_freq(iActProfile);
+            create_tree_entry_freq(cRequest, vcRows);
             break;
         case PROFILE_AUDIO:
             break;
@@ -299,14 +454,27 @@ void clientTreeWidget::create_tree_entry(int iActProfile)
     }
     else
     {
-        create_tree_entry_ignore();
+        create_tree_entry_ignore(cRequest, vcRows);
     }
+    return;
+}
+
+
+/*
+*   apply rows built by worker (GUI thread)
+*/
+void clientTreeWidget::apply_rows(uint64 nRequestId, std::vector<client_tree_row>& vcRows)
+{
+    CALL_STACK
+    //result is outdated, the newer one is on the way
+    if (nRequestId != this->m_nRequestId)
+        return;
+
+    //only changed rows are passed to the view
+    this->m_pcModel->apply(std::move(vcRows));
 
     //set default width
     this->setColumnWidth(0, (this->columnWidth(0) > 200) ? this->columnWidth(0) : 200);
-
-    //work done with client tree, release mutex
-    this->m_cClientTreeMutex.unlock();
     return;
 }
 
@@ -314,7 +482,7 @@ void clientTreeWidget::create_tree_entry(int iActProfile)
 /*
 *   update tree client/channel list, if profile is of type FREQUENCY
 */
-void clientTreeWidget::create_tree_entry_freq(int iActProfile)
+void clientTreeWidget::create_tree_entry_freq(tree_request& cRequest, std::vector<client_tree_row>& vcRows)
 {
     CALL_STACK
     for (std::vector<client_filter*>::iterator it = this->m_vcClientFilter.begin(); it != this->m_vcClientFilter.end(); it++)
@@ -322,33 +490,31 @@ void clientTreeWidget::create_tree_entry_freq(int iActProfile)
         //make sure, that no one writes to ClientList variable while we are reading
         (*it)->m_cClientListMutex.lock();
 
-        int iActFreq = this->m_pcConfigData->s_get_ActiveFreq(iActProfile);
+        int iActFreq = cRequest.iActiveFreq;
         std::vector<int> vClientIdx = (*it)->get_client_list_idx(iActFreq, false, false);
 
-
-        QStringList cEntry;
+        //talk statistics of the profile are read without lock
+        std::unordered_map<client_filter*, talk_tracker*>::iterator itTracker = this->m_mTalkTracker.find(*it);
+        talk_tracker *pcTracker = (itTracker != this->m_mTalkTracker.end()) ? itTracker->second : nullptr;
+        QString sServerState = TRANSLATE(L"ctUi_treeItemStateNone");
+        talk_activity cActivity;
+        if ((pcTracker != nullptr) && pcTracker->get_activity(cRequest.iActProfile, cActivity) && (cActivity.iIdle_ms >= 0))
+        {
+            unsigned nSeconds = (unsigned)(cActivity.nTalkTime_ms / 1000);
+            sServerState = TRANSLATE(L"ctUi_treeItemStateTalkTime").arg(cActivity.nTalkers).arg(cActivity.nWhispers).arg(nSeconds / 60).arg(nSeconds % 60, 2, 10, QChar('0'));
+        }
 
         //create Server Item for first client that is in list
-        cEntry.clear();
-        cEntry << QString::fromStdString((*it)->get_server_name()) << TRANSLATE(L"ctUi_treeItemStateNone");
-        QTreeWidgetItem *ServerParent = new QTreeWidgetItem(this, cEntry);
-        ServerParent->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled);
-        ServerParent->setFont(0, m_cServerFont);
-        ServerParent->setData(0, ROLE_TYPE, eItemType::ITEM_SERVER);
-        ServerParent->setData(0, ROLE_ID, (*it)->get_server_id());
+        vcRows.push_back({ clientTreeModel::ITEM_SERVER, (*it)->get_server_id(), QString::fromStdString((*it)->get_server_name()), sServerState, -1, {} });
+        client_tree_row& ServerParent = vcRows.back();
 
         size_t nClientIndex = 0;
         while (!vClientIdx.empty())
         {
             //create Channel Item for first client that is in list
             uint64 nActualChannelID = (*it)->m_cClientList[vClientIdx[0]].nActualChannelID;
-            cEntry.clear();
-            cEntry << QString::fromStdString((*it)->get_channel_name(nActualChannelID)) << TRANSLATE(L"ctUi_treeItemStateNone");
-            QTreeWidgetItem *ChannelParent = new QTreeWidgetItem(ServerParent, cEntry);
-            ChannelParent->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled);
-            ChannelParent->setFont(0, m_cChFont);
-            ChannelParent->setData(0, ROLE_TYPE, eItemType::ITEM_CHANNEL);
-            ChannelParent->setData(0, ROLE_ID, nActualChannelID);
+            ServerParent.vcChildren.push_back({ clientTreeModel::ITEM_CHANNEL, nActualChannelID, QString::fromStdString((*it)->get_channel_name(nActualChannelID)), TRANSLATE(L"ctUi_treeItemStateNone"), -1, {} });
+            client_tree_row& ChannelParent = ServerParent.vcChildren.back();
 
             nClientIndex = 0;
             while ((!vClientIdx.empty()) && (nClientIndex < vClientIdx.size()))
@@ -356,7 +522,6 @@ void clientTreeWidget::create_tree_entry_freq(int iActProfile)
                 //create Client Items for all clients with the actual channel ID and delete them from the list
                 if (nActualChannelID == (*it)->m_cClientList[vClientIdx[nClientIndex]].nActualChannelID)
                 {
-                    cEntry.clear();
                     QString sState;
                     //get state of user and create new item
                     int iActFreqSet = (*it)->find_active_freq(vClientIdx[nClientIndex], iActFreq, false, false);
@@ -370,20 +535,20 @@ void clientTreeWidget::create_tree_entry_freq(int iActProfile)
                         sState = TRANSLATE(L"ctUi_treeItemStatePriority");
                     else
                         sState = TRANSLATE(L"ctUi_treeItemStateActive");
-                    cEntry << QString::fromStdString((*it)->m_cClientList[vClientIdx[nClientIndex]].sClientName) << sState;
+
+                    //client is talking right now
+                    uint64_t nDuration_ms = 0;
+                    uint8_t nTalk = (pcTracker != nullptr) ? pcTracker->get_client((*it)->m_cClientList[vClientIdx[nClientIndex]].nClientID, nDuration_ms) : 0;
+                    if (nTalk & TRACKER_TALKING)
+                        sState += QString(" / ") + TRANSLATE((nTalk & TRACKER_WHISPER) ? L"ctUi_treeItemStateWhisper" : L"ctUi_treeItemStateTalking");
 
                     //add item to list
-                    QTreeWidgetItem *ClientParent = new QTreeWidgetItem(ChannelParent, cEntry);
-                    ClientParent->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled);
-                    ClientParent->setData(0, ROLE_TYPE, eItemType::ITEM_CLIENT);
-                    ClientParent->setData(0, ROLE_ID, (uint64)((*it)->m_cClientList[vClientIdx[nClientIndex]].nClientID));
+                    ChannelParent.vcChildren.push_back({ clientTreeModel::ITEM_CLIENT, (uint64)((*it)->m_cClientList[vClientIdx[nClientIndex]].nClientID), QString::fromStdString((*it)->m_cClientList[vClientIdx[nClientIndex]].sClientName), sState, -1, {} });
                     vClientIdx.erase(vClientIdx.begin() + nClientIndex);
                 }
                 nClientIndex++;
             }
-            this->expandItem(ChannelParent);
         }
-        this->expandItem(ServerParent);
 
         //work done with this client, release mutex
         (*it)->m_cClientListMutex.unlock();
@@ -395,56 +560,36 @@ void clientTreeWidget::create_tree_entry_freq(int iActProfile)
 /*
 *   update tree client/channel list, if profile is of type LEVEL
 */
-void clientTreeWidget::create_tree_entry_level(int iActProfile)
+void clientTreeWidget::create_tree_entry_level(tree_request& cRequest, std::vector<client_tree_row>& vcRows)
 {
     CALL_STACK
     for (std::vector<channel_filter*>::iterator it = this->m_vcChannelFilter.begin(); it != this->m_vcChannelFilter.end(); it++)
     {
-        QStringList cEntry;
-
         //create Server Item for first client that is in list
-        cEntry.clear();
-        cEntry << QString::fromStdString((*it)->get_server_name()) << TRANSLATE(L"ctUi_treeItemStateNone");
-        QTreeWidgetItem *ServerParent = new QTreeWidgetItem(this, cEntry);
-        ServerParent->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled);
-        ServerParent->setFont(0, m_cServerFont);
-        ServerParent->setData(0, ROLE_TYPE, eItemType::ITEM_SERVER);
-        ServerParent->setData(0, ROLE_ID, (*it)->get_server_id());
+        vcRows.push_back({ clientTreeModel::ITEM_SERVER, (*it)->get_server_id(), QString::fromStdString((*it)->get_server_name()), TRANSLATE(L"ctUi_treeItemStateNone"), -1, {} });
+        client_tree_row& ServerParent = vcRows.back();
 
         // print channel list based on same filter like hotkey
-        QTreeWidgetItem *ChannelParent;
-        uint64 *pnFilteredList = (*it)->filter_channel_from_level(this->m_pcConfigData->s_get_MinChLevel(iActProfile), this->m_pcConfigData->s_get_MaxChLevel(iActProfile), false);
+        uint64 *pnFilteredList = (*it)->filter_channel_from_level(cRequest.nMinChLevel, cRequest.nMaxChLevel, false);
         if (pnFilteredList != nullptr)
         {
             for (int jj = 0; pnFilteredList[jj] != 0; jj++)
             {
                 bool bIgnored = false;
-                if (((*it)->find_channel_in_list(this->m_pcConfigData->s_get_IgnoreList(), pnFilteredList[jj]) >= 0) && this->m_pcConfigData->s_get_UseIgnoreListTx(iActProfile))
+                if (cRequest.bUseIgnoreTx && ((*it)->find_channel_in_list(&cRequest.vcIgnoreList, pnFilteredList[jj]) >= 0))
                     bIgnored = true;
-                
-                cEntry.clear();
-                cEntry << QString::fromStdString((*it)->get_channel_name(pnFilteredList[jj])) << (bIgnored ? TRANSLATE(L"ctUi_Ignore") : (TRANSLATE(L"ctUi_Level") + QString::number((*it)->get_channel_level(pnFilteredList[jj]))));
-                ChannelParent = new QTreeWidgetItem(ServerParent, cEntry);
-                ChannelParent->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled);
-                ChannelParent->setFont(0, m_cChFont);
-                ChannelParent->setData(0, ROLE_TYPE, eItemType::ITEM_CHANNEL);
-                ChannelParent->setData(0, ROLE_ID, pnFilteredList[jj]);
+
+                int iLevel = (int)(*it)->get_channel_level(pnFilteredList[jj]);
+                ServerParent.vcChildren.push_back({ clientTreeModel::ITEM_CHANNEL, pnFilteredList[jj], QString::fromStdString((*it)->get_channel_name(pnFilteredList[jj])),
+                    (bIgnored ? TRANSLATE(L"ctUi_Ignore") : (TRANSLATE(L"ctUi_Level") + QString::number(iLevel))), iLevel, {} });
             }
             // free filtered list after function is done
             (*it)->free_channel_list(pnFilteredList);
         }
         else
         {
-            cEntry.clear();
-            cEntry << TRANSLATE(L"ctUi_NoChannel") << QString("");
-            ChannelParent = new QTreeWidgetItem(ServerParent, cEntry);
-            ChannelParent->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled);
-            ChannelParent->setFont(0, m_cChFont);
-            ChannelParent->setData(0, ROLE_TYPE, eItemType::ITEM_CHANNEL);
-            ChannelParent->setData(0, ROLE_ID, 0);
+            ServerParent.vcChildren.push_back({ clientTreeModel::ITEM_CHANNEL, 0, TRANSLATE(L"ctUi_NoChannel"), QString(""), -1, {} });
         }
-        this->expandItem(ChannelParent);
-        this->expandItem(ServerParent);
     }
     return;
 }
@@ -453,25 +598,17 @@ void clientTreeWidget::create_tree_entry_level(int iActProfile)
 /*
 *   update tree client/channel list, if profile is of type FAVORITE
 */
-void clientTreeWidget::create_tree_entry_fav(int iActProfile)
+void clientTreeWidget::create_tree_entry_fav(tree_request& cRequest, std::vector<client_tree_row>& vcRows)
 {
     CALL_STACK
     for (std::vector<channel_filter*>::iterator it = this->m_vcChannelFilter.begin(); it != this->m_vcChannelFilter.end(); it++)
     {
-        QStringList cEntry;
-
         //create Server Item for first client that is in list
-        cEntry.clear();
-        cEntry << QString::fromStdString((*it)->get_server_name()) << TRANSLATE(L"ctUi_treeItemStateNone");
-        QTreeWidgetItem *ServerParent = new QTreeWidgetItem(this, cEntry);
-        ServerParent->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled);
-        ServerParent->setFont(0, m_cServerFont);
-        ServerParent->setData(0, ROLE_TYPE, eItemType::ITEM_SERVER);
-        ServerParent->setData(0, ROLE_ID, (*it)->get_server_id());
+        vcRows.push_back({ clientTreeModel::ITEM_SERVER, (*it)->get_server_id(), QString::fromStdString((*it)->get_server_name()), TRANSLATE(L"ctUi_treeItemStateNone"), -1, {} });
+        client_tree_row& ServerParent = vcRows.back();
 
         // print channel list based on same filter like hotkey
-        QTreeWidgetItem *ChannelParent;
-        uint64 *pnFilteredList = (*it)->filter_channel_from_list(this->m_pcConfigData->s_get_FavoriteList(iActProfile), this->m_pcConfigData->s_get_UseSubChOfFav(iActProfile), false);
+        uint64 *pnFilteredList = (*it)->filter_channel_from_list(&cRequest.vcFavoriteList, cRequest.bUseSubChOfFav, false);
         if (pnFilteredList != nullptr)
         {
             for (int jj = 0; pnFilteredList[jj] != 0; jj++)
@@ -480,36 +617,23 @@ void clientTreeWidget::create_tree_entry_fav(int iActProfile)
                 bool bIgnored = false;
 
                 //if subchannel are used, try to find it in the master list
-                if (this->m_pcConfigData->s_get_UseSubChOfFav(iActProfile))
-                    if (this->m_pcConfigData->s_find_entry(this->m_pcConfigData->s_get_FavoriteList(iActProfile), (*it)->get_channel_info(pnFilteredList[jj])) < 0)
+                if (cRequest.bUseSubChOfFav)
+                    if (this->m_pcConfigData->s_find_entry(&cRequest.vcFavoriteList, (*it)->get_channel_info(pnFilteredList[jj])) < 0)
                         bIsSubChannel = true;;
 
-                if (((*it)->find_channel_in_list(this->m_pcConfigData->s_get_IgnoreList(), pnFilteredList[jj]) >= 0) && this->m_pcConfigData->s_get_UseIgnoreListTx(iActProfile))
+                if (cRequest.bUseIgnoreTx && ((*it)->find_channel_in_list(&cRequest.vcIgnoreList, pnFilteredList[jj]) >= 0))
                     bIgnored = true;
 
-                cEntry.clear();
-                cEntry << QString::fromStdString((*it)->get_channel_name(pnFilteredList[jj])) << (bIgnored ? TRANSLATE(L"ctUi_Ignore") : (bIsSubChannel ? TRANSLATE(L"ctUi_SubChannel") : TRANSLATE(L"ctUi_Favorite")));
-                ChannelParent = new QTreeWidgetItem(ServerParent, cEntry);
-                ChannelParent->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled);
-                ChannelParent->setFont(0, m_cChFont);
-                ChannelParent->setData(0, ROLE_TYPE, eItemType::ITEM_CHANNEL);
-                ChannelParent->setData(0, ROLE_ID, pnFilteredList[jj]);
+                ServerParent.vcChildren.push_back({ clientTreeModel::ITEM_CHANNEL, pnFilteredList[jj], QString::fromStdString((*it)->get_channel_name(pnFilteredList[jj])),
+                    (bIgnored ? TRANSLATE(L"ctUi_Ignore") : (bIsSubChannel ? TRANSLATE(L"ctUi_SubChannel") : TRANSLATE(L"ctUi_Favorite"))), -1, {} });
             }
             // free filtered list after function is done
             (*it)->free_channel_list(pnFilteredList);
         }
         else
         {
-            cEntry.clear();
-            cEntry << TRANSLATE(L"ctUi_NoChannel") << QString("");
-            ChannelParent = new QTreeWidgetItem(ServerParent, cEntry);
-            ChannelParent->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled);
-            ChannelParent->setFont(0, m_cChFont);
-            ChannelParent->setData(0, ROLE_TYPE, eItemType::ITEM_CHANNEL);
-            ChannelParent->setData(0, ROLE_ID, 0);
+            ServerParent.vcChildren.push_back({ clientTreeModel::ITEM_CHANNEL, 0, TRANSLATE(L"ctUi_NoChannel"), QString(""), -1, {} });
         }
-        this->expandItem(ChannelParent);
-        this->expandItem(ServerParent);
     }
     return;
 }
@@ -517,52 +641,30 @@ void clientTreeWidget::create_tree_entry_fav(int iActProfile)
 /*
 *   update tree client/channel list, if ignore list is selected
 */
-void clientTreeWidget::create_tree_entry_ignore()
+void clientTreeWidget::create_tree_entry_ignore(tree_request& cRequest, std::vector<client_tree_row>& vcRows)
 {
     CALL_STACK
     for (std::vector<channel_filter*>::iterator it = this->m_vcChannelFilter.begin(); it != this->m_vcChannelFilter.end(); it++)
     {
-        QStringList cEntry;
-
         //create Server Item for first client that is in list
-        cEntry.clear();
-        cEntry << QString::fromStdString((*it)->get_server_name()) << TRANSLATE(L"ctUi_treeItemStateNone");
-        QTreeWidgetItem *ServerParent = new QTreeWidgetItem(this, cEntry);
-        ServerParent->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled);
-        ServerParent->setFont(0, m_cServerFont);
-        ServerParent->setData(0, ROLE_TYPE, eItemType::ITEM_SERVER);
-        ServerParent->setData(0, ROLE_ID, (*it)->get_server_id());
+        vcRows.push_back({ clientTreeModel::ITEM_SERVER, (*it)->get_server_id(), QString::fromStdString((*it)->get_server_name()), TRANSLATE(L"ctUi_treeItemStateNone"), -1, {} });
+        client_tree_row& ServerParent = vcRows.back();
 
         // print channel list based on same filter like hotkey
-        QTreeWidgetItem *ChannelParent;
-        uint64 *pnFilteredList = (*it)->filter_channel_from_list(this->m_pcConfigData->s_get_IgnoreList(), false, false);
+        uint64 *pnFilteredList = (*it)->filter_channel_from_list(&cRequest.vcIgnoreList, false, false);
         if (pnFilteredList != nullptr)
         {
             for (int jj = 0; pnFilteredList[jj] != 0; jj++)
             {
-                cEntry.clear();
-                cEntry << QString::fromStdString((*it)->get_channel_name(pnFilteredList[jj])) << TRANSLATE(L"ctUi_Ignore");
-                ChannelParent = new QTreeWidgetItem(ServerParent, cEntry);
-                ChannelParent->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled);
-                ChannelParent->setFont(0, m_cChFont);
-                ChannelParent->setData(0, ROLE_TYPE, eItemType::ITEM_CHANNEL);
-                ChannelParent->setData(0, ROLE_ID, pnFilteredList[jj]);
+                ServerParent.vcChildren.push_back({ clientTreeModel::ITEM_CHANNEL, pnFilteredList[jj], QString::fromStdString((*it)->get_channel_name(pnFilteredList[jj])), TRANSLATE(L"ctUi_Ignore"), -1, {} });
             }
             // free filtered list after function is done
             (*it)->free_channel_list(pnFilteredList);
         }
         else
         {
-            cEntry.clear();
-            cEntry << TRANSLATE(L"ctUi_NoChannel") << QString("");
-            ChannelParent = new QTreeWidgetItem(ServerParent, cEntry);
-            ChannelParent->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled);
-            ChannelParent->setFont(0, m_cChFont);
-            ChannelParent->setData(0, ROLE_TYPE, eItemType::ITEM_CHANNEL);
-            ChannelParent->setData(0, ROLE_ID, 0);
+            ServerParent.vcChildren.push_back({ clientTreeModel::ITEM_CHANNEL, 0, TRANSLATE(L"ctUi_NoChannel"), QString(""), -1, {} });
         }
-        this->expandItem(ChannelParent);
-        this->expandItem(ServerParent);
     }
     return;
-}
\ No newline at end of file
+}
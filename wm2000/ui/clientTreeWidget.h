@@ -1,18 +1,23 @@
 #pragma once
-#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QTreeView>
 #include <QtWidgets/qaction.h>
 #include <QtWidgets/qmenu.h>
-#include <boost\thread.hpp>
+#include <boost/thread.hpp>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
 
 #include "misc/client_filter.h"
 #include "misc/channel_filter.h"
 #include "misc/error_handler.h"
 #include "misc/language_pkg.h"
 #include "misc/config_container.h"
-#include "misc/language_pkg.h"
+#include "misc/work_pool.h"
+#include "misc/talk_tracker.h"
+#include "ui/clientTreeModel.h"
 
 class clientTreeWidget :
-    public QTreeWidget
+    public QTreeView
 {
     Q_OBJECT
 
@@ -24,37 +29,46 @@ public:
     void init(config_container *pcConfigData, QIcon *pcIgnoreIcon, QIcon *pcFavIcon);
 
     //client filter interface
-    void add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter);
-    void delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter);
+    void add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker);
+    void delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker);
 
     void set_language(std::string sNewLanguage);
     void create_tree_entry(int iActProfile);
     void update_meta_data();
+    void set_work_pool(work_pool *pcWorkPool) { m_pcWorkPool = pcWorkPool; };
 
     int  get_NextUnusedFreq();
 
 protected:
+    //snapshot of all settings needed to build the rows, taken on the GUI thread
+    struct tree_request
+    {
+        uint64                      nRequestId;     // sequence number, older results are dropped
+        int                         iActProfile;
+        eProfileType                eType;
+        int                         iActiveFreq;
+        size_t                      nMinChLevel;
+        size_t                      nMaxChLevel;
+        bool                        bUseIgnoreTx;
+        bool                        bUseSubChOfFav;
+        std::vector<channel_info>   vcFavoriteList;
+        std::vector<channel_info>   vcIgnoreList;
+    };
+
     void prepare_context_menu(const QPoint & pos);
 
-    void create_tree_entry_freq(int iActProfile);
-    void create_tree_entry_level(int iActProfile);
-    void create_tree_entry_fav(int iActProfile);
-    void create_tree_entry_ignore();
+    void expand_new_rows(const QModelIndex &parent, int first, int last);
 
-    enum eItemRole
-    {
-        ROLE_TYPE = Qt::UserRole,
-        ROLE_ID
-    };
+    void run_tasks(const std::vector<work_pool::task>& vTask);
 
-    enum eItemType
-    {
-        ITEM_MIN,
-        ITEM_SERVER = ITEM_MIN,
-        ITEM_CHANNEL,
-        ITEM_CLIENT,
-        ITEM_MAX = ITEM_CLIENT
-    };
+    void worker_loop();
+    void build_rows(tree_request& cRequest, std::vector<client_tree_row>& vcRows);
+    void apply_rows(uint64 nRequestId, std::vector<client_tree_row>& vcRows);
+
+    void create_tree_entry_freq(tree_request& cRequest, std::vector<client_tree_row>& vcRows);
+    void create_tree_entry_level(tree_request& cRequest, std::vector<client_tree_row>& vcRows);
+    void create_tree_entry_fav(tree_request& cRequest, std::vector<client_tree_row>& vcRows);
+    void create_tree_entry_ignore(tree_request& cRequest, std::vector<client_tree_row>& vcRows);
 
 signals:
     void channel_ignore_triggered(int iProfile, uint64 nChannel);
@@ -75,9 +89,17 @@ protected:
 
     std::vector<client_filter*>  m_vcClientFilter;   // vector of client filter for all connected ServerTabs
     std::vector<channel_filter*> m_vcChannelFilter;  // vector of channel filter for all connected ServerTabs
-
-    QFont                       m_cServerFont;
-    QFont                       m_cChFont;
-    QTreeWidgetItem            *m_qTreeWidgetItem;
+    std::unordered_map<client_filter*, talk_tracker*> m_mTalkTracker;  // talk statistics of the server of a client filter
+    work_pool                  *m_pcWorkPool;       // runs operations over all ServerTabs in parallel (nullptr => serial)
+
+    clientTreeModel            *m_pcModel;          // model with server/channel/client rows
+
+    boost::thread               m_cWorker;          // builds the rows in background
+    boost::mutex                m_cRequestMutex;    // protects the request members below
+    boost::condition_variable   m_cRequestCond;     // wakes worker on new request
+    tree_request                m_cRequest;         // latest request, only the newest one is built
+    bool                        m_bRequestPending;  // request was not taken by worker yet
+    bool                        m_bWorkerStop;      // worker shall terminate
+    std::atomic<uint64>         m_nRequestId;       // id of latest request
 };
 
@@ -3,7 +3,7 @@
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qtextstream.h>
 
-#define TRANSLATE(a) QString(this->m_cTranslate.translate(a).c_str())
+#define TRANSLATE(a) QString(this->m_cTranslate.translate(a))
 #if USE_CALL_STACK
 #define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
 #else
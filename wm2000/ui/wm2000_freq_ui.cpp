@@ -1,8 +1,8 @@
 #include "wm2000_freq_ui.h"
-#include <QtWidgets\QMessageBox>
-#include <QtWidgets\QInputDialog>
+#include <QtWidgets/QMessageBox>
+#include <QtWidgets/QInputDialog>
 
-#define TRANSLATE(a) QString(this->m_cTranslate.translate(a).c_str())
+#define TRANSLATE(a) QString(this->m_cTranslate.translate(a))
 #if USE_CALL_STACK
 #define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
 #else
@@ -96,11 +96,11 @@ void wm2000_freq_ui::update_config()
 /*
 *   add entity of client filter
 */
-void wm2000_freq_ui::add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter)
+void wm2000_freq_ui::add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker)
 {
     CALL_STACK
     //try to find requested element
-    this->m_cUi.treeRxList->add_pointer(pcClientFilter, pcChannelFilter);
+    this->m_cUi.treeRxList->add_pointer(pcClientFilter, pcChannelFilter, pcTalkTracker);
 
     //update list field
     if(this->m_iActualTabIndex >= 0) this->m_cUi.treeRxList->create_tree_entry(this->m_iFreqProfileIdx[this->m_iActualTabIndex]);
@@ -109,11 +109,11 @@ void wm2000_freq_ui::add_pointer(client_filter *pcClientFilter, channel_filter*
 /*
 *   delete entity of client_filter
 */
-void wm2000_freq_ui::delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter)
+void wm2000_freq_ui::delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker)
 {
     CALL_STACK
     //try to find requested element and delete element
-    this->m_cUi.treeRxList->delete_pointer(pcClientFilter, pcChannelFilter);
+    this->m_cUi.treeRxList->delete_pointer(pcClientFilter, pcChannelFilter, pcTalkTracker);
 
     //update list field
     if(this->m_iActualTabIndex >= 0) this->m_cUi.treeRxList->create_tree_entry(this->m_iFreqProfileIdx[this->m_iActualTabIndex]);
@@ -252,8 +252,12 @@ void wm2000_freq_ui::handler_statedial_value_changed(int iValue)
     this->m_pPbSetFreq[iIndex]->setEnabled(bState);
     this->m_pPbNextFreq[iIndex]->setEnabled(bState);
     this->m_pSwitchPriority[iIndex]->setEnabled(bState);
+    this->m_pSwitchRadio[iIndex]->setEnabled(bState);
+    this->m_pSwitchSpatial[iIndex]->setEnabled(bState);
 
     this->m_pSwitchPriority[iIndex]->setValue(this->m_cLocalConfigData.s_get_PrioFreq(this->m_iFreqProfileIdx[iIndex]));
+    this->m_pSwitchRadio[iIndex]->setValue(this->m_cLocalConfigData.s_get_RadioFreq(this->m_iFreqProfileIdx[iIndex]));
+    this->m_pSwitchSpatial[iIndex]->setValue(this->m_cLocalConfigData.s_get_SpatialFreq(this->m_iFreqProfileIdx[iIndex]));
     return;
 }
 
@@ -326,6 +330,34 @@ void wm2000_freq_ui::handler_swPriority_valueChanged(bool bValue)
     return;
 }
 
+void wm2000_freq_ui::handler_swRadio_valueChanged(bool bValue)
+{
+    CALL_STACK
+    int iIndex = this->m_cUi.tabProfile->currentIndex();
+    // if widget index is invalid, bail out early
+    if ((iIndex < 0) || (iIndex >= this->m_iFreqProfileCnt))
+        return;
+
+    this->m_cLocalConfigData.s_set_RadioFreq(this->m_iFreqProfileIdx[iIndex], bValue);
+
+    this->m_cUi.pbApply->setEnabled(this->m_cLocalConfigData != (*this->m_pcConfigData));
+    return;
+}
+
+void wm2000_freq_ui::handler_swSpatial_valueChanged(bool bValue)
+{
+    CALL_STACK
+    int iIndex = this->m_cUi.tabProfile->currentIndex();
+    // if widget index is invalid, bail out early
+    if ((iIndex < 0) || (iIndex >= this->m_iFreqProfileCnt))
+        return;
+
+    this->m_cLocalConfigData.s_set_SpatialFreq(this->m_iFreqProfileIdx[iIndex], bValue);
+
+    this->m_cUi.pbApply->setEnabled(this->m_cLocalConfigData != (*this->m_pcConfigData));
+    return;
+}
+
 void wm2000_freq_ui::handler_tabProfile_currentItemChanged(int iIndex)
 {
     CALL_STACK
@@ -382,6 +414,10 @@ void wm2000_freq_ui::init_profile_tab()
         this->m_pLabelSquelch[ii]   = nullptr;
         this->m_pLabelPriority[ii]  = nullptr;
         this->m_pSwitchPriority[ii] = nullptr;
+        this->m_pLabelRadio[ii]     = nullptr;
+        this->m_pSwitchRadio[ii]    = nullptr;
+        this->m_pLabelSpatial[ii]   = nullptr;
+        this->m_pSwitchSpatial[ii]  = nullptr;
     }
 
     // init dummy Tab
@@ -513,6 +549,32 @@ void wm2000_freq_ui::create_profile_tab(int iTabIdx, int iProfileIdx)
     this->m_pLabelPriority[iTabIdx]->setWordWrap(true);
     this->m_pLabelPriority[iTabIdx]->setWhatsThis(TRANSLATE(L"fUi_WhatIsPriority"));
 
+    if (this->m_pSwitchRadio[iTabIdx] == nullptr) this->m_pSwitchRadio[iTabIdx] = new SwitchButton(this->m_pGbGeneral[iTabIdx]); // Default style is Style::ONOFF
+    this->m_pSwitchRadio[iTabIdx]->setObjectName(QStringLiteral("widRadio"));
+    this->m_pSwitchRadio[iTabIdx]->setGeometry(QRect(240, 20, 71, 21));
+    this->m_pSwitchRadio[iTabIdx]->setWhatsThis(TRANSLATE(L"fUi_WhatIsRadio"));
+
+    if (this->m_pLabelRadio[iTabIdx] == nullptr) this->m_pLabelRadio[iTabIdx] = new QLabel(this->m_pGbGeneral[iTabIdx]);
+    this->m_pLabelRadio[iTabIdx]->setObjectName(QStringLiteral("lbRadio"));
+    this->m_pLabelRadio[iTabIdx]->setGeometry(QRect(225, 44, 90, 20));
+    this->m_pLabelRadio[iTabIdx]->setFont(cFontLabel);
+    this->m_pLabelRadio[iTabIdx]->setText(TRANSLATE(L"fUi_lbRadio"));
+    this->m_pLabelRadio[iTabIdx]->setAlignment(Qt::AlignHCenter | Qt::AlignTop);
+    this->m_pLabelRadio[iTabIdx]->setWhatsThis(TRANSLATE(L"fUi_WhatIsRadio"));
+
+    if (this->m_pSwitchSpatial[iTabIdx] == nullptr) this->m_pSwitchSpatial[iTabIdx] = new SwitchButton(this->m_pGbGeneral[iTabIdx]); // Default style is Style::ONOFF
+    this->m_pSwitchSpatial[iTabIdx]->setObjectName(QStringLiteral("widSpatial"));
+    this->m_pSwitchSpatial[iTabIdx]->setGeometry(QRect(0, 20, 71, 21));
+    this->m_pSwitchSpatial[iTabIdx]->setWhatsThis(TRANSLATE(L"fUi_WhatIsSpatial"));
+
+    if (this->m_pLabelSpatial[iTabIdx] == nullptr) this->m_pLabelSpatial[iTabIdx] = new QLabel(this->m_pGbGeneral[iTabIdx]);
+    this->m_pLabelSpatial[iTabIdx]->setObjectName(QStringLiteral("lbSpatial"));
+    this->m_pLabelSpatial[iTabIdx]->setGeometry(QRect(0, 44, 71, 20));
+    this->m_pLabelSpatial[iTabIdx]->setFont(cFontLabel);
+    this->m_pLabelSpatial[iTabIdx]->setText(TRANSLATE(L"fUi_lbSpatial"));
+    this->m_pLabelSpatial[iTabIdx]->setAlignment(Qt::AlignHCenter | Qt::AlignTop);
+    this->m_pLabelSpatial[iTabIdx]->setWhatsThis(TRANSLATE(L"fUi_WhatIsSpatial"));
+
     //add "Tab" to tabProfile
     this->m_cUi.tabProfile->addTab(this->m_pTabProfile[iTabIdx], QString());
 
@@ -531,6 +593,8 @@ void wm2000_freq_ui::create_profile_tab(int iTabIdx, int iProfileIdx)
     connect(this->m_pPbNextFreq[iTabIdx],       &QPushButton::clicked,      this,   &wm2000_freq_ui::handler_pbNextFreq_clicked);
     connect(this->m_pDialState[iTabIdx],        &QDial::valueChanged,       this,   &wm2000_freq_ui::handler_statedial_value_changed);
     connect(this->m_pSwitchPriority[iTabIdx],   &SwitchButton::valueChanged,this,   &wm2000_freq_ui::handler_swPriority_valueChanged);
+    connect(this->m_pSwitchRadio[iTabIdx],      &SwitchButton::valueChanged,this,   &wm2000_freq_ui::handler_swRadio_valueChanged);
+    connect(this->m_pSwitchSpatial[iTabIdx],    &SwitchButton::valueChanged,this,   &wm2000_freq_ui::handler_swSpatial_valueChanged);
     return;
 }
 
@@ -564,5 +628,11 @@ void wm2000_freq_ui::set_profile_tab(int iTabIdx, int iProfileIdx)
 
     this->m_pSwitchPriority[iTabIdx]->setValue(this->m_cLocalConfigData.s_get_PrioFreq(iProfileIdx));
     this->m_pSwitchPriority[iTabIdx]->setEnabled(this->m_cLocalConfigData.s_get_ActiveFreq(iProfileIdx) != 0);
+
+    this->m_pSwitchRadio[iTabIdx]->setValue(this->m_cLocalConfigData.s_get_RadioFreq(iProfileIdx));
+    this->m_pSwitchRadio[iTabIdx]->setEnabled(this->m_cLocalConfigData.s_get_ActiveFreq(iProfileIdx) != 0);
+
+    this->m_pSwitchSpatial[iTabIdx]->setValue(this->m_cLocalConfigData.s_get_SpatialFreq(iProfileIdx));
+    this->m_pSwitchSpatial[iTabIdx]->setEnabled(this->m_cLocalConfigData.s_get_ActiveFreq(iProfileIdx) != 0);
     return;
 }
\ No newline at end of file
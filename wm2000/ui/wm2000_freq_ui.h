@@ -1,10 +1,11 @@
 #pragma once
 
 #include <QtWidgets/QDialog>
-#include <boost\thread.hpp>
+#include <boost/thread.hpp>
 #include "ui_wm2000_freq_ui.h"
 #include "misc/client_filter.h"
 #include "misc/channel_filter.h"
+#include "misc/talk_tracker.h"
 #include "misc/error_handler.h"
 #include "misc/language_pkg.h"
 #include "misc/config_container.h"
@@ -32,8 +33,9 @@ public:
     void update_config();
 
     //client filter interface
-    void add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter);
-    void delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter);
+    void add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker);
+    void delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker);
+    void set_work_pool(work_pool *pcWorkPool) { this->m_cUi.treeRxList->set_work_pool(pcWorkPool); };
 
     //event handler
     void handler_pbOk_clicked();
@@ -44,6 +46,8 @@ public:
     void handler_pbSetFreq_clicked();
     void handler_pbNextFreq_clicked();
     void handler_swPriority_valueChanged(bool bValue);
+    void handler_swRadio_valueChanged(bool bValue);
+    void handler_swSpatial_valueChanged(bool bValue);
     void handler_tabProfile_currentItemChanged(int index);
 
 private:
@@ -82,4 +86,8 @@ private:
     QLabel                 *m_pLabelSquelch[REAL_MAXNUMPROFILES];
     QLabel                 *m_pLabelPriority[REAL_MAXNUMPROFILES];
     SwitchButton           *m_pSwitchPriority[REAL_MAXNUMPROFILES];
+    QLabel                 *m_pLabelRadio[REAL_MAXNUMPROFILES];
+    SwitchButton           *m_pSwitchRadio[REAL_MAXNUMPROFILES];
+    QLabel                 *m_pLabelSpatial[REAL_MAXNUMPROFILES];
+    SwitchButton           *m_pSwitchSpatial[REAL_MAXNUMPROFILES];
 };
@@ -9,6 +9,7 @@
 #include "misc/config_container.h"
 #include "misc/client_filter.h"
 #include "misc/channel_filter.h"
+#include "misc/talk_tracker.h"
 #include "wm2000_about_ui.h"
 #include "wm2000_freq_ui.h"
 
@@ -29,8 +30,8 @@ public:
     virtual void update_config() = 0;
 
     //client filter interface
-    virtual void add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter) = 0;
-    virtual void delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter) = 0;
+    virtual void add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker) = 0;
+    virtual void delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker) = 0;
     void update_box_size();
 
 public Q_SLOTS:
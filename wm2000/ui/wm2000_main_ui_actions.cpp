@@ -1,10 +1,10 @@
 #include "wm2000_main_ui_actions.h"
-#include <QtWidgets\QMessageBox>
-#include <QtWidgets\qinputdialog.h>
-#include <QtCore\qdiriterator.h>
-#include <QtWidgets\qfiledialog.h>
+#include <QtWidgets/QMessageBox>
+#include <QtWidgets/qinputdialog.h>
+#include <QtCore/qdiriterator.h>
+#include <QtWidgets/qfiledialog.h>
 
-#define TRANSLATE(a) QString(this->m_cTranslate.translate(a).c_str())
+#define TRANSLATE(a) QString(this->m_cTranslate.translate(a))
 #if USE_CALL_STACK
 #define CALL_STACK if(USE_CALL_STACK) this->m_cErrHandler.message_callstack(__FUNCSIG__);
 #else
@@ -18,6 +18,10 @@ wm2000_main_ui_actions::wm2000_main_ui_actions(config_container *pcConfigData, v
     : wm2000_main_ui(pcConfigData, fUpdate_server, sConfigPath, parent)
 {
     CALL_STACK
+    this->m_bRefreshPending = false;
+    this->m_cRefreshTimer.setSingleShot(true);
+    this->m_cRefreshTimer.setTimerType(Qt::PreciseTimer);     // a coarse timer may fire early and exceed UiRefreshRate
+
     // load stored settings and set interface up
     std::string sXmlPath = sConfigPath + std::string("config.xml");
     pcConfigData->set_file_path(sXmlPath);
@@ -58,6 +62,7 @@ void wm2000_main_ui_actions::init_ui(QWidget *parent)
     connect(this->m_pcExpertAction,     SIGNAL(triggered()),            this, SLOT(handler_select_Expert()));
     connect(this->m_pcFreqAction,       SIGNAL(triggered()),            this, SLOT(open_freq_ui()));
     connect(this->m_pcAboutAction,      SIGNAL(triggered()),            this, SLOT(open_about_ui()));
+    connect(&this->m_cRefreshTimer,     SIGNAL(timeout()),              this, SLOT(handler_refresh_timeout()));
 
     connect(this->m_cUi.treeRxList,     SIGNAL(channel_ignore_triggered(int,uint64)),  this, SLOT(handler_add_to_ignore_clicked(int, uint64)));
     connect(this->m_cUi.treeRxList,     SIGNAL(channel_remove_triggered(int, uint64)), this, SLOT(handler_delete_from_list_clicked(int, uint64)));
@@ -757,6 +762,58 @@ void wm2000_main_ui_actions::update_ui()
 }
 
 
+/*
+*   request ui update, can be called from any thread
+*     all requests until the next refresh are merged into one refresh on the GUI thread
+*     (max. UiRefreshRate refreshes per second)
+*/
+void wm2000_main_ui_actions::request_update_ui()
+{
+    CALL_STACK
+    boost::lock_guard<boost::mutex> lock(this->m_cRefreshMutex);
+
+    if (!this->m_bRefreshPending)
+    {
+        this->m_bRefreshPending = true;
+        QMetaObject::invokeMethod(this, "handler_refresh_requested", Qt::QueuedConnection);
+    }
+    return;
+}
+
+
+/*
+*   first request since last refresh arrived at GUI thread, schedule refresh
+*/
+void wm2000_main_ui_actions::handler_refresh_requested()
+{
+    CALL_STACK
+    int iRate = this->m_pcConfigData->s_get_UiRefreshRate();
+    qint64 nInterval = 1000 / ((iRate > 0) ? iRate : DEFAULT_UI_REFRESH_RATE);
+    qint64 nElapsed  = this->m_cLastRefresh.isValid() ? this->m_cLastRefresh.elapsed() : nInterval;
+
+    this->m_cRefreshTimer.start((nElapsed >= nInterval) ? 0 : (int)(nInterval - nElapsed));
+    return;
+}
+
+
+/*
+*   refresh ui with all changes collected since last refresh
+*/
+void wm2000_main_ui_actions::handler_refresh_timeout()
+{
+    CALL_STACK
+    // take over request, events arriving from now on schedule the next refresh
+    {
+        boost::lock_guard<boost::mutex> lock(this->m_cRefreshMutex);
+        this->m_bRefreshPending = false;
+    }
+
+    this->m_cLastRefresh.start();
+    update_ui();
+    return;
+}
+
+
 /*
 *   update ui, if parameter where changed from plugin
 */
@@ -778,12 +835,12 @@ void wm2000_main_ui_actions::update_config()
 /*
 *   add entity of client filter
 */
-void wm2000_main_ui_actions::add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter)
+void wm2000_main_ui_actions::add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker)
 {
     CALL_STACK
     // update all clientTreeWidgets
-    this->m_pFreqUi->add_pointer(pcClientFilter, pcChannelFilter);
-    this->m_cUi.treeRxList->add_pointer(pcClientFilter, pcChannelFilter);
+    this->m_pFreqUi->add_pointer(pcClientFilter, pcChannelFilter, pcTalkTracker);
+    this->m_cUi.treeRxList->add_pointer(pcClientFilter, pcChannelFilter, pcTalkTracker);
 
     //update list field
     this->m_cUi.treeRxList->create_tree_entry(m_iActTabIndex - 1);
@@ -793,18 +850,29 @@ void wm2000_main_ui_actions::add_pointer(client_filter *pcClientFilter, channel_
 /*
 *   delete entity of client_filter
 */
-void wm2000_main_ui_actions::delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter)
+void wm2000_main_ui_actions::delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker)
 {
     CALL_STACK
     // update all clientTreeWidgets
-    this->m_pFreqUi->delete_pointer(pcClientFilter, pcChannelFilter);
-    this->m_cUi.treeRxList->delete_pointer(pcClientFilter, pcChannelFilter);
+    this->m_pFreqUi->delete_pointer(pcClientFilter, pcChannelFilter, pcTalkTracker);
+    this->m_cUi.treeRxList->delete_pointer(pcClientFilter, pcChannelFilter, pcTalkTracker);
 
     //update list field
     this->m_cUi.treeRxList->create_tree_entry(m_iActTabIndex - 1);
 }
 
 
+/*
+*   work pool for operations over all servers
+*/
+void wm2000_main_ui_actions::set_work_pool(work_pool *pcWorkPool)
+{
+    CALL_STACK
+    this->m_pFreqUi->set_work_pool(pcWorkPool);
+    this->m_cUi.treeRxList->set_work_pool(pcWorkPool);
+}
+
+
 /*
 *   compare local with static settings and enable "Save" dialog on demand
 */
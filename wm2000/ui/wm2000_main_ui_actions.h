@@ -1,4 +1,6 @@
 #pragma once
+#include <QtCore/QTimer>
+#include <QtCore/QElapsedTimer>
 #include "wm2000_main_ui.h"
 
 
@@ -15,17 +17,28 @@ public:
     //update function for plugin_base
     void update_ui() override;
     void update_config() override;
+    void request_update_ui();
 
     //client filter interface
-    void add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter) override;
-    void delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter) override;
+    void add_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker) override;
+    void delete_pointer(client_filter *pcClientFilter, channel_filter* pcChannelFilter, talk_tracker* pcTalkTracker) override;
+    void set_work_pool(work_pool *pcWorkPool);
 
 protected:
     bool check_LocalSettings();
     void load_base_config(config_container *pcConfigData, bool bInit = false);
     void init_ui(QWidget *parent) override;
 
+protected:
+    boost::mutex            m_cRefreshMutex;    // protects refresh request data, written by TS3 thread
+    bool                    m_bRefreshPending;  // refresh is already queued to GUI thread
+    QTimer                  m_cRefreshTimer;    // single shot timer to limit refresh rate
+    QElapsedTimer           m_cLastRefresh;     // time since last refresh
+
 public Q_SLOTS:
+    void handler_refresh_requested();
+    void handler_refresh_timeout();
+
     void handler_pbOk_clicked();
     void handler_pbApply_clicked();
     void handler_SaveAs_clicked();